@@ -0,0 +1,124 @@
+// Crowd playback from vertex animation textures, every instance reads its skinned vertices from
+// the baked frames instead of being skinned on the CPU
+
+cbuffer FrameBuffer : register(b0)
+{
+    matrix viewProjection;
+    float3 viewPosition;
+    float time;
+    float3 boundsMin;
+    uint textureWidth;
+    float3 boundsExtent;
+    uint rowsPerFrame;
+    uint vertexOffset;
+    bool useDiffuseMap;
+}
+
+cbuffer LightBuffer : register(b1)
+{
+    float4 lightAmbient;
+    float4 lightDiffuse;
+    float4 lightSpecular;
+    float3 lightDirection;
+}
+
+cbuffer MaterialBuffer : register(b2)
+{
+    float4 materialEmissive;
+    float4 materialAmbient;
+    float4 materialDiffuse;
+    float4 materialSpecular;
+    float materialShininess;
+}
+
+cbuffer ClipBuffer : register(b3)
+{
+    float4 clips[64]; // First frame, frame count, duration
+}
+
+struct Instance
+{
+    matrix world;
+    uint clipIndex;
+    float timeOffset;
+    float speed;
+    float padding;
+};
+
+cbuffer InstanceBuffer : register(b4)
+{
+    Instance instances[512];
+}
+
+SamplerState textureSampler : register(s0);
+
+Texture2D positionMap : register(t0);
+Texture2D normalMap : register(t1);
+Texture2D diffuseMap : register(t2);
+
+struct VS_INPUT
+{
+    float3 position : POSITION;
+    float3 normal : NORMAL;
+    float3 tangent : TANGENT;
+    float2 texCoord : TEXCOORD;
+};
+
+struct VS_OUTPUT
+{
+    float4 position : SV_Position;
+    float3 worldNormal : NORMAL;
+    float2 texCoord : TEXCOORD;
+    float3 dirToLight : TEXCOORD1;
+    float3 dirToView : TEXCOORD2;
+};
+
+int3 GetTexel(uint vertex, uint frame)
+{
+    return int3(vertex % textureWidth, frame * rowsPerFrame + vertex / textureWidth, 0);
+}
+
+VS_OUTPUT VS(VS_INPUT input, uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+    Instance instance = instances[instanceId];
+    float4 clip = clips[instance.clipIndex];
+
+    // Clips loop, playback blends the two frames around the current time
+    float phase = frac((time * instance.speed + instance.timeOffset) / clip.z);
+    float frame = phase * (clip.y - 1.0f);
+    uint frame0 = (uint) frame;
+    uint frame1 = min(frame0 + 1, (uint) clip.y - 1);
+    float t = frame - frame0;
+
+    uint vertex = vertexOffset + vertexId;
+    int3 texel0 = GetTexel(vertex, (uint) clip.x + frame0);
+    int3 texel1 = GetTexel(vertex, (uint) clip.x + frame1);
+    float3 position = lerp(positionMap.Load(texel0).xyz, positionMap.Load(texel1).xyz, t);
+    float3 normal = lerp(normalMap.Load(texel0).xyz, normalMap.Load(texel1).xyz, t);
+    position = boundsMin + position * boundsExtent;
+
+    float4 worldPosition = mul(float4(position, 1.0f), instance.world);
+
+    VS_OUTPUT output;
+    output.position = mul(worldPosition, viewProjection);
+    output.worldNormal = mul(normal, (float3x3) instance.world);
+    output.texCoord = input.texCoord;
+    output.dirToLight = -lightDirection;
+    output.dirToView = normalize(viewPosition - worldPosition.xyz);
+    return output;
+}
+
+float4 PS(VS_OUTPUT input) : SV_Target
+{
+    float3 n = normalize(input.worldNormal);
+    float3 light = normalize(input.dirToLight);
+    float3 view = normalize(input.dirToView);
+
+    float4 ambient = lightAmbient * materialAmbient;
+    float4 diffuse = saturate(dot(light, n)) * lightDiffuse * materialDiffuse;
+    float3 r = reflect(-light, n);
+    float4 specular = pow(saturate(dot(r, view)), materialShininess) * lightSpecular * materialSpecular;
+
+    float4 diffuseMapColor = (useDiffuseMap) ? diffuseMap.Sample(textureSampler, input.texCoord) : 1.0f;
+    return (materialEmissive + ambient + diffuse) * diffuseMapColor + specular;
+}
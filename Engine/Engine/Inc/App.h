@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "AssetPreloader.h"
 
 namespace Engine
 {
@@ -12,8 +13,44 @@ struct AppConfig
     uint32_t winWidth = 1200;
     uint32_t winHeight = 720;
     uint32_t maxVertexCount = 10000;
+    size_t frameMemorySize = 4 * 1024 * 1024; // Per frame arena, see FrameAllocator
+    std::filesystem::path logFile = L"Log.txt"; // Empty to only log to the console
+
+    // Periodic export of frame times and PerfCounters, .json for JSON lines, otherwise CSV.
+    // Empty to disable, the overlay (F3) works either way. F4 shows the memory breakdown.
+    std::filesystem::path telemetryFile;
+    float telemetryInterval = 10.0f; // Seconds
+
+    // Simulates frame N+1 on a worker while frame N is submitted, for states that support it.
+    // Throughput goes up when submission is CPU bound, at the cost of one frame of latency.
+    bool pipelined = false;
+
+    // Input recording of the run, or a recording to play back instead of the window's input.
+    // A replay runs with the recorded frame times and no vsync, writes every frame's CPU time to
+    // replayReportFile and quits when the recording ends. Only InputSystem is recorded: DebugUI
+    // takes its input straight from the window, so widget interaction and anything depending on
+    // WantCaptureMouse is not replayed. Record sessions without touching the DebugUI.
+    std::filesystem::path inputRecordFile;
+    std::filesystem::path inputReplayFile;
+    std::filesystem::path replayReportFile = L"ReplayFrames.csv";
+
+    // Seconds, replaces the measured frame time when above 0, for runs that record or replay
+    float fixedDeltaTime = 0.0f;
+
+    // Benchmark pass: flies the state's camera along the CameraPath in the file for
+    // flythroughFrameCount frames without vsync, then quits. Frames step by fixedDeltaTime, or
+    // Flythrough::DefaultFrameTime when it is 0. See Flythrough for the report.
+    std::filesystem::path flythroughFile;
+    uint32_t flythroughFrameCount = 1000;
+    std::filesystem::path flythroughReportFile = L"Flythrough.csv";
 };
 
+// Overrides the config from the command line, so builds can be benchmarked without code changes:
+//   --flythrough <path file> [--frames <count>] [--report <csv>]
+//   --record <input file>, --replay <input file>
+//   --pipelined, to compare a replay's frame times against the sequential run
+void ParseCommandLine(AppConfig& config, int argc, char* argv[]);
+
 class App final
 {
   public:
@@ -39,15 +76,23 @@ class App final
         }
     }
 
+    // Switches once the next state's assets are resident. Main thread only, not from Simulate.
     void ChangeState(const std::string& stateName);
 
   private:
     using AppStateMap = std::map<std::string, std::unique_ptr<AppState>>;
 
+    // Runs the graph with the state's tasks added, then the state's Initialize
+    void InitializeState(Core::TaskGraph& graph, Core::TaskId systems, const char* title);
+    void ShowDebugUI();
+
     AppStateMap mAppStates;
     AppState* mCurrentState = nullptr;
     AppState* mNextState = nullptr;
+    AssetPreloader mPreloader; // Loads what mNextState needs
 
     bool mRunning = false;
+    bool mShowPerfCounters = false;
+    bool mShowMemory = false;
 };
 } // namespace Engine
@@ -1,11 +1,31 @@
 #pragma once
 
+#include "Common.h"
+
 namespace Engine
 {
+struct AssetManifest;
+struct RenderSnapshot;
+
 class AppState
 {
   public:
     virtual ~AppState() = default;
+
+    // Work for Initialize that can run on workers alongside the engine's own startup: parsing
+    // models, decoding images, compiling shaders. Tasks without dependencies start with the window
+    // and may load CPU data through the asset managers, one task per manager as they are not
+    // thread safe. Tasks creating GPU resources depend on systems, done once the device is up.
+    // Initialize runs after the whole graph, on the main thread, and picks up the results.
+    virtual void AddInitializeTasks(Core::TaskGraph& graph, Core::TaskId systems)
+    {
+    }
+
+    // Models and textures Initialize loads. On ChangeState they are loaded in the background
+    // while the current state keeps running, the switch happens once all of them are resident.
+    virtual void GetAssetManifest(AssetManifest& manifest) const
+    {
+    }
     virtual void Initialize()
     {
     }
@@ -18,8 +38,43 @@ class AppState
     virtual void Render()
     {
     }
+
+    // Right before Render, with the mouse movement since Update, for states that return true from
+    // WantsLateLatch. Turning the camera here shows the newest cursor position instead of the one
+    // from the start of the frame. The movement handed over is left out of the next Update, so
+    // states that do not opt in keep seeing all of it there. Pipelined frames skip it, their
+    // camera is already in the snapshot.
+    virtual bool WantsLateLatch() const
+    {
+        return false;
+    }
+    virtual void LateLatch(float deltaTime, int mouseMoveX, int mouseMoveY)
+    {
+    }
     virtual void DebugUI()
     {
     }
+
+    // The camera a flythrough (AppConfig::flythroughFile) moves, after Update and before Render.
+    // States without one are not benchmarked.
+    virtual Graphics::Camera* GetCamera()
+    {
+        return nullptr;
+    }
+
+    // Pipelined frames (AppConfig::pipelined) call these instead of Update and Render. Simulate
+    // runs on a worker while the previous frame's snapshot is submitted, so it may not use the
+    // graphics device, SimpleDraw or the FrameAllocator, and must copy whatever Submit draws into
+    // the snapshot. DebugUI runs before Simulate starts, so it may still edit the state.
+    virtual bool SupportsPipelining() const
+    {
+        return false;
+    }
+    virtual void Simulate(float deltaTime, RenderSnapshot& snapshot)
+    {
+    }
+    virtual void Submit(const RenderSnapshot& snapshot)
+    {
+    }
 };
 } // namespace Engine
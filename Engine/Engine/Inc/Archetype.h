@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Entity.h"
+
+namespace Engine::ECS
+{
+// Storage for every entity with exactly the same set of components. Entities are packed into
+// fixed size chunks, and each chunk holds one array per component (plus the entity handles), so
+// systems iterate tightly packed component arrays. Rows stay dense: removing an entity moves the
+// last one into its slot.
+class Archetype
+{
+  public:
+    static constexpr uint32_t ChunkSize = 16 * 1024;
+
+    explicit Archetype(ComponentMask mask);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    ComponentMask GetMask() const;
+    bool Has(ComponentTypeId typeId) const;
+
+    uint32_t GetEntityCount() const;
+    uint32_t GetChunkCount() const;
+    uint32_t GetChunkCapacity() const;
+    uint32_t GetChunkEntityCount(uint32_t chunkIndex) const;
+
+    Entity* GetEntities(uint32_t chunkIndex);
+    void* GetComponents(uint32_t chunkIndex, ComponentTypeId typeId);
+    void* GetComponent(uint32_t row, ComponentTypeId typeId);
+    Entity GetEntity(uint32_t row) const;
+
+    // Adds a row for the entity. Its components are left unconstructed for the caller to fill.
+    uint32_t Allocate(Entity entity);
+
+    // Destroys the row's components. Returns the entity moved into the row, or NullEntity.
+    Entity Remove(uint32_t row);
+
+    // Moves the components both archetypes share into dstRow and destroys the rest. Returns the
+    // entity moved into the row, or NullEntity.
+    Entity MoveTo(uint32_t row, Archetype& dst, uint32_t dstRow);
+
+    void Clear();
+
+  private:
+    struct Column
+    {
+        ComponentTypeId typeId = 0;
+        uint32_t offset = 0; // Byte offset of the array inside a chunk
+        uint32_t size = 0;
+        ComponentInfo info;
+    };
+
+    struct alignas(64) Chunk
+    {
+        std::byte data[ChunkSize];
+    };
+
+    std::byte* GetAddress(uint32_t row, const Column& column) const;
+    Entity FillHole(uint32_t row);
+
+    ComponentMask mMask = 0;
+    std::vector<Column> mColumns;
+    int8_t mColumnIndices[MaxComponentTypes];
+    uint32_t mCapacity = 0;
+
+    std::vector<std::unique_ptr<Chunk>> mChunks;
+    uint32_t mEntityCount = 0;
+};
+} // namespace Engine::ECS
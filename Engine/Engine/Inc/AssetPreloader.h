@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine
+{
+// What a state loads in Initialize, for the preloader to have resident before the switch
+struct AssetManifest
+{
+    std::vector<std::filesystem::path> models;   // As RenderGroup::Initialize takes them
+    std::vector<std::filesystem::path> textures; // As TextureManager::LoadTexture takes them
+};
+
+// Loads the assets of the next state while the current one keeps running. Models are parsed and
+// textures decoded and created on the workers, Update hands them to the managers on the main
+// thread. The preloader holds a reference to every texture of the manifest and of the models'
+// materials until Release, so textures both states use stay resident through the switch.
+class AssetPreloader final
+{
+  public:
+    AssetPreloader() = default;
+    ~AssetPreloader();
+
+    AssetPreloader(const AssetPreloader&) = delete;
+    AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+    // Releases a preload still in flight and starts on the manifest. Resident assets are only
+    // referenced.
+    void Begin(const AssetManifest& manifest);
+
+    // Once per frame on the main thread. True when everything is resident.
+    bool Update();
+
+    // Waits for the workers and drops the preloader's references, once the next state holds its
+    // own. Also drops whatever was not handed to the managers yet.
+    void Release();
+
+    uint32_t GetPendingCount() const;
+
+  private:
+    struct PendingModel
+    {
+        std::filesystem::path filePath;
+        std::unique_ptr<Graphics::Model> model;
+        std::atomic<bool> isReady{false};
+    };
+
+    struct PendingTexture
+    {
+        std::filesystem::path filename;
+        Graphics::Texture texture;
+        std::atomic<bool> isReady{false};
+    };
+
+    void RequestModel(const std::filesystem::path& filePath);
+    void RequestMaterialTextures(const Graphics::Model& model);
+    void RequestTexture(const std::filesystem::path& filename, bool useRootDir);
+    void Wait();
+
+    // Behind pointers, the jobs write into them while new requests are added
+    std::vector<std::unique_ptr<PendingModel>> mModels;
+    std::vector<std::unique_ptr<PendingTexture>> mTextures;
+    Core::FlatHashMap<Core::StringId, bool> mRequested; // Every path of this preload
+    std::vector<Graphics::TextureId> mTextureIds;
+    Core::JobCounter mCounter;
+
+    std::chrono::steady_clock::time_point mStartTime;
+    uint32_t mModelCount = 0;
+    uint32_t mTextureCount = 0;
+    bool mIsLoading = false;
+};
+} // namespace Engine
@@ -3,6 +3,13 @@
 #include "Common.h"
 #include "AppState.h"
 #include "App.h"
+#include "AssetPreloader.h"
+#include "Flythrough.h"
+#include "FramePipeline.h"
+#include "RenderSnapshot.h"
+#include "World.h"
+#include "SceneComponents.h"
+#include "SceneSystems.h"
 
 namespace Engine
 {
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::ECS
+{
+// Index into the world's entity records plus a generation, so stale handles to a destroyed and
+// reused slot are detected
+struct Entity
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const
+    {
+        return index != UINT32_MAX;
+    }
+
+    bool operator==(const Entity& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const Entity& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+constexpr Entity NullEntity;
+
+using ComponentTypeId = uint32_t;
+using ComponentMask = uint64_t;
+constexpr uint32_t MaxComponentTypes = 64;
+
+// Type erased operations the archetype storage needs to move components between chunks
+struct ComponentInfo
+{
+    const char* name = nullptr;
+    uint32_t size = 0;
+    uint32_t alignment = 0;
+    void (*moveConstruct)(void* dst, void* src) = nullptr; // Move constructs then destroys src
+    void (*destroy)(void* ptr) = nullptr;
+};
+
+ComponentTypeId RegisterComponentType(const ComponentInfo& info);
+const ComponentInfo& GetComponentInfo(ComponentTypeId typeId);
+
+namespace Detail
+{
+template <class Type> ComponentTypeId GetTypeId()
+{
+    static_assert(std::is_move_constructible_v<Type>, "ECS: Components must be movable");
+
+    static const ComponentTypeId sTypeId = []()
+    {
+        ComponentInfo info;
+        info.name = typeid(Type).name();
+        info.size = static_cast<uint32_t>(sizeof(Type));
+        info.alignment = static_cast<uint32_t>(alignof(Type));
+        info.moveConstruct = [](void* dst, void* src)
+        {
+            new (dst) Type(std::move(*static_cast<Type*>(src)));
+            static_cast<Type*>(src)->~Type();
+        };
+        info.destroy = [](void* ptr) { static_cast<Type*>(ptr)->~Type(); };
+        return ECS::RegisterComponentType(info);
+    }();
+    return sTypeId;
+}
+} // namespace Detail
+
+// Any movable type can be a component, ids are handed out on first use. T and const T share an id.
+template <class T> ComponentTypeId GetComponentTypeId()
+{
+    return Detail::GetTypeId<std::remove_cv_t<std::remove_reference_t<T>>>();
+}
+
+template <class... Ts> ComponentMask GetComponentMask()
+{
+    return (ComponentMask{0} | ... | (ComponentMask{1} << GetComponentTypeId<Ts>()));
+}
+} // namespace Engine::ECS
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine
+{
+// Benchmark pass that flies the state's camera along a CameraPath for a fixed number of frames,
+// whatever the input does. Every frame's CPU and GPU time and PerfCounters are kept, End writes
+// them out and logs the spread and the worst frames.
+class Flythrough final
+{
+  public:
+    static constexpr float DefaultFrameTime = 1.0f / 60.0f; // Seconds the states step per frame
+
+    Flythrough() = default;
+    ~Flythrough();
+
+    Flythrough(const Flythrough&) = delete;
+    Flythrough& operator=(const Flythrough&) = delete;
+
+    bool Begin(const std::filesystem::path& pathFile, uint32_t frameCount);
+    bool IsRunning() const;
+
+    // At the start of the frame, the CPU and GPU time run until EndRender
+    void BeginFrame();
+    void Apply(Graphics::Camera& camera) const;
+
+    // Right before present. Present blocks on the GPU with vsync off, it would show up as CPU time.
+    void EndRender();
+
+    // After PerfCounters::EndFrame. False once every frame ran.
+    bool EndFrame();
+
+    // Waits for the GPU times still in flight, writes a CSV of every frame and its counters and
+    // logs the summary. Empty reportFile only logs.
+    void End(const std::filesystem::path& reportFile);
+
+  private:
+    void LogFrame(const char* title, uint32_t frame) const;
+
+    Graphics::CameraPath mPath;
+    Graphics::GpuTimer mGpuTimer;
+    std::chrono::steady_clock::time_point mFrameStart;
+    uint32_t mFrame = 0;
+    uint32_t mFrameCount = 0;
+    bool mIsRunning = false;
+
+    std::vector<float> mCpuMs;
+    std::vector<float> mGpuMs;           // Negative for frames the GPU timer missed
+    std::vector<int64_t> mCounterValues; // mCounterCount per frame
+    uint32_t mCounterCount = 0;
+};
+} // namespace Engine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+
+namespace Engine
+{
+class AppState;
+
+// Runs the simulation of the next frame on a worker while the current one is submitted. Two
+// snapshots take turns: Kick starts AppState::Simulate into one and hands back the other, filled
+// by the previous Kick, for AppState::Submit. Frames are shown one frame later than sequentially.
+class FramePipeline final
+{
+  public:
+    FramePipeline() = default;
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Starts simulating the next frame. Returns the snapshot to submit meanwhile, nullptr on the
+    // first frame after a Reset, when nothing has been simulated yet.
+    const RenderSnapshot* Kick(AppState& state, float deltaTime);
+
+    // Blocks until the frame in flight is simulated. Anything Simulate reads, input, the window
+    // or the state itself, may only change after this.
+    void Wait();
+
+    // Waits and drops both snapshots, e.g. before the state changes
+    void Reset();
+
+  private:
+    RenderSnapshot mSnapshots[2];
+    Core::JobCounter mCounter;
+    uint64_t mFrame = 0;
+    uint32_t mSimulateIndex = 0;
+    bool mHasSnapshot = false;
+};
+} // namespace Engine
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine
+{
+// What one frame draws, copied out of the simulation. With pipelined frames the snapshot of
+// frame N is submitted while frame N+1 fills the other one, so it may only point at draw data
+// the simulation leaves alone: render objects, render groups, materials and textures.
+struct RenderSnapshot
+{
+    struct MeshDraw
+    {
+        const Graphics::RenderObject* renderObject = nullptr;
+        Math::Matrix4 matWorld;
+    };
+
+    struct ModelDraw
+    {
+        Graphics::RenderGroup* renderGroup = nullptr; // Non const for the MeshletCuller
+        Math::Matrix4 matWorld;
+    };
+
+    Graphics::Camera camera;
+    Graphics::DirectionalLight directionalLight;
+
+    std::vector<MeshDraw> meshes;
+    std::vector<ModelDraw> models;
+    std::vector<MeshDraw> shadowMeshes; // Shadow casters, also in the lists above
+    std::vector<ModelDraw> shadowModels;
+
+    uint64_t frame = 0; // Counts up from 1, 0 until the snapshot is first filled
+};
+} // namespace Engine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::ECS
+{
+// Local transform is Graphics::Transform itself. WorldMatrix is written by UpdateWorldMatrices.
+struct WorldMatrix
+{
+    Math::Matrix4 value = Math::Matrix4::Identity;
+};
+
+// Renderables point at shared draw data. Meshes, materials and textures stay in the render
+// object or group, so entities sharing a model share them, and the per-entity rows systems
+// iterate only hold the transform, the world matrix and this pointer.
+struct MeshRenderer
+{
+    const Graphics::RenderObject* renderObject = nullptr;
+};
+
+struct ModelRenderer
+{
+    Graphics::RenderGroup* renderGroup = nullptr; // Non const so the MeshletCuller can rewrite it
+};
+
+// Tag for entities drawn into the shadow map
+struct ShadowCaster
+{
+};
+} // namespace Engine::ECS
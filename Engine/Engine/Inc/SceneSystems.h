@@ -0,0 +1,43 @@
+#pragma once
+
+#include "World.h"
+#include "RenderSnapshot.h"
+#include "SceneComponents.h"
+
+namespace Engine::ECS
+{
+// Rebuilds WorldMatrix from Graphics::Transform for every entity that has both, chunks in parallel
+void UpdateWorldMatrices(World& world);
+
+// Draws every MeshRenderer and ModelRenderer, between the effect's Begin and End. With a culler
+// (after its Begin) each model is culled right before its draw, since entities sharing a
+// RenderGroup also share the index buffers the culler rewrites.
+void RenderScene(World& world,
+                 Graphics::StandardEffect& effect,
+                 Graphics::MeshletCuller* culler = nullptr);
+
+// Draws every ShadowCaster, between the effect's Begin and End, culling like RenderScene
+void RenderShadows(World& world,
+                   Graphics::ShadowEffect& effect,
+                   Graphics::MeshletCuller* culler = nullptr);
+
+// Copies every MeshRenderer and ModelRenderer with its world matrix into the snapshot's draw
+// lists, shadow casters into the shadow lists too. Only reads the world, so it can run on a
+// worker while another snapshot is being submitted.
+void BuildRenderSnapshot(World& world, RenderSnapshot& snapshot);
+
+// Same as the World versions, drawing from a snapshot
+void RenderScene(const RenderSnapshot& snapshot,
+                 Graphics::StandardEffect& effect,
+                 Graphics::MeshletCuller* culler = nullptr);
+void RenderShadows(const RenderSnapshot& snapshot,
+                   Graphics::ShadowEffect& effect,
+                   Graphics::MeshletCuller* culler = nullptr);
+
+// Closest ModelRenderer hit along the ray, in world units
+bool Raycast(World& world,
+             const Math::Ray& ray,
+             float maxDistance,
+             Entity& hitEntity,
+             Graphics::RayHit& hit);
+} // namespace Engine::ECS
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Archetype.h"
+
+namespace Engine::ECS
+{
+// Owns entities and their components, stored by archetype. Component data for a query is visited
+// chunk by chunk, so a system only touches the arrays it asks for. Adding or removing a component
+// moves the entity to the archetype matching its new component set.
+//
+// Entities can not be created, destroyed or change components while a ForEach is running.
+class World final
+{
+  public:
+    World() = default;
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    template <class... Ts> Entity Create(Ts&&... components);
+    void Destroy(Entity entity);
+    bool IsAlive(Entity entity) const;
+    void Clear();
+
+    // Constructs the component from args, or assigns it when the entity already has one
+    template <class T, class... Args> T& AddComponent(Entity entity, Args&&... args);
+    template <class T> void RemoveComponent(Entity entity);
+    template <class T> bool HasComponent(Entity entity) const;
+    template <class T> T* GetComponent(Entity entity); // nullptr when missing
+
+    // Fn is void(Entity, Ts&...)
+    template <class... Ts, class Fn> void ForEach(Fn&& fn);
+
+    // Fn is void(uint32_t count, const Entity* entities, Ts*... components), called once per
+    // chunk with the packed component arrays
+    template <class... Ts, class Fn> void ForEachChunk(Fn&& fn);
+
+    // Same as the above, with chunks spread over the JobSystem. Blocks until every chunk ran.
+    template <class... Ts, class Fn> void ParallelForEach(Fn&& fn);
+    template <class... Ts, class Fn> void ParallelForEachChunk(Fn&& fn);
+
+    uint32_t GetEntityCount() const;
+    uint32_t GetArchetypeCount() const;
+
+  private:
+    struct EntityRecord
+    {
+        Archetype* archetype = nullptr; // nullptr when the slot is free
+        uint32_t row = 0;
+        uint32_t generation = 0;
+    };
+
+    struct ChunkRef
+    {
+        Archetype* archetype;
+        uint32_t chunkIndex;
+    };
+
+    Entity AllocateEntity(Archetype& archetype);
+    Archetype& GetArchetype(ComponentMask mask);
+    void MoveEntity(Entity entity, Archetype& dst);
+    void GatherChunks(ComponentMask mask, std::vector<ChunkRef>& chunks) const;
+    EntityRecord* GetRecord(Entity entity);
+    const EntityRecord* GetRecord(Entity entity) const;
+
+    std::vector<EntityRecord> mRecords;
+    std::vector<uint32_t> mFreeIndices;
+    std::vector<std::unique_ptr<Archetype>> mArchetypes;
+    Core::FlatHashMap<ComponentMask, Archetype*> mArchetypeLookup;
+    uint32_t mEntityCount = 0;
+    uint32_t mIterationDepth = 0;
+};
+
+template <class... Ts> Entity World::Create(Ts&&... components)
+{
+    ASSERT(mIterationDepth == 0, "World: Can not create entities while iterating");
+
+    const ComponentMask mask = GetComponentMask<Ts...>();
+    ASSERT(std::bitset<MaxComponentTypes>(mask).count() == sizeof...(Ts),
+           "World: Duplicate component type");
+
+    Archetype& archetype = GetArchetype(mask);
+    const Entity entity = AllocateEntity(archetype);
+    const uint32_t row = mRecords[entity.index].row;
+    (new (archetype.GetComponent(row, GetComponentTypeId<Ts>()))
+         std::remove_cv_t<std::remove_reference_t<Ts>>(std::forward<Ts>(components)),
+     ...);
+    return entity;
+}
+
+template <class T, class... Args> T& World::AddComponent(Entity entity, Args&&... args)
+{
+    ASSERT(mIterationDepth == 0, "World: Can not add components while iterating");
+
+    EntityRecord* record = GetRecord(entity);
+    ASSERT(record != nullptr, "World: Invalid entity");
+
+    const ComponentTypeId typeId = GetComponentTypeId<T>();
+    if (record->archetype->Has(typeId))
+    {
+        T* component = static_cast<T*>(record->archetype->GetComponent(record->row, typeId));
+        *component = T{std::forward<Args>(args)...};
+        return *component;
+    }
+
+    Archetype& dst = GetArchetype(record->archetype->GetMask() | (ComponentMask{1} << typeId));
+    MoveEntity(entity, dst);
+    return *new (dst.GetComponent(record->row, typeId)) T{std::forward<Args>(args)...};
+}
+
+template <class T> void World::RemoveComponent(Entity entity)
+{
+    ASSERT(mIterationDepth == 0, "World: Can not remove components while iterating");
+
+    EntityRecord* record = GetRecord(entity);
+    ASSERT(record != nullptr, "World: Invalid entity");
+
+    const ComponentTypeId typeId = GetComponentTypeId<T>();
+    if (record != nullptr && record->archetype->Has(typeId))
+    {
+        const ComponentMask mask = record->archetype->GetMask() & ~(ComponentMask{1} << typeId);
+        MoveEntity(entity, GetArchetype(mask));
+    }
+}
+
+template <class T> bool World::HasComponent(Entity entity) const
+{
+    const EntityRecord* record = GetRecord(entity);
+    return record != nullptr && record->archetype->Has(GetComponentTypeId<T>());
+}
+
+template <class T> T* World::GetComponent(Entity entity)
+{
+    const EntityRecord* record = GetRecord(entity);
+    if (record == nullptr)
+    {
+        return nullptr;
+    }
+    return static_cast<T*>(record->archetype->GetComponent(record->row, GetComponentTypeId<T>()));
+}
+
+template <class... Ts, class Fn> void World::ForEach(Fn&& fn)
+{
+    ForEachChunk<Ts...>(
+        [&fn](uint32_t count, const Entity* entities, Ts*... components)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                fn(entities[i], components[i]...);
+            }
+        });
+}
+
+template <class... Ts, class Fn> void World::ForEachChunk(Fn&& fn)
+{
+    const ComponentMask mask = GetComponentMask<Ts...>();
+    ++mIterationDepth;
+    for (const std::unique_ptr<Archetype>& archetype : mArchetypes)
+    {
+        if ((archetype->GetMask() & mask) != mask)
+        {
+            continue;
+        }
+
+        const uint32_t chunkCount = archetype->GetChunkCount();
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            const uint32_t count = archetype->GetChunkEntityCount(chunkIndex);
+            if (count > 0)
+            {
+                fn(count,
+                   archetype->GetEntities(chunkIndex),
+                   static_cast<Ts*>(archetype->GetComponents(chunkIndex,
+                                                             GetComponentTypeId<Ts>()))...);
+            }
+        }
+    }
+    --mIterationDepth;
+}
+
+template <class... Ts, class Fn> void World::ParallelForEach(Fn&& fn)
+{
+    ParallelForEachChunk<Ts...>(
+        [&fn](uint32_t count, const Entity* entities, Ts*... components)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                fn(entities[i], components[i]...);
+            }
+        });
+}
+
+template <class... Ts, class Fn> void World::ParallelForEachChunk(Fn&& fn)
+{
+    // Registers the component types on this thread before any job looks them up
+    const ComponentMask mask = GetComponentMask<Ts...>();
+    std::vector<ChunkRef> chunks;
+    GatherChunks(mask, chunks);
+
+    ++mIterationDepth;
+    Core::JobSystem::Get()->ParallelFor(
+        static_cast<uint32_t>(chunks.size()),
+        1,
+        [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                Archetype& archetype = *chunks[i].archetype;
+                const uint32_t chunkIndex = chunks[i].chunkIndex;
+                fn(archetype.GetChunkEntityCount(chunkIndex),
+                   archetype.GetEntities(chunkIndex),
+                   static_cast<Ts*>(archetype.GetComponents(chunkIndex,
+                                                            GetComponentTypeId<Ts>()))...);
+            }
+        });
+    --mIterationDepth;
+}
+} // namespace Engine::ECS
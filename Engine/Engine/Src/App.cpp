@@ -1,74 +1,259 @@
 #include "Precompiled.h"
 #include "App.h"
 #include "AppState.h"
+#include "Flythrough.h"
+#include "FramePipeline.h"
 
 using namespace Engine;
 using namespace Engine::Core;
 using namespace Engine::Graphics;
 using namespace Engine::Input;
 
+namespace
+{
+void WriteReplayReport(const std::filesystem::path& filePath, std::vector<float> frameMs)
+{
+    if (frameMs.empty())
+    {
+        return;
+    }
+
+    if (!filePath.empty())
+    {
+        FILE* file = fopen(filePath.u8string().c_str(), "w");
+        if (file == nullptr)
+        {
+            LOG_WARNING(Engine, "App: Failed to open %s", filePath.u8string().c_str());
+        }
+        else
+        {
+            fprintf(file, "frame,ms\n");
+            for (size_t i = 0; i < frameMs.size(); ++i)
+            {
+                fprintf(file, "%zu,%.3f\n", i, frameMs[i]);
+            }
+            fclose(file);
+        }
+    }
+
+    const TimeUtil::FrameTimeSummary summary = TimeUtil::Summarize(std::move(frameMs));
+    LOG_INFO(Engine,
+             "App: Replay of %u frames, min %.3f ms, mean %.3f ms, p50 %.3f ms, p95 %.3f ms, "
+             "p99 %.3f ms, max %.3f ms",
+             summary.count,
+             summary.min,
+             summary.mean,
+             summary.p50,
+             summary.p95,
+             summary.p99,
+             summary.max);
+}
+} // namespace
+
 void App::Run(const AppConfig& config)
 {
+    Logger::StaticInitialize(config.logFile);
     LOG("App Started");
+    PerfCounters::StaticInitialize(config.telemetryFile, config.telemetryInterval);
 
     // Initialize Everything
-    Window myWindow;
-    myWindow.Initialize(nullptr, config.appName, config.winWidth, config.winHeight);
-    auto handle = myWindow.GetWindowHandle();
-    GraphicsSystem::StaticInitialize(handle, false);
-    InputSystem::StaticInitialize(handle);
-    DebugUI::StaticInitialize(handle, false, true);
-    SimpleDraw::StaticInitialize(config.maxVertexCount);
+    JobSystem::StaticInitialize();
+    FrameAllocator::StaticInitialize(config.frameMemorySize);
     TextureManager::StaticInitialize(L"Assets/Textures");
     ModelManager::StaticInitialize(L"Assets/Models");
 
+    // The window and everything bound to it stays on this thread, in the old order: ImGui chains
+    // the input callbacks. SimpleDraw and the state's own tasks run on the workers meanwhile;
+    // device creation calls are thread safe and the context is not touched before the first frame.
+    Window myWindow;
+    TaskGraph startup;
+    const TaskId windowTask = startup.Add(
+        "Window",
+        [&]() { myWindow.Initialize(nullptr, config.appName, config.winWidth, config.winHeight); },
+        {},
+        TaskThread::Main);
+    const TaskId graphicsTask = startup.Add(
+        "GraphicsSystem",
+        [&]() { GraphicsSystem::StaticInitialize(myWindow.GetWindowHandle(), false); },
+        {windowTask},
+        TaskThread::Main);
+    const TaskId inputTask = startup.Add(
+        "InputSystem",
+        [&]() { InputSystem::StaticInitialize(myWindow.GetWindowHandle()); },
+        {windowTask},
+        TaskThread::Main);
+    const TaskId debugUITask = startup.Add(
+        "DebugUI",
+        [&]() { DebugUI::StaticInitialize(myWindow.GetWindowHandle(), false, true); },
+        {graphicsTask, inputTask},
+        TaskThread::Main);
+    const TaskId simpleDrawTask =
+        startup.Add("SimpleDraw",
+                    [&]() { SimpleDraw::StaticInitialize(config.maxVertexCount); },
+                    {graphicsTask});
+    const TaskId systemsTask =
+        startup.Add("Systems", nullptr, {graphicsTask, inputTask, debugUITask, simpleDrawTask});
+
     // Last Step Before Running
     ASSERT(mCurrentState != nullptr, "App: Need an app state to run");
-    mCurrentState->Initialize();
+    InitializeState(startup, systemsTask, "Startup");
 
     // Process Updates
     InputSystem* input = InputSystem::Get();
+    if (!config.inputReplayFile.empty() && input->StartReplay(config.inputReplayFile))
+    {
+        GraphicsSystem::Get()->SetVSync(false);
+    }
+    else if (!config.inputRecordFile.empty())
+    {
+        input->StartRecording(config.inputRecordFile);
+    }
+    std::vector<float> replayFrameMs;
+
+    Flythrough flythrough;
+    if (!config.flythroughFile.empty() && mCurrentState->GetCamera() == nullptr)
+    {
+        LOG_WARNING(Engine, "App: The state has no camera for the flythrough");
+    }
+    else if (!config.flythroughFile.empty() &&
+             flythrough.Begin(config.flythroughFile, config.flythroughFrameCount))
+    {
+        GraphicsSystem::Get()->SetVSync(false);
+    }
+
+    FramePipeline pipeline;
     mRunning = true;
     while (mRunning)
     {
+        // Everything below is read by the frame in flight
+        pipeline.Wait();
+
+        const auto frameStart = std::chrono::steady_clock::now();
+        FrameAllocator::BeginFrame();
         myWindow.ProcessMessage();
 
+        const bool wasReplaying = input->IsReplaying();
         input->Update();
+        if (wasReplaying && !input->IsReplaying())
+        {
+            Quit();
+            continue;
+        }
 
         if (!myWindow.IsActive() || input->IsKeyPressed(KeyCode::ESCAPE))
         {
             Quit();
             continue;
         }
+        if (input->IsKeyPressed(KeyCode::F3))
+        {
+            mShowPerfCounters = !mShowPerfCounters;
+        }
+        if (input->IsKeyPressed(KeyCode::F4))
+        {
+            mShowMemory = !mShowMemory;
+        }
 
-        if (mNextState != nullptr)
+        if (mNextState != nullptr && mPreloader.Update())
         {
+            pipeline.Reset();
             mCurrentState->Terminate();
             mCurrentState = std::exchange(mNextState, nullptr);
-            mCurrentState->Initialize();
+
+            TaskGraph graph;
+            InitializeState(graph, graph.Add("Systems", nullptr), "State change");
+            mPreloader.Release();
         }
 
-        float deltaTime = TimeUtil::GetDeltaTime();
+        float fixedDeltaTime = config.fixedDeltaTime;
+        if (flythrough.IsRunning())
+        {
+            flythrough.BeginFrame();
+            if (fixedDeltaTime <= 0.0f)
+            {
+                fixedDeltaTime = Flythrough::DefaultFrameTime;
+            }
+        }
+        const float measuredTime = TimeUtil::GetDeltaTime();
+        const float deltaTime =
+            input->GetFrameDeltaTime(fixedDeltaTime > 0.0f ? fixedDeltaTime : measuredTime);
+        bool isPaused = false;
 #if defined(_DEBUG)
-        if (deltaTime < 0.5f) // Primarily for handling Breakpoints
+        isPaused = (deltaTime >= 0.5f); // Primarily for handling Breakpoints
 #endif
+
+        GraphicsSystem* gs = GraphicsSystem::Get();
+        // A flythrough places the camera between Update and Render, so it runs sequentially
+        if (config.pipelined && mCurrentState->SupportsPipelining() && !flythrough.IsRunning())
         {
-            mCurrentState->Update(deltaTime);
+            // The state is edited by DebugUI before the worker starts reading it
+            DebugUI::BeginRender();
+            ShowDebugUI();
+            const RenderSnapshot* snapshot =
+                pipeline.Kick(*mCurrentState, isPaused ? 0.0f : deltaTime);
+
+            gs->BeginRender();
+            if (snapshot != nullptr)
+            {
+                mCurrentState->Submit(*snapshot);
+            }
+            DebugUI::EndRender();
         }
+        else
+        {
+            pipeline.Reset();
+            if (!isPaused)
+            {
+                mCurrentState->Update(deltaTime);
+            }
 
-        GraphicsSystem* gs = GraphicsSystem::Get();
-        gs->BeginRender();
-        mCurrentState->Render();
+            gs->BeginRender();
+            Camera* camera = flythrough.IsRunning() ? mCurrentState->GetCamera() : nullptr;
+            if (camera != nullptr)
+            {
+                flythrough.Apply(*camera);
+            }
+            else if (!isPaused && mCurrentState->WantsLateLatch())
+            {
+                int mouseMoveX = 0;
+                int mouseMoveY = 0;
+                input->LatchMouse(mouseMoveX, mouseMoveY);
+                mCurrentState->LateLatch(deltaTime, mouseMoveX, mouseMoveY);
+            }
+            mCurrentState->Render();
 
-        DebugUI::BeginRender();
-        mCurrentState->DebugUI();
-        DebugUI::EndRender();
+            DebugUI::BeginRender();
+            ShowDebugUI();
+            DebugUI::EndRender();
+        }
 
+        const bool isFlythroughFrame = flythrough.IsRunning();
+        if (isFlythroughFrame)
+        {
+            flythrough.EndRender();
+        }
         gs->EndRender();
+        input->OnFramePresented();
+        PerfCounters::EndFrame();
+        if (isFlythroughFrame && !flythrough.EndFrame())
+        {
+            Quit();
+        }
+        if (wasReplaying)
+        {
+            const auto frameTime = std::chrono::steady_clock::now() - frameStart;
+            replayFrameMs.push_back(std::chrono::duration<float, std::milli>(frameTime).count());
+        }
     }
 
     // Terminate Everything
     LOG("App Quit");
+    WriteReplayReport(config.replayReportFile, std::move(replayFrameMs));
+    flythrough.End(config.flythroughReportFile);
+    input->StopRecording();
+    input->StopReplay();
+    pipeline.Reset();
+    mPreloader.Release();
     mCurrentState->Terminate();
 
     ModelManager::StaticTerminate();
@@ -79,6 +264,32 @@ void App::Run(const AppConfig& config)
     InputSystem::StaticTerminate();
 
     myWindow.Terminate();
+    FrameAllocator::StaticTerminate();
+    JobSystem::StaticTerminate();
+    MemoryTracker::ReportLeaks();
+    PerfCounters::StaticTerminate();
+    Logger::StaticTerminate();
+}
+
+void App::InitializeState(TaskGraph& graph, TaskId systems, const char* title)
+{
+    mCurrentState->AddInitializeTasks(graph, systems);
+    graph.Run();
+    graph.LogTimeline(title);
+    mCurrentState->Initialize();
+}
+
+void App::ShowDebugUI()
+{
+    mCurrentState->DebugUI();
+    if (mShowPerfCounters)
+    {
+        DebugUI::ShowPerfCounters();
+    }
+    if (mShowMemory)
+    {
+        DebugUI::ShowMemory();
+    }
 }
 
 void App::Quit()
@@ -92,5 +303,60 @@ void App::ChangeState(const std::string& stateName)
     if (iter != mAppStates.end())
     {
         mNextState = iter->second.get();
+
+        // Before Run the managers are not up, the state loads everything in Initialize
+        if (mRunning)
+        {
+            AssetManifest manifest;
+            mNextState->GetAssetManifest(manifest);
+            mPreloader.Begin(manifest);
+        }
+    }
+}
+
+void Engine::ParseCommandLine(AppConfig& config, int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view option = argv[i];
+        if (option == "--pipelined")
+        {
+            config.pipelined = true;
+            continue;
+        }
+
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            LOG_WARNING(Engine, "App: %s needs a value", argv[i]);
+            break;
+        }
+
+        if (option == "--flythrough")
+        {
+            config.flythroughFile = std::filesystem::u8path(value);
+        }
+        else if (option == "--frames")
+        {
+            config.flythroughFrameCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--report")
+        {
+            config.flythroughReportFile = std::filesystem::u8path(value);
+        }
+        else if (option == "--record")
+        {
+            config.inputRecordFile = std::filesystem::u8path(value);
+        }
+        else if (option == "--replay")
+        {
+            config.inputReplayFile = std::filesystem::u8path(value);
+        }
+        else
+        {
+            LOG_WARNING(Engine, "App: Unknown option %s", argv[i]);
+            continue;
+        }
+        ++i;
     }
 }
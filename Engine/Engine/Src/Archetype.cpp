@@ -0,0 +1,218 @@
+#include "Precompiled.h"
+#include "Archetype.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+
+namespace
+{
+uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Byte size of a chunk laid out as [entities][column 0][column 1]... for the given capacity
+uint32_t GetLayoutSize(const std::vector<ComponentInfo>& infos, uint32_t capacity)
+{
+    uint32_t size = static_cast<uint32_t>(sizeof(Entity)) * capacity;
+    for (const ComponentInfo& info : infos)
+    {
+        size = AlignUp(size, info.alignment) + info.size * capacity;
+    }
+    return size;
+}
+} // namespace
+
+Archetype::Archetype(ComponentMask mask)
+    : mMask(mask)
+{
+    std::fill(std::begin(mColumnIndices), std::end(mColumnIndices), int8_t(-1));
+
+    std::vector<ComponentInfo> infos;
+    uint32_t rowSize = static_cast<uint32_t>(sizeof(Entity));
+    for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; ++typeId)
+    {
+        if ((mask & (ComponentMask{1} << typeId)) != 0)
+        {
+            const ComponentInfo& info = GetComponentInfo(typeId);
+            ASSERT(info.alignment <= alignof(Chunk), "Archetype: Component alignment too large");
+            mColumnIndices[typeId] = static_cast<int8_t>(mColumns.size());
+            mColumns.push_back({typeId, 0, info.size, info});
+            infos.push_back(info);
+            rowSize += info.size;
+        }
+    }
+
+    // Start from the unpadded estimate and back off until the alignment padding fits
+    mCapacity = ChunkSize / rowSize;
+    while (mCapacity > 1 && GetLayoutSize(infos, mCapacity) > ChunkSize)
+    {
+        --mCapacity;
+    }
+    ASSERT(mCapacity > 0 && GetLayoutSize(infos, mCapacity) <= ChunkSize,
+           "Archetype: Components do not fit in a chunk");
+
+    uint32_t offset = static_cast<uint32_t>(sizeof(Entity)) * mCapacity;
+    for (size_t i = 0; i < mColumns.size(); ++i)
+    {
+        offset = AlignUp(offset, infos[i].alignment);
+        mColumns[i].offset = offset;
+        offset += infos[i].size * mCapacity;
+    }
+}
+
+Archetype::~Archetype()
+{
+    Clear();
+}
+
+ComponentMask Archetype::GetMask() const
+{
+    return mMask;
+}
+
+bool Archetype::Has(ComponentTypeId typeId) const
+{
+    return (mMask & (ComponentMask{1} << typeId)) != 0;
+}
+
+uint32_t Archetype::GetEntityCount() const
+{
+    return mEntityCount;
+}
+
+uint32_t Archetype::GetChunkCount() const
+{
+    return static_cast<uint32_t>(mChunks.size());
+}
+
+uint32_t Archetype::GetChunkCapacity() const
+{
+    return mCapacity;
+}
+
+uint32_t Archetype::GetChunkEntityCount(uint32_t chunkIndex) const
+{
+    const uint32_t begin = chunkIndex * mCapacity;
+    return (mEntityCount > begin) ? std::min(mCapacity, mEntityCount - begin) : 0;
+}
+
+Entity* Archetype::GetEntities(uint32_t chunkIndex)
+{
+    return reinterpret_cast<Entity*>(mChunks[chunkIndex]->data);
+}
+
+void* Archetype::GetComponents(uint32_t chunkIndex, ComponentTypeId typeId)
+{
+    const int8_t column = mColumnIndices[typeId];
+    if (column < 0)
+    {
+        return nullptr;
+    }
+    return mChunks[chunkIndex]->data + mColumns[column].offset;
+}
+
+void* Archetype::GetComponent(uint32_t row, ComponentTypeId typeId)
+{
+    const int8_t column = mColumnIndices[typeId];
+    if (column < 0)
+    {
+        return nullptr;
+    }
+    return GetAddress(row, mColumns[column]);
+}
+
+Entity Archetype::GetEntity(uint32_t row) const
+{
+    const Entity* entities = reinterpret_cast<const Entity*>(mChunks[row / mCapacity]->data);
+    return entities[row % mCapacity];
+}
+
+uint32_t Archetype::Allocate(Entity entity)
+{
+    const uint32_t row = mEntityCount++;
+    if (row / mCapacity >= mChunks.size())
+    {
+        mChunks.push_back(std::make_unique<Chunk>());
+        Core::MemoryTracker::AddBytes(Core::MemoryTag::Ecs, sizeof(Chunk));
+    }
+
+    Entity* entities = reinterpret_cast<Entity*>(mChunks[row / mCapacity]->data);
+    entities[row % mCapacity] = entity;
+    return row;
+}
+
+Entity Archetype::Remove(uint32_t row)
+{
+    ASSERT(row < mEntityCount, "Archetype: Invalid row");
+    for (const Column& column : mColumns)
+    {
+        column.info.destroy(GetAddress(row, column));
+    }
+    return FillHole(row);
+}
+
+Entity Archetype::MoveTo(uint32_t row, Archetype& dst, uint32_t dstRow)
+{
+    ASSERT(row < mEntityCount, "Archetype: Invalid row");
+    for (const Column& column : mColumns)
+    {
+        void* src = GetAddress(row, column);
+        void* target = dst.GetComponent(dstRow, column.typeId);
+        if (target != nullptr)
+        {
+            column.info.moveConstruct(target, src);
+        }
+        else
+        {
+            column.info.destroy(src);
+        }
+    }
+    return FillHole(row);
+}
+
+void Archetype::Clear()
+{
+    for (uint32_t row = 0; row < mEntityCount; ++row)
+    {
+        for (const Column& column : mColumns)
+        {
+            column.info.destroy(GetAddress(row, column));
+        }
+    }
+    mEntityCount = 0;
+    Core::MemoryTracker::AddBytes(Core::MemoryTag::Ecs, -int64_t(mChunks.size() * sizeof(Chunk)));
+    mChunks.clear();
+}
+
+std::byte* Archetype::GetAddress(uint32_t row, const Column& column) const
+{
+    return mChunks[row / mCapacity]->data + column.offset + (row % mCapacity) * column.size;
+}
+
+// The row's components are already destroyed or moved out. Moves the last row into it.
+Entity Archetype::FillHole(uint32_t row)
+{
+    const uint32_t last = --mEntityCount;
+    Entity moved = NullEntity;
+    if (row != last)
+    {
+        for (const Column& column : mColumns)
+        {
+            column.info.moveConstruct(GetAddress(row, column), GetAddress(last, column));
+        }
+
+        moved = GetEntity(last);
+        Entity* entities = reinterpret_cast<Entity*>(mChunks[row / mCapacity]->data);
+        entities[row % mCapacity] = moved;
+    }
+
+    // Keep one spare chunk around so an entity bouncing across a boundary does not reallocate
+    const size_t usedChunks = (mEntityCount + mCapacity - 1) / mCapacity;
+    while (mChunks.size() > usedChunks + 1)
+    {
+        mChunks.pop_back();
+        Core::MemoryTracker::AddBytes(Core::MemoryTag::Ecs, -int64_t(sizeof(Chunk)));
+    }
+    return moved;
+}
@@ -0,0 +1,184 @@
+#include "Precompiled.h"
+#include "AssetPreloader.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+using namespace Engine::Graphics;
+
+namespace
+{
+const PerfCounter sPending("Assets.Preloading", PerfCounterType::Gauge);
+} // namespace
+
+AssetPreloader::~AssetPreloader()
+{
+    Wait();
+}
+
+void AssetPreloader::Begin(const AssetManifest& manifest)
+{
+    Release();
+    mStartTime = std::chrono::steady_clock::now();
+    mIsLoading = true;
+    for (const std::filesystem::path& filePath : manifest.models)
+    {
+        RequestModel(filePath);
+    }
+    for (const std::filesystem::path& filename : manifest.textures)
+    {
+        RequestTexture(filename, true);
+    }
+}
+
+bool AssetPreloader::Update()
+{
+    // Models first, their materials add textures
+    for (size_t i = 0; i < mModels.size();)
+    {
+        PendingModel& pending = *mModels[i];
+        if (!pending.isReady.load(std::memory_order_acquire))
+        {
+            ++i;
+            continue;
+        }
+        const ModelId modelId =
+            ModelManager::Get()->AddModel(pending.filePath, std::move(pending.model));
+        RequestMaterialTextures(*ModelManager::Get()->GetModel(modelId));
+        mModels[i] = std::move(mModels.back());
+        mModels.pop_back();
+    }
+
+    for (size_t i = 0; i < mTextures.size();)
+    {
+        PendingTexture& pending = *mTextures[i];
+        if (!pending.isReady.load(std::memory_order_acquire))
+        {
+            ++i;
+            continue;
+        }
+        TextureManager* tm = TextureManager::Get();
+        mTextureIds.push_back(tm->AddTexture(pending.filename, std::move(pending.texture)));
+        mTextures[i] = std::move(mTextures.back());
+        mTextures.pop_back();
+    }
+
+    sPending.Set(GetPendingCount());
+    if (mIsLoading && GetPendingCount() == 0)
+    {
+        mIsLoading = false;
+        const auto loadTime = std::chrono::steady_clock::now() - mStartTime;
+        LOG_INFO(Engine,
+                 "AssetPreloader: %u models and %u textures loaded in %.1f ms",
+                 mModelCount,
+                 mTextureCount,
+                 std::chrono::duration<double, std::milli>(loadTime).count());
+    }
+    return !mIsLoading;
+}
+
+void AssetPreloader::Release()
+{
+    Wait();
+    for (std::unique_ptr<PendingTexture>& pending : mTextures)
+    {
+        pending->texture.Terminate();
+    }
+    mModels.clear();
+    mTextures.clear();
+    mRequested.Clear();
+
+    for (TextureId textureId : mTextureIds)
+    {
+        TextureManager::Get()->ReleaseTexture(textureId);
+    }
+    mTextureIds.clear();
+    mModelCount = 0;
+    mTextureCount = 0;
+    mIsLoading = false;
+    sPending.Set(0);
+}
+
+uint32_t AssetPreloader::GetPendingCount() const
+{
+    return static_cast<uint32_t>(mModels.size() + mTextures.size());
+}
+
+void AssetPreloader::RequestModel(const std::filesystem::path& filePath)
+{
+    if (!mRequested.TryEmplace(HashPath(filePath), true).second)
+    {
+        return;
+    }
+
+    ModelManager* mm = ModelManager::Get();
+    const ModelId modelId = mm->GetModelId(filePath);
+    if (modelId != InvalidHandle)
+    {
+        RequestMaterialTextures(*mm->GetModel(modelId));
+        return;
+    }
+
+    PendingModel& pending = *mModels.emplace_back(std::make_unique<PendingModel>());
+    pending.filePath = filePath;
+    ++mModelCount;
+    JobSystem::Get()->Submit(
+        [mm, &pending]()
+        {
+            pending.model = mm->ReadModel(pending.filePath);
+            pending.isReady.store(true, std::memory_order_release);
+        },
+        &mCounter);
+}
+
+// Same names and root as RenderGroup::Initialize
+void AssetPreloader::RequestMaterialTextures(const Model& model)
+{
+    for (const Model::MaterialData& materialData : model.materialData)
+    {
+        for (const std::string* name : {&materialData.diffuseMapName,
+                                        &materialData.specMapName,
+                                        &materialData.normalMapName,
+                                        &materialData.bumpMapName})
+        {
+            if (!name->empty())
+            {
+                RequestTexture(*name, false);
+            }
+        }
+    }
+}
+
+void AssetPreloader::RequestTexture(const std::filesystem::path& filename, bool useRootDir)
+{
+    if (!mRequested.TryEmplace(HashPath(filename), true).second)
+    {
+        return;
+    }
+
+    // Resident textures only get the reference that keeps them through the switch
+    TextureManager* tm = TextureManager::Get();
+    if (tm->FindTexture(filename) != InvalidHandle)
+    {
+        mTextureIds.push_back(tm->LoadTexture(filename, useRootDir));
+        return;
+    }
+
+    PendingTexture& pending = *mTextures.emplace_back(std::make_unique<PendingTexture>());
+    pending.filename = filename;
+    ++mTextureCount;
+    JobSystem::Get()->Submit(
+        [&pending, filePath = tm->GetFilePath(filename, useRootDir)]()
+        {
+            pending.texture.Initialize(filePath);
+            pending.isReady.store(true, std::memory_order_release);
+        },
+        &mCounter);
+}
+
+void AssetPreloader::Wait()
+{
+    if (mCounter.pending.load(std::memory_order_acquire) > 0)
+    {
+        JobSystem::Get()->Wait(mCounter);
+    }
+}
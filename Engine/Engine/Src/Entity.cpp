@@ -0,0 +1,27 @@
+#include "Precompiled.h"
+#include "Entity.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+
+namespace
+{
+// Fixed storage so references handed out stay valid while other types register
+std::mutex sRegistryMutex;
+ComponentInfo sComponentInfos[MaxComponentTypes];
+uint32_t sComponentTypeCount = 0;
+} // namespace
+
+ComponentTypeId ECS::RegisterComponentType(const ComponentInfo& info)
+{
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    ASSERT(sComponentTypeCount < MaxComponentTypes, "ECS: Too many component types");
+    sComponentInfos[sComponentTypeCount] = info;
+    return sComponentTypeCount++;
+}
+
+const ComponentInfo& ECS::GetComponentInfo(ComponentTypeId typeId)
+{
+    ASSERT(typeId < MaxComponentTypes, "ECS: Invalid component type");
+    return sComponentInfos[typeId];
+}
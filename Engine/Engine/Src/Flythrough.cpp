@@ -0,0 +1,225 @@
+#include "Precompiled.h"
+#include "Flythrough.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+using namespace Engine::Graphics;
+
+namespace
+{
+// The report was asked for, like ASSERT it skips the level filter that hides Info in release
+template <class... Args> void Report(const char* format, const Args&... args)
+{
+    Logger::Write(LogLevel::Info, LogCategory::Engine, format, args...);
+}
+
+void LogSummary(const char* title, const std::vector<float>& milliseconds)
+{
+    std::vector<float> measured;
+    measured.reserve(milliseconds.size());
+    for (float ms : milliseconds)
+    {
+        if (ms >= 0.0f)
+        {
+            measured.push_back(ms);
+        }
+    }
+    if (measured.empty())
+    {
+        Report("Flythrough: %s not measured", title);
+        return;
+    }
+
+    const TimeUtil::FrameTimeSummary summary = TimeUtil::Summarize(std::move(measured));
+    Report("Flythrough: %s %u frames, min %.3f ms, avg %.3f ms, p95 %.3f ms, p99 %.3f ms, "
+           "max %.3f ms",
+           title,
+           summary.count,
+           summary.min,
+           summary.mean,
+           summary.p95,
+           summary.p99,
+           summary.max);
+}
+
+uint32_t GetWorstFrame(const std::vector<float>& milliseconds)
+{
+    const auto worst = std::max_element(milliseconds.begin(), milliseconds.end());
+    return static_cast<uint32_t>(worst - milliseconds.begin());
+}
+} // namespace
+
+Flythrough::~Flythrough()
+{
+    ASSERT(!mIsRunning && !mGpuTimer.IsAvailable(), "Flythrough: End must be called");
+}
+
+bool Flythrough::Begin(const std::filesystem::path& pathFile, uint32_t frameCount)
+{
+    if (frameCount == 0 || !mPath.Load(pathFile))
+    {
+        return false;
+    }
+
+    mFrame = 0;
+    mFrameCount = frameCount;
+    mCounterCount = PerfCounters::GetCount();
+    mCpuMs.assign(frameCount, 0.0f);
+    mGpuMs.assign(frameCount, -1.0f);
+    mCounterValues.assign(static_cast<size_t>(frameCount) * mCounterCount, 0);
+    mGpuTimer.Initialize();
+    mIsRunning = true;
+    LOG_INFO(Engine,
+             "Flythrough: %u frames along %s, %.1f units",
+             frameCount,
+             pathFile.u8string().c_str(),
+             mPath.GetLength());
+    return true;
+}
+
+bool Flythrough::IsRunning() const
+{
+    return mIsRunning;
+}
+
+void Flythrough::BeginFrame()
+{
+    mFrameStart = std::chrono::steady_clock::now();
+    mGpuTimer.Begin(mFrame);
+}
+
+void Flythrough::Apply(Camera& camera) const
+{
+    const float t = (mFrameCount > 1) ? static_cast<float>(mFrame) / (mFrameCount - 1) : 0.0f;
+    mPath.Apply(camera, t);
+}
+
+void Flythrough::EndRender()
+{
+    const auto frameTime = std::chrono::steady_clock::now() - mFrameStart;
+    mCpuMs[mFrame] = std::chrono::duration<float, std::milli>(frameTime).count();
+    mGpuTimer.End();
+}
+
+bool Flythrough::EndFrame()
+{
+    int64_t* counterValues = mCounterValues.data() + static_cast<size_t>(mFrame) * mCounterCount;
+    for (PerfCounterId id = 0; id < mCounterCount; ++id)
+    {
+        counterValues[id] = PerfCounters::GetLastFrameValue(id);
+    }
+
+    uint32_t gpuFrame = 0;
+    float gpuMs = 0.0f;
+    while (mGpuTimer.Read(gpuFrame, gpuMs))
+    {
+        mGpuMs[gpuFrame] = gpuMs;
+    }
+
+    ++mFrame;
+    mIsRunning = (mFrame < mFrameCount);
+    return mIsRunning;
+}
+
+void Flythrough::End(const std::filesystem::path& reportFile)
+{
+    if (mFrameCount == 0)
+    {
+        return;
+    }
+
+    uint32_t gpuFrame = 0;
+    float gpuMs = 0.0f;
+    while (mGpuTimer.Read(gpuFrame, gpuMs, true))
+    {
+        mGpuMs[gpuFrame] = gpuMs;
+    }
+    mGpuTimer.Terminate();
+
+    // A run cut short, e.g. by escape, reports the frames it got to
+    const uint32_t frameCount = mFrame;
+    mCpuMs.resize(frameCount);
+    mGpuMs.resize(frameCount);
+
+    if (!reportFile.empty())
+    {
+        FILE* file = fopen(reportFile.u8string().c_str(), "w");
+        if (file == nullptr)
+        {
+            LOG_WARNING(Engine, "Flythrough: Failed to open %s", reportFile.u8string().c_str());
+        }
+        else
+        {
+            fprintf(file, "frame,cpuMs,gpuMs");
+            for (PerfCounterId id = 0; id < mCounterCount; ++id)
+            {
+                fprintf(file, ",%s", PerfCounters::GetName(id));
+            }
+            fprintf(file, "\n");
+            for (uint32_t frame = 0; frame < frameCount; ++frame)
+            {
+                fprintf(file, "%u,%.3f,", frame, mCpuMs[frame]);
+                if (mGpuMs[frame] >= 0.0f)
+                {
+                    fprintf(file, "%.3f", mGpuMs[frame]);
+                }
+                const int64_t* values =
+                    mCounterValues.data() + static_cast<size_t>(frame) * mCounterCount;
+                for (PerfCounterId id = 0; id < mCounterCount; ++id)
+                {
+                    fprintf(file, ",%lld", static_cast<long long>(values[id]));
+                }
+                fprintf(file, "\n");
+            }
+            fclose(file);
+        }
+    }
+
+    LogSummary("CPU", mCpuMs);
+    LogSummary("GPU", mGpuMs);
+    if (frameCount > 0)
+    {
+        LogFrame("Worst CPU frame", GetWorstFrame(mCpuMs));
+        if (*std::max_element(mGpuMs.begin(), mGpuMs.end()) >= 0.0f)
+        {
+            LogFrame("Worst GPU frame", GetWorstFrame(mGpuMs));
+        }
+    }
+
+    mFrameCount = 0;
+    mIsRunning = false;
+}
+
+// Where the camera was and every counter that was not zero, to reproduce the frame
+void Flythrough::LogFrame(const char* title, uint32_t frame) const
+{
+    const float t = (mFrameCount > 1) ? static_cast<float>(frame) / (mFrameCount - 1) : 0.0f;
+    const Math::Vector3 position = mPath.GetPosition(t);
+    const Math::Vector3 target = mPath.GetTarget(t);
+    char gpuText[32] = "not measured";
+    if (mGpuMs[frame] >= 0.0f)
+    {
+        snprintf(gpuText, sizeof(gpuText), "%.3f ms", mGpuMs[frame]);
+    }
+    Report("Flythrough: %s %u, CPU %.3f ms, GPU %s, camera (%.2f, %.2f, %.2f) looking at "
+           "(%.2f, %.2f, %.2f)",
+           title,
+           frame,
+           mCpuMs[frame],
+           gpuText,
+           position.x,
+           position.y,
+           position.z,
+           target.x,
+           target.y,
+           target.z);
+
+    const int64_t* values = mCounterValues.data() + static_cast<size_t>(frame) * mCounterCount;
+    for (PerfCounterId id = 0; id < mCounterCount; ++id)
+    {
+        if (values[id] != 0)
+        {
+            Report("  %-32s %lld", PerfCounters::GetName(id), static_cast<long long>(values[id]));
+        }
+    }
+}
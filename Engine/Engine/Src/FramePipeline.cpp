@@ -0,0 +1,78 @@
+#include "Precompiled.h"
+#include "FramePipeline.h"
+
+#include "AppState.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+const PerfCounter sSimulateTime("Frame.SimulateUs");
+const PerfCounter sStallTime("Frame.PipelineStallUs");
+
+void Simulate(AppState& state, float deltaTime, uint64_t frame, RenderSnapshot& snapshot)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Clearing keeps the capacity, a steady scene stops allocating after the first frames
+    snapshot.meshes.clear();
+    snapshot.models.clear();
+    snapshot.shadowMeshes.clear();
+    snapshot.shadowModels.clear();
+    snapshot.frame = frame;
+    state.Simulate(deltaTime, snapshot);
+
+    const auto simulateTime = std::chrono::steady_clock::now() - startTime;
+    sSimulateTime.Add(std::chrono::duration_cast<std::chrono::microseconds>(simulateTime).count());
+}
+} // namespace
+
+FramePipeline::~FramePipeline()
+{
+    Wait();
+}
+
+const RenderSnapshot* FramePipeline::Kick(AppState& state, float deltaTime)
+{
+    Wait();
+
+    const RenderSnapshot* submitSnapshot = mHasSnapshot ? &mSnapshots[mSimulateIndex] : nullptr;
+    mSimulateIndex ^= 1;
+    mHasSnapshot = true;
+
+    RenderSnapshot& snapshot = mSnapshots[mSimulateIndex];
+    const uint64_t frame = ++mFrame;
+    JobSystem::Get()->Submit([&state, &snapshot, deltaTime, frame]()
+                             { Simulate(state, deltaTime, frame, snapshot); },
+                             &mCounter);
+    return submitSnapshot;
+}
+
+void FramePipeline::Wait()
+{
+    if (mCounter.pending.load(std::memory_order_acquire) == 0)
+    {
+        return;
+    }
+
+    // Time the main thread sits idle, the simulation is the bottleneck when this grows
+    const auto startTime = std::chrono::steady_clock::now();
+    JobSystem::Get()->Wait(mCounter);
+    const auto stallTime = std::chrono::steady_clock::now() - startTime;
+    sStallTime.Add(std::chrono::duration_cast<std::chrono::microseconds>(stallTime).count());
+}
+
+void FramePipeline::Reset()
+{
+    Wait();
+    if (!mHasSnapshot)
+    {
+        return;
+    }
+    for (RenderSnapshot& snapshot : mSnapshots)
+    {
+        snapshot = RenderSnapshot();
+    }
+    mHasSnapshot = false;
+}
@@ -0,0 +1,158 @@
+#include "Precompiled.h"
+#include "SceneSystems.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+using namespace Engine::Graphics;
+
+// The batch kernel writes plain matrices straight into the WorldMatrix array
+static_assert(sizeof(WorldMatrix) == sizeof(Math::Matrix4), "WorldMatrix must only hold a matrix");
+
+void ECS::UpdateWorldMatrices(World& world)
+{
+    world.ParallelForEachChunk<const Transform, WorldMatrix>(
+        [](uint32_t count, const Entity*, const Transform* transforms, WorldMatrix* worlds)
+        { ComputeMatrices(transforms, count, &worlds->value); });
+}
+
+void ECS::RenderScene(World& world, StandardEffect& effect, MeshletCuller* culler)
+{
+    world.ForEach<const MeshRenderer, const WorldMatrix>(
+        [&effect](Entity, const MeshRenderer& mesh, const WorldMatrix& matWorld)
+        {
+            if (mesh.renderObject != nullptr)
+            {
+                effect.Render(*mesh.renderObject, matWorld.value);
+            }
+        });
+    world.ForEach<const ModelRenderer, const WorldMatrix>(
+        [&effect, culler](Entity, const ModelRenderer& model, const WorldMatrix& matWorld)
+        {
+            if (model.renderGroup != nullptr)
+            {
+                if (culler != nullptr)
+                {
+                    culler->Cull(*model.renderGroup, matWorld.value);
+                }
+                effect.Render(*model.renderGroup, matWorld.value);
+            }
+        });
+}
+
+void ECS::RenderShadows(World& world, ShadowEffect& effect, MeshletCuller* culler)
+{
+    world.ForEach<const ShadowCaster, const MeshRenderer, const WorldMatrix>(
+        [&effect](
+            Entity, const ShadowCaster&, const MeshRenderer& mesh, const WorldMatrix& matWorld)
+        {
+            if (mesh.renderObject != nullptr)
+            {
+                effect.Render(*mesh.renderObject, matWorld.value);
+            }
+        });
+    world.ForEach<const ShadowCaster, const ModelRenderer, const WorldMatrix>(
+        [&effect, culler](
+            Entity, const ShadowCaster&, const ModelRenderer& model, const WorldMatrix& matWorld)
+        {
+            if (model.renderGroup != nullptr)
+            {
+                if (culler != nullptr)
+                {
+                    culler->Cull(*model.renderGroup, matWorld.value);
+                }
+                effect.Render(*model.renderGroup, matWorld.value);
+            }
+        });
+}
+
+void ECS::BuildRenderSnapshot(World& world, RenderSnapshot& snapshot)
+{
+    world.ForEach<const MeshRenderer, const WorldMatrix>(
+        [&snapshot](Entity, const MeshRenderer& mesh, const WorldMatrix& matWorld)
+        {
+            if (mesh.renderObject != nullptr)
+            {
+                snapshot.meshes.push_back({mesh.renderObject, matWorld.value});
+            }
+        });
+    world.ForEach<const ModelRenderer, const WorldMatrix>(
+        [&snapshot](Entity, const ModelRenderer& model, const WorldMatrix& matWorld)
+        {
+            if (model.renderGroup != nullptr)
+            {
+                snapshot.models.push_back({model.renderGroup, matWorld.value});
+            }
+        });
+    world.ForEach<const ShadowCaster, const MeshRenderer, const WorldMatrix>(
+        [&snapshot](
+            Entity, const ShadowCaster&, const MeshRenderer& mesh, const WorldMatrix& matWorld)
+        {
+            if (mesh.renderObject != nullptr)
+            {
+                snapshot.shadowMeshes.push_back({mesh.renderObject, matWorld.value});
+            }
+        });
+    world.ForEach<const ShadowCaster, const ModelRenderer, const WorldMatrix>(
+        [&snapshot](
+            Entity, const ShadowCaster&, const ModelRenderer& model, const WorldMatrix& matWorld)
+        {
+            if (model.renderGroup != nullptr)
+            {
+                snapshot.shadowModels.push_back({model.renderGroup, matWorld.value});
+            }
+        });
+}
+
+void ECS::RenderScene(const RenderSnapshot& snapshot, StandardEffect& effect, MeshletCuller* culler)
+{
+    for (const RenderSnapshot::MeshDraw& mesh : snapshot.meshes)
+    {
+        effect.Render(*mesh.renderObject, mesh.matWorld);
+    }
+    for (const RenderSnapshot::ModelDraw& model : snapshot.models)
+    {
+        if (culler != nullptr)
+        {
+            culler->Cull(*model.renderGroup, model.matWorld);
+        }
+        effect.Render(*model.renderGroup, model.matWorld);
+    }
+}
+
+void ECS::RenderShadows(const RenderSnapshot& snapshot, ShadowEffect& effect, MeshletCuller* culler)
+{
+    for (const RenderSnapshot::MeshDraw& mesh : snapshot.shadowMeshes)
+    {
+        effect.Render(*mesh.renderObject, mesh.matWorld);
+    }
+    for (const RenderSnapshot::ModelDraw& model : snapshot.shadowModels)
+    {
+        if (culler != nullptr)
+        {
+            culler->Cull(*model.renderGroup, model.matWorld);
+        }
+        effect.Render(*model.renderGroup, model.matWorld);
+    }
+}
+
+bool ECS::Raycast(World& world,
+                  const Math::Ray& ray,
+                  float maxDistance,
+                  Entity& hitEntity,
+                  RayHit& hit)
+{
+    hitEntity = NullEntity;
+    world.ForEach<const ModelRenderer, const WorldMatrix>(
+        [&](Entity entity, const ModelRenderer& model, const WorldMatrix& matWorld)
+        {
+            RayHit modelHit;
+            if (model.renderGroup != nullptr &&
+                model.renderGroup->Raycast(matWorld.value, ray, maxDistance, modelHit))
+            {
+                maxDistance = modelHit.distance;
+                hitEntity = entity;
+                hit = modelHit;
+            }
+        });
+    return hitEntity.IsValid();
+}
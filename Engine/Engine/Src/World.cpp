@@ -0,0 +1,145 @@
+#include "Precompiled.h"
+#include "World.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+
+World::~World()
+{
+    Clear();
+}
+
+void World::Destroy(Entity entity)
+{
+    ASSERT(mIterationDepth == 0, "World: Can not destroy entities while iterating");
+
+    EntityRecord* record = GetRecord(entity);
+    ASSERT(record != nullptr, "World: Invalid entity");
+    if (record == nullptr)
+    {
+        return;
+    }
+
+    const Entity moved = record->archetype->Remove(record->row);
+    if (moved.IsValid())
+    {
+        mRecords[moved.index].row = record->row;
+    }
+
+    record->archetype = nullptr;
+    ++record->generation;
+    mFreeIndices.push_back(entity.index);
+    --mEntityCount;
+}
+
+bool World::IsAlive(Entity entity) const
+{
+    return GetRecord(entity) != nullptr;
+}
+
+void World::Clear()
+{
+    ASSERT(mIterationDepth == 0, "World: Can not clear while iterating");
+
+    mArchetypeLookup.Clear();
+    mArchetypes.clear();
+    mRecords.clear();
+    mFreeIndices.clear();
+    mEntityCount = 0;
+}
+
+uint32_t World::GetEntityCount() const
+{
+    return mEntityCount;
+}
+
+uint32_t World::GetArchetypeCount() const
+{
+    return static_cast<uint32_t>(mArchetypes.size());
+}
+
+Entity World::AllocateEntity(Archetype& archetype)
+{
+    Entity entity;
+    if (mFreeIndices.empty())
+    {
+        entity.index = static_cast<uint32_t>(mRecords.size());
+        mRecords.emplace_back();
+    }
+    else
+    {
+        entity.index = mFreeIndices.back();
+        mFreeIndices.pop_back();
+    }
+
+    EntityRecord& record = mRecords[entity.index];
+    entity.generation = record.generation;
+    record.archetype = &archetype;
+    record.row = archetype.Allocate(entity);
+    ++mEntityCount;
+    return entity;
+}
+
+Archetype& World::GetArchetype(ComponentMask mask)
+{
+    Archetype** archetype = mArchetypeLookup.Find(mask);
+    if (archetype != nullptr)
+    {
+        return **archetype;
+    }
+
+    Archetype* created = mArchetypes.emplace_back(std::make_unique<Archetype>(mask)).get();
+    mArchetypeLookup.TryEmplace(mask, created);
+    return *created;
+}
+
+void World::MoveEntity(Entity entity, Archetype& dst)
+{
+    EntityRecord& record = mRecords[entity.index];
+    const uint32_t dstRow = dst.Allocate(entity);
+    const Entity moved = record.archetype->MoveTo(record.row, dst, dstRow);
+    if (moved.IsValid())
+    {
+        mRecords[moved.index].row = record.row;
+    }
+
+    record.archetype = &dst;
+    record.row = dstRow;
+}
+
+void World::GatherChunks(ComponentMask mask, std::vector<ChunkRef>& chunks) const
+{
+    for (const std::unique_ptr<Archetype>& archetype : mArchetypes)
+    {
+        if ((archetype->GetMask() & mask) != mask)
+        {
+            continue;
+        }
+
+        const uint32_t chunkCount = archetype->GetChunkCount();
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            if (archetype->GetChunkEntityCount(chunkIndex) > 0)
+            {
+                chunks.push_back({archetype.get(), chunkIndex});
+            }
+        }
+    }
+}
+
+World::EntityRecord* World::GetRecord(Entity entity)
+{
+    if (entity.index >= mRecords.size())
+    {
+        return nullptr;
+    }
+
+    EntityRecord& record = mRecords[entity.index];
+    return (record.archetype != nullptr && record.generation == entity.generation) ? &record
+                                                                                   : nullptr;
+}
+
+const World::EntityRecord* World::GetRecord(Entity entity) const
+{
+    return const_cast<World*>(this)->GetRecord(entity);
+}
@@ -26,7 +26,7 @@ void GameState::Initialize()
     MeshPX spaceSphere = MeshBuilder::CreateSkySpherePX(30, 30, 350.0f);
     mSkySphere.mesh.Initialize(spaceSphere);
     mSkySphere.textureId = TextureManager::Get()->LoadTexture(L"space.jpg");
-    mSkySphere.matWorld = Math::Matrix4::Identity;
+    mSkySphere.node = mHierarchy.Create();
 
     // Create sun
     constexpr float visualScale = 0.1f; // scale down real ratios for visualization
@@ -34,7 +34,7 @@ void GameState::Initialize()
     MeshPX sunSphere = MeshBuilder::CreateSpherePX(32, 32, sunRadius);
     mSun.mesh.Initialize(sunSphere);
     mSun.textureId = TextureManager::Get()->LoadTexture(L"sun.jpg");
-    mSun.matWorld = Math::Matrix4::Identity;
+    mSun.node = mHierarchy.Create();
     float orbitOffset = sunRadius;
 
     // Create planets
@@ -90,9 +90,9 @@ void GameState::Initialize()
         planet.orbitRadius = orbitOffset + orbitRadius * orbitScale;
         planet.orbitSpeed = orbitSpeed;
         planet.rotationSpeed = rotationSpeed;
-        planet.object.matWorld = Math::Matrix4::RotationY(planet.orbitAngle) *
-                                 Math::Matrix4::Translation(planet.orbitRadius, 0.0f, 0.0f) *
-                                 Math::Matrix4::RotationY(planet.rotationAngle);
+        planet.orbitNode = mHierarchy.Create();
+        planet.object.node = mHierarchy.Create(planet.orbitNode);
+        mHierarchy.SetPosition(planet.object.node, {planet.orbitRadius, 0.0f, 0.0f});
         planet.radius = size;
         mPlanets.push_back(std::move(planet));
 
@@ -103,7 +103,8 @@ void GameState::Initialize()
             MeshPX moonSphere = MeshBuilder::CreateSpherePX(32, 32, 0.2724f * visualScale);
             moon->mesh.Initialize(moonSphere);
             moon->textureId = TextureManager::Get()->LoadTexture(L"planets/pluto.jpg");
-            moon->matWorld = Math::Matrix4::Translation(2.5f, 0.0f, 0.0f);
+            moon->node = mHierarchy.Create(planet.object.node);
+            mHierarchy.SetPosition(moon->node, {1.5f, 0.0f, 0.0f});
             mMoons.push_back(std::move(moon));
         }
     }
@@ -146,6 +147,8 @@ void GameState::Terminate()
     mVertexShader.Terminate();
     mPixelShader.Terminate();
     mSampler.Terminate();
+
+    mHierarchy.Clear();
 }
 
 void GameState::Update(float deltaTime)
@@ -153,27 +156,29 @@ void GameState::Update(float deltaTime)
     UpdateCamera(deltaTime);
 
     // Update sun rotation
-    mSun.matWorld = Math::Matrix4::RotationY(deltaTime * 0.1f * mGlobalSpeedMultiplier);
+    mHierarchy.SetRotation(mSun.node,
+                           Math::Quaternion::CreateFromAxisAngle(
+                               Math::Vector3::YAxis, deltaTime * 0.1f * mGlobalSpeedMultiplier));
 
     // Update planets
-    for (size_t i = 0; i < mPlanets.size(); ++i)
+    for (PlanetData& planet : mPlanets)
     {
-        UpdateCelestialBody(mPlanets[i], deltaTime);
-        if (i == 2 && !mMoons.empty())
-        { // Earth's moon
-            // Update moon orbit and rotation around Earth
-            float moonOrbitSpeed = 4.0f;
-            float moonRotationSpeed = 2.0f;
-            static float moonOrbitAngle = 0.0f;
-            static float moonRotationAngle = 0.0f;
-            moonOrbitAngle += deltaTime * moonOrbitSpeed * mGlobalSpeedMultiplier;
-            moonRotationAngle += deltaTime * moonRotationSpeed * mGlobalSpeedMultiplier;
-            Math::Matrix4 moonOrbit = Math::Matrix4::RotationY(moonOrbitAngle) *
-                                      Math::Matrix4::Translation(1.5f, 0.0f, 0.0f);
-            Math::Matrix4 moonRotation = Math::Matrix4::RotationY(moonRotationAngle);
-            mMoons[0]->matWorld = moonRotation * moonOrbit * mPlanets[2].object.matWorld;
-        }
+        UpdateCelestialBody(planet, deltaTime);
+    }
+
+    // Earth's moon, parented to Earth so it follows it around the sun
+    if (!mMoons.empty())
+    {
+        const float moonOrbitSpeed = 4.0f;
+        const float moonRotationSpeed = 2.0f;
+        mMoonOrbitAngle += deltaTime * moonOrbitSpeed * mGlobalSpeedMultiplier;
+        mMoonRotationAngle += deltaTime * moonRotationSpeed * mGlobalSpeedMultiplier;
+        mHierarchy.SetRotation(mMoons[0]->node,
+                               Math::Quaternion::CreateFromAxisAngle(
+                                   Math::Vector3::YAxis, mMoonRotationAngle + mMoonOrbitAngle));
     }
+
+    mHierarchy.Update();
 }
 
 void GameState::UpdateCelestialBody(PlanetData& body, float deltaTime)
@@ -182,9 +187,12 @@ void GameState::UpdateCelestialBody(PlanetData& body, float deltaTime)
     body.orbitAngle += deltaTime * body.orbitSpeed * mGlobalSpeedMultiplier;
     body.rotationAngle += deltaTime * body.rotationSpeed * mGlobalSpeedMultiplier;
 
-    body.object.matWorld = Math::Matrix4::RotationY(body.orbitAngle) *
-                           Math::Matrix4::Translation(body.orbitRadius, 0.0f, 0.0f) *
-                           Math::Matrix4::RotationY(body.rotationAngle);
+    mHierarchy.SetRotation(
+        body.object.node,
+        Math::Quaternion::CreateFromAxisAngle(Math::Vector3::YAxis, body.orbitAngle));
+    mHierarchy.SetRotation(
+        body.orbitNode,
+        Math::Quaternion::CreateFromAxisAngle(Math::Vector3::YAxis, body.rotationAngle));
 }
 
 void GameState::DrawOrbit(const PlanetData& body)
@@ -262,7 +270,7 @@ void GameState::RenderMesh(const PlanetObject& object, const Camera& camera)
 {
     const Math::Matrix4 matView = camera.GetViewMatrix();
     const Math::Matrix4 matProj = camera.GetProjectionMatrix();
-    const Math::Matrix4 matFinal = object.matWorld * matView * matProj;
+    const Math::Matrix4 matFinal = mHierarchy.GetWorldMatrix(object.node) * matView * matProj;
     const Math::Matrix4 wvp = Math::Transpose(matFinal);
     mTransformBuffer.Update(&wvp);
 
@@ -326,6 +334,11 @@ void GameState::DebugUI()
     ImGui::End();
 }
 
+Camera* GameState::GetCamera()
+{
+    return &mMainCamera;
+}
+
 void GameState::UpdateCamera(float deltaTime)
 {
     // Camera Controls:
@@ -5,22 +5,9 @@
 using namespace Engine;
 using namespace Engine::Graphics;
 
-struct Transform
-{
-    Math::Vector3 position = Math::Vector3::Zero;
-    Math::Quaternion rotation = Math::Quaternion::Identity;
-    Math::Vector3 scale = Math::Vector3::One;
-
-    Math::Matrix4 Apply() const
-    {
-        return Math::Matrix4::Translation(position) *
-               Math::Matrix4::MatrixRotationQuaternion(rotation) * Math::Matrix4::Scaling(scale);
-    }
-};
-
 struct PlanetObject
 {
-    Math::Matrix4 matWorld = Math::Matrix4::Identity;
+    TransformNodeId node = InvalidTransformNode;
     MeshBuffer mesh;
     TextureId textureId = 0;
 };
@@ -28,6 +15,7 @@ struct PlanetObject
 struct PlanetData
 {
     PlanetObject object;
+    TransformNodeId orbitNode = InvalidTransformNode; // Pivot at the sun the planet orbits around
     float orbitRadius;
     float orbitSpeed;
     float rotationSpeed;
@@ -45,6 +33,8 @@ class GameState : public AppState
     void Render() override;
     void DebugUI() override;
 
+    Camera* GetCamera() override;
+
   private:
     void UpdateCamera(float deltaTime);
     void UpdateCelestialBody(PlanetData& body, float deltaTime);
@@ -64,10 +54,13 @@ class GameState : public AppState
     Sampler mSampler;
 
     // Render Objects
+    TransformHierarchy mHierarchy;
     PlanetObject mSkySphere;
     PlanetObject mSun;
     std::vector<PlanetData> mPlanets;
     std::vector<std::unique_ptr<PlanetObject>> mMoons;
+    float mMoonOrbitAngle = 0.0f;
+    float mMoonRotationAngle = 0.0f;
 
     // UI state
     int mSelectedPlanetIndex;
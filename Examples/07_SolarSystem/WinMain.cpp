@@ -2,10 +2,11 @@
 
 using namespace Engine;
 
-int main()
+int main(int argc, char* argv[])
 {
     AppConfig config;
     config.appName = L"Solar System";
+    ParseCommandLine(config, argc, argv);
 
     App& myApp = MainApp();
 
@@ -4,6 +4,46 @@ using namespace Engine;
 using namespace Engine::Graphics;
 using namespace Engine::Input;
 
+namespace
+{
+    struct PickName
+    {
+        const char* name = nullptr;
+    };
+
+    const char* const CharacterFile = "Character_01/Character_01.model";
+    const char* const ParasiteFile = "parasite/parasite.model";
+    const char* const ZombieFile = "zombie/zombie.model";
+    const char* const GroundTextureFile = "misc/concrete.jpg";
+}
+
+void GameState::GetAssetManifest(AssetManifest& manifest) const
+{
+    manifest.models = { CharacterFile, ParasiteFile, ZombieFile };
+    manifest.textures = { GroundTextureFile };
+}
+
+void GameState::AddInitializeTasks(Core::TaskGraph& graph, Core::TaskId systems)
+{
+    // One task per manager, they are not thread safe. The shaders compile meanwhile.
+    const Core::TaskId models = graph.Add("Models", []()
+        {
+            ModelManager* mm = ModelManager::Get();
+            mm->LoadModel(CharacterFile);
+            mm->LoadModel(ParasiteFile);
+            mm->LoadModel(ZombieFile);
+        });
+    graph.Add("Render groups", [this]()
+        {
+            mGround.diffuseMapId = TextureManager::Get()->LoadTexture(GroundTextureFile);
+            mCharacter.Initialize(CharacterFile);
+            parasite.Initialize(ParasiteFile);
+            zombie.Initialize(ZombieFile);
+        }, { models, systems });
+    graph.Add("Shadow effect", [this]() { mShadowEffect.Initialize(); }, { systems });
+    graph.Add("Standard effect", [this]()
+        { mStandardEffect.Initialize("Assets/Shaders/Standard.hlsl"); }, { systems });
+}
 
 void GameState::Initialize()
 {
@@ -17,29 +57,30 @@ void GameState::Initialize()
 
     Mesh groundMesh = MeshBuilder::CreatePlane(25, 25, 1.0f);
     mGround.meshBuffer.Initialize(groundMesh);
-    mGround.diffuseMapId = TextureManager::Get()->LoadTexture("misc/concrete.jpg");
-    mGround.transform.position = { 0.0f, 0.0f, 0.0f };
 
-    mCharacter.Initialize("Character_01/Character_01.model");
-    mCharacter.transform.position = { 0.0f, 0.0f, 0.0f };
+    mWorld.Create(Transform(), ECS::WorldMatrix(), ECS::MeshRenderer{ &mGround });
 
-    parasite.Initialize("parasite/parasite.model");
-    parasite.transform.position = { -0.5f, 0.0f, 0.9f };
-
-    zombie.Initialize("zombie/zombie.model");
-    zombie.transform.position = { 0.5f, 0.0f, 0.6f };
+    const std::tuple<const char*, RenderGroup*, Math::Vector3> characters[] = {
+        { "Character", &mCharacter, { 0.0f, 0.0f, 0.0f } },
+        { "Parasite", &parasite, { -0.5f, 0.0f, 0.9f } },
+        { "Zombie", &zombie, { 0.5f, 0.0f, 0.6f } },
+    };
+    for (const auto& [name, renderGroup, position] : characters)
+    {
+        Transform transform;
+        transform.position = position;
+        mWorld.Create(transform,
+                      ECS::WorldMatrix(),
+                      ECS::ModelRenderer{ renderGroup },
+                      ECS::ShadowCaster(),
+                      PickName{ name });
+    }
 
     MeshPX screenQuadMesh = MeshBuilder::CreateScreenQuadPX();
     mScreenQuad.meshBuffer.Initialize(screenQuadMesh);
 
-    // Initialize Shadow Effect first so we can get its light camera
-    mShadowEffect.Initialize();
-    mShadowEffect.SetDirectionalLight(mDirectionalLight);
-
-    std::filesystem::path shaderFile = "Assets/Shaders/Standard.hlsl";
-    mStandardEffect.Initialize(shaderFile);
-    mStandardEffect.SetCamera(mCamera);
-    mStandardEffect.SetDirectionalLight(mDirectionalLight);
+    // Both effects were initialized by the startup tasks. Camera and light are set per frame,
+    // pipelined frames draw the copies in the snapshot.
     mStandardEffect.SetLightCamera(mShadowEffect.GetLightCamera());
     mStandardEffect.SetShadowMap(mShadowEffect.GetDepthMap());
 
@@ -50,6 +91,7 @@ void GameState::Initialize()
 
 void GameState::Terminate()
 {
+    mWorld.Clear();
     mShadowEffect.Terminate();
     mScreenQuad.Terminate();
     mCharacter.Terminate();
@@ -62,32 +104,82 @@ void GameState::Terminate()
 void GameState::Update(float deltaTime)
 {
     UpdateCamera(deltaTime);
+    ECS::UpdateWorldMatrices(mWorld);
+    UpdatePicking();
 }
 
 void GameState::Render()
 {
+    mShadowEffect.SetDirectionalLight(mDirectionalLight);
+    mStandardEffect.SetCamera(mCamera);
+    mStandardEffect.SetDirectionalLight(mDirectionalLight);
+
     //----------------------------------------------------------
     // First Pass: Render to Shadow Map [Have to do Shadow Pass first]
     //----------------------------------------------------------
+    mMeshletCuller.Begin(mShadowEffect.GetLightCamera());
     mShadowEffect.Begin();
-        mShadowEffect.Render(mCharacter);
-        mShadowEffect.Render(parasite);
-        mShadowEffect.Render(zombie);
+        ECS::RenderShadows(mWorld, mShadowEffect, &mMeshletCuller);
     mShadowEffect.End();
 
     //----------------------------------------------------------
     // Second Pass: Render Scene
     //----------------------------------------------------------
+    mMeshletCuller.Begin(mCamera);
+    mStandardEffect.Begin();
+        ECS::RenderScene(mWorld, mStandardEffect, &mMeshletCuller);
+    mStandardEffect.End();
+
+    if (mPickedName != nullptr)
+    {
+        SimpleDraw::AddSphere(8, 8, 0.02f, Colors::Yellow, mPickedPosition);
+        SimpleDraw::Render(mCamera);
+    }
+}
+
+bool GameState::SupportsPipelining() const
+{
+    return true;
+}
+
+void GameState::Simulate(float deltaTime, RenderSnapshot& snapshot)
+{
+    Update(deltaTime);
+    ECS::BuildRenderSnapshot(mWorld, snapshot);
+    snapshot.camera = mCamera;
+    snapshot.directionalLight = mDirectionalLight;
+}
+
+void GameState::Submit(const RenderSnapshot& snapshot)
+{
+    mShadowEffect.SetDirectionalLight(snapshot.directionalLight);
+    mStandardEffect.SetCamera(snapshot.camera);
+    mStandardEffect.SetDirectionalLight(snapshot.directionalLight);
+
+    mMeshletCuller.Begin(mShadowEffect.GetLightCamera());
+    mShadowEffect.Begin();
+        ECS::RenderShadows(snapshot, mShadowEffect, &mMeshletCuller);
+    mShadowEffect.End();
+
+    mMeshletCuller.Begin(snapshot.camera);
     mStandardEffect.Begin();
-        mStandardEffect.Render(mGround);
-        mStandardEffect.Render(mCharacter);
-        mStandardEffect.Render(parasite);
-        mStandardEffect.Render(zombie);
+        ECS::RenderScene(snapshot, mStandardEffect, &mMeshletCuller);
     mStandardEffect.End();
+
+    if (mMarkerName != nullptr)
+    {
+        SimpleDraw::AddSphere(8, 8, 0.02f, Colors::Yellow, mMarkerPosition);
+        SimpleDraw::Render(snapshot.camera);
+    }
 }
 
 void GameState::DebugUI()
 {
+    // Runs on the main thread before the next Simulate, see the members
+    mMouseOverUI = ImGui::GetIO().WantCaptureMouse;
+    mMarkerName = mPickedName;
+    mMarkerPosition = mPickedPosition;
+
     ImGui::Begin("Debug", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
     if (ImGui::CollapsingHeader("Light", ImGuiTreeNodeFlags_DefaultOpen))
     {
@@ -129,9 +221,21 @@ void GameState::DebugUI()
 
     mShadowEffect.DebugUI();
 
+    mMeshletCuller.DebugUI();
+
+    if (ImGui::CollapsingHeader("Picking", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Text("Picked: %s", mPickedName != nullptr ? mPickedName : "None");
+    }
+
     ImGui::End();
 }
 
+Camera* GameState::GetCamera()
+{
+    return &mCamera;
+}
+
 void GameState::UpdateCamera(float deltaTime)
 {
     // Camera Controls:
@@ -157,3 +261,24 @@ void GameState::UpdateCamera(float deltaTime)
         mCamera.Pitch(input->GetMouseMoveY() * turnSpeed * deltaTime);
     }
 }
+
+void GameState::UpdatePicking()
+{
+    InputSystem* input = InputSystem::Get();
+    if (!input->IsMousePressed(MouseButton::LBUTTON) || mMouseOverUI)
+    {
+        return;
+    }
+
+    const Math::Ray ray = mCamera.ScreenPointToRay(input->GetMouseScreenX(), input->GetMouseScreenY());
+
+    ECS::Entity entity;
+    RayHit hit;
+    mPickedName = nullptr;
+    if (ECS::Raycast(mWorld, ray, 1000.0f, entity, hit))
+    {
+        const PickName* pickName = mWorld.GetComponent<PickName>(entity);
+        mPickedName = (pickName != nullptr) ? pickName->name : "Unnamed";
+        mPickedPosition = Math::GetPoint(ray, hit.distance);
+    }
+}
@@ -5,6 +5,8 @@
 class GameState : public Engine::AppState
 {
 public:
+    void AddInitializeTasks(Engine::Core::TaskGraph& graph, Engine::Core::TaskId systems) override;
+    void GetAssetManifest(Engine::AssetManifest& manifest) const override;
     void Initialize() override;
 
     void Terminate() override;
@@ -15,20 +17,39 @@ public:
 
     void DebugUI() override;
 
+    Engine::Graphics::Camera* GetCamera() override;
+
+    bool SupportsPipelining() const override;
+    void Simulate(float deltaTime, Engine::RenderSnapshot& snapshot) override;
+    void Submit(const Engine::RenderSnapshot& snapshot) override;
+
 private:
 
     void UpdateCamera(float deltaTime);
+    void UpdatePicking();
 
     Engine::Graphics::Camera mCamera;
     Engine::Graphics::DirectionalLight mDirectionalLight;
 
+    // Shared draw data, the scene places entities that reference it
     Engine::Graphics::RenderGroup mCharacter;
     Engine::Graphics::RenderGroup parasite;
     Engine::Graphics::RenderGroup zombie;
     Engine::Graphics::RenderObject mGround;
 
+    Engine::ECS::World mWorld;
+
     Engine::Graphics::RenderObject mScreenQuad;
 
     Engine::Graphics::StandardEffect mStandardEffect;
     Engine::Graphics::ShadowEffect mShadowEffect;
+    Engine::Graphics::MeshletCuller mMeshletCuller;
+
+    // Written by Update or Simulate. Submit draws the marker copy DebugUI takes before the next
+    // Simulate starts, so the simulation never changes it mid draw.
+    const char* mPickedName = nullptr;
+    Engine::Math::Vector3 mPickedPosition;
+    const char* mMarkerName = nullptr;
+    Engine::Math::Vector3 mMarkerPosition;
+    bool mMouseOverUI = false;
 };
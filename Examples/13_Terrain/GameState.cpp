@@ -145,6 +145,11 @@ void GameState::DebugUI()
     ImGui::End();
 }
 
+Camera* GameState::GetCamera()
+{
+    return &mCamera;
+}
+
 void GameState::UpdateCamera(float deltaTime)
 {
     // Camera Controls:
@@ -15,6 +15,8 @@ public:
 
     void DebugUI() override;
 
+    Engine::Graphics::Camera* GetCamera() override;
+
 private:
 
     void UpdateCamera(float deltaTime);
@@ -1,7 +1,7 @@
 #include <Engine/Inc/Engine.h>
 #include "GameState.h"
 
-int main()
+int main(int argc, char* argv[])
 {
     Engine::App& myApp = Engine::MainApp();
     myApp.AddState<GameState>("GameState");
@@ -10,6 +10,7 @@ int main()
     appConfig.appName = L"Hello Terrain";
     appConfig.winWidth = 1280;
     appConfig.winHeight = 720;
+    Engine::ParseCommandLine(appConfig, argc, argv);
 
     myApp.Run(appConfig);
     return 0;
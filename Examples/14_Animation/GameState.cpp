@@ -0,0 +1,376 @@
+#include "GameState.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Input;
+
+namespace
+{
+const char* const CharacterFile = "Character_01/Character_01.model";
+constexpr float CameraTurnSpeed = 0.1f;
+constexpr uint32_t ChainBoneCount = 12;
+constexpr float ChainBoneLength = 0.15f;
+
+// Swaying chain of bones, stands in for the character's rig until an animated model is imported
+RawAnimationClip CreateChainClip(const char* name, float duration, float frequency, float amplitude)
+{
+    RawAnimationClip clip;
+    clip.name = name;
+    clip.duration = duration;
+    clip.tracks.resize(ChainBoneCount);
+    constexpr uint32_t keyCount = 60;
+    for (uint32_t b = 1; b < ChainBoneCount; ++b)
+    {
+        RawAnimationClip::Track& track = clip.tracks[b];
+        const float phase = b * 0.35f;
+        for (uint32_t k = 0; k <= keyCount; ++k)
+        {
+            const float time = duration * k / keyCount;
+            const float wave = sinf(time * frequency * Math::Constants::TwoPi + phase);
+            const float angle = amplitude * wave;
+            track.rotationKeys.push_back(
+                {Math::Quaternion::CreateFromAxisAngle(Math::Vector3::ZAxis, angle), time});
+        }
+    }
+
+    // Only the root moves, bobbing up and down
+    for (uint32_t k = 0; k <= keyCount; ++k)
+    {
+        const float time = duration * k / keyCount;
+        const float height = 0.05f * sinf(time * frequency * Math::Constants::TwoPi);
+        clip.tracks[0].positionKeys.push_back({{0.0f, height, 0.0f}, time});
+    }
+    return clip;
+}
+} // namespace
+
+void GameState::AddInitializeTasks(Core::TaskGraph& graph, Core::TaskId systems)
+{
+    // Parsing starts with the window, the buffers and textures wait for the device
+    const Core::TaskId model =
+        graph.Add("Character model", []() { ModelManager::Get()->LoadModel(CharacterFile); });
+    graph.Add("Character", [this]() { mCharacter.Initialize(CharacterFile); }, {model, systems});
+    graph.Add("Standard effect",
+              [this]() { mStandardEffect.Initialize(L"Assets/Shaders/Standard.hlsl"); },
+              {systems});
+}
+
+void GameState::Initialize()
+{
+    mCamera.SetPosition({0.0f, 1.5f, -3.0f});
+    mCamera.SetLookAt({0.0f, 1.0f, 0.0f});
+
+    mDirectionalLight.direction = Math::Normalize({1.0f, -1.0f, 1.0f});
+    mDirectionalLight.ambient = {0.4f, 0.4f, 0.4f, 1.0f};
+    mDirectionalLight.diffuse = {0.8f, 0.8f, 0.8f, 1.0f};
+    mDirectionalLight.specular = {0.9f, 0.9f, 0.9f, 1.0f};
+
+    mStandardEffect.SetCamera(mCamera);
+    mStandardEffect.SetDirectionalLight(mDirectionalLight);
+
+    const Model* model = ModelManager::Get()->GetModel(mCharacter.modelId);
+    if (model != nullptr && !model->skeleton.IsEmpty() && !model->animationClips.empty())
+    {
+        mSkeleton = &model->skeleton;
+        mClips = &model->animationClips;
+
+        // Only meshes with bone weights are skinned, the rest keep their static buffers
+        mSkinner.Initialize(*model, mCharacter);
+        mSkinned = mSkinner.GetVertexCount() > 0;
+        InitializeCrowd(*model);
+    }
+    else
+    {
+        BuildProceduralAnimation();
+        mSkeleton = &mProceduralSkeleton;
+        mClips = &mProceduralClips;
+    }
+
+    mAnimator.Initialize(*mSkeleton, *mClips);
+    mAnimator.Play(0, mLooping);
+}
+
+void GameState::Terminate()
+{
+    if (mHasCrowd)
+    {
+        mCrowdEffect.Terminate();
+        mCrowdAnimation.Terminate();
+        mCrowd.Terminate();
+    }
+    mSkinner.Terminate();
+    mAnimator.Terminate();
+    mCharacter.Terminate();
+    mStandardEffect.Terminate();
+}
+
+void GameState::Update(float deltaTime)
+{
+    UpdateCamera(deltaTime);
+
+    using Clock = std::chrono::high_resolution_clock;
+    using Micros = std::chrono::duration<float, std::micro>;
+    const auto start = Clock::now();
+    mAnimator.Update(deltaTime);
+    const auto animated = Clock::now();
+    if (mSkinned)
+    {
+        const SkinningMethod method = static_cast<SkinningMethod>(mSkinningMethod);
+        mSkinner.Update(mAnimator.GetSkinningMatrices().data(), method);
+    }
+    const auto skinned = Clock::now();
+
+    const float animationMicros = Micros(animated - start).count();
+    const float skinningMicros = Micros(skinned - animated).count();
+    mAnimationTime = Math::Lerp(mAnimationTime, animationMicros, 0.05f);
+    mSkinningTime = Math::Lerp(mSkinningTime, skinningMicros, 0.05f);
+
+    mCrowdTime += deltaTime;
+}
+
+void GameState::Render()
+{
+    SimpleDraw::AddGroundPlane(20.0f, Colors::Wheat);
+
+    if (mShowBones)
+    {
+        // Procedural chains are drawn beside the character so they don't hide inside the mesh
+        const Math::Matrix4 world = (mSkeleton == &mProceduralSkeleton)
+                                        ? Math::Matrix4::Translation({1.0f, 0.0f, 0.0f})
+                                        : mCharacter.GetWorldMatrix();
+        const std::vector<Math::Matrix4>& modelMatrices = mAnimator.GetModelMatrices();
+        for (size_t i = 0; i < mSkeleton->bones.size(); ++i)
+        {
+            const int parentIndex = mSkeleton->bones[i].parentIndex;
+            if (parentIndex >= 0)
+            {
+                const Math::Matrix4 bone = modelMatrices[i] * world;
+                const Math::Matrix4 parent = modelMatrices[parentIndex] * world;
+                SimpleDraw::AddLine(
+                    Math::GetTranslation(parent), Math::GetTranslation(bone), Colors::Cyan);
+            }
+        }
+    }
+    SimpleDraw::Render(mCamera);
+
+    mStandardEffect.Begin();
+    mStandardEffect.Render(mCharacter);
+    mStandardEffect.End();
+
+    if (mShowCrowd)
+    {
+        mCrowdEffect.SetTime(mCrowdTime);
+        mCrowdEffect.Begin();
+        mCrowdEffect.Render(mCrowd,
+                            mCrowdAnimation,
+                            mCrowdInstances.data(),
+                            static_cast<uint32_t>(mCrowdInstances.size()));
+        mCrowdEffect.End();
+    }
+}
+
+void GameState::DebugUI()
+{
+    ImGui::Begin("Debug", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    if (ImGui::CollapsingHeader("Animation", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        const AnimationClip& current = (*mClips)[mClipIndex];
+        if (ImGui::BeginCombo("Clip", current.GetName().c_str()))
+        {
+            for (int i = 0; i < static_cast<int>(mClips->size()); ++i)
+            {
+                if (ImGui::Selectable((*mClips)[i].GetName().c_str(), i == mClipIndex))
+                {
+                    mClipIndex = i;
+                    mAnimator.Play(mClipIndex, mLooping, mBlendDuration);
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        float speed = mAnimator.GetSpeed();
+        if (ImGui::DragFloat("Speed", &speed, 0.01f, 0.0f, 4.0f))
+        {
+            mAnimator.SetSpeed(speed);
+        }
+        ImGui::DragFloat("Crossfade", &mBlendDuration, 0.01f, 0.0f, 2.0f);
+        if (ImGui::Checkbox("Looping", &mLooping) || ImGui::Button("Restart"))
+        {
+            mAnimator.Play(mClipIndex, mLooping);
+        }
+        ImGui::Checkbox("Show Bones", &mShowBones);
+
+        ImGui::Text("Time: %.2f / %.2f", mAnimator.GetTime(), current.GetDuration());
+        ImGui::Text("Bones: %zu, Frames: %u", mSkeleton->bones.size(), current.GetFrameCount());
+
+        const AnimationClip::Stats stats = current.GetStats();
+        ImGui::Text("Animated tracks: %u rotation, %u position, %u scale",
+                    stats.animatedRotations,
+                    stats.animatedPositions,
+                    stats.animatedScales);
+        ImGui::Text("Constant channels: %u, Rest channels: %u",
+                    stats.constantChannels,
+                    stats.restChannels);
+        ImGui::Text("Compressed size: %zu bytes", current.GetMemorySize());
+        if (mProceduralRawSize > 0 && mClips == &mProceduralClips)
+        {
+            ImGui::Text("Raw size: %zu bytes", mProceduralRawSize);
+        }
+
+        const size_t boneCount = Math::Max<size_t>(mSkeleton->bones.size(), 1);
+        ImGui::Text("Update: %.2f us, %.1f ns per bone",
+                    mAnimationTime,
+                    mAnimationTime * 1000.0f / boneCount);
+
+        if (mSkinned)
+        {
+            const char* methods[] = {"Linear Blend", "Dual Quaternion"};
+            ImGui::Combo("Skinning", &mSkinningMethod, methods, IM_ARRAYSIZE(methods));
+
+            const uint32_t vertexCount = mSkinner.GetVertexCount();
+            ImGui::Text("Skinning: %.2f us, %u vertices, %.1f ns per vertex",
+                        mSkinningTime,
+                        vertexCount,
+                        mSkinningTime * 1000.0f / vertexCount);
+        }
+    }
+    if (mHasCrowd && ImGui::CollapsingHeader("Crowd", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Checkbox("Show Crowd", &mShowCrowd);
+        if (ImGui::DragInt("Characters", &mCrowdSize, 10.0f, 1, 10000))
+        {
+            BuildCrowd();
+        }
+
+        const VertexAnimationData& data = mCrowdAnimation.GetData();
+        ImGui::Text("Baked: %zu clips, %u frames, %ux%u texels",
+                    data.clips.size(),
+                    data.frameCount,
+                    data.textureWidth,
+                    data.GetTextureHeight());
+        ImGui::Text("Draw calls: %u", mShowCrowd ? mCrowdEffect.GetDrawCount() : 0);
+    }
+    ImGui::Separator();
+
+    mStandardEffect.DebugUI();
+
+    ImGui::End();
+}
+
+void GameState::BuildProceduralAnimation()
+{
+    mProceduralSkeleton.bones.resize(ChainBoneCount);
+    for (uint32_t b = 0; b < ChainBoneCount; ++b)
+    {
+        Bone& bone = mProceduralSkeleton.bones[b];
+        bone.name = "Chain" + std::to_string(b);
+        bone.parentIndex = static_cast<int>(b) - 1;
+        bone.restTransform.position = {0.0f, (b == 0) ? 0.0f : ChainBoneLength, 0.0f};
+    }
+    mProceduralSkeleton.BuildRestPose();
+
+    const RawAnimationClip sway = CreateChainClip("Sway", 2.0f, 0.5f, 0.15f);
+    const RawAnimationClip whip = CreateChainClip("Whip", 1.0f, 2.0f, 0.35f);
+    mProceduralClips.push_back(AnimationClip::Compress(sway, mProceduralSkeleton));
+    mProceduralClips.push_back(AnimationClip::Compress(whip, mProceduralSkeleton));
+    mProceduralRawSize = sway.GetMemorySize();
+}
+
+void GameState::InitializeCrowd(const Model& model)
+{
+    // Models without a baked .vat file are baked here, VATBaker saves the result ahead of time
+    VertexAnimationData bakedAnimation;
+    const VertexAnimationData* animation = &model.vertexAnimation;
+    if (animation->IsEmpty())
+    {
+        bakedAnimation = VertexAnimationData::Bake(model);
+        animation = &bakedAnimation;
+    }
+    if (animation->IsEmpty())
+    {
+        return;
+    }
+
+    mCrowd.Initialize("Character_01/Character_01.model");
+    mCrowdAnimation.Initialize(*animation);
+    mCrowdEffect.Initialize(L"Assets/Shaders/VertexAnimation.hlsl");
+    mCrowdEffect.SetCamera(mCamera);
+    mCrowdEffect.SetDirectionalLight(mDirectionalLight);
+    mHasCrowd = true;
+    BuildCrowd();
+}
+
+void GameState::BuildCrowd()
+{
+    // A grid in front of the character, every instance at its own clip, phase and pace
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const uint32_t clipCount = static_cast<uint32_t>(mCrowdAnimation.GetData().clips.size());
+    const int columns = static_cast<int>(ceilf(sqrtf(static_cast<float>(mCrowdSize))));
+    constexpr float spacing = 1.5f;
+
+    mCrowdInstances.resize(mCrowdSize);
+    for (int i = 0; i < mCrowdSize; ++i)
+    {
+        const float x = (i % columns - columns * 0.5f) * spacing;
+        const float z = (i / columns + 2) * spacing;
+        VertexAnimationInstance& instance = mCrowdInstances[i];
+        instance.world = Math::Matrix4::RotationY(unit(rng) * Math::Constants::TwoPi) *
+                         Math::Matrix4::Translation({x, 0.0f, z});
+        instance.clipIndex = static_cast<uint32_t>(unit(rng) * clipCount) % clipCount;
+        instance.timeOffset = unit(rng) * 10.0f;
+        instance.speed = 0.8f + 0.4f * unit(rng);
+    }
+}
+
+void GameState::UpdateCamera(float deltaTime)
+{
+    InputSystem* input = InputSystem::Get();
+    const float moveSpeed = input->IsKeyDown(KeyCode::LSHIFT) ? 10.0f : 1.0f;
+
+    if (input->IsKeyDown(KeyCode::W))
+    {
+        mCamera.Walk(moveSpeed * deltaTime);
+    }
+    else if (input->IsKeyDown(KeyCode::S))
+    {
+        mCamera.Walk(-moveSpeed * deltaTime);
+    }
+    if (input->IsKeyDown(KeyCode::D))
+    {
+        mCamera.Strafe(moveSpeed * deltaTime);
+    }
+    else if (input->IsKeyDown(KeyCode::A))
+    {
+        mCamera.Strafe(-moveSpeed * deltaTime);
+    }
+    if (input->IsKeyDown(KeyCode::E))
+    {
+        mCamera.Rise(moveSpeed * deltaTime);
+    }
+    else if (input->IsKeyDown(KeyCode::Q))
+    {
+        mCamera.Rise(-moveSpeed * deltaTime);
+    }
+
+    if (input->IsMouseDown(MouseButton::RBUTTON))
+    {
+        mCamera.Yaw(input->GetMouseMoveX() * CameraTurnSpeed * deltaTime);
+        mCamera.Pitch(input->GetMouseMoveY() * CameraTurnSpeed * deltaTime);
+    }
+}
+
+bool GameState::WantsLateLatch() const
+{
+    return true;
+}
+
+void GameState::LateLatch(float deltaTime, int mouseMoveX, int mouseMoveY)
+{
+    // The rest of the turn UpdateCamera would only apply next frame
+    if (InputSystem::Get()->IsMouseDown(MouseButton::RBUTTON))
+    {
+        mCamera.Yaw(mouseMoveX * CameraTurnSpeed * deltaTime);
+        mCamera.Pitch(mouseMoveY * CameraTurnSpeed * deltaTime);
+    }
+}
@@ -5,9 +5,53 @@
 class GameState : public Engine::AppState
 {
   public:
+    void AddInitializeTasks(Engine::Core::TaskGraph& graph, Engine::Core::TaskId systems) override;
     void Initialize() override;
     void Terminate() override;
     void Update(float deltaTime) override;
+    bool WantsLateLatch() const override;
+    void LateLatch(float deltaTime, int mouseMoveX, int mouseMoveY) override;
     void Render() override;
     void DebugUI() override;
+
+  private:
+    void UpdateCamera(float deltaTime);
+    void BuildProceduralAnimation();
+    void InitializeCrowd(const Engine::Graphics::Model& model);
+    void BuildCrowd();
+
+    Engine::Graphics::Camera mCamera;
+    Engine::Graphics::DirectionalLight mDirectionalLight;
+    Engine::Graphics::StandardEffect mStandardEffect;
+
+    Engine::Graphics::RenderGroup mCharacter;
+
+    // Used when the character was imported without a skeleton
+    Engine::Graphics::Skeleton mProceduralSkeleton;
+    std::vector<Engine::Graphics::AnimationClip> mProceduralClips;
+    size_t mProceduralRawSize = 0;
+
+    const Engine::Graphics::Skeleton* mSkeleton = nullptr;
+    const std::vector<Engine::Graphics::AnimationClip>* mClips = nullptr;
+    Engine::Graphics::Animator mAnimator;
+    Engine::Graphics::Skinner mSkinner;
+    bool mSkinned = false;
+    int mSkinningMethod = 0;
+
+    int mClipIndex = 0;
+    bool mLooping = true;
+    float mBlendDuration = 0.3f;
+    bool mShowBones = true;
+    float mAnimationTime = 0.0f; // Microseconds, smoothed
+    float mSkinningTime = 0.0f;
+
+    // Background characters played back from the vertex animation texture
+    Engine::Graphics::RenderGroup mCrowd;
+    Engine::Graphics::VertexAnimationTexture mCrowdAnimation;
+    Engine::Graphics::VertexAnimationEffect mCrowdEffect;
+    std::vector<Engine::Graphics::VertexAnimationInstance> mCrowdInstances;
+    bool mHasCrowd = false;
+    bool mShowCrowd = false;
+    int mCrowdSize = 1000;
+    float mCrowdTime = 0.0f;
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CORE_CPU_PAUSE() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CORE_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#define CORE_CPU_PAUSE() ((void) 0)
+#endif
+
+namespace Engine::Core
+{
+// Keeps data written by different threads on different cache lines
+constexpr size_t CacheLineSize = 64;
+
+// Exponential backoff for spin loops: pauses twice as long after every failed attempt, then
+// yields the thread once spinning stops paying off
+class Backoff
+{
+  public:
+    static constexpr uint32_t MaxSpinCount = 64;
+
+    void Pause()
+    {
+        if (mSpinCount <= MaxSpinCount)
+        {
+            for (uint32_t i = 0; i < mSpinCount; ++i)
+            {
+                CORE_CPU_PAUSE();
+            }
+            mSpinCount *= 2;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // True once Pause has started yielding, a hint to block instead
+    bool IsYielding() const
+    {
+        return mSpinCount > MaxSpinCount;
+    }
+
+    void Reset()
+    {
+        mSpinCount = 1;
+    }
+
+  private:
+    uint32_t mSpinCount = 1;
+};
+} // namespace Engine::Core
@@ -2,6 +2,26 @@
 
 #include "Common.h"
 
+#include "Backoff.h"
 #include "DebugUtil.h"
+#include "Event.h"
+#include "FlatHashMap.h"
+#include "FrameAllocator.h"
+#include "HandlePool.h"
+#include "Hash.h"
+#include "JobSystem.h"
+#include "LinearAllocator.h"
+#include "Logger.h"
+#include "MemoryTracker.h"
+#include "MpmcQueue.h"
+#include "PerfCounters.h"
+#include "PoolAllocator.h"
+#include "SeqLock.h"
+#include "SmallVector.h"
+#include "SpinLock.h"
+#include "SpscQueue.h"
+#include "StlAllocator.h"
+#include "StringTable.h"
+#include "TaskGraph.h"
 #include "TimeUtil.h"
 #include "Window.h"
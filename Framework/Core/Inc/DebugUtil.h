@@ -1,6 +1,6 @@
 #pragma once
 
-#include "TimeUtil.h"
+#include "Logger.h"
 
 using namespace Engine;
 using namespace Engine::Core;
@@ -13,31 +13,58 @@ using namespace Engine::Core;
     #define PLATFORM_BREAK() raise(SIGTRAP)
 #endif
 
-#if defined(_DEBUG)
-#define LOG(format, ...)                                                                           \
-    ;                                                                                              \
+// Logging goes through the asynchronous Logger in every build. A disabled level or category
+// costs one check and does not evaluate the arguments. The unevaluated printf keeps the compile
+// time format checks.
+#define LOG_MESSAGE(level, category, format, ...)                                                  \
     do                                                                                             \
     {                                                                                              \
-        char _buffer[256];                                                                         \
-        int _res = snprintf(_buffer,                                                               \
-                            std::size(_buffer),                                                    \
-                            "{%.3f}: " format "\n",                                                \
-                            TimeUtil::GetTime(),                                                   \
-                            __VA_ARGS__);                                                          \
-        std::cout << _buffer;                                                                      \
+        if (Engine::Core::Logger::IsEnabled(level, category))                                      \
+        {                                                                                          \
+            (void) sizeof(printf(format, ##__VA_ARGS__));                                          \
+            Engine::Core::Logger::Write(level, category, format, ##__VA_ARGS__);                   \
+        }                                                                                          \
     } while (false)
 
+#define LOG(format, ...)                                                                           \
+    LOG_MESSAGE(Engine::Core::LogLevel::Info,                                                      \
+                Engine::Core::LogCategory::General,                                                \
+                format,                                                                            \
+                ##__VA_ARGS__)
+#define LOG_INFO(category, format, ...)                                                            \
+    LOG_MESSAGE(Engine::Core::LogLevel::Info,                                                      \
+                Engine::Core::LogCategory::category,                                               \
+                format,                                                                            \
+                ##__VA_ARGS__)
+#define LOG_WARNING(category, format, ...)                                                         \
+    LOG_MESSAGE(Engine::Core::LogLevel::Warning,                                                   \
+                Engine::Core::LogCategory::category,                                               \
+                format,                                                                            \
+                ##__VA_ARGS__)
+#define LOG_ERROR(category, format, ...)                                                           \
+    LOG_MESSAGE(Engine::Core::LogLevel::Error,                                                     \
+                Engine::Core::LogCategory::category,                                               \
+                format,                                                                            \
+                ##__VA_ARGS__)
+
+#if defined(_DEBUG)
+// Skips the filters and flushes so the message is out before the debugger stops
 #define ASSERT(condition, format, ...)                                                             \
     do                                                                                             \
     {                                                                                              \
         if (!(condition))                                                                          \
         {                                                                                          \
-            LOG("ASSERT! %s(%d)\n" format, __FILE__, __LINE__, __VA_ARGS__);                       \
-            PLATFORM_BREAK();                                                                          \
+            Engine::Core::Logger::Write(Engine::Core::LogLevel::Error,                             \
+                                        Engine::Core::LogCategory::General,                        \
+                                        "ASSERT! %s(%d)\n" format,                                 \
+                                        __FILE__,                                                  \
+                                        __LINE__,                                                  \
+                                        ##__VA_ARGS__);                                            \
+            Engine::Core::Logger::Flush();                                                         \
+            PLATFORM_BREAK();                                                                      \
         }                                                                                          \
     } while (false)
 #else
-#define LOG(format, ...)
 #define ASSERT(condition, format, ...)                                                             \
     do                                                                                             \
     {                                                                                              \
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Engine::Core
+{
+// Signaled flag that threads can block on, in the spirit of a futex: signaling and checking are
+// single atomic operations while nobody waits, and only threads that actually have to sleep touch
+// the mutex and condition variable. Waiters spin briefly before sleeping.
+class Event final
+{
+  public:
+    enum class Mode
+    {
+        AutoReset,  // Each signal releases one waiter and clears the flag
+        ManualReset // Stays signaled, releasing every waiter, until Reset
+    };
+
+    explicit Event(Mode mode = Mode::AutoReset, bool signaled = false);
+
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+
+    void Signal();
+    void Reset();
+
+    void Wait();
+    bool WaitFor(std::chrono::milliseconds timeout); // False if the timeout ran out first
+    bool TryWait(); // Wait without blocking, false if not signaled
+
+    bool IsSignaled() const;
+
+  private:
+    std::atomic<bool> mSignaled;
+    std::atomic<uint32_t> mWaiterCount{0};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    const Mode mMode;
+};
+} // namespace Engine::Core
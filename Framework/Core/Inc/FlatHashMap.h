@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::Core
+{
+// Open addressing hash map with linear probing. Entries live in one array next to a parallel
+// array of 32 bit hash tags, so a lookup scans a few contiguous tags and touches a single entry
+// instead of chasing bucket nodes. Erase shifts the following entries back, so there are no
+// tombstones and probe lengths stay short. Pointers returned by Find and TryEmplace are
+// invalidated by any insert that grows the table and by Erase.
+template <class Key, class Value, class Hash = std::hash<Key>> class FlatHashMap final
+{
+  public:
+    FlatHashMap() = default;
+
+    ~FlatHashMap()
+    {
+        Clear();
+    }
+
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+    FlatHashMap(FlatHashMap&& rhs) noexcept
+    {
+        Swap(rhs);
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Clear();
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    Value* Find(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        return (index != NotFound) ? &GetSlot(index).value : nullptr;
+    }
+
+    const Value* Find(const Key& key) const
+    {
+        const size_t index = FindIndex(key);
+        return (index != NotFound) ? &GetSlot(index).value : nullptr;
+    }
+
+    bool Contains(const Key& key) const
+    {
+        return FindIndex(key) != NotFound;
+    }
+
+    // Constructs the value from args only if the key is not in the map yet. Returns the value and
+    // whether it was inserted.
+    template <class... Args> std::pair<Value*, bool> TryEmplace(const Key& key, Args&&... args)
+    {
+        if ((mSize + 1) * 4 > mTags.size() * 3)
+        {
+            Rehash(std::max<size_t>(mTags.size() * 2, MinCapacity));
+        }
+
+        const uint32_t tag = GetTag(key);
+        const size_t mask = mTags.size() - 1;
+        size_t index = tag & mask;
+        while (mTags[index] != 0)
+        {
+            if (mTags[index] == tag && GetSlot(index).key == key)
+            {
+                return {&GetSlot(index).value, false};
+            }
+            index = (index + 1) & mask;
+        }
+
+        new (&mStorage[index]) Slot{key, Value(std::forward<Args>(args)...)};
+        mTags[index] = tag;
+        ++mSize;
+        return {&GetSlot(index).value, true};
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return *TryEmplace(key).first;
+    }
+
+    bool Erase(const Key& key)
+    {
+        size_t hole = FindIndex(key);
+        if (hole == NotFound)
+        {
+            return false;
+        }
+
+        GetSlot(hole).~Slot();
+        --mSize;
+
+        // Pull later entries of the probe run back into the hole when that keeps them reachable
+        const size_t mask = mTags.size() - 1;
+        for (size_t index = (hole + 1) & mask; mTags[index] != 0; index = (index + 1) & mask)
+        {
+            const size_t home = mTags[index] & mask;
+            if (((index - home) & mask) >= ((index - hole) & mask))
+            {
+                new (&mStorage[hole]) Slot(std::move(GetSlot(index)));
+                GetSlot(index).~Slot();
+                mTags[hole] = mTags[index];
+                hole = index;
+            }
+        }
+        mTags[hole] = 0;
+        return true;
+    }
+
+    void Clear()
+    {
+        for (size_t i = 0; i < mTags.size(); ++i)
+        {
+            if (mTags[i] != 0)
+            {
+                GetSlot(i).~Slot();
+                mTags[i] = 0;
+            }
+        }
+        mSize = 0;
+    }
+
+    void Reserve(size_t count)
+    {
+        size_t capacity = MinCapacity;
+        while (capacity * 3 < count * 4)
+        {
+            capacity *= 2;
+        }
+        if (capacity > mTags.size())
+        {
+            Rehash(capacity);
+        }
+    }
+
+    // Calls fn(const Key&, Value&) for every entry, in no particular order
+    template <class Fn> void ForEach(Fn&& fn)
+    {
+        for (size_t i = 0; i < mTags.size(); ++i)
+        {
+            if (mTags[i] != 0)
+            {
+                Slot& slot = GetSlot(i);
+                fn(static_cast<const Key&>(slot.key), slot.value);
+            }
+        }
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    bool IsEmpty() const
+    {
+        return mSize == 0;
+    }
+
+  private:
+    struct Slot
+    {
+        Key key;
+        Value value;
+    };
+
+    struct alignas(Slot) SlotStorage
+    {
+        unsigned char bytes[sizeof(Slot)];
+    };
+
+    static constexpr size_t MinCapacity = 16;
+    static constexpr size_t NotFound = SIZE_MAX;
+
+    // Mixes the hash so identity hashes of integers still spread over the table. The top bit
+    // marks the tag as used, which limits the table to 2^31 slots.
+    static uint32_t GetTag(const Key& key)
+    {
+        uint64_t h = static_cast<uint64_t>(Hash()(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return static_cast<uint32_t>(h) | 0x80000000u;
+    }
+
+    Slot& GetSlot(size_t index)
+    {
+        return *std::launder(reinterpret_cast<Slot*>(&mStorage[index]));
+    }
+
+    const Slot& GetSlot(size_t index) const
+    {
+        return *std::launder(reinterpret_cast<const Slot*>(&mStorage[index]));
+    }
+
+    size_t FindIndex(const Key& key) const
+    {
+        if (mSize == 0)
+        {
+            return NotFound;
+        }
+
+        const uint32_t tag = GetTag(key);
+        const size_t mask = mTags.size() - 1;
+        for (size_t index = tag & mask; mTags[index] != 0; index = (index + 1) & mask)
+        {
+            if (mTags[index] == tag && GetSlot(index).key == key)
+            {
+                return index;
+            }
+        }
+        return NotFound;
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<uint32_t> oldTags(capacity, 0);
+        std::unique_ptr<SlotStorage[]> oldStorage = std::make_unique<SlotStorage[]>(capacity);
+        oldTags.swap(mTags);
+        oldStorage.swap(mStorage);
+
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < oldTags.size(); ++i)
+        {
+            if (oldTags[i] == 0)
+            {
+                continue;
+            }
+
+            Slot& slot = *std::launder(reinterpret_cast<Slot*>(&oldStorage[i]));
+            size_t index = oldTags[i] & mask;
+            while (mTags[index] != 0)
+            {
+                index = (index + 1) & mask;
+            }
+            new (&mStorage[index]) Slot(std::move(slot));
+            mTags[index] = oldTags[i];
+            slot.~Slot();
+        }
+    }
+
+    void Swap(FlatHashMap& rhs)
+    {
+        mTags.swap(rhs.mTags);
+        mStorage.swap(rhs.mStorage);
+        std::swap(mSize, rhs.mSize);
+    }
+
+    std::vector<uint32_t> mTags; // 0 for empty slots
+    std::unique_ptr<SlotStorage[]> mStorage;
+    size_t mSize = 0;
+};
+} // namespace Engine::Core
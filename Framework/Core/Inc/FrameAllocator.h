@@ -0,0 +1,44 @@
+#pragma once
+
+#include "LinearAllocator.h"
+
+namespace Engine::Core
+{
+// Arena for memory that only has to last until the end of the frame. App::Run resets it at the
+// start of every frame. Belongs to the main thread, jobs use a ScratchScope instead.
+namespace FrameAllocator
+{
+void StaticInitialize(size_t capacity);
+void StaticTerminate();
+LinearAllocator* Get();
+
+// Resets the arena, the counters of the frame that ended are kept for GetLastFrameStats
+void BeginFrame();
+const AllocatorStats& GetLastFrameStats();
+} // namespace FrameAllocator
+
+// Temporary memory on a per thread stack, everything allocated through the scope is freed when
+// it closes. Scopes nest, and the stack of each thread is created on its first use.
+class ScratchScope final
+{
+  public:
+    static constexpr size_t StackCapacity = 1024 * 1024;
+
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    LinearAllocator& GetAllocator();
+
+    template <class T> T* Allocate(size_t count)
+    {
+        return mAllocator.Allocate<T>(count);
+    }
+
+  private:
+    LinearAllocator& mAllocator;
+    LinearAllocator::Marker mMarker;
+};
+} // namespace Engine::Core
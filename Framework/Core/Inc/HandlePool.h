@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::Core
+{
+// Slot index in the low 32 bits and the slot's generation in the high 32 bits. Live generations
+// are odd, so a valid handle is never zero and zero initialized ids read as "none".
+using Handle = uint64_t;
+constexpr Handle InvalidHandle = 0;
+
+// Dense array of values addressed by generation checked handles. Looking a handle up is an index
+// and a compare, removed slots are reused and their generation bumped so stale handles miss.
+// Values are stored inline, so pointers from Get are invalidated when Add grows the array.
+template <class T> class HandlePool final
+{
+  public:
+    template <class... Args> Handle Add(Args&&... args)
+    {
+        uint32_t index = 0;
+        if (!mFreeIndices.empty())
+        {
+            index = mFreeIndices.back();
+            mFreeIndices.pop_back();
+            mValues[index] = T(std::forward<Args>(args)...);
+            ++mGenerations[index];
+        }
+        else
+        {
+            index = static_cast<uint32_t>(mValues.size());
+            mValues.emplace_back(std::forward<Args>(args)...);
+            mGenerations.push_back(1);
+        }
+        return (static_cast<Handle>(mGenerations[index]) << 32) | index;
+    }
+
+    T* Get(Handle handle)
+    {
+        return IsValid(handle) ? &mValues[GetIndex(handle)] : nullptr;
+    }
+
+    const T* Get(Handle handle) const
+    {
+        return IsValid(handle) ? &mValues[GetIndex(handle)] : nullptr;
+    }
+
+    bool IsValid(Handle handle) const
+    {
+        const uint32_t index = GetIndex(handle);
+        return index < mGenerations.size() && mGenerations[index] == GetGeneration(handle) &&
+               (mGenerations[index] & 1) != 0;
+    }
+
+    // Resets the slot to a default value and frees it for reuse
+    bool Remove(Handle handle)
+    {
+        if (!IsValid(handle))
+        {
+            return false;
+        }
+
+        const uint32_t index = GetIndex(handle);
+        mValues[index] = T();
+        ++mGenerations[index];
+        mFreeIndices.push_back(index);
+        return true;
+    }
+
+    void Reserve(uint32_t capacity)
+    {
+        mValues.reserve(capacity);
+        mGenerations.reserve(capacity);
+    }
+
+    void Clear()
+    {
+        for (uint32_t i = 0; i < mGenerations.size(); ++i)
+        {
+            if ((mGenerations[i] & 1) != 0)
+            {
+                Remove((static_cast<Handle>(mGenerations[i]) << 32) | i);
+            }
+        }
+    }
+
+    // Calls fn(Handle, T&) for every live value
+    template <class Fn> void ForEach(Fn&& fn)
+    {
+        for (uint32_t i = 0; i < mGenerations.size(); ++i)
+        {
+            if ((mGenerations[i] & 1) != 0)
+            {
+                fn((static_cast<Handle>(mGenerations[i]) << 32) | i, mValues[i]);
+            }
+        }
+    }
+
+    uint32_t GetCount() const
+    {
+        return static_cast<uint32_t>(mValues.size() - mFreeIndices.size());
+    }
+
+    static uint32_t GetIndex(Handle handle)
+    {
+        return static_cast<uint32_t>(handle);
+    }
+
+    static uint32_t GetGeneration(Handle handle)
+    {
+        return static_cast<uint32_t>(handle >> 32);
+    }
+
+  private:
+    std::vector<T> mValues;
+    std::vector<uint32_t> mGenerations;
+    std::vector<uint32_t> mFreeIndices;
+};
+} // namespace Engine::Core
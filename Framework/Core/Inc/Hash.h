@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::Core
+{
+// 64 bit XXH64 hash. Not cryptographic, but fast and identical on every platform and run, so the
+// values can be written to disk and used as cache keys.
+uint64_t Hash64(const void* data, size_t size, uint64_t seed = 0);
+
+inline uint64_t Hash64(std::string_view text, uint64_t seed = 0)
+{
+    return Hash64(text.data(), text.size(), seed);
+}
+
+// Path in the form asset ids are computed from: '/' separators, "." and ".." collapsed and ASCII
+// letters lower cased, so the same file spelled differently gets the same id on every platform
+std::string NormalizePath(const std::filesystem::path& path);
+
+inline uint64_t HashPath(const std::filesystem::path& path)
+{
+    return Hash64(NormalizePath(path));
+}
+} // namespace Engine::Core
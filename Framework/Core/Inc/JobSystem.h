@@ -0,0 +1,60 @@
+#pragma once
+
+namespace Engine::Core
+{
+// Tracks a group of submitted jobs, Wait on it to join them
+struct JobCounter
+{
+    std::atomic<uint32_t> pending{0};
+};
+
+class JobSystem final
+{
+  public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+    // A thread count of 0 uses one worker per hardware thread, minus the calling thread
+    static void StaticInitialize(uint32_t threadCount = 0);
+    static void StaticTerminate();
+    static JobSystem* Get();
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem(const JobSystem&&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&&) = delete;
+
+    void Initialize(uint32_t threadCount);
+    void Terminate();
+
+    void Submit(Job job, JobCounter* counter = nullptr);
+
+    // Runs queued jobs on the calling thread until the counter reaches zero
+    void Wait(const JobCounter& counter);
+
+    // Splits [0, count) into chunks of at least grainSize and blocks until all of them ran
+    void ParallelFor(uint32_t count, uint32_t grainSize, const RangeJob& job);
+
+    uint32_t GetWorkerCount() const;
+
+  private:
+    struct Entry
+    {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    void WorkerMain();
+    bool TryRunOne();
+    void Run(Entry& entry);
+
+    std::vector<std::thread> mWorkers;
+    std::deque<Entry> mQueue;
+    std::mutex mMutex;
+    std::condition_variable mWakeCondition;
+    bool mRunning = false;
+};
+} // namespace Engine::Core
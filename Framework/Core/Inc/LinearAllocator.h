@@ -0,0 +1,76 @@
+#pragma once
+
+namespace Engine::Core
+{
+// Counters since the last Reset
+struct AllocatorStats
+{
+    size_t allocatedBytes = 0; // Requested, without alignment padding or guards
+    size_t overflowBytes = 0;  // Part of allocatedBytes that did not fit and went to the heap
+    uint32_t allocationCount = 0;
+};
+
+// Bump allocator over one block, everything is freed together by Reset or back to a marker.
+// Requests that do not fit go to the heap and live until Reset, so a full arena is slow rather
+// than fatal. Not thread safe, each thread should use its own.
+//
+// Debug builds fill new memory with 0xCD and freed memory with 0xDD, and follow every allocation
+// with guard bytes that Reset and FreeToMarker check for overruns.
+class LinearAllocator final
+{
+  public:
+    struct Marker
+    {
+        size_t offset = 0;
+        size_t overflowCount = 0;
+        size_t guardCount = 0;
+    };
+
+    LinearAllocator() = default;
+    ~LinearAllocator();
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    void Initialize(size_t capacity);
+    void Terminate();
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects
+    template <class T> T* Allocate(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Frees everything allocated after the marker was taken
+    Marker GetMarker() const;
+    void FreeToMarker(const Marker& marker);
+
+    void Reset();
+
+    size_t GetCapacity() const;
+    size_t GetUsed() const;
+    size_t GetPeakUsed() const; // Highest GetUsed since Initialize
+    const AllocatorStats& GetStats() const;
+
+  private:
+    struct OverflowBlock
+    {
+        void* memory = nullptr;
+        size_t alignment = 0;
+    };
+
+    void CheckGuards(size_t firstGuard) const;
+
+    uint8_t* mBuffer = nullptr;
+    size_t mCapacity = 0;
+    size_t mOffset = 0;
+    size_t mPeakOffset = 0;
+    std::vector<OverflowBlock> mOverflow;
+#if defined(_DEBUG)
+    std::vector<size_t> mGuards; // Offsets of the guard bytes after each block allocation
+#endif
+    AllocatorStats mStats;
+};
+} // namespace Engine::Core
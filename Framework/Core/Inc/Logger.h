@@ -0,0 +1,210 @@
+#pragma once
+
+#include "TimeUtil.h"
+
+namespace Engine::Core
+{
+enum class LogLevel : uint8_t
+{
+    Info,
+    Warning,
+    Error
+};
+
+enum class LogCategory : uint8_t
+{
+    General,
+    Core,
+    Graphics,
+    Animation,
+    Input,
+    Engine,
+    Count
+};
+
+// One log call in binary form: the format string pointer, the arguments packed behind it and the
+// function that knows their types. Formatting happens later on the logger thread. Strings are
+// copied into the payload, everything else must be printf compatible and trivially copyable.
+struct LogRecord
+{
+    static constexpr size_t PayloadSize = 192;
+
+    // Null when the arguments did not fit and the payload holds a preformatted std::string*
+    using FormatFn = int (*)(const LogRecord& record, char* buffer, size_t size);
+
+    const char* format = nullptr;
+    FormatFn formatFn = nullptr;
+    float time = 0.0f;
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::General;
+    alignas(8) uint8_t payload[PayloadSize];
+};
+
+// Asynchronous log backend behind the LOG macros. Every thread pushes records into its own lock
+// free ring, a background thread formats them in time order and writes them to the console and
+// the log file. Filtering by level and category is a runtime check and works in every build.
+namespace Logger
+{
+// Until StaticInitialize and after StaticTerminate messages are written on the calling thread.
+// Other threads must have stopped logging before StaticTerminate. An empty path disables the file.
+void StaticInitialize(const std::filesystem::path& logFile);
+void StaticTerminate();
+
+// Blocks until everything logged before the call has been written
+void Flush();
+
+void SetMinLevel(LogLevel level);
+void SetCategoryEnabled(LogCategory category, bool enabled);
+void SetConsoleEnabled(bool enabled);
+
+bool IsEnabled(LogLevel level, LogCategory category);
+
+template <class... Args>
+void Write(LogLevel level, LogCategory category, const char* format, const Args&... args);
+} // namespace Logger
+
+namespace Logger::Detail
+{
+extern std::atomic<uint8_t> sMinLevel;
+extern std::atomic<uint32_t> sCategoryMask;
+
+void Submit(const LogRecord& record);
+void SubmitFormatted(LogRecord& record, std::string* text);
+
+// Narrow and wide strings are copied, every other argument is stored as is
+template <class T>
+using Stored = std::conditional_t<
+    std::is_same_v<std::decay_t<T>, char*>,
+    const char*,
+    std::conditional_t<std::is_same_v<std::decay_t<T>, wchar_t*>, const wchar_t*, std::decay_t<T>>>;
+
+inline uint8_t* AlignUp(uint8_t* cursor, size_t alignment)
+{
+    const uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+    return cursor + ((alignment - (address % alignment)) % alignment);
+}
+
+inline const uint8_t* AlignUp(const uint8_t* cursor, size_t alignment)
+{
+    return AlignUp(const_cast<uint8_t*>(cursor), alignment);
+}
+
+template <class T> size_t GetEncodedSize(const T& value)
+{
+    using S = Stored<T>;
+    if constexpr (std::is_same_v<S, const char*>)
+    {
+        return sizeof(uint32_t) + strlen((value != nullptr) ? value : "(null)") + 1;
+    }
+    else if constexpr (std::is_same_v<S, const wchar_t*>)
+    {
+        const size_t length = wcslen((value != nullptr) ? value : L"(null)");
+        return sizeof(uint32_t) + alignof(wchar_t) - 1 + (length + 1) * sizeof(wchar_t);
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<S>, "LOG: Arguments must be printf compatible");
+        return sizeof(S);
+    }
+}
+
+template <class T> void Encode(uint8_t*& cursor, const T& value)
+{
+    using S = Stored<T>;
+    if constexpr (std::is_same_v<S, const char*>)
+    {
+        const char* text = (value != nullptr) ? value : "(null)";
+        const uint32_t length = static_cast<uint32_t>(strlen(text));
+        memcpy(cursor, &length, sizeof(length));
+        memcpy(cursor + sizeof(length), text, length + 1);
+        cursor += sizeof(length) + length + 1;
+    }
+    else if constexpr (std::is_same_v<S, const wchar_t*>)
+    {
+        const wchar_t* text = (value != nullptr) ? value : L"(null)";
+        const uint32_t length = static_cast<uint32_t>(wcslen(text));
+        memcpy(cursor, &length, sizeof(length));
+        cursor = AlignUp(cursor + sizeof(length), alignof(wchar_t));
+        memcpy(cursor, text, (length + 1) * sizeof(wchar_t));
+        cursor += (length + 1) * sizeof(wchar_t);
+    }
+    else
+    {
+        const S stored = value;
+        memcpy(cursor, &stored, sizeof(S));
+        cursor += sizeof(S);
+    }
+}
+
+template <class S> S Decode(const uint8_t*& cursor)
+{
+    if constexpr (std::is_same_v<S, const char*>)
+    {
+        uint32_t length = 0;
+        memcpy(&length, cursor, sizeof(length));
+        const char* text = reinterpret_cast<const char*>(cursor + sizeof(length));
+        cursor += sizeof(length) + length + 1;
+        return text;
+    }
+    else if constexpr (std::is_same_v<S, const wchar_t*>)
+    {
+        uint32_t length = 0;
+        memcpy(&length, cursor, sizeof(length));
+        cursor = AlignUp(cursor + sizeof(length), alignof(wchar_t));
+        const wchar_t* text = reinterpret_cast<const wchar_t*>(cursor);
+        cursor += (length + 1) * sizeof(wchar_t);
+        return text;
+    }
+    else
+    {
+        S value;
+        memcpy(&value, cursor, sizeof(S));
+        cursor += sizeof(S);
+        return value;
+    }
+}
+
+template <class... S> int FormatRecord(const LogRecord& record, char* buffer, size_t size)
+{
+    // Unused when the record has no arguments
+    [[maybe_unused]] const uint8_t* cursor = record.payload;
+    const std::tuple<S...> values{Decode<S>(cursor)...};
+    return std::apply([&](const auto&... value)
+                      { return snprintf(buffer, size, record.format, value...); },
+                      values);
+}
+} // namespace Logger::Detail
+
+inline bool Logger::IsEnabled(LogLevel level, LogCategory category)
+{
+    return static_cast<uint8_t>(level) >= Detail::sMinLevel.load(std::memory_order_relaxed) &&
+           (Detail::sCategoryMask.load(std::memory_order_relaxed) &
+            (1u << static_cast<uint32_t>(category))) != 0;
+}
+
+template <class... Args>
+void Logger::Write(LogLevel level, LogCategory category, const char* format, const Args&... args)
+{
+    LogRecord record;
+    record.format = format;
+    record.time = TimeUtil::GetTime();
+    record.level = level;
+    record.category = category;
+
+    if ((size_t{0} + ... + Detail::GetEncodedSize(args)) <= LogRecord::PayloadSize)
+    {
+        [[maybe_unused]] uint8_t* cursor = record.payload;
+        (Detail::Encode(cursor, args), ...);
+        record.formatFn = &Detail::FormatRecord<Detail::Stored<Args>...>;
+        Detail::Submit(record);
+    }
+    else
+    {
+        // Too large for a record, rare enough to format right here
+        const int length = snprintf(nullptr, 0, format, Detail::Stored<Args>(args)...);
+        std::string* text = new std::string(std::max(length, 0), '\0');
+        snprintf(text->data(), text->size() + 1, format, Detail::Stored<Args>(args)...);
+        Detail::SubmitFormatted(record, text);
+    }
+}
+} // namespace Engine::Core
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "HandlePool.h"
+
+namespace Engine::Core
+{
+enum class MemoryTag : uint8_t
+{
+    // CPU heap
+    General,
+    Allocators, // Reserved blocks of arenas and pools
+    Models,     // Mesh, skeleton and animation data kept on the CPU
+    Ecs,        // Component chunks
+
+    // GPU resources created through the graphics device
+    Textures,
+    Buffers,       // Vertex, index and constant buffers
+    RenderTargets, // Including depth buffers, shadow maps and the swap chain
+    Count
+};
+
+using MemoryAllocationId = Handle;
+
+struct MemoryAllocationInfo
+{
+    const char* name = nullptr;
+    size_t bytes = 0;
+    MemoryTag tag = MemoryTag::General;
+};
+
+// Live totals per tag for CPU and GPU memory, plus a record of every named allocation for the per
+// asset breakdown and the leak report. The totals are plain atomics and can be read and updated
+// from any thread; named allocations take a short lock.
+namespace MemoryTracker
+{
+// Memory without a name, only the totals of the tag change
+void AddBytes(MemoryTag tag, int64_t bytes);
+
+// The name is not copied, it must live as long as the allocation: a literal or a StringTable
+// string. Untrack ignores InvalidHandle, so ids of resources never created can be passed.
+MemoryAllocationId Track(MemoryTag tag, size_t bytes, const char* name);
+void Untrack(MemoryAllocationId id);
+
+// Logs a warning each time the tag goes over its budget, 0 removes the budget
+void SetBudget(MemoryTag tag, size_t bytes);
+
+bool IsGpuTag(MemoryTag tag);
+const char* GetTagName(MemoryTag tag);
+size_t GetLiveBytes(MemoryTag tag);
+size_t GetPeakBytes(MemoryTag tag);
+size_t GetBudget(MemoryTag tag);
+size_t GetCpuBytes();
+size_t GetGpuBytes();
+
+// Copies every named allocation that is still alive
+void GetAllocations(std::vector<MemoryAllocationInfo>& allocations);
+
+// Logs every named allocation that is still alive and returns how many there are. Meant for the
+// end of the run, once every system has been terminated.
+uint32_t ReportLeaks();
+} // namespace MemoryTracker
+} // namespace Engine::Core
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Backoff.h"
+
+namespace Engine::Core
+{
+// Bounded lock free ring for any number of producers and consumers. Every slot carries a
+// sequence number that says whether it is ready to be written or read for the current lap, so
+// claiming a slot is one compare and swap on the shared index and no slot is ever locked.
+template <class T> class MpmcQueue final
+{
+  public:
+    // Capacity is rounded up to a power of two
+    explicit MpmcQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        mCells = std::make_unique<Cell[]>(size);
+        mMask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Returns false, leaving value untouched, when the queue is full
+    template <class U> bool TryPush(U&& value)
+    {
+        size_t position = mTail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = mCells[position & mMask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference =
+                static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0)
+            {
+                if (mTail.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::forward<U>(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // The slot still holds last lap's value
+            }
+            else
+            {
+                position = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false when the queue is empty
+    bool TryPop(T& value)
+    {
+        size_t position = mHead.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = mCells[position & mMask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference =
+                static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0)
+            {
+                if (mHead.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mMask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // Nothing written to the slot yet this lap
+            }
+            else
+            {
+                position = mHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t GetCapacity() const
+    {
+        return mMask + 1;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> mCells;
+    size_t mMask = 0;
+
+    alignas(CacheLineSize) std::atomic<size_t> mTail{0}; // Next slot to push
+    alignas(CacheLineSize) std::atomic<size_t> mHead{0}; // Next slot to pop
+};
+} // namespace Engine::Core
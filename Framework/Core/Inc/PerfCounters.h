@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Backoff.h"
+
+namespace Engine::Core
+{
+enum class PerfCounterType : uint8_t
+{
+    Counter, // Summed over the frame and reset by EndFrame, e.g. draw calls
+    Gauge    // Keeps its value until set again, e.g. loaded textures
+};
+
+using PerfCounterId = uint32_t;
+
+// Process wide registry of named counters. Updating one is a single relaxed atomic add on its own
+// cache line, so any thread can count without locks. EndFrame samples every counter into a
+// rolling history for the overlay and into the interval statistics that Export writes out.
+namespace PerfCounters
+{
+constexpr uint32_t MaxCounters = 64;
+constexpr uint32_t HistoryLength = 240; // Frames kept for the graphs
+constexpr uint32_t FrameTimeBucketCount = 12;
+
+// Upper bound in milliseconds of each frame time histogram bucket, the last one is open
+constexpr float FrameTimeBucketEdges[FrameTimeBucketCount - 1] =
+    {4.0f, 8.0f, 12.0f, 16.7f, 20.0f, 25.0f, 33.3f, 50.0f, 66.7f, 100.0f, 250.0f};
+
+// Opens the telemetry file and exports to it every interval. An extension of .json writes one
+// JSON object per line, anything else CSV rows. An empty path only keeps the in-memory history.
+void StaticInitialize(const std::filesystem::path& exportFile, float exportIntervalSeconds);
+void StaticTerminate();
+
+// Safe at any time, also during static initialization. Registering a name again returns the
+// same id. The name is not copied and must live as long as the program, e.g. a literal.
+PerfCounterId Register(const char* name, PerfCounterType type);
+
+void Add(PerfCounterId id, int64_t value = 1);
+void Set(PerfCounterId id, int64_t value);
+
+// Main thread, once per frame. Measures the frame time, samples and resets the counters and
+// exports when the interval has passed.
+void EndFrame();
+
+// Writes the statistics gathered since the last export and starts a new interval
+void Export();
+
+uint32_t GetCount();
+const char* GetName(PerfCounterId id);
+PerfCounterType GetType(PerfCounterId id);
+int64_t GetLastFrameValue(PerfCounterId id);
+float GetLastFrameTime(); // Milliseconds
+
+// Ring buffers of HistoryLength values, GetHistoryOffset is the index of the oldest one
+const float* GetHistory(PerfCounterId id);
+const float* GetFrameTimeHistory();
+uint32_t GetHistoryOffset();
+} // namespace PerfCounters
+
+namespace PerfCounters::Detail
+{
+struct alignas(CacheLineSize) Slot
+{
+    std::atomic<int64_t> value{0};
+};
+
+// One spare slot past the end takes the updates of counters that did not fit
+extern Slot sSlots[MaxCounters + 1];
+} // namespace PerfCounters::Detail
+
+inline void PerfCounters::Add(PerfCounterId id, int64_t value)
+{
+    Detail::sSlots[id].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+inline void PerfCounters::Set(PerfCounterId id, int64_t value)
+{
+    Detail::sSlots[id].value.store(value, std::memory_order_relaxed);
+}
+
+// Registers itself on construction, meant to be defined once at file scope next to the code
+// it counts:  const PerfCounter sDrawCalls("Graphics.DrawCalls");
+class PerfCounter final
+{
+  public:
+    explicit PerfCounter(const char* name, PerfCounterType type = PerfCounterType::Counter)
+        : mId(PerfCounters::Register(name, type))
+    {
+    }
+
+    void Add(int64_t value = 1) const
+    {
+        PerfCounters::Add(mId, value);
+    }
+
+    void Set(int64_t value) const
+    {
+        PerfCounters::Set(mId, value);
+    }
+
+    PerfCounterId GetId() const
+    {
+        return mId;
+    }
+
+  private:
+    PerfCounterId mId;
+};
+} // namespace Engine::Core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "DebugUtil.h"
+
+namespace Engine::Core
+{
+// Fixed size blocks carved from one allocation, allocate and free are a pop and a push on an
+// intrusive free list. Not thread safe.
+//
+// Debug builds fill allocated blocks with 0xCD and freed ones with 0xDD, catch double frees, and
+// follow every block with guard bytes that Free checks for overruns.
+class PoolAllocator final
+{
+  public:
+    PoolAllocator() = default;
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void Initialize(size_t blockSize,
+                    uint32_t blockCount,
+                    size_t alignment = alignof(std::max_align_t));
+    void Terminate();
+
+    // Returns nullptr when every block is in use
+    void* Allocate();
+    void Free(void* block);
+
+    template <class T, class... Args> T* New(Args&&... args)
+    {
+        ASSERT(sizeof(T) <= mBlockSize && alignof(T) <= mAlignment,
+               "PoolAllocator: type does not fit in a block");
+        void* memory = Allocate();
+        return (memory != nullptr) ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template <class T> void Delete(T* object)
+    {
+        if (object != nullptr)
+        {
+            object->~T();
+            Free(object);
+        }
+    }
+
+    bool Owns(const void* block) const;
+
+    size_t GetBlockSize() const;
+    size_t GetAlignment() const;
+    uint32_t GetBlockCount() const;
+    uint32_t GetUsedCount() const;
+    uint32_t GetPeakUsedCount() const;
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    uint8_t* mBuffer = nullptr;
+    FreeBlock* mFreeList = nullptr;
+    size_t mBlockSize = 0;
+    size_t mStride = 0; // Block size plus guard, rounded up to the alignment
+    size_t mAlignment = 0;
+    uint32_t mBlockCount = 0;
+    uint32_t mUsedCount = 0;
+    uint32_t mPeakUsedCount = 0;
+#if defined(_DEBUG)
+    std::vector<bool> mAllocated;
+#endif
+};
+} // namespace Engine::Core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Backoff.h"
+
+namespace Engine::Core
+{
+// Value shared by one writer and many readers without blocking the writer. The writer bumps a
+// sequence number to odd before changing the value and back to even after, readers copy the value
+// and retry if the sequence changed meanwhile. Suits small, often read values such as a camera
+// or a stats snapshot. The value is kept as atomic words so concurrent copies are well defined.
+template <class T> class SeqLock final
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock: value must be trivially copyable");
+
+  public:
+    SeqLock() = default;
+
+    explicit SeqLock(const T& value)
+    {
+        Store(value);
+    }
+
+    // Single writer, several writers must be serialized by the caller
+    void Store(const T& value)
+    {
+        uint64_t words[WordCount] = {};
+        memcpy(words, &value, sizeof(T));
+
+        const uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WordCount; ++i)
+        {
+            mWords[i].store(words[i], std::memory_order_relaxed);
+        }
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Never blocks the writer, spins while a store is in progress
+    T Load() const
+    {
+        uint64_t words[WordCount];
+        Backoff backoff;
+        for (;;)
+        {
+            const uint32_t before = mSequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0)
+            {
+                for (size_t i = 0; i < WordCount; ++i)
+                {
+                    words[i] = mWords[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (mSequence.load(std::memory_order_relaxed) == before)
+                {
+                    break;
+                }
+            }
+            backoff.Pause();
+        }
+
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+  private:
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> mSequence{0};
+    std::atomic<uint64_t> mWords[WordCount] = {};
+};
+} // namespace Engine::Core
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Engine::Core
+{
+// Vector that keeps its first InlineCount elements inside the object and only allocates once it
+// grows past them. Meant for short lists built on the stack, such as walks up a hierarchy. Any
+// growth invalidates pointers into it, like std::vector.
+template <class T, size_t InlineCount> class SmallVector final
+{
+    static_assert(InlineCount > 0, "SmallVector: InlineCount must be at least 1");
+
+  public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<T*>;
+    using const_reverse_iterator = std::reverse_iterator<const T*>;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values)
+    {
+        reserve(values.size());
+        std::uninitialized_copy(values.begin(), values.end(), mData);
+        mSize = values.size();
+    }
+
+    SmallVector(const SmallVector& rhs)
+    {
+        reserve(rhs.mSize);
+        std::uninitialized_copy(rhs.begin(), rhs.end(), mData);
+        mSize = rhs.mSize;
+    }
+
+    SmallVector(SmallVector&& rhs) noexcept
+    {
+        MoveFrom(rhs);
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        FreeHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            reserve(rhs.mSize);
+            std::uninitialized_copy(rhs.begin(), rhs.end(), mData);
+            mSize = rhs.mSize;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            clear();
+            FreeHeap();
+            MoveFrom(rhs);
+        }
+        return *this;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args> T& emplace_back(Args&&... args)
+    {
+        if (mSize == mCapacity)
+        {
+            // Build the element first, args may refer into the old storage
+            T value(std::forward<Args>(args)...);
+            Grow(mCapacity * 2);
+            return *new (mData + mSize++) T(std::move(value));
+        }
+        return *new (mData + mSize++) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        mData[--mSize].~T();
+    }
+
+    void clear()
+    {
+        std::destroy(mData, mData + mSize);
+        mSize = 0;
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > mCapacity)
+        {
+            Grow(capacity);
+        }
+    }
+
+    void resize(size_t size)
+    {
+        if (size < mSize)
+        {
+            std::destroy(mData + size, mData + mSize);
+        }
+        else
+        {
+            reserve(size);
+            std::uninitialized_value_construct(mData + mSize, mData + size);
+        }
+        mSize = size;
+    }
+
+    T& operator[](size_t index)
+    {
+        return mData[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return mData[index];
+    }
+
+    T& front()
+    {
+        return mData[0];
+    }
+
+    T& back()
+    {
+        return mData[mSize - 1];
+    }
+
+    const T& back() const
+    {
+        return mData[mSize - 1];
+    }
+
+    T* data()
+    {
+        return mData;
+    }
+
+    const T* data() const
+    {
+        return mData;
+    }
+
+    iterator begin()
+    {
+        return mData;
+    }
+
+    iterator end()
+    {
+        return mData + mSize;
+    }
+
+    const_iterator begin() const
+    {
+        return mData;
+    }
+
+    const_iterator end() const
+    {
+        return mData + mSize;
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    bool empty() const
+    {
+        return mSize == 0;
+    }
+
+    // True while the elements still fit in the inline storage
+    bool IsInline() const
+    {
+        return mData == GetInline();
+    }
+
+  private:
+    T* GetInline()
+    {
+        return std::launder(reinterpret_cast<T*>(mInline));
+    }
+
+    const T* GetInline() const
+    {
+        return std::launder(reinterpret_cast<const T*>(mInline));
+    }
+
+    void Grow(size_t capacity)
+    {
+        void* memory = ::operator new(capacity * sizeof(T), std::align_val_t(alignof(T)));
+        T* data = static_cast<T*>(memory);
+        std::uninitialized_move(mData, mData + mSize, data);
+        std::destroy(mData, mData + mSize);
+        FreeHeap();
+        mData = data;
+        mCapacity = capacity;
+    }
+
+    void FreeHeap()
+    {
+        if (!IsInline())
+        {
+            ::operator delete(mData, std::align_val_t(alignof(T)));
+            mData = GetInline();
+            mCapacity = InlineCount;
+        }
+    }
+
+    // Expects this to be empty and inline
+    void MoveFrom(SmallVector& rhs)
+    {
+        if (rhs.IsInline())
+        {
+            std::uninitialized_move(rhs.begin(), rhs.end(), mData);
+            mSize = rhs.mSize;
+            rhs.clear();
+        }
+        else
+        {
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mCapacity = rhs.mCapacity;
+            rhs.mData = rhs.GetInline();
+            rhs.mSize = 0;
+            rhs.mCapacity = InlineCount;
+        }
+    }
+
+    alignas(T) unsigned char mInline[sizeof(T) * InlineCount];
+    T* mData = GetInline();
+    size_t mSize = 0;
+    size_t mCapacity = InlineCount;
+};
+} // namespace Engine::Core
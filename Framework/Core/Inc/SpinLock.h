@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Backoff.h"
+
+namespace Engine::Core
+{
+// Test and test-and-set lock for short critical sections. Waiters spin on a plain load, so the
+// cache line is only written when the lock looks free, and back off exponentially. The lower
+// case methods let it be used with std::lock_guard and std::unique_lock.
+class SpinLock final
+{
+  public:
+    void Lock()
+    {
+        Backoff backoff;
+        while (mLocked.exchange(true, std::memory_order_acquire))
+        {
+            while (mLocked.load(std::memory_order_relaxed))
+            {
+                backoff.Pause();
+            }
+        }
+    }
+
+    bool TryLock()
+    {
+        return !mLocked.load(std::memory_order_relaxed) &&
+               !mLocked.exchange(true, std::memory_order_acquire);
+    }
+
+    void Unlock()
+    {
+        mLocked.store(false, std::memory_order_release);
+    }
+
+    void lock()
+    {
+        Lock();
+    }
+
+    bool try_lock()
+    {
+        return TryLock();
+    }
+
+    void unlock()
+    {
+        Unlock();
+    }
+
+  private:
+    std::atomic<bool> mLocked{false};
+};
+} // namespace Engine::Core
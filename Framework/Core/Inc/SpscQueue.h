@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Backoff.h"
+
+namespace Engine::Core
+{
+// Bounded lock free ring for exactly one producer thread and one consumer thread. Each side owns
+// one index on its own cache line and caches the other side's index, so it only reads the shared
+// line when the queue looks full or empty.
+template <class T> class SpscQueue final
+{
+  public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        mSlots = std::make_unique<T[]>(size);
+        mMask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Returns false, leaving value untouched, when the queue is full.
+    template <class U> bool TryPush(U&& value)
+    {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mCachedHead > mMask)
+        {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+            if (tail - mCachedHead > mMask)
+            {
+                return false;
+            }
+        }
+        mSlots[tail & mMask] = std::forward<U>(value);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Returns false when the queue is empty.
+    bool TryPop(T& value)
+    {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mCachedTail)
+        {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+            if (head == mCachedTail)
+            {
+                return false;
+            }
+        }
+        value = std::move(mSlots[head & mMask]);
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t GetCapacity() const
+    {
+        return mMask + 1;
+    }
+
+  private:
+    std::unique_ptr<T[]> mSlots;
+    size_t mMask = 0;
+
+    alignas(CacheLineSize) std::atomic<size_t> mHead{0}; // Next slot to pop
+    size_t mCachedTail = 0;                              // Consumer's last look at mTail
+
+    alignas(CacheLineSize) std::atomic<size_t> mTail{0}; // Next slot to push
+    size_t mCachedHead = 0;                              // Producer's last look at mHead
+};
+} // namespace Engine::Core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "LinearAllocator.h"
+#include "PoolAllocator.h"
+
+namespace Engine::Core
+{
+// Standard library allocator that takes memory from a linear allocator, deallocate does nothing.
+// Containers must not outlive the arena's next Reset, and growth leaves the old buffer behind
+// until then, so reserve up front.
+template <class T> class ArenaStlAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ArenaStlAllocator(LinearAllocator& arena) noexcept
+        : mArena(&arena)
+    {
+    }
+
+    template <class U>
+    ArenaStlAllocator(const ArenaStlAllocator<U>& other) noexcept
+        : mArena(other.GetArena())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return mArena->Allocate<T>(count);
+    }
+
+    void deallocate(T*, size_t) noexcept
+    {
+    }
+
+    LinearAllocator* GetArena() const noexcept
+    {
+        return mArena;
+    }
+
+    template <class U> bool operator==(const ArenaStlAllocator<U>& other) const noexcept
+    {
+        return mArena == other.GetArena();
+    }
+
+    template <class U> bool operator!=(const ArenaStlAllocator<U>& other) const noexcept
+    {
+        return mArena != other.GetArena();
+    }
+
+  private:
+    LinearAllocator* mArena;
+};
+
+// Standard library allocator for node based containers. Single objects that fit come from the
+// pool, arrays and anything else go to the heap.
+template <class T> class PoolStlAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit PoolStlAllocator(PoolAllocator& pool) noexcept
+        : mPool(&pool)
+    {
+    }
+
+    template <class U>
+    PoolStlAllocator(const PoolStlAllocator<U>& other) noexcept
+        : mPool(other.GetPool())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        const bool fits = count == 1 && sizeof(T) <= mPool->GetBlockSize() &&
+                          alignof(T) <= mPool->GetAlignment();
+        void* memory = fits ? mPool->Allocate() : nullptr;
+        return static_cast<T*>((memory != nullptr) ? memory : ::operator new(sizeof(T) * count));
+    }
+
+    void deallocate(T* memory, size_t) noexcept
+    {
+        if (mPool->Owns(memory))
+        {
+            mPool->Free(memory);
+        }
+        else
+        {
+            ::operator delete(memory);
+        }
+    }
+
+    PoolAllocator* GetPool() const noexcept
+    {
+        return mPool;
+    }
+
+    template <class U> bool operator==(const PoolStlAllocator<U>& other) const noexcept
+    {
+        return mPool == other.GetPool();
+    }
+
+    template <class U> bool operator!=(const PoolStlAllocator<U>& other) const noexcept
+    {
+        return mPool != other.GetPool();
+    }
+
+  private:
+    PoolAllocator* mPool;
+};
+
+template <class T> using ArenaVector = std::vector<T, ArenaStlAllocator<T>>;
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaStlAllocator<char>>;
+} // namespace Engine::Core
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Hash.h"
+
+namespace Engine::Core
+{
+// Stable id of an interned string, its Hash64. Equal strings get equal ids in every run, so ids
+// can be stored in files and caches.
+using StringId = uint64_t;
+
+// Process wide table of interned strings. Every string is stored once and its pointer stays valid
+// for the life of the program. Debug builds check every intern against the stored string and
+// assert on a hash collision. Safe to use from any thread.
+namespace StringTable
+{
+StringId Intern(std::string_view text);
+
+// Interns the normalized form of the path, the id equals HashPath(path)
+StringId InternPath(const std::filesystem::path& path);
+
+// Nullptr if nothing was interned under the id
+const char* GetString(StringId id);
+
+size_t GetCount();
+} // namespace StringTable
+} // namespace Engine::Core
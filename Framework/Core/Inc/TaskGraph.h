@@ -0,0 +1,83 @@
+#pragma once
+
+#include "JobSystem.h"
+
+namespace Engine::Core
+{
+// Index of a task in its graph
+using TaskId = uint32_t;
+
+enum class TaskThread : uint8_t
+{
+    Any,  // Runs on a JobSystem worker
+    Main, // Runs on the thread calling Run, e.g. window and device creation
+};
+
+// Work split into named tasks with dependencies, run as soon as their dependencies are done. Main
+// tasks run on the calling thread in the order they become ready, everything else on the
+// JobSystem workers, so loading and compiling overlaps the work that must stay on one thread.
+// Every task is timed, LogTimeline prints where the time went.
+class TaskGraph final
+{
+  public:
+    using Task = std::function<void()>;
+
+    struct TaskTiming
+    {
+        const char* name = nullptr;
+        float startMs = 0.0f; // From the start of Run
+        float endMs = 0.0f;
+        bool isMainThread = false;
+    };
+
+    TaskGraph() = default;
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // Dependencies must be added first, so a graph cannot have cycles. An empty task only joins
+    // its dependencies. The name is not copied, it must outlive the graph.
+    TaskId Add(const char* name,
+               Task task,
+               std::initializer_list<TaskId> dependencies = {},
+               TaskThread thread = TaskThread::Any);
+
+    // Blocks until every task ran. Must not be called from a job.
+    void Run();
+
+    // Timings of the last Run, in the order the tasks were added
+    const std::vector<TaskTiming>& GetTimings() const;
+    float GetTotalMs() const;
+
+    // One line per task sorted by start, then the total, the summed task time and the chain of
+    // tasks that decided the total
+    void LogTimeline(const char* title) const;
+
+  private:
+    struct Node
+    {
+        const char* name = nullptr;
+        Task task;
+        std::vector<TaskId> dependencies;
+        std::vector<TaskId> dependents;
+        TaskThread thread = TaskThread::Any;
+    };
+
+    void Schedule(TaskId id);
+    void Execute(TaskId id);
+    float GetElapsedMs() const;
+
+    std::vector<Node> mNodes;
+    std::vector<TaskTiming> mTimings;
+    std::unique_ptr<std::atomic<uint32_t>[]> mRemaining; // Dependencies left per task
+
+    std::deque<TaskId> mMainQueue;
+    std::mutex mMutex;
+    std::condition_variable mMainCondition;
+    JobCounter mCounter;
+
+    std::thread::id mMainThreadId;
+    std::chrono::steady_clock::time_point mStartTime;
+    float mTotalMs = 0.0f;
+};
+} // namespace Engine::Core
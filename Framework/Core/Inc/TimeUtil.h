@@ -5,4 +5,17 @@ namespace Engine::Core::TimeUtil
 float GetTime();
 
 float GetDeltaTime();
+
+// Spread of a run's frame times, for the replay and flythrough reports
+struct FrameTimeSummary
+{
+    uint32_t count = 0;
+    float min = 0.0f;
+    float mean = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+FrameTimeSummary Summarize(std::vector<float> milliseconds);
 } // namespace Engine::Core::TimeUtil
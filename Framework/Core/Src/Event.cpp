@@ -0,0 +1,85 @@
+#include "Precompiled.h"
+#include "Event.h"
+
+#include "Backoff.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+Event::Event(Mode mode, bool signaled)
+    : mSignaled(signaled),
+      mMode(mode)
+{
+}
+
+void Event::Signal()
+{
+    // Both sides use sequentially consistent operations: either the waiter sees the flag before
+    // sleeping, or this sees the waiter and notifies under the mutex it sleeps with
+    mSignaled.store(true);
+    if (mWaiterCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mMode == Mode::AutoReset)
+        {
+            mCondition.notify_one();
+        }
+        else
+        {
+            mCondition.notify_all();
+        }
+    }
+}
+
+void Event::Reset()
+{
+    mSignaled.store(false);
+}
+
+void Event::Wait()
+{
+    Backoff backoff;
+    while (!backoff.IsYielding())
+    {
+        if (TryWait())
+        {
+            return;
+        }
+        backoff.Pause();
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWaiterCount.fetch_add(1);
+    mCondition.wait(lock, [this]() { return TryWait(); });
+    mWaiterCount.fetch_sub(1);
+}
+
+bool Event::WaitFor(std::chrono::milliseconds timeout)
+{
+    if (TryWait())
+    {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWaiterCount.fetch_add(1);
+    const bool signaled = mCondition.wait_for(lock, timeout, [this]() { return TryWait(); });
+    mWaiterCount.fetch_sub(1);
+    return signaled;
+}
+
+bool Event::TryWait()
+{
+    if (mMode == Mode::ManualReset)
+    {
+        return mSignaled.load();
+    }
+
+    bool expected = true;
+    return mSignaled.compare_exchange_strong(expected, false);
+}
+
+bool Event::IsSignaled() const
+{
+    return mSignaled.load();
+}
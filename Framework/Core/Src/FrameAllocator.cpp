@@ -0,0 +1,95 @@
+#include "Precompiled.h"
+#include "FrameAllocator.h"
+
+#include "DebugUtil.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+std::unique_ptr<LinearAllocator> sFrameAllocator;
+AllocatorStats sLastFrameStats;
+MemoryAllocationId sFrameMemoryId = InvalidHandle;
+
+const PerfCounter sFrameBytes("Memory.FrameArenaBytes", PerfCounterType::Gauge);
+const PerfCounter sFrameOverflowBytes("Memory.FrameArenaOverflowBytes", PerfCounterType::Gauge);
+
+// Frees its stack when the thread exits
+struct ScratchStack
+{
+    ScratchStack()
+    {
+        allocator.Initialize(ScratchScope::StackCapacity);
+    }
+
+    ~ScratchStack()
+    {
+        allocator.Terminate();
+    }
+
+    LinearAllocator allocator;
+};
+
+LinearAllocator& GetScratchStack()
+{
+    thread_local ScratchStack stack;
+    return stack.allocator;
+}
+} // namespace
+
+void FrameAllocator::StaticInitialize(size_t capacity)
+{
+    ASSERT(sFrameAllocator == nullptr, "FrameAllocator: already initialized");
+    sFrameAllocator = std::make_unique<LinearAllocator>();
+    sFrameAllocator->Initialize(capacity);
+    sLastFrameStats = {};
+    sFrameMemoryId = MemoryTracker::Track(MemoryTag::Allocators, capacity, "Frame arena");
+}
+
+void FrameAllocator::StaticTerminate()
+{
+    if (sFrameAllocator != nullptr)
+    {
+        sFrameAllocator->Terminate();
+        sFrameAllocator.reset();
+        MemoryTracker::Untrack(std::exchange(sFrameMemoryId, InvalidHandle));
+    }
+}
+
+LinearAllocator* FrameAllocator::Get()
+{
+    ASSERT(sFrameAllocator != nullptr, "FrameAllocator: not initialized");
+    return sFrameAllocator.get();
+}
+
+void FrameAllocator::BeginFrame()
+{
+    sLastFrameStats = sFrameAllocator->GetStats();
+    sFrameAllocator->Reset();
+    sFrameBytes.Set(sLastFrameStats.allocatedBytes);
+    sFrameOverflowBytes.Set(sLastFrameStats.overflowBytes);
+}
+
+const AllocatorStats& FrameAllocator::GetLastFrameStats()
+{
+    return sLastFrameStats;
+}
+
+ScratchScope::ScratchScope()
+    : mAllocator(GetScratchStack()),
+      mMarker(mAllocator.GetMarker())
+{
+}
+
+ScratchScope::~ScratchScope()
+{
+    mAllocator.FreeToMarker(mMarker);
+}
+
+LinearAllocator& ScratchScope::GetAllocator()
+{
+    return mAllocator;
+}
@@ -0,0 +1,170 @@
+#include "Precompiled.h"
+#include "Hash.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+// Every supported target is little endian, which is the byte order XXH64 is defined in
+uint64_t Read64(const uint8_t* bytes)
+{
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const uint8_t* bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input)
+{
+    accumulator += input * Prime2;
+    accumulator = RotateLeft(accumulator, 31);
+    return accumulator * Prime1;
+}
+
+uint64_t MergeRound(uint64_t hash, uint64_t accumulator)
+{
+    hash ^= Round(0, accumulator);
+    return hash * Prime1 + Prime4;
+}
+} // namespace
+
+uint64_t Core::Hash64(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = bytes + size;
+
+    uint64_t hash = 0;
+    if (size >= 32)
+    {
+        // Four independent lanes, so the multiplies of one stripe run in parallel
+        uint64_t v1 = seed + Prime1 + Prime2;
+        uint64_t v2 = seed + Prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - Prime1;
+        const uint8_t* const limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(bytes));
+            v2 = Round(v2, Read64(bytes + 8));
+            v3 = Round(v3, Read64(bytes + 16));
+            v4 = Round(v4, Read64(bytes + 24));
+            bytes += 32;
+        } while (bytes <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + Prime5;
+    }
+    hash += static_cast<uint64_t>(size);
+
+    while (bytes + 8 <= end)
+    {
+        hash ^= Round(0, Read64(bytes));
+        hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+        bytes += 8;
+    }
+    if (bytes + 4 <= end)
+    {
+        hash ^= static_cast<uint64_t>(Read32(bytes)) * Prime1;
+        hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+        bytes += 4;
+    }
+    while (bytes < end)
+    {
+        hash ^= static_cast<uint64_t>(*bytes) * Prime5;
+        hash = RotateLeft(hash, 11) * Prime1;
+        ++bytes;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::string Core::NormalizePath(const std::filesystem::path& path)
+{
+    // One pass instead of lexically_normal, which is several times slower. Backslashes are
+    // separators on every platform so paths written on Windows hash the same everywhere.
+    const std::string text = path.u8string();
+    std::string normalized;
+    normalized.reserve(text.size());
+
+    const bool isAbsolute = !text.empty() && (text[0] == '/' || text[0] == '\\');
+    if (isAbsolute)
+    {
+        normalized.push_back('/');
+    }
+    size_t fixedLength = normalized.size(); // Root and leading ".." that can not be popped
+
+    size_t begin = 0;
+    while (begin <= text.size())
+    {
+        size_t end = text.find_first_of("/\\", begin);
+        if (end == std::string::npos)
+        {
+            end = text.size();
+        }
+        const std::string_view part(text.data() + begin, end - begin);
+        begin = end + 1;
+
+        if (part.empty() || part == ".")
+        {
+            continue;
+        }
+        if (part == "..")
+        {
+            if (normalized.size() > fixedLength)
+            {
+                const size_t slash = normalized.rfind('/');
+                const bool isFirst = (slash == std::string::npos || slash < fixedLength);
+                normalized.resize(isFirst ? fixedLength : slash);
+                continue;
+            }
+            if (isAbsolute)
+            {
+                continue; // ".." of the root is the root
+            }
+        }
+
+        if (!normalized.empty() && normalized.back() != '/')
+        {
+            normalized.push_back('/');
+        }
+        for (char c : part)
+        {
+            normalized.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+        }
+        if (part == "..")
+        {
+            fixedLength = normalized.size();
+        }
+    }
+    return normalized;
+}
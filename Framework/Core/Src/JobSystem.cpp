@@ -0,0 +1,176 @@
+#include "Precompiled.h"
+#include "JobSystem.h"
+
+#include "DebugUtil.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+std::unique_ptr<JobSystem> sJobSystem;
+}
+
+void JobSystem::StaticInitialize(uint32_t threadCount)
+{
+    ASSERT(sJobSystem == nullptr, "JobSystem: already initialized");
+    sJobSystem = std::make_unique<JobSystem>();
+    sJobSystem->Initialize(threadCount);
+}
+
+void JobSystem::StaticTerminate()
+{
+    if (sJobSystem != nullptr)
+    {
+        sJobSystem->Terminate();
+        sJobSystem.reset();
+    }
+}
+
+JobSystem* JobSystem::Get()
+{
+    ASSERT(sJobSystem != nullptr, "JobSystem: not initialized");
+    return sJobSystem.get();
+}
+
+JobSystem::~JobSystem()
+{
+    ASSERT(mWorkers.empty(), "JobSystem: terminate must be called before destruction");
+}
+
+void JobSystem::Initialize(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+    }
+
+    mRunning = true;
+    mWorkers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        mWorkers.emplace_back(&JobSystem::WorkerMain, this);
+    }
+}
+
+void JobSystem::Terminate()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+    }
+    mWakeCondition.notify_all();
+
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+    mWorkers.clear();
+    mQueue.clear();
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueue.push_back({std::move(job), counter});
+    }
+    mWakeCondition.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    // Help out instead of blocking, this also makes waiting from inside a job safe
+    while (counter.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (!TryRunOne())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const RangeJob& job)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Enough chunks to keep every thread busy, without going below the grain size
+    const uint32_t threadCount = static_cast<uint32_t>(mWorkers.size()) + 1;
+    const uint32_t minChunk = std::max(grainSize, 1u);
+    const uint32_t chunkCount = threadCount * 4;
+    const uint32_t chunkSize = std::max(minChunk, (count + chunkCount - 1) / chunkCount);
+    if (chunkSize >= count)
+    {
+        job(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = chunkSize; begin < count; begin += chunkSize)
+    {
+        const uint32_t end = std::min(begin + chunkSize, count);
+        Submit([&job, begin, end]() { job(begin, end); }, &counter);
+    }
+
+    // The calling thread takes the first chunk itself
+    job(0, chunkSize);
+    Wait(counter);
+}
+
+uint32_t JobSystem::GetWorkerCount() const
+{
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+void JobSystem::WorkerMain()
+{
+    while (true)
+    {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeCondition.wait(lock, [this]() { return !mRunning || !mQueue.empty(); });
+            if (!mRunning && mQueue.empty())
+            {
+                return;
+            }
+            entry = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+        Run(entry);
+    }
+}
+
+bool JobSystem::TryRunOne()
+{
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mQueue.empty())
+        {
+            return false;
+        }
+        entry = std::move(mQueue.front());
+        mQueue.pop_front();
+    }
+    Run(entry);
+    return true;
+}
+
+void JobSystem::Run(Entry& entry)
+{
+    entry.job();
+    if (entry.counter != nullptr)
+    {
+        entry.counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
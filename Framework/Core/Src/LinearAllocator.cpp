@@ -0,0 +1,156 @@
+#include "Precompiled.h"
+#include "LinearAllocator.h"
+
+#include "DebugUtil.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+#if defined(_DEBUG)
+constexpr uint8_t AllocatedPattern = 0xCD;
+constexpr uint8_t FreedPattern = 0xDD;
+constexpr uint8_t GuardPattern = 0xFD;
+constexpr size_t GuardSize = 8;
+#else
+constexpr size_t GuardSize = 0;
+#endif
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+LinearAllocator::~LinearAllocator()
+{
+    ASSERT(mBuffer == nullptr, "LinearAllocator: terminate must be called before destruction");
+}
+
+void LinearAllocator::Initialize(size_t capacity)
+{
+    ASSERT(mBuffer == nullptr, "LinearAllocator: already initialized");
+    mCapacity = capacity;
+    mBuffer = static_cast<uint8_t*>(
+        ::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+#if defined(_DEBUG)
+    memset(mBuffer, FreedPattern, capacity);
+#endif
+    mOffset = 0;
+    mPeakOffset = 0;
+    mStats = {};
+}
+
+void LinearAllocator::Terminate()
+{
+    Reset();
+    if (mBuffer != nullptr)
+    {
+        ::operator delete(mBuffer, std::align_val_t(alignof(std::max_align_t)));
+        mBuffer = nullptr;
+    }
+    mCapacity = 0;
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment)
+{
+    ASSERT((alignment & (alignment - 1)) == 0, "LinearAllocator: alignment must be a power of 2");
+    ++mStats.allocationCount;
+    mStats.allocatedBytes += size;
+
+    // The address is aligned, the buffer itself is only max_align_t aligned
+    const uintptr_t base = reinterpret_cast<uintptr_t>(mBuffer);
+    const size_t offset =
+        AlignUp(base + mOffset, std::max(alignment, alignof(std::max_align_t))) - base;
+    if (offset + size + GuardSize <= mCapacity)
+    {
+        uint8_t* memory = mBuffer + offset;
+        mOffset = offset + size + GuardSize;
+        mPeakOffset = std::max(mPeakOffset, mOffset);
+#if defined(_DEBUG)
+        memset(memory, AllocatedPattern, size);
+        memset(memory + size, GuardPattern, GuardSize);
+        mGuards.push_back(offset + size);
+#endif
+        return memory;
+    }
+
+    mStats.overflowBytes += size;
+    void* memory = ::operator new(size, std::align_val_t(alignment));
+#if defined(_DEBUG)
+    memset(memory, AllocatedPattern, size);
+#endif
+    mOverflow.push_back({memory, alignment});
+    return memory;
+}
+
+LinearAllocator::Marker LinearAllocator::GetMarker() const
+{
+    Marker marker;
+    marker.offset = mOffset;
+    marker.overflowCount = mOverflow.size();
+#if defined(_DEBUG)
+    marker.guardCount = mGuards.size();
+#endif
+    return marker;
+}
+
+void LinearAllocator::FreeToMarker(const Marker& marker)
+{
+    ASSERT(marker.offset <= mOffset && marker.overflowCount <= mOverflow.size(),
+           "LinearAllocator: marker is newer than the allocator state");
+#if defined(_DEBUG)
+    CheckGuards(marker.guardCount);
+    mGuards.resize(marker.guardCount);
+    memset(mBuffer + marker.offset, FreedPattern, mOffset - marker.offset);
+#endif
+    for (size_t i = marker.overflowCount; i < mOverflow.size(); ++i)
+    {
+        ::operator delete(mOverflow[i].memory, std::align_val_t(mOverflow[i].alignment));
+    }
+    mOverflow.resize(marker.overflowCount);
+    mOffset = marker.offset;
+}
+
+void LinearAllocator::Reset()
+{
+    FreeToMarker({});
+    mStats = {};
+}
+
+size_t LinearAllocator::GetCapacity() const
+{
+    return mCapacity;
+}
+
+size_t LinearAllocator::GetUsed() const
+{
+    return mOffset;
+}
+
+size_t LinearAllocator::GetPeakUsed() const
+{
+    return mPeakOffset;
+}
+
+const AllocatorStats& LinearAllocator::GetStats() const
+{
+    return mStats;
+}
+
+void LinearAllocator::CheckGuards([[maybe_unused]] size_t firstGuard) const
+{
+#if defined(_DEBUG)
+    for (size_t g = firstGuard; g < mGuards.size(); ++g)
+    {
+        const uint8_t* guard = mBuffer + mGuards[g];
+        for (size_t i = 0; i < GuardSize; ++i)
+        {
+            ASSERT(guard[i] == GuardPattern,
+                   "LinearAllocator: write past the end of allocation %zu",
+                   g);
+        }
+    }
+#endif
+}
@@ -0,0 +1,274 @@
+#include "Precompiled.h"
+#include "Logger.h"
+
+#include "Backoff.h"
+#include "Event.h"
+#include "SpscQueue.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr size_t RingCapacity = 512; // Records per thread
+constexpr std::chrono::milliseconds FlushInterval(5);
+constexpr size_t MessageSize = 1024;
+
+struct ThreadRing
+{
+    SpscQueue<LogRecord> records{RingCapacity};
+    uint32_t generation = 0;
+};
+
+struct LoggerState
+{
+    std::thread thread;
+    Event wake;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> flushRequests{0};
+    std::atomic<uint64_t> flushedRequests{0};
+
+    // Rings of threads that have exited are dropped once empty, only the list holds them then
+    std::mutex ringMutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+
+    FILE* file = nullptr;
+    std::vector<LogRecord> batch; // Logger thread only
+    uint32_t generation = 0;
+};
+
+std::unique_ptr<LoggerState> sState;
+uint32_t sGeneration = 0;
+std::atomic<bool> sConsoleEnabled{true};
+std::mutex sDirectMutex; // Serializes writes made without the logger thread
+thread_local std::shared_ptr<ThreadRing> tRing;
+
+const char* const sCategoryNames[] = {"", "Core", "Graphics", "Animation", "Input", "Engine"};
+static_assert(std::size(sCategoryNames) == static_cast<size_t>(LogCategory::Count));
+
+void WriteRecord(const LogRecord& record, FILE* file)
+{
+    char message[MessageSize];
+    std::string* formatted = nullptr;
+    const char* text = message;
+    if (record.formatFn != nullptr)
+    {
+        record.formatFn(record, message, std::size(message));
+    }
+    else
+    {
+        memcpy(&formatted, record.payload, sizeof(formatted));
+        text = formatted->c_str();
+    }
+
+    char prefix[64];
+    const char* categoryName = sCategoryNames[static_cast<size_t>(record.category)];
+    const char* levelName = (record.level == LogLevel::Error)     ? "Error: "
+                            : (record.level == LogLevel::Warning) ? "Warning: "
+                                                                  : "";
+    snprintf(prefix,
+             std::size(prefix),
+             "{%.3f}: %s%s%s%s",
+             record.time,
+             (categoryName[0] != '\0') ? "[" : "",
+             categoryName,
+             (categoryName[0] != '\0') ? "] " : "",
+             levelName);
+
+    if (sConsoleEnabled.load(std::memory_order_relaxed))
+    {
+        fprintf(stdout, "%s%s\n", prefix, text);
+    }
+    if (file != nullptr)
+    {
+        fprintf(file, "%s%s\n", prefix, text);
+    }
+    delete formatted;
+}
+
+ThreadRing& GetThreadRing(LoggerState& state)
+{
+    if (tRing == nullptr || tRing->generation != state.generation)
+    {
+        tRing = std::make_shared<ThreadRing>();
+        tRing->generation = state.generation;
+        std::lock_guard<std::mutex> lock(state.ringMutex);
+        state.rings.push_back(tRing);
+    }
+    return *tRing;
+}
+
+void Drain(LoggerState& state)
+{
+    {
+        std::lock_guard<std::mutex> lock(state.ringMutex);
+        for (size_t i = 0; i < state.rings.size();)
+        {
+            const size_t first = state.batch.size();
+            LogRecord record;
+            while (state.rings[i]->records.TryPop(record))
+            {
+                state.batch.push_back(record);
+            }
+
+            if (state.batch.size() == first && state.rings[i].use_count() == 1)
+            {
+                state.rings[i] = std::move(state.rings.back());
+                state.rings.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    // Each ring is in order already, a stable sort merges them without reordering a thread
+    std::stable_sort(state.batch.begin(),
+                     state.batch.end(),
+                     [](const LogRecord& a, const LogRecord& b) { return a.time < b.time; });
+    for (const LogRecord& record : state.batch)
+    {
+        WriteRecord(record, state.file);
+    }
+    if (!state.batch.empty())
+    {
+        fflush(stdout);
+        if (state.file != nullptr)
+        {
+            fflush(state.file);
+        }
+    }
+    state.batch.clear();
+}
+
+void Run(LoggerState& state)
+{
+    for (;;)
+    {
+        const bool running = state.running.load();
+        const uint64_t flushRequests = state.flushRequests.load();
+        Drain(state);
+        state.flushedRequests.store(flushRequests);
+        if (!running)
+        {
+            break;
+        }
+        state.wake.WaitFor(FlushInterval);
+    }
+}
+} // namespace
+
+#if defined(_DEBUG)
+std::atomic<uint8_t> Logger::Detail::sMinLevel{static_cast<uint8_t>(LogLevel::Info)};
+#else
+std::atomic<uint8_t> Logger::Detail::sMinLevel{static_cast<uint8_t>(LogLevel::Warning)};
+#endif
+std::atomic<uint32_t> Logger::Detail::sCategoryMask{UINT32_MAX};
+
+void Logger::StaticInitialize(const std::filesystem::path& logFile)
+{
+    if (sState != nullptr)
+    {
+        return;
+    }
+
+    sState = std::make_unique<LoggerState>();
+    sState->generation = ++sGeneration;
+    if (!logFile.empty())
+    {
+        sState->file = fopen(logFile.u8string().c_str(), "w");
+    }
+    sState->thread = std::thread(Run, std::ref(*sState));
+}
+
+void Logger::StaticTerminate()
+{
+    if (sState == nullptr)
+    {
+        return;
+    }
+
+    sState->running.store(false);
+    sState->wake.Signal();
+    sState->thread.join();
+    if (sState->file != nullptr)
+    {
+        fclose(sState->file);
+    }
+    sState.reset();
+}
+
+void Logger::Flush()
+{
+    LoggerState* state = sState.get();
+    if (state == nullptr)
+    {
+        return;
+    }
+
+    const uint64_t request = state->flushRequests.fetch_add(1) + 1;
+    state->wake.Signal();
+    Backoff backoff;
+    while (state->flushedRequests.load() < request)
+    {
+        backoff.Pause();
+    }
+}
+
+void Logger::SetMinLevel(LogLevel level)
+{
+    Detail::sMinLevel.store(static_cast<uint8_t>(level));
+}
+
+void Logger::SetCategoryEnabled(LogCategory category, bool enabled)
+{
+    const uint32_t bit = 1u << static_cast<uint32_t>(category);
+    if (enabled)
+    {
+        Detail::sCategoryMask.fetch_or(bit);
+    }
+    else
+    {
+        Detail::sCategoryMask.fetch_and(~bit);
+    }
+}
+
+void Logger::SetConsoleEnabled(bool enabled)
+{
+    sConsoleEnabled.store(enabled);
+}
+
+void Logger::Detail::Submit(const LogRecord& record)
+{
+    LoggerState* state = sState.get();
+    if (state == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(sDirectMutex);
+        WriteRecord(record, nullptr);
+        return;
+    }
+
+    ThreadRing& ring = GetThreadRing(*state);
+    if (!ring.records.TryPush(record))
+    {
+        // Full ring: wake the logger thread and wait for room rather than lose the message
+        Backoff backoff;
+        do
+        {
+            state->wake.Signal();
+            backoff.Pause();
+        } while (!ring.records.TryPush(record));
+    }
+    if (record.level == LogLevel::Error)
+    {
+        state->wake.Signal();
+    }
+}
+
+void Logger::Detail::SubmitFormatted(LogRecord& record, std::string* text)
+{
+    record.formatFn = nullptr;
+    memcpy(record.payload, &text, sizeof(text));
+    Submit(record);
+}
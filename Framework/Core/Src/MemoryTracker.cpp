@@ -0,0 +1,208 @@
+#include "Precompiled.h"
+#include "MemoryTracker.h"
+
+#include "DebugUtil.h"
+#include "PerfCounters.h"
+#include "SpinLock.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+constexpr double MegaByte = 1024.0 * 1024.0;
+
+struct TagTotals
+{
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+    std::atomic<int64_t> budget{0};
+    std::atomic<bool> isOverBudget{false};
+};
+
+struct Records
+{
+    SpinLock lock;
+    HandlePool<MemoryAllocationInfo> allocations;
+};
+
+const char* const sTagNames[] = {
+    "General", "Allocators", "Models", "ECS", "Textures", "Buffers", "Render Targets"};
+static_assert(std::size(sTagNames) == TagCount);
+
+TagTotals sTotals[TagCount];
+std::atomic<int64_t> sCpuBytes{0};
+std::atomic<int64_t> sGpuBytes{0};
+
+const PerfCounter sCpuGauge("Memory.CpuTrackedBytes", PerfCounterType::Gauge);
+const PerfCounter sGpuGauge("Memory.GpuBytes", PerfCounterType::Gauge);
+
+Records& GetRecords()
+{
+    static Records sRecords;
+    return sRecords;
+}
+
+void UpdateTotals(MemoryTag tag, int64_t bytes)
+{
+    TagTotals& totals = sTotals[static_cast<size_t>(tag)];
+    const int64_t live = totals.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (MemoryTracker::IsGpuTag(tag))
+    {
+        sGpuGauge.Set(sGpuBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+    else
+    {
+        sCpuGauge.Set(sCpuBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+
+    int64_t peak = totals.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !totals.peakBytes.compare_exchange_weak(peak, live))
+    {
+    }
+
+    // Only the thread that flips the flag reports, so crossing the budget warns once
+    const int64_t budget = totals.budget.load(std::memory_order_relaxed);
+    const bool isOver = (budget > 0 && live > budget);
+    if (isOver && !totals.isOverBudget.load(std::memory_order_relaxed) &&
+        !totals.isOverBudget.exchange(true))
+    {
+        LOG_WARNING(Core,
+                    "Memory: %s over budget, %.2f of %.2f MB",
+                    sTagNames[static_cast<size_t>(tag)],
+                    live / MegaByte,
+                    budget / MegaByte);
+    }
+    else if (!isOver && totals.isOverBudget.load(std::memory_order_relaxed))
+    {
+        totals.isOverBudget.store(false, std::memory_order_relaxed);
+    }
+}
+} // namespace
+
+void MemoryTracker::AddBytes(MemoryTag tag, int64_t bytes)
+{
+    UpdateTotals(tag, bytes);
+}
+
+MemoryAllocationId MemoryTracker::Track(MemoryTag tag, size_t bytes, const char* name)
+{
+    MemoryAllocationInfo info;
+    info.name = (name != nullptr) ? name : "";
+    info.bytes = bytes;
+    info.tag = tag;
+
+    MemoryAllocationId id = InvalidHandle;
+    {
+        Records& records = GetRecords();
+        std::lock_guard<SpinLock> lock(records.lock);
+        id = records.allocations.Add(info);
+    }
+    UpdateTotals(tag, static_cast<int64_t>(bytes));
+    return id;
+}
+
+void MemoryTracker::Untrack(MemoryAllocationId id)
+{
+    if (id == InvalidHandle)
+    {
+        return;
+    }
+
+    MemoryAllocationInfo info;
+    {
+        Records& records = GetRecords();
+        std::lock_guard<SpinLock> lock(records.lock);
+        const MemoryAllocationInfo* stored = records.allocations.Get(id);
+        if (stored == nullptr)
+        {
+            ASSERT(false, "MemoryTracker: Allocation untracked twice");
+            return;
+        }
+        info = *stored;
+        records.allocations.Remove(id);
+    }
+    UpdateTotals(info.tag, -static_cast<int64_t>(info.bytes));
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes)
+{
+    sTotals[static_cast<size_t>(tag)].budget.store(static_cast<int64_t>(bytes));
+    UpdateTotals(tag, 0);
+}
+
+bool MemoryTracker::IsGpuTag(MemoryTag tag)
+{
+    return tag >= MemoryTag::Textures;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+    return sTagNames[static_cast<size_t>(tag)];
+}
+
+size_t MemoryTracker::GetLiveBytes(MemoryTag tag)
+{
+    return static_cast<size_t>(sTotals[static_cast<size_t>(tag)].liveBytes.load());
+}
+
+size_t MemoryTracker::GetPeakBytes(MemoryTag tag)
+{
+    return static_cast<size_t>(sTotals[static_cast<size_t>(tag)].peakBytes.load());
+}
+
+size_t MemoryTracker::GetBudget(MemoryTag tag)
+{
+    return static_cast<size_t>(sTotals[static_cast<size_t>(tag)].budget.load());
+}
+
+size_t MemoryTracker::GetCpuBytes()
+{
+    return static_cast<size_t>(sCpuBytes.load());
+}
+
+size_t MemoryTracker::GetGpuBytes()
+{
+    return static_cast<size_t>(sGpuBytes.load());
+}
+
+void MemoryTracker::GetAllocations(std::vector<MemoryAllocationInfo>& allocations)
+{
+    allocations.clear();
+    Records& records = GetRecords();
+    std::lock_guard<SpinLock> lock(records.lock);
+    allocations.reserve(records.allocations.GetCount());
+    records.allocations.ForEach([&](Handle, const MemoryAllocationInfo& info)
+                                { allocations.push_back(info); });
+}
+
+uint32_t MemoryTracker::ReportLeaks()
+{
+    std::vector<MemoryAllocationInfo> allocations;
+    GetAllocations(allocations);
+    if (allocations.empty())
+    {
+        return 0;
+    }
+
+    std::sort(allocations.begin(),
+              allocations.end(),
+              [](const MemoryAllocationInfo& a, const MemoryAllocationInfo& b)
+              { return (a.tag != b.tag) ? a.tag < b.tag : a.bytes > b.bytes; });
+
+    size_t totalBytes = 0;
+    for (const MemoryAllocationInfo& info : allocations)
+    {
+        totalBytes += info.bytes;
+    }
+    LOG_ERROR(Core,
+              "Memory: %zu allocations leaked, %.2f MB",
+              allocations.size(),
+              totalBytes / MegaByte);
+    for (const MemoryAllocationInfo& info : allocations)
+    {
+        LOG_ERROR(Core, "  [%s] %s, %zu bytes", GetTagName(info.tag), info.name, info.bytes);
+    }
+    return static_cast<uint32_t>(allocations.size());
+}
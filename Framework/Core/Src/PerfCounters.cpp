@@ -0,0 +1,396 @@
+#include "Precompiled.h"
+#include "PerfCounters.h"
+
+#include "DebugUtil.h"
+#include "SpinLock.h"
+#include "TimeUtil.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct IntervalStats
+{
+    int64_t total = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+    int64_t last = 0;
+    uint32_t frames = 0; // Counters registered mid interval have seen fewer frames
+};
+
+enum class ExportFormat
+{
+    Csv,
+    Json
+};
+
+// Everything the registry touches is constant initialized, counters at file scope of other
+// translation units can register before main
+SpinLock sRegisterLock;
+std::atomic<uint32_t> sCount{0};
+const char* sNames[PerfCounters::MaxCounters] = {};
+PerfCounterType sTypes[PerfCounters::MaxCounters] = {};
+
+// Main thread only
+int64_t sLastValues[PerfCounters::MaxCounters] = {};
+float sHistory[PerfCounters::MaxCounters][PerfCounters::HistoryLength] = {};
+float sFrameTimes[PerfCounters::HistoryLength] = {};
+uint32_t sHistoryOffset = 0;
+Clock::time_point sLastFrame;
+
+IntervalStats sStats[PerfCounters::MaxCounters] = {};
+uint32_t sFrameTimeBuckets[PerfCounters::FrameTimeBucketCount] = {};
+uint32_t sTimedFrames = 0;
+double sFrameTimeSum = 0.0;
+float sFrameTimeMax = 0.0f;
+Clock::time_point sIntervalStart;
+
+FILE* sFile = nullptr;
+ExportFormat sFormat = ExportFormat::Csv;
+float sExportInterval = 0.0f;
+
+uint32_t GetBucket(float frameTime)
+{
+    uint32_t bucket = 0;
+    while (bucket < PerfCounters::FrameTimeBucketCount - 1 &&
+           frameTime > PerfCounters::FrameTimeBucketEdges[bucket])
+    {
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Interpolates inside the bucket the percentile falls in, exact enough for a dashboard
+float GetFrameTimePercentile(float fraction)
+{
+    constexpr uint32_t LastBucket = PerfCounters::FrameTimeBucketCount - 1;
+    const float* edges = PerfCounters::FrameTimeBucketEdges;
+    const float target = fraction * sTimedFrames;
+    uint32_t cumulative = 0;
+    for (uint32_t bucket = 0; bucket <= LastBucket; ++bucket)
+    {
+        const uint32_t count = sFrameTimeBuckets[bucket];
+        if (count > 0 && cumulative + count >= target)
+        {
+            const float lower = (bucket == 0) ? 0.0f : edges[bucket - 1];
+            const float upper =
+                (bucket < LastBucket) ? std::min(edges[bucket], sFrameTimeMax) : sFrameTimeMax;
+            return lower + (upper - lower) * std::max(target - cumulative, 0.0f) / count;
+        }
+        cumulative += count;
+    }
+    return sFrameTimeMax;
+}
+
+void WriteCsvRow(long long timestamp, double uptime, const char* metric, double value)
+{
+    fprintf(sFile, "%lld,%.3f,%s,%.6g\n", timestamp, uptime, metric, value);
+}
+
+void WriteCsv(long long timestamp, double uptime, uint32_t count)
+{
+    const float frameTimeAverage = (sTimedFrames > 0) ? float(sFrameTimeSum / sTimedFrames) : 0.0f;
+    WriteCsvRow(timestamp, uptime, "FrameTime.frames", sTimedFrames);
+    WriteCsvRow(timestamp, uptime, "FrameTime.avg", frameTimeAverage);
+    WriteCsvRow(timestamp, uptime, "FrameTime.p50", GetFrameTimePercentile(0.50f));
+    WriteCsvRow(timestamp, uptime, "FrameTime.p95", GetFrameTimePercentile(0.95f));
+    WriteCsvRow(timestamp, uptime, "FrameTime.p99", GetFrameTimePercentile(0.99f));
+    WriteCsvRow(timestamp, uptime, "FrameTime.max", sFrameTimeMax);
+
+    char metric[128];
+    for (uint32_t bucket = 0; bucket < PerfCounters::FrameTimeBucketCount; ++bucket)
+    {
+        if (bucket < PerfCounters::FrameTimeBucketCount - 1)
+        {
+            snprintf(metric,
+                     std::size(metric),
+                     "FrameTime.le_%g",
+                     PerfCounters::FrameTimeBucketEdges[bucket]);
+        }
+        else
+        {
+            snprintf(metric, std::size(metric), "FrameTime.le_inf");
+        }
+        WriteCsvRow(timestamp, uptime, metric, sFrameTimeBuckets[bucket]);
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const IntervalStats& stats = sStats[i];
+        if (stats.frames == 0)
+        {
+            continue;
+        }
+
+        if (sTypes[i] == PerfCounterType::Counter)
+        {
+            snprintf(metric, std::size(metric), "%s.total", sNames[i]);
+            WriteCsvRow(timestamp, uptime, metric, double(stats.total));
+            snprintf(metric, std::size(metric), "%s.avg", sNames[i]);
+            WriteCsvRow(timestamp, uptime, metric, double(stats.total) / stats.frames);
+        }
+        else
+        {
+            snprintf(metric, std::size(metric), "%s.last", sNames[i]);
+            WriteCsvRow(timestamp, uptime, metric, double(stats.last));
+            snprintf(metric, std::size(metric), "%s.min", sNames[i]);
+            WriteCsvRow(timestamp, uptime, metric, double(stats.min));
+        }
+        snprintf(metric, std::size(metric), "%s.max", sNames[i]);
+        WriteCsvRow(timestamp, uptime, metric, double(stats.max));
+    }
+}
+
+void WriteJson(long long timestamp, double uptime, uint32_t count)
+{
+    const float frameTimeAverage = (sTimedFrames > 0) ? float(sFrameTimeSum / sTimedFrames) : 0.0f;
+    fprintf(sFile,
+            "{\"timestamp\":%lld,\"uptime\":%.3f,\"frameTime\":{\"frames\":%u,\"avg\":%.4f,"
+            "\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f,\"histogram\":{\"edges\":[",
+            timestamp,
+            uptime,
+            sTimedFrames,
+            frameTimeAverage,
+            GetFrameTimePercentile(0.50f),
+            GetFrameTimePercentile(0.95f),
+            GetFrameTimePercentile(0.99f),
+            sFrameTimeMax);
+    for (uint32_t bucket = 0; bucket < PerfCounters::FrameTimeBucketCount - 1; ++bucket)
+    {
+        fprintf(sFile, (bucket > 0) ? ",%g" : "%g", PerfCounters::FrameTimeBucketEdges[bucket]);
+    }
+    fputs("],\"counts\":[", sFile);
+    for (uint32_t bucket = 0; bucket < PerfCounters::FrameTimeBucketCount; ++bucket)
+    {
+        fprintf(sFile, (bucket > 0) ? ",%u" : "%u", sFrameTimeBuckets[bucket]);
+    }
+    fputs("]}},\"counters\":{", sFile);
+
+    bool first = true;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const IntervalStats& stats = sStats[i];
+        if (stats.frames == 0)
+        {
+            continue;
+        }
+
+        // Counter names are code identifiers, nothing in them needs escaping
+        fprintf(sFile, "%s\"%s\":{", first ? "" : ",", sNames[i]);
+        first = false;
+        if (sTypes[i] == PerfCounterType::Counter)
+        {
+            fprintf(sFile,
+                    "\"total\":%lld,\"avg\":%.6g,",
+                    static_cast<long long>(stats.total),
+                    double(stats.total) / stats.frames);
+        }
+        else
+        {
+            fprintf(sFile,
+                    "\"last\":%lld,\"min\":%lld,",
+                    static_cast<long long>(stats.last),
+                    static_cast<long long>(stats.min));
+        }
+        fprintf(sFile, "\"max\":%lld}", static_cast<long long>(stats.max));
+    }
+    fputs("}}\n", sFile);
+}
+
+void ResetInterval()
+{
+    for (IntervalStats& stats : sStats)
+    {
+        stats = IntervalStats();
+    }
+    std::fill(std::begin(sFrameTimeBuckets), std::end(sFrameTimeBuckets), 0);
+    sTimedFrames = 0;
+    sFrameTimeSum = 0.0;
+    sFrameTimeMax = 0.0f;
+    sIntervalStart = Clock::now();
+}
+} // namespace
+
+PerfCounters::Detail::Slot PerfCounters::Detail::sSlots[MaxCounters + 1];
+
+void PerfCounters::StaticInitialize(const std::filesystem::path& exportFile,
+                                    float exportIntervalSeconds)
+{
+    ASSERT(sFile == nullptr, "PerfCounters: already initialized");
+    ResetInterval();
+    sLastFrame = Clock::time_point();
+    sExportInterval = exportIntervalSeconds;
+    if (exportFile.empty())
+    {
+        return;
+    }
+
+    sFormat = (exportFile.extension() == ".json") ? ExportFormat::Json : ExportFormat::Csv;
+    sFile = fopen(exportFile.u8string().c_str(), "w");
+    if (sFile == nullptr)
+    {
+        LOG_WARNING(Core, "PerfCounters: Failed to open %s", exportFile.u8string().c_str());
+        return;
+    }
+    if (sFormat == ExportFormat::Csv)
+    {
+        fputs("timestamp,uptime,metric,value\n", sFile);
+    }
+}
+
+void PerfCounters::StaticTerminate()
+{
+    if (sFile == nullptr)
+    {
+        return;
+    }
+
+    if (sTimedFrames > 0)
+    {
+        Export();
+    }
+    fclose(sFile);
+    sFile = nullptr;
+}
+
+PerfCounterId PerfCounters::Register(const char* name, PerfCounterType type)
+{
+    std::lock_guard<SpinLock> lock(sRegisterLock);
+    const uint32_t count = sCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (strcmp(sNames[i], name) == 0)
+        {
+            ASSERT(sTypes[i] == type, "PerfCounters: %s registered with two types", name);
+            return i;
+        }
+    }
+
+    if (count == MaxCounters)
+    {
+        ASSERT(false, "PerfCounters: Out of counters, %s is not recorded", name);
+        return MaxCounters;
+    }
+    sNames[count] = name;
+    sTypes[count] = type;
+    sCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void PerfCounters::EndFrame()
+{
+    const Clock::time_point now = Clock::now();
+    const bool isTimed = (sLastFrame != Clock::time_point());
+    const float frameTime =
+        isTimed ? std::chrono::duration<float, std::milli>(now - sLastFrame).count() : 0.0f;
+    sLastFrame = now;
+
+    const uint32_t count = sCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::atomic<int64_t>& slot = Detail::sSlots[i].value;
+        const int64_t value = (sTypes[i] == PerfCounterType::Counter)
+                                  ? slot.exchange(0, std::memory_order_relaxed)
+                                  : slot.load(std::memory_order_relaxed);
+        sLastValues[i] = value;
+        sHistory[i][sHistoryOffset] = static_cast<float>(value);
+
+        IntervalStats& stats = sStats[i];
+        if (stats.frames == 0)
+        {
+            stats.min = value;
+            stats.max = value;
+        }
+        stats.total += value;
+        stats.min = std::min(stats.min, value);
+        stats.max = std::max(stats.max, value);
+        stats.last = value;
+        ++stats.frames;
+    }
+    Detail::sSlots[MaxCounters].value.store(0, std::memory_order_relaxed);
+
+    sFrameTimes[sHistoryOffset] = frameTime;
+    sHistoryOffset = (sHistoryOffset + 1) % HistoryLength;
+    if (isTimed)
+    {
+        ++sFrameTimeBuckets[GetBucket(frameTime)];
+        ++sTimedFrames;
+        sFrameTimeSum += frameTime;
+        sFrameTimeMax = std::max(sFrameTimeMax, frameTime);
+    }
+
+    if (sFile != nullptr &&
+        std::chrono::duration<float>(now - sIntervalStart).count() >= sExportInterval)
+    {
+        Export();
+    }
+}
+
+void PerfCounters::Export()
+{
+    if (sFile != nullptr)
+    {
+        const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+        const long long timestamp =
+            std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count();
+        const double uptime = TimeUtil::GetTime();
+        const uint32_t count = sCount.load(std::memory_order_acquire);
+        if (sFormat == ExportFormat::Json)
+        {
+            WriteJson(timestamp, uptime, count);
+        }
+        else
+        {
+            WriteCsv(timestamp, uptime, count);
+        }
+        fflush(sFile);
+    }
+    ResetInterval();
+}
+
+uint32_t PerfCounters::GetCount()
+{
+    return sCount.load(std::memory_order_acquire);
+}
+
+const char* PerfCounters::GetName(PerfCounterId id)
+{
+    ASSERT(id < GetCount(), "PerfCounters: Invalid counter id %u", id);
+    return sNames[id];
+}
+
+PerfCounterType PerfCounters::GetType(PerfCounterId id)
+{
+    ASSERT(id < GetCount(), "PerfCounters: Invalid counter id %u", id);
+    return sTypes[id];
+}
+
+int64_t PerfCounters::GetLastFrameValue(PerfCounterId id)
+{
+    ASSERT(id < GetCount(), "PerfCounters: Invalid counter id %u", id);
+    return sLastValues[id];
+}
+
+float PerfCounters::GetLastFrameTime()
+{
+    return sFrameTimes[(sHistoryOffset + HistoryLength - 1) % HistoryLength];
+}
+
+const float* PerfCounters::GetHistory(PerfCounterId id)
+{
+    ASSERT(id < GetCount(), "PerfCounters: Invalid counter id %u", id);
+    return sHistory[id];
+}
+
+const float* PerfCounters::GetFrameTimeHistory()
+{
+    return sFrameTimes;
+}
+
+uint32_t PerfCounters::GetHistoryOffset()
+{
+    return sHistoryOffset;
+}
@@ -0,0 +1,147 @@
+#include "Precompiled.h"
+#include "PoolAllocator.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+#if defined(_DEBUG)
+constexpr uint8_t AllocatedPattern = 0xCD;
+constexpr uint8_t FreedPattern = 0xDD;
+constexpr uint8_t GuardPattern = 0xFD;
+constexpr size_t GuardSize = 8;
+#else
+constexpr size_t GuardSize = 0;
+#endif
+} // namespace
+
+PoolAllocator::~PoolAllocator()
+{
+    ASSERT(mBuffer == nullptr, "PoolAllocator: terminate must be called before destruction");
+}
+
+void PoolAllocator::Initialize(size_t blockSize, uint32_t blockCount, size_t alignment)
+{
+    ASSERT(mBuffer == nullptr, "PoolAllocator: already initialized");
+    ASSERT((alignment & (alignment - 1)) == 0, "PoolAllocator: alignment must be a power of 2");
+
+    // Free blocks hold the list link, so every block is at least a pointer
+    mAlignment = std::max(alignment, alignof(FreeBlock));
+    mBlockSize = std::max(blockSize, sizeof(FreeBlock));
+    mStride = (mBlockSize + GuardSize + mAlignment - 1) & ~(mAlignment - 1);
+    mBlockCount = blockCount;
+    mUsedCount = 0;
+    mPeakUsedCount = 0;
+    mBuffer = static_cast<uint8_t*>(
+        ::operator new(mStride * blockCount, std::align_val_t(mAlignment)));
+
+    // Linked in address order so the first allocations are next to each other
+    mFreeList = nullptr;
+    for (uint32_t i = blockCount; i > 0; --i)
+    {
+        uint8_t* block = mBuffer + (i - 1) * mStride;
+#if defined(_DEBUG)
+        memset(block, FreedPattern, mBlockSize);
+        memset(block + mBlockSize, GuardPattern, GuardSize);
+#endif
+        FreeBlock* freeBlock = reinterpret_cast<FreeBlock*>(block);
+        freeBlock->next = mFreeList;
+        mFreeList = freeBlock;
+    }
+#if defined(_DEBUG)
+    mAllocated.assign(blockCount, false);
+#endif
+}
+
+void PoolAllocator::Terminate()
+{
+    ASSERT(mUsedCount == 0, "PoolAllocator: %u blocks were not freed", mUsedCount);
+    if (mBuffer != nullptr)
+    {
+        ::operator delete(mBuffer, std::align_val_t(mAlignment));
+        mBuffer = nullptr;
+    }
+    mFreeList = nullptr;
+    mBlockCount = 0;
+    mUsedCount = 0;
+}
+
+void* PoolAllocator::Allocate()
+{
+    if (mFreeList == nullptr)
+    {
+        return nullptr;
+    }
+
+    FreeBlock* block = mFreeList;
+    mFreeList = block->next;
+    ++mUsedCount;
+    mPeakUsedCount = std::max(mPeakUsedCount, mUsedCount);
+#if defined(_DEBUG)
+    const size_t index = (reinterpret_cast<uint8_t*>(block) - mBuffer) / mStride;
+    mAllocated[index] = true;
+    memset(block, AllocatedPattern, mBlockSize);
+#endif
+    return block;
+}
+
+void PoolAllocator::Free(void* block)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+
+    ASSERT(Owns(block), "PoolAllocator: block was not allocated from this pool");
+#if defined(_DEBUG)
+    uint8_t* bytes = static_cast<uint8_t*>(block);
+    const size_t index = (bytes - mBuffer) / mStride;
+    ASSERT(mAllocated[index], "PoolAllocator: block %zu freed twice", index);
+    for (size_t i = 0; i < GuardSize; ++i)
+    {
+        ASSERT(bytes[mBlockSize + i] == GuardPattern,
+               "PoolAllocator: write past the end of block %zu",
+               index);
+    }
+    mAllocated[index] = false;
+    memset(bytes, FreedPattern, mBlockSize);
+#endif
+
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = mFreeList;
+    mFreeList = freeBlock;
+    --mUsedCount;
+}
+
+bool PoolAllocator::Owns(const void* block) const
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(block);
+    return bytes >= mBuffer && bytes < mBuffer + mStride * mBlockCount &&
+           (bytes - mBuffer) % mStride == 0;
+}
+
+size_t PoolAllocator::GetBlockSize() const
+{
+    return mBlockSize;
+}
+
+size_t PoolAllocator::GetAlignment() const
+{
+    return mAlignment;
+}
+
+uint32_t PoolAllocator::GetBlockCount() const
+{
+    return mBlockCount;
+}
+
+uint32_t PoolAllocator::GetUsedCount() const
+{
+    return mUsedCount;
+}
+
+uint32_t PoolAllocator::GetPeakUsedCount() const
+{
+    return mPeakUsedCount;
+}
@@ -0,0 +1,73 @@
+#include "Precompiled.h"
+#include "StringTable.h"
+
+#include "DebugUtil.h"
+#include "FlatHashMap.h"
+#include "SpinLock.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+struct Table
+{
+    SpinLock lock;
+    FlatHashMap<StringId, const std::string*> strings;
+    std::deque<std::string> storage; // Deque elements never move, so pointers stay valid
+};
+
+Table& GetTable()
+{
+    static Table sTable;
+    return sTable;
+}
+
+StringId InternHashed(StringId id, std::string_view text)
+{
+    Table& table = GetTable();
+    std::lock_guard<SpinLock> guard(table.lock);
+    auto [stored, inserted] = table.strings.TryEmplace(id, nullptr);
+    if (inserted)
+    {
+        *stored = &table.storage.emplace_back(text);
+    }
+#if defined(_DEBUG)
+    else if (**stored != text)
+    {
+        ASSERT(false,
+               "StringTable: Hash collision between \"%s\" and \"%.*s\"",
+               (*stored)->c_str(),
+               static_cast<int>(text.size()),
+               text.data());
+    }
+#endif
+    return id;
+}
+} // namespace
+
+StringId StringTable::Intern(std::string_view text)
+{
+    return InternHashed(Hash64(text), text);
+}
+
+StringId StringTable::InternPath(const std::filesystem::path& path)
+{
+    const std::string normalized = NormalizePath(path);
+    return InternHashed(Hash64(normalized), normalized);
+}
+
+const char* StringTable::GetString(StringId id)
+{
+    Table& table = GetTable();
+    std::lock_guard<SpinLock> guard(table.lock);
+    const std::string* const* stored = table.strings.Find(id);
+    return (stored != nullptr) ? (*stored)->c_str() : nullptr;
+}
+
+size_t StringTable::GetCount()
+{
+    Table& table = GetTable();
+    std::lock_guard<SpinLock> guard(table.lock);
+    return table.strings.GetSize();
+}
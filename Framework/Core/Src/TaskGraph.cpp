@@ -0,0 +1,177 @@
+#include "Precompiled.h"
+#include "TaskGraph.h"
+
+#include "DebugUtil.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+TaskId TaskGraph::Add(const char* name,
+                      Task task,
+                      std::initializer_list<TaskId> dependencies,
+                      TaskThread thread)
+{
+    const TaskId id = static_cast<TaskId>(mNodes.size());
+    Node& node = mNodes.emplace_back();
+    node.name = name;
+    node.task = std::move(task);
+    node.thread = thread;
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "TaskGraph: %s depends on a task added after it", name);
+        node.dependencies.push_back(dependency);
+        mNodes[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+void TaskGraph::Run()
+{
+    const uint32_t taskCount = static_cast<uint32_t>(mNodes.size());
+    mTimings.assign(taskCount, {});
+    mRemaining = std::make_unique<std::atomic<uint32_t>[]>(taskCount);
+    uint32_t mainTaskCount = 0;
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        mTimings[i].name = mNodes[i].name;
+        mRemaining[i].store(static_cast<uint32_t>(mNodes[i].dependencies.size()));
+        mainTaskCount += (mNodes[i].thread == TaskThread::Main) ? 1 : 0;
+    }
+
+    mMainThreadId = std::this_thread::get_id();
+    mStartTime = std::chrono::steady_clock::now();
+
+    // Every count is set before the first task can finish and release its dependents
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        if (mNodes[i].dependencies.empty())
+        {
+            Schedule(i);
+        }
+    }
+
+    // Sleeps rather than helping the workers, a ready main task would otherwise wait for
+    // whatever job the thread picked up
+    for (uint32_t i = 0; i < mainTaskCount; ++i)
+    {
+        TaskId id = 0;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mMainCondition.wait(lock, [this]() { return !mMainQueue.empty(); });
+            id = mMainQueue.front();
+            mMainQueue.pop_front();
+        }
+        Execute(id);
+    }
+    JobSystem::Get()->Wait(mCounter);
+    mTotalMs = GetElapsedMs();
+}
+
+const std::vector<TaskGraph::TaskTiming>& TaskGraph::GetTimings() const
+{
+    return mTimings;
+}
+
+float TaskGraph::GetTotalMs() const
+{
+    return mTotalMs;
+}
+
+void TaskGraph::LogTimeline(const char* title) const
+{
+    if (mTimings.empty())
+    {
+        return;
+    }
+
+    std::vector<TaskId> order(mTimings.size());
+    for (TaskId i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(),
+              order.end(),
+              [this](TaskId a, TaskId b) { return mTimings[a].startMs < mTimings[b].startMs; });
+
+    float taskMs = 0.0f;
+    LOG_INFO(Core, "%s timeline:", title);
+    for (TaskId id : order)
+    {
+        const TaskTiming& timing = mTimings[id];
+        taskMs += timing.endMs - timing.startMs;
+        LOG_INFO(Core,
+                 "  %8.1f - %8.1f ms  %6.1f ms  %-6s %s",
+                 timing.startMs,
+                 timing.endMs,
+                 timing.endMs - timing.startMs,
+                 timing.isMainThread ? "main" : "worker",
+                 timing.name);
+    }
+
+    // Walks back from the last task to finish through the dependency that finished last
+    TaskId last = order[0];
+    for (TaskId id : order)
+    {
+        last = (mTimings[id].endMs > mTimings[last].endMs) ? id : last;
+    }
+    std::string path = mTimings[last].name;
+    for (TaskId id = last; !mNodes[id].dependencies.empty();)
+    {
+        TaskId latest = mNodes[id].dependencies[0];
+        for (TaskId dependency : mNodes[id].dependencies)
+        {
+            latest = (mTimings[dependency].endMs > mTimings[latest].endMs) ? dependency : latest;
+        }
+        path = std::string(mTimings[latest].name) + " > " + path;
+        id = latest;
+    }
+    LOG_INFO(Core,
+             "%s: %.1f ms, %.1f ms of tasks, critical path %s",
+             title,
+             mTotalMs,
+             taskMs,
+             path.c_str());
+}
+
+void TaskGraph::Schedule(TaskId id)
+{
+    if (mNodes[id].thread == TaskThread::Main)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mMainQueue.push_back(id);
+        }
+        mMainCondition.notify_one();
+    }
+    else
+    {
+        JobSystem::Get()->Submit([this, id]() { Execute(id); }, &mCounter);
+    }
+}
+
+void TaskGraph::Execute(TaskId id)
+{
+    TaskTiming& timing = mTimings[id];
+    timing.isMainThread = (std::this_thread::get_id() == mMainThreadId);
+    timing.startMs = GetElapsedMs();
+    if (mNodes[id].task)
+    {
+        mNodes[id].task();
+    }
+    timing.endMs = GetElapsedMs();
+
+    // Dependents are submitted before this job's counter drops, so Wait cannot return early
+    for (TaskId dependent : mNodes[id].dependents)
+    {
+        if (mRemaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Schedule(dependent);
+        }
+    }
+}
+
+float TaskGraph::GetElapsedMs() const
+{
+    const auto elapsed = std::chrono::steady_clock::now() - mStartTime;
+    return std::chrono::duration<float, std::milli>(elapsed).count();
+}
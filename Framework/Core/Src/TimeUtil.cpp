@@ -25,3 +25,30 @@ float TimeUtil::GetDeltaTime()
 
     return milliseconds / 1000.0f;
 }
+
+TimeUtil::FrameTimeSummary TimeUtil::Summarize(std::vector<float> milliseconds)
+{
+    FrameTimeSummary summary;
+    if (milliseconds.empty())
+    {
+        return summary;
+    }
+
+    double total = 0.0;
+    for (float ms : milliseconds)
+    {
+        total += ms;
+    }
+    std::sort(milliseconds.begin(), milliseconds.end());
+    auto percentile = [&milliseconds](size_t p)
+    { return milliseconds[(milliseconds.size() - 1) * p / 100]; };
+
+    summary.count = static_cast<uint32_t>(milliseconds.size());
+    summary.min = milliseconds.front();
+    summary.mean = static_cast<float>(total / milliseconds.size());
+    summary.p50 = percentile(50);
+    summary.p95 = percentile(95);
+    summary.p99 = percentile(99);
+    summary.max = milliseconds.back();
+    return summary;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Skeleton.h"
+
+namespace Engine::Graphics
+{
+// Keyframes as imported, before compression. Times are in seconds.
+struct RawAnimationClip
+{
+    template <class T> struct Key
+    {
+        T value;
+        float time = 0.0f;
+    };
+
+    struct Track
+    {
+        std::vector<Key<Math::Vector3>> positionKeys;
+        std::vector<Key<Math::Quaternion>> rotationKeys;
+        std::vector<Key<Math::Vector3>> scaleKeys;
+    };
+
+    std::string name;
+    float duration = 0.0f;
+    std::vector<Track> tracks; // Indexed by bone, empty channels keep the rest pose
+
+    size_t GetMemorySize() const;
+};
+
+struct AnimationCompressionSettings
+{
+    float sampleRate = 30.0f;        // Frames per second of the resampled clip
+    uint32_t segmentFrameCount = 16; // Frames sharing one set of quantization ranges
+    float rotationTolerance = 0.0005f; // Radians
+    float positionTolerance = 0.0001f; // Model units
+    float scaleTolerance = 0.0001f;
+};
+
+// Compressed clip, resampled at a uniform rate so sampling never searches for keys.
+//  - Channels that never leave the rest pose are dropped, channels that never change are stored
+//    once at full precision, only the rest are stored per frame.
+//  - Rotations are stored as the three smallest components, 15 bits each, plus the index of the
+//    dropped largest one (48 bits per rotation).
+//  - Positions and scales are 16 bits per component, normalized to the range the track covers
+//    inside each segment of frames.
+// Frames are laid out one after another, so a sample reads two short contiguous runs of memory.
+class AnimationClip
+{
+  public:
+    struct Stats
+    {
+        uint32_t animatedRotations = 0;
+        uint32_t animatedPositions = 0;
+        uint32_t animatedScales = 0;
+        uint32_t constantChannels = 0;
+        uint32_t restChannels = 0; // Dropped, the skeleton's rest pose is used instead
+    };
+
+    static AnimationClip Compress(const RawAnimationClip& rawClip,
+                                  const Skeleton& skeleton,
+                                  const AnimationCompressionSettings& settings = {});
+
+    // Writes every bone of the pose. Bones without tracks get the skeleton's rest pose.
+    void Sample(const Skeleton& skeleton, float time, bool looping, Pose& outPose) const;
+
+    const std::string& GetName() const;
+    float GetDuration() const;
+    uint32_t GetFrameCount() const;
+    uint32_t GetBoneCount() const;
+    Stats GetStats() const;
+    size_t GetMemorySize() const;
+
+    // Binary serialization, used by ModelIO
+    void Write(FILE* file) const;
+    bool Read(FILE* file);
+
+  private:
+    void DecodeRotations(uint32_t frame,
+                         uint32_t first,
+                         uint32_t count,
+                         Math::Quaternion* out) const;
+    Math::Vector3 DecodeVector(uint32_t frame, uint32_t track) const; // Positions, then scales
+
+    std::string mName;
+    float mDuration = 0.0f;
+    float mSampleRate = 0.0f;
+    uint32_t mFrameCount = 0;
+    uint32_t mSegmentFrameCount = 0;
+    uint32_t mBoneCount = 0;
+
+    std::vector<uint16_t> mConstantRotationBones;
+    std::vector<Math::Quaternion> mConstantRotations;
+    std::vector<uint16_t> mConstantPositionBones;
+    std::vector<Math::Vector3> mConstantPositions;
+    std::vector<uint16_t> mConstantScaleBones;
+    std::vector<Math::Vector3> mConstantScales;
+
+    std::vector<uint16_t> mAnimatedRotationBones;
+    std::vector<uint16_t> mAnimatedPositionBones;
+    std::vector<uint16_t> mAnimatedScaleBones;
+
+    // Per segment, per animated position then scale track: min xyz then extent xyz
+    std::vector<float> mSegmentRanges;
+
+    // Per frame: 3 words per animated rotation, then per position, then per scale
+    std::vector<uint16_t> mFrameData;
+};
+} // namespace Engine::Graphics
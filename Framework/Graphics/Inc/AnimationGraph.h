@@ -0,0 +1,261 @@
+#pragma once
+
+#include "AnimationClip.h"
+
+namespace Engine::Graphics
+{
+// Authoring description of an animation graph. Nodes reference each other by index and the graph
+// is compiled once into an AnimationGraph shared by every character using it.
+struct AnimationGraphDesc
+{
+    enum class NodeType
+    {
+        Clip,
+        Blend,        // lerp(inputs[0], inputs[1], weight)
+        BlendSpace1D, // Clips placed on one parameter, played in sync
+        BlendSpace2D, // Clips placed on two parameters, played in sync
+        Additive,     // inputs[0] + weight * (inputs[1] - first frame of inputs[1]'s clip)
+        Layered,      // inputs[1] over inputs[0] on the bones of the mask, scaled by weight
+        StateMachine
+    };
+
+    enum class Comparison
+    {
+        Greater,
+        Less
+    };
+
+    struct BlendSample
+    {
+        uint32_t clipIndex = 0;
+        Math::Vector2 position = Math::Vector2::Zero; // Only x is used by 1D blend spaces
+    };
+
+    struct Transition
+    {
+        int fromState = -1; // -1 transitions from any other state
+        uint32_t toState = 0;
+        uint32_t parameter = 0;
+        Comparison comparison = Comparison::Greater;
+        float threshold = 0.0f;
+        float duration = 0.2f; // Seconds of cross fade
+    };
+
+    struct Node
+    {
+        NodeType type = NodeType::Clip;
+
+        // Clip
+        uint32_t clipIndex = 0;
+        bool looping = true;
+        float speed = 1.0f;
+
+        // Blend, Additive and Layered
+        uint32_t inputs[2] = {};
+        int weightParameter = -1; // Clamped to [0, 1], the constant weight is used when -1
+        float weight = 1.0f;
+        std::vector<float> boneMask; // Layered, per bone weight
+
+        // Blend spaces
+        std::vector<BlendSample> samples;
+        uint32_t parameters[2] = {};
+
+        // State machine, the first state is the entry state
+        std::vector<uint32_t> states;
+        std::vector<Transition> transitions;
+    };
+
+    std::vector<std::string> parameters;
+    std::vector<Node> nodes;
+    uint32_t root = 0;
+
+    uint32_t AddParameter(const std::string& name);
+    uint32_t AddClip(uint32_t clipIndex, bool looping = true, float speed = 1.0f);
+    uint32_t AddBlend(uint32_t from, uint32_t to, int weightParameter, float weight = 1.0f);
+    uint32_t AddBlendSpace1D(uint32_t parameter, std::vector<BlendSample> samples);
+    uint32_t AddBlendSpace2D(uint32_t parameterX,
+                             uint32_t parameterY,
+                             std::vector<BlendSample> samples);
+    uint32_t AddAdditive(uint32_t base,
+                         uint32_t additive,
+                         int weightParameter,
+                         float weight = 1.0f);
+    uint32_t AddLayered(uint32_t base,
+                        uint32_t layer,
+                        std::vector<float> boneMask,
+                        int weightParameter,
+                        float weight = 1.0f);
+    uint32_t AddStateMachine(std::vector<uint32_t> states);
+    void AddTransition(uint32_t stateMachine, const Transition& transition);
+};
+
+// A graph compiled to a flat list of instructions over a small set of pose registers. Evaluation
+// walks the list once, subtrees whose weight is zero are skipped with a jump instead of being
+// sampled. Inactive branches keep their clocks paused.
+class AnimationGraph
+{
+  public:
+    // Returns false when the description references missing nodes, clips or parameters, or when
+    // a node is reachable from itself
+    bool Compile(const AnimationGraphDesc& desc,
+                 const Skeleton& skeleton,
+                 const std::vector<AnimationClip>& clips);
+
+    int FindParameter(const std::string& name) const; // -1 when missing
+    uint32_t GetParameterCount() const;
+    uint32_t GetInstructionCount() const;
+    uint32_t GetRegisterCount() const;
+    const Skeleton* GetSkeleton() const;
+
+  private:
+    friend class AnimationGraphInstance;
+
+    enum class Op : uint16_t
+    {
+        LoadParameter,    // weights[weight] = saturate(parameters[index])
+        StateMachine,     // Runs transitions, writes the weight of every state
+        BlendSpace1D,     // Writes the sample weights, advances the shared clock
+        BlendSpace2D,
+        AdvanceClock,     // Clip index, clock
+        SkipIfZero,       // Skips count instructions when weights[weight] <= 0
+        SkipIfOne,        // Skips count instructions when weights[weight] >= 1
+        Clear,            // Empties an accumulating register
+        Sample,           // target = clip at clock
+        AccumulateSample, // target += clip at clock with weights[weight], source is scratch
+        Accumulate,       // target += source with weights[weight]
+        Blend,            // target = lerp(target, source, weights[weight])
+        Additive,         // target += (source - references[index]) * weights[weight]
+        Layered           // target = lerp(target, source, masks[index][bone] * weights[weight])
+    };
+
+    struct Instruction
+    {
+        Op op = Op::Clear;
+        uint16_t target = 0;
+        uint16_t source = 0;
+        uint16_t index = 0;
+        uint16_t clock = 0;
+        uint16_t weight = 0;
+        uint16_t count = 0;
+    };
+
+    struct Clock
+    {
+        bool looping = true;
+        float speed = 1.0f;
+    };
+
+    struct BlendSpace
+    {
+        std::vector<uint32_t> clipIndices;
+        std::vector<Math::Vector2> positions; // 1D spaces are sorted by x
+        uint16_t parameters[2] = {};
+        uint16_t firstWeight = 0;
+        uint16_t clock = 0;
+    };
+
+    struct StateMachine
+    {
+        std::vector<AnimationGraphDesc::Transition> transitions;
+        std::vector<std::pair<uint16_t, uint16_t>> stateClocks; // [first, last) per state
+        uint16_t firstWeight = 0;
+        uint16_t stateCount = 0;
+    };
+
+    struct CompileContext;
+    bool CompileNode(CompileContext& context, uint32_t nodeIndex, uint16_t target);
+
+    const Skeleton* mSkeleton = nullptr;
+    const std::vector<AnimationClip>* mClips = nullptr;
+
+    std::vector<Instruction> mInstructions;
+    std::vector<std::string> mParameterNames;
+    std::vector<float> mInitialWeights; // Constant node weights, others are written at runtime
+    std::vector<Clock> mClocks;
+    std::vector<BlendSpace> mBlendSpaces;
+    std::vector<StateMachine> mStateMachines;
+    std::vector<Pose> mAdditiveReferences;
+    std::vector<std::vector<float>> mBoneMasks;
+    uint32_t mRegisterCount = 0;
+};
+
+// Above a distance, characters are evaluated every few frames and interpolated in between
+struct AnimationLodSettings
+{
+    float reducedRateDistance = 20.0f;
+    uint32_t reducedRateInterval = 2; // Frames between evaluations
+    float lowRateDistance = 50.0f;
+    uint32_t lowRateInterval = 4;
+
+    uint32_t GetInterval(float distance) const;
+};
+
+// Per character state of a graph: parameters, clocks, state machines and the output pose. The
+// graph is not owned and must outlive the instance.
+class AnimationGraphInstance
+{
+  public:
+    void Initialize(const AnimationGraph& graph);
+    void Terminate();
+
+    void SetParameter(uint32_t parameter, float value);
+    float GetParameter(uint32_t parameter) const;
+
+    // Distance to the camera, picks the update rate
+    void SetLodDistance(float distance);
+
+    // Evaluates the graph if it is due and updates the matrices
+    void Update(float deltaTime, const AnimationLodSettings& lodSettings = {});
+
+    // Updates many characters on the JobSystem, each thread evaluates with its own pose scratch
+    static void Update(AnimationGraphInstance* const* instances,
+                       uint32_t count,
+                       float deltaTime,
+                       const AnimationLodSettings& lodSettings = {});
+
+    // Valid after Update
+    const Pose& GetPose() const;
+    const std::vector<Math::Matrix4>& GetModelMatrices() const;
+    const std::vector<Math::Matrix4>& GetSkinningMatrices() const;
+
+    int GetCurrentState(uint32_t stateMachine) const;
+    uint32_t GetUpdateInterval() const;
+    uint32_t GetEvaluationCount() const;
+
+  private:
+    struct MachineState
+    {
+        int current = 0;
+        int previous = -1;
+        float transitionTime = 0.0f;
+        float transitionDuration = 0.0f;
+    };
+
+    struct Scratch;
+
+    void Evaluate(float deltaTime, Scratch& scratch);
+    void RunStateMachine(uint32_t machineIndex, float deltaTime);
+    void ComputeBlendSpaceWeights(const AnimationGraph::BlendSpace& space, bool twoDimensional);
+    float GetClipTime(uint32_t clipIndex, uint32_t clock) const;
+
+    const AnimationGraph* mGraph = nullptr;
+
+    std::vector<float> mParameters;
+    std::vector<float> mWeights;
+    std::vector<float> mClocks; // Normalized phase
+    std::vector<MachineState> mMachineStates;
+
+    float mLodDistance = 0.0f;
+    uint32_t mInterval = 1;
+    uint32_t mFramesSinceEvaluation = 0;
+    uint32_t mEvaluationCount = 0;
+    uint32_t mStagger = 0; // Spreads reduced rate evaluations over frames
+    float mPendingTime = 0.0f;
+
+    Pose mPose;
+    Pose mPreviousPose;
+    Pose mNextPose;
+    std::vector<Math::Matrix4> mModelMatrices;
+    std::vector<Math::Matrix4> mSkinningMatrices;
+};
+} // namespace Engine::Graphics
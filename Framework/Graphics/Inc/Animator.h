@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AnimationClip.h"
+
+namespace Engine::Graphics
+{
+// Plays the clips of one skeleton, cross fading between them. The skeleton and clips are not
+// owned and must outlive the animator.
+class Animator
+{
+  public:
+    void Initialize(const Skeleton& skeleton, const std::vector<AnimationClip>& clips);
+    void Terminate();
+
+    // A blend duration above zero cross fades from the current pose
+    void Play(uint32_t clipIndex, bool looping = true, float blendDuration = 0.0f);
+    void Update(float deltaTime);
+
+    void SetSpeed(float speed);
+    float GetSpeed() const;
+
+    // Valid after Update
+    const Pose& GetPose() const;
+    const std::vector<Math::Matrix4>& GetModelMatrices() const;
+    const std::vector<Math::Matrix4>& GetSkinningMatrices() const;
+
+    uint32_t GetClipCount() const;
+    int GetClipIndex() const; // -1 before the first Play
+    float GetTime() const;
+    bool IsFinished() const;
+
+  private:
+    const Skeleton* mSkeleton = nullptr;
+    const std::vector<AnimationClip>* mClips = nullptr;
+
+    int mClipIndex = -1;
+    float mTime = 0.0f;
+    bool mLooping = true;
+
+    int mPreviousClipIndex = -1;
+    float mPreviousTime = 0.0f;
+    bool mPreviousLooping = true;
+    float mBlendTime = 0.0f;
+    float mBlendDuration = 0.0f;
+
+    float mSpeed = 1.0f;
+
+    Pose mPose;
+    Pose mCurrentPose;
+    Pose mPreviousPose;
+    std::vector<Math::Matrix4> mModelMatrices;
+    std::vector<Math::Matrix4> mSkinningMatrices;
+};
+} // namespace Engine::Graphics
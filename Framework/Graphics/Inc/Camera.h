@@ -12,6 +12,7 @@ class Camera
     };
 
     void SetMode(ProjectionMode mode);
+    ProjectionMode GetMode() const;
 
     void SetPosition(const Math::Vector3& position);
 
@@ -52,6 +53,9 @@ class Camera
     Math::Matrix4 GetPerspectiveMatrix() const;
     Math::Matrix4 GetOrthographicMatrix() const;
 
+    // World space ray through a back buffer pixel, for picking
+    Math::Ray ScreenPointToRay(int screenX, int screenY) const;
+
   private:
     ProjectionMode mProjectionMode = ProjectionMode::Perspective;
 
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Engine::Graphics
+{
+class Camera;
+
+// A camera flight through keys, each a position and the point looked at. Catmull-Rom splines run
+// through both, and progress is spread over the keys by the distance between them, so the camera
+// keeps a steady speed however the keys are spaced.
+class CameraPath final
+{
+  public:
+    // Text with one key per line: position x y z, then target x y z. Empty lines and lines
+    // starting with # are skipped.
+    bool Load(const std::filesystem::path& filePath);
+
+    void AddKey(const Math::Vector3& position, const Math::Vector3& target);
+    void Clear();
+
+    uint32_t GetKeyCount() const;
+    float GetLength() const;
+
+    // t runs from 0 at the first key to 1 at the last
+    Math::Vector3 GetPosition(float t) const;
+    Math::Vector3 GetTarget(float t) const;
+    void Apply(Camera& camera, float t) const;
+
+  private:
+    struct Key
+    {
+        Math::Vector3 position;
+        Math::Vector3 target;
+        float distance = 0.0f; // Along the path up to this key
+    };
+
+    // The segment t falls in and how far into it
+    size_t Locate(float t, float& segmentT) const;
+    template <class T> T Sample(T Key::*member, float t) const;
+
+    std::vector<Key> mKeys;
+};
+} // namespace Engine::Graphics
@@ -20,6 +20,8 @@ class ConstantBuffer
 
   private:
     ID3D11Buffer* mConstantBuffer = nullptr;
+    uint32_t mBufferSize = 0;
+    Core::MemoryAllocationId mMemoryId = Core::InvalidHandle;
 };
 
 template <class DataType> class TypedConstantBuffer final : public ConstantBuffer
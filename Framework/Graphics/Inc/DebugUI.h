@@ -17,4 +17,10 @@ void SetTheme(Theme theme);
 
 void BeginRender();
 void EndRender();
+
+// Window with the frame time and a rolling graph of every Core::PerfCounters entry
+void ShowPerfCounters();
+
+// Window with live, peak and budget per Core::MemoryTracker tag, and the largest assets of each
+void ShowMemory();
 } // namespace Engine::Graphics::DebugUI
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace Engine::Graphics
+{
+// GPU time of a frame's work from timestamp queries. The results come back a few frames late
+// and are read without stalling the pipeline. Devices without timestamp queries, such as the
+// null device, leave the timer unavailable and nothing is measured.
+class GpuTimer final
+{
+  public:
+    static constexpr uint32_t FramesInFlight = 4;
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer(const GpuTimer&&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&&) = delete;
+
+    void Initialize();
+    void Terminate();
+
+    bool IsAvailable() const;
+
+    // Around the GPU work of a frame. When FramesInFlight frames are still waiting to be read,
+    // the frame is not measured.
+    void Begin(uint32_t frame);
+    void End();
+
+    // The oldest finished measurement, false when none is ready. With isWaiting it blocks until
+    // the frames in flight are done instead. Disjoint measurements are dropped.
+    bool Read(uint32_t& frame, float& milliseconds, bool isWaiting = false);
+
+  private:
+    struct Slot
+    {
+        ID3D11Query* disjoint = nullptr;
+        ID3D11Query* begin = nullptr;
+        ID3D11Query* end = nullptr;
+        uint32_t frame = 0;
+    };
+
+    Slot mSlots[FramesInFlight];
+    uint32_t mNext = 0; // Pending slots run from mNext - mPendingCount to mNext
+    uint32_t mPendingCount = 0;
+    bool mIsMeasuring = false;
+    bool mIsAvailable = false;
+};
+} // namespace Engine::Graphics
@@ -2,20 +2,30 @@
 
 #include "Common.h"
 
+#include "AnimationClip.h"
+#include "AnimationGraph.h"
+#include "Animator.h"
 #include "BlendState.h"
 #include "Camera.h"
+#include "CameraPath.h"
 #include "Color.h"
 #include "ConstantBuffer.h"
 #include "DebugUI.h"
 #include "DirectionalLight.h"
+#include "GpuTimer.h"
 #include "GraphicsSystem.h"
 #include "Material.h"
 #include "MeshBuffer.h"
+#include "MeshBVH.h"
 #include "Model.h"
 #include "ModelIO.h"
 #include "ModelManager.h"
+#include "MorphTarget.h"
+#include "NullDevice.h"
 #include "MeshBuilder.h"
 #include "MeshTypes.h"
+#include "Meshlet.h"
+#include "MeshletCuller.h"
 #include "PixelShader.h"
 #include "RenderObject.h"
 #include "RenderTarget.h"
@@ -26,9 +36,14 @@
 #include "Texture.h"
 #include "TextureManager.h"
 #include "Transform.h"
+#include "TransformHierarchy.h"
+#include "VertexAnimation.h"
+#include "VertexAnimationEffect.h"
 #include "VertexShader.h"
 #include "VertexTypes.h"
 #include "PostProcessingEffect.h"
 #include "ShadowEffect.h"
+#include "Skeleton.h"
+#include "Skinning.h"
 #include "Terrain.h"
 #include "TerrainEffect.h"
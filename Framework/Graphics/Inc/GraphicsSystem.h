@@ -8,9 +8,14 @@ class GraphicsSystem final
 {
   public:
     static void StaticInitialize(GLFWwindow* window, bool fullscreen);
+    // Runs on the null device: no window, nothing is drawn and every API call is counted
+    static void StaticInitialize(uint32_t width, uint32_t height);
     static void StaticTerminate();
     static GraphicsSystem* Get();
 
+    // Bytes of video memory the texture takes, every mip level and array slice included
+    static size_t GetTextureMemorySize(const D3D11_TEXTURE2D_DESC& desc);
+
     GraphicsSystem() = default;
     ~GraphicsSystem();
 
@@ -20,6 +25,7 @@ class GraphicsSystem final
     GraphicsSystem& operator=(const GraphicsSystem&&) = delete;
 
     void Initialize(GLFWwindow* window, bool fullscreen);
+    void Initialize(uint32_t width, uint32_t height);
     void Terminate();
 
     void BeginRender();
@@ -37,6 +43,7 @@ class GraphicsSystem final
     uint32_t GetBackBufferWidth() const;
     uint32_t GetBackBufferHeight() const;
     float GetBackBufferAspectRatio() const;
+    bool IsNullDevice() const;
 
     ID3D11Device* GetDevice();
     ID3D11DeviceContext* GetContext();
@@ -53,10 +60,14 @@ class GraphicsSystem final
     ID3D11Texture2D* mDepthStencilBuffer = nullptr;
     ID3D11DepthStencilView* mDepthStencilView = nullptr;
 
+    Core::MemoryAllocationId mBackBufferMemoryId = Core::InvalidHandle;
+    Core::MemoryAllocationId mDepthStencilMemoryId = Core::InvalidHandle;
+
     DXGI_SWAP_CHAIN_DESC mSwapChainDesc{};
     D3D11_VIEWPORT mViewport{};
 
     Color mClearColor = Colors::Black;
     UINT mVSync = 1;
+    bool mIsNullDevice = false;
 };
 } // namespace Engine::Graphics
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "MeshTypes.h"
+
+namespace Engine::Graphics
+{
+struct RayHit
+{
+    float distance = std::numeric_limits<float>::max();
+    uint32_t meshIndex = 0;
+    uint32_t triangleIndex = 0; // Index into the mesh's triangles (indices / 3)
+    float u = 0.0f;             // Barycentric weight of the triangle's second vertex
+    float v = 0.0f;             // Barycentric weight of the triangle's third vertex
+};
+
+// Bounding volume hierarchy over the triangles of one mesh, built with a binned surface area
+// heuristic. Triangle positions are copied into leaf order so traversal never touches the mesh.
+class MeshBVH
+{
+  public:
+    // 32 bytes, two nodes per cache line. Children are always allocated as a pair, so an interior
+    // node only stores its left child and the right child is the one after it.
+    struct Node
+    {
+        Math::Vector3 min;
+        uint32_t leftFirst = 0; // Left child for interior nodes, first triangle for leaves
+        Math::Vector3 max;
+        uint32_t triangleCount = 0; // 0 for interior nodes
+    };
+
+    static constexpr uint32_t PacketSize = 4;
+
+    void Build(const Mesh& mesh);
+
+    // Restores a saved hierarchy, node bounds are refit from the mesh. Returns false and stays
+    // empty when the data does not describe a tree over this mesh, to be built again lazily.
+    bool Initialize(const Mesh& mesh, std::vector<Node> nodes, std::vector<uint32_t> triangleIds);
+    void Terminate();
+
+    bool IsBuilt() const;
+
+    // Closest hit, the ray direction does not need to be normalized
+    bool Raycast(const Math::Ray& ray, float maxDistance, RayHit& hit) const;
+
+    // Any hit, for shadow/line of sight queries
+    bool Occluded(const Math::Ray& ray, float maxDistance) const;
+
+    // Traces PacketSize coherent rays together, returns a bit mask of the rays that hit
+    uint32_t RaycastPacket(const Math::Ray* rays, float maxDistance, RayHit* hits) const;
+
+    const std::vector<Node>& GetNodes() const;
+    const std::vector<uint32_t>& GetTriangleIds() const;
+
+  private:
+    void Subdivide(uint32_t nodeIndex);
+    void UpdateBounds(uint32_t nodeIndex);
+    void RefitBounds();
+    void TestLeaf(const Node& node, const Math::Ray& ray, RayHit& hit) const;
+
+    std::vector<Node> mNodes;
+    std::vector<uint32_t> mTriangleIds;       // Source triangle for each leaf slot
+    std::vector<Math::Vector3> mPositions;    // 3 per leaf slot
+    std::vector<Math::Vector3> mCentroids;    // Only used while building
+};
+} // namespace Engine::Graphics
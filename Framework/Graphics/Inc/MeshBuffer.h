@@ -12,13 +12,14 @@ class MeshBuffer final
         Triangles
     };
 
-    template <class MeshType> void Initialize(const MeshType& mesh)
+    template <class MeshType> void Initialize(const MeshType& mesh, bool dynamicIndices = false)
     {
         Initialize(mesh.vertices.data(),
                    static_cast<uint32_t>(sizeof(typename MeshType::VertexType)),
                    static_cast<uint32_t>(mesh.vertices.size()),
                    mesh.indices.data(),
-                   static_cast<uint32_t>(mesh.indices.size()));
+                   static_cast<uint32_t>(mesh.indices.size()),
+                   dynamicIndices);
     }
 
     void Initialize(const void* vertices, uint32_t vertexSize, uint32_t vertexCount);
@@ -26,24 +27,37 @@ class MeshBuffer final
                     uint32_t vertexSize,
                     uint32_t vertexCount,
                     const void* indices,
-                    uint32_t indexCount);
+                    uint32_t indexCount,
+                    bool dynamicIndices = false);
 
     void Terminate();
 
     void SetTopology(Topology topology);
     void Update(const void* vertices, uint32_t vertexCount);
+    // Maps a dynamic vertex buffer for writing, discarding its contents. Lets the vertices be
+    // generated straight into the buffer instead of copied in by Update. Call Unmap when done.
+    void* Map();
+    void Unmap();
+    // Replaces the drawn index list, requires dynamic indices and at most the initial index count
+    void UpdateIndices(const uint32_t* indices, uint32_t indexCount);
     void Render() const;
+    // Draws the mesh instanceCount times, shaders tell the copies apart by SV_InstanceID
+    void RenderInstanced(uint32_t instanceCount) const;
 
   private:
     void CreateVertexBuffer(const void* vertices, uint32_t vertexSize, uint32_t vertexCount);
-    void CreateIndexBuffer(const void* indices, uint32_t indexCount);
+    void CreateIndexBuffer(const void* indices, uint32_t indexCount, bool isDynamic);
 
     ID3D11Buffer* mVertexBuffer = nullptr;
     ID3D11Buffer* mIndexBuffer = nullptr;
+    Core::MemoryAllocationId mVertexMemoryId = Core::InvalidHandle;
+    Core::MemoryAllocationId mIndexMemoryId = Core::InvalidHandle;
     D3D11_PRIMITIVE_TOPOLOGY mTopology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
     uint32_t mVertexSize;
     uint32_t mVertexCount;
     uint32_t mIndexCount;
+    uint32_t mIndexCapacity = 0;
+    bool mDynamicIndices = false;
 };
 } // namespace Engine::Graphics
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "MeshTypes.h"
+
+namespace Engine::Graphics
+{
+// A small cluster of triangles with its own bounds. Meshlets are built in index order, so each one
+// covers a contiguous range of the source index buffer and can be compacted with range copies.
+struct Meshlet
+{
+    uint32_t indexOffset = 0;
+    uint32_t triangleCount = 0;
+    uint32_t vertexCount = 0;
+
+    // Bounding sphere (model space)
+    Math::Vector3 center = Math::Vector3::Zero;
+    float radius = 0.0f;
+
+    // Normal cone, a cutoff of 1 means the triangles face too many ways to ever be cone culled
+    Math::Vector3 coneAxis = Math::Vector3::Zero;
+    float coneCutoff = 1.0f;
+};
+
+namespace MeshletBuilder
+{
+constexpr uint32_t MaxVertices = 64;
+constexpr uint32_t MaxTriangles = 124;
+
+std::vector<Meshlet> Build(const Mesh& mesh,
+                           uint32_t maxVertices = MaxVertices,
+                           uint32_t maxTriangles = MaxTriangles);
+} // namespace MeshletBuilder
+} // namespace Engine::Graphics
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Meshlet.h"
+
+namespace Engine::Graphics
+{
+class Camera;
+class RenderGroup;
+
+// Culls the meshlets of a render group against a camera and rewrites each mesh's index buffer
+// with the surviving triangles. The buffers hold one placement at a time, so cull right before
+// each draw of the group rather than culling every instance up front.
+class MeshletCuller
+{
+  public:
+    struct Stats
+    {
+        uint32_t totalMeshlets = 0;
+        uint32_t visibleMeshlets = 0;
+        uint32_t frustumCulled = 0;
+        uint32_t coneCulled = 0;
+        uint32_t totalTriangles = 0;
+        uint32_t visibleTriangles = 0;
+    };
+
+    void Begin(const Camera& camera);
+    void Cull(RenderGroup& renderGroup);
+    void Cull(RenderGroup& renderGroup, const Math::Matrix4& matWorld);
+
+    const Stats& GetStats() const;
+
+    void DebugUI();
+
+  private:
+    const Camera* mCamera = nullptr;
+    Stats mStats;
+
+    std::vector<uint32_t> mIndices;
+
+    bool mEnabled = true;
+    bool mUseConeCulling = true;
+};
+} // namespace Engine::Graphics
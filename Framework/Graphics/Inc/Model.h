@@ -2,6 +2,11 @@
 
 #include "MeshTypes.h"
 #include "Material.h"
+#include "Meshlet.h"
+#include "MeshBVH.h"
+#include "MorphTarget.h"
+#include "AnimationClip.h"
+#include "VertexAnimation.h"
 
 namespace Engine::Graphics
 {
@@ -11,6 +16,10 @@ namespace Engine::Graphics
         {
             Mesh mesh;
             uint32_t materialIndex = 0;
+            std::vector<Meshlet> meshlets;
+            MeshBVH bvh; // Built on the first ray cast unless it was saved with the model
+            std::vector<BoneWeights> boneWeights; // One per vertex, empty for rigid meshes
+            std::vector<MorphTarget> morphTargets; // Blend shapes, offsets from the bind pose
         };
 
         struct MaterialData
@@ -24,6 +33,9 @@ namespace Engine::Graphics
 
         std::vector<MeshData> meshData;
         std::vector<MaterialData> materialData;
+        Skeleton skeleton;
+        std::vector<AnimationClip> animationClips;
+        VertexAnimationData vertexAnimation; // Baked clips for crowds, empty unless saved
     };
 }
 
@@ -12,6 +12,28 @@ namespace Engine::Graphics
 
         void SaveMaterial(std::filesystem::path filePath, const Model& material);
         void LoadMaterial(std::filesystem::path filePath, Model& material);
+
+        void SaveMeshlets(std::filesystem::path filePath, const Model& model);
+        void LoadMeshlets(std::filesystem::path filePath, Model& model);
+
+        void SaveBVH(std::filesystem::path filePath, const Model& model);
+        void LoadBVH(std::filesystem::path filePath, Model& model);
+
+        // Bones and per vertex bone weights
+        void SaveSkeleton(std::filesystem::path filePath, const Model& model);
+        void LoadSkeleton(std::filesystem::path filePath, Model& model);
+
+        // Compressed clips, binary
+        void SaveAnimations(std::filesystem::path filePath, const Model& model);
+        void LoadAnimations(std::filesystem::path filePath, Model& model);
+
+        // Sparse quantized blend shapes of each mesh, binary
+        void SaveMorphTargets(std::filesystem::path filePath, const Model& model);
+        void LoadMorphTargets(std::filesystem::path filePath, Model& model);
+
+        // Vertex animation textures baked from the clips, binary
+        void SaveVertexAnimation(std::filesystem::path filePath, const Model& model);
+        void LoadVertexAnimation(std::filesystem::path filePath, Model& model);
     }
 }
 
@@ -4,7 +4,8 @@
 
 namespace Engine::Graphics
 {
-    using ModelId = std::size_t;
+    // Generation checked index into the manager's model array, 0 means no model
+    using ModelId = Core::Handle;
 
     class ModelManager final
     {
@@ -14,7 +15,7 @@ namespace Engine::Graphics
         static ModelManager* Get();
 
         ModelManager() = default;
-        ~ModelManager() = default;
+        ~ModelManager();
 
         ModelManager(const ModelManager&) = delete;
         ModelManager(const ModelManager&&) = delete;
@@ -22,13 +23,37 @@ namespace Engine::Graphics
         ModelManager& operator=(const ModelManager&&) = delete;
 
         void SetRootDirectory(const std::filesystem::path& rootPath);
-        ModelId GetModelId(const std::filesystem::path& filePath);
+        // Id of an already loaded model, 0 if it is not loaded
+        ModelId GetModelId(const std::filesystem::path& filePath) const;
         ModelId LoadModel(const std::filesystem::path& filePath);
+
+        // LoadModel in two steps, so the parsing can run on a worker. ReadModel only reads the
+        // root directory and can be called from any thread. AddModel keeps the model already
+        // loaded under the path, if any, and drops the new one.
+        std::unique_ptr<Model> ReadModel(const std::filesystem::path& filePath) const;
+        ModelId AddModel(const std::filesystem::path& filePath, std::unique_ptr<Model> model);
         const Model* GetModel(ModelId id);
 
+        // Ray casts are in model space, mesh BVHs are built the first time a model is queried
+        bool Raycast(ModelId id, const Math::Ray& ray, float maxDistance, RayHit& hit);
+        bool Occluded(ModelId id, const Math::Ray& ray, float maxDistance);
+
     private:
-        using Inventory = std::map<ModelId, std::unique_ptr<Model>>;
+        Model* GetModelWithBVH(ModelId id);
+
+        // Models stay behind a pointer so the Model* handed out survive later loads
+        struct Entry
+        {
+            std::unique_ptr<Model> model;
+            Core::StringId pathId = 0;
+            Core::MemoryAllocationId memoryId = Core::InvalidHandle; // CPU side data
+        };
+        using Inventory = Core::HandlePool<Entry>;
+
+        static void TrackModelMemory(Entry& entry);
+
         Inventory mInventory;
+        Core::FlatHashMap<Core::StringId, ModelId> mLookup; // Interned path to id
 
         std::filesystem::path mRootDirectory;
     };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "MeshTypes.h"
+
+namespace Engine::Graphics
+{
+// Position xyz and normal xyz offsets of one vertex, quantized to 16 bits each. Padded to 16
+// bytes so a delta is one SSE load.
+struct alignas(16) MorphDelta
+{
+    int16_t values[8] = {};
+};
+
+// Blend shape of one mesh, stored sparsely: only the vertices it moves, each with its index and a
+// quantized delta. Offsets dequantize as value * positionScale or value * normalScale.
+struct MorphTarget
+{
+    std::string name;
+    std::vector<uint32_t> vertexIndices; // Ascending
+    std::vector<MorphDelta> deltas;      // One per vertex index
+    float positionScale = 0.0f;
+    float normalScale = 0.0f;
+
+    // Offsets between the mesh and the same mesh fully morphed, one position and normal per
+    // vertex. Vertices that move by less than half a quantization step are left out.
+    static MorphTarget Build(std::string name,
+                             const Mesh& mesh,
+                             const Math::Vector3* positions,
+                             const Math::Vector3* normals);
+
+    uint32_t GetVertexCount() const;
+    size_t GetMemorySize() const;
+
+    // Binary serialization, used by ModelIO
+    void Write(FILE* file) const;
+    bool Read(FILE* file);
+};
+
+struct VertexRange
+{
+    uint32_t begin = 0;
+    uint32_t end = 0; // One past the last vertex
+};
+
+// Applies weighted morph targets of one mesh on the CPU. Only targets with a non zero weight are
+// accumulated, four components per SSE step, and only the vertex ranges they touch, or touched on
+// the previous call, are written back.
+class Morpher
+{
+  public:
+    void Initialize(const Mesh& mesh, const std::vector<MorphTarget>& targets);
+    void Terminate();
+
+    // One weight per target. Output must hold the mesh, or what the previous call left in it;
+    // vertices outside the changed ranges are not touched.
+    void Apply(const float* weights, Vertex* output);
+
+    // Ranges of the output written by the last Apply, ascending and disjoint
+    const std::vector<VertexRange>& GetChangedRanges() const;
+
+    uint32_t GetTargetCount() const;
+    uint32_t GetVertexCount() const;
+
+  private:
+    struct Target
+    {
+        MorphTarget data;
+        std::vector<VertexRange> ranges; // Runs of nearby vertex indices
+    };
+
+    void AccumulateTarget(const Target& target, float weight);
+
+    std::vector<Target> mTargets;
+    std::vector<Math::Vector3> mPositions;
+    std::vector<Math::Vector3> mNormals;
+    std::vector<float> mOffsets; // Eight floats per vertex, laid out like MorphDelta
+    std::vector<VertexRange> mActiveRanges;
+    std::vector<VertexRange> mChangedRanges;
+    std::vector<VertexRange> mScratch;
+};
+} // namespace Engine::Graphics
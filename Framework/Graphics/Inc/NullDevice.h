@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Engine::Graphics
+{
+// Device and context calls grouped by what they cost a real driver
+enum class GraphicsApiCall : uint8_t
+{
+    Draw,        // Draws and dispatches
+    SetShader,   // Shaders and input layouts
+    SetState,    // Blend, depth, rasterizer, topology, viewports and render targets
+    SetResource, // Constant, vertex and index buffers, shader resources and samplers
+    Map,         // Map and Unmap
+    Update,      // UpdateSubresource, copies and mip generation
+    Clear,
+    Create, // Every resource, view, shader and state object
+    Query,  // Getters and capability checks
+    Present,
+    Other,
+    Count
+};
+
+// A D3D11 device and immediate context that run without a GPU: nothing is drawn, every call is
+// counted and every buffer and texture is sized. Mapped resources get CPU memory so the code that
+// fills them runs unchanged, and the bound render targets and viewports are kept for the code
+// that saves and restores them. GraphicsSystem::StaticInitialize(width, height) installs it, so
+// render, culling and loading code can be benchmarked and tested on machines without a Vulkan
+// driver. The device must be released last, after everything created from it.
+namespace NullDevice
+{
+// Both come with one reference for the caller
+void Create(ID3D11Device** device, ID3D11DeviceContext** context);
+
+// Called on present: the calls counted so far become the last frame's
+void EndFrame();
+
+// Calls and uploads of the last completed frame
+uint64_t GetFrameCallCount(GraphicsApiCall call);
+uint64_t GetFrameCallCount();
+uint64_t GetFrameUploadedBytes();
+
+// Objects and memory created through the device that are still alive
+uint32_t GetLiveObjectCount();
+size_t GetLiveBufferBytes();
+size_t GetLiveTextureBytes();
+
+const char* GetCallName(GraphicsApiCall call);
+} // namespace NullDevice
+} // namespace Engine::Graphics
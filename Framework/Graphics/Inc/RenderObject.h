@@ -2,6 +2,7 @@
 
 #include "MeshBuffer.h"
 #include "Transform.h"
+#include "TransformHierarchy.h"
 #include "Material.h"
 #include "TextureManager.h"
 #include "ModelManager.h"
@@ -13,7 +14,12 @@ namespace Engine::Graphics
     public:
         void Terminate();
 
+        // World matrix to render with, cached by the hierarchy node when one is attached
+        Math::Matrix4 GetWorldMatrix() const;
+
         Transform transform;   // Location/ Orientation
+        const TransformHierarchy* hierarchy = nullptr; // Optional, overrides transform
+        TransformNodeId transformNode = InvalidTransformNode;
         MeshBuffer meshBuffer; // Shape
 
         Material material;    // Light data
@@ -30,8 +36,20 @@ namespace Engine::Graphics
         void Initialize(const std::filesystem::path& modelFilePath);
         void Terminate();
 
+        // World space ray cast against the group's model, hit distances are in world units
+        bool Raycast(const Math::Ray& ray, float maxDistance, RayHit& hit) const;
+        bool Raycast(const Math::Matrix4& matWorld,
+                     const Math::Ray& ray,
+                     float maxDistance,
+                     RayHit& hit) const;
+
+        // World matrix to render with, cached by the hierarchy node when one is attached
+        Math::Matrix4 GetWorldMatrix() const;
+
         ModelId modelId; // Model Identifier
         Transform transform; // Root Transform (Other objects may have other transforms)
+        const TransformHierarchy* hierarchy = nullptr; // Optional, overrides transform
+        TransformNodeId transformNode = InvalidTransformNode;
         std::vector<RenderObject> renderObjects; // All objects to render
     };
 } // namespace Engine::Graphics
@@ -17,7 +17,11 @@ class RenderTarget final : public Texture
     RenderTarget() = default;
     ~RenderTarget() override;
     void Initialize(const std::filesystem::path& fileName) override;
-    void Initialize(uint32_t width, uint32_t height, Format format);
+    // The name shows up in the memory breakdown and must outlive the render target
+    void Initialize(uint32_t width,
+                    uint32_t height,
+                    Format format,
+                    const char* name = "Render target");
     void Terminate() override;
 
     void BeginRender(Color clearColor = Colors::Black);
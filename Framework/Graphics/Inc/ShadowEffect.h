@@ -24,6 +24,8 @@ class ShadowEffect
 
     void Render(const RenderObject& renderObject);
     void Render(const RenderGroup& renderGroup);
+    void Render(const RenderObject& renderObject, const Math::Matrix4& matWorld);
+    void Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld);
 
     void DebugUI();
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Transform.h"
+
+namespace Engine::Graphics
+{
+// Local transforms of every bone of a skeleton, one array per channel so poses can be sampled and
+// blended with SIMD
+struct Pose
+{
+    std::vector<Math::Quaternion> rotations;
+    std::vector<Math::Vector3> positions;
+    std::vector<Math::Vector3> scales;
+
+    void Resize(uint32_t boneCount);
+    uint32_t GetBoneCount() const;
+};
+
+struct Bone
+{
+    std::string name;
+    int parentIndex = -1;
+    Transform restTransform;                               // Relative to the parent
+    Math::Matrix4 offsetTransform = Math::Matrix4::Identity; // Mesh space to bone space
+};
+
+struct Skeleton
+{
+    std::vector<Bone> bones; // Parents always come before their children
+    Pose restPose;           // Rebuilt from the bones by BuildRestPose
+
+    void BuildRestPose();
+    int FindBone(const std::string& name) const; // -1 when missing
+    bool IsEmpty() const;
+};
+
+// Up to four bone influences for one vertex, weights sum to one
+struct BoneWeights
+{
+    static constexpr uint32_t MaxInfluences = 4;
+
+    uint16_t boneIndices[MaxInfluences] = {};
+    float weights[MaxInfluences] = {};
+};
+
+// Result = lerp(from, to, t) per bone, rotations are normalized lerps along the shortest arc
+void BlendPoses(const Pose& from, const Pose& to, float t, Pose& result);
+
+// Bone to model space matrices, parents first
+void ComputeModelMatrices(const Skeleton& skeleton, const Pose& pose, Math::Matrix4* outMatrices);
+
+// Mesh space to posed mesh space matrices, offsetTransform * model matrix
+void ComputeSkinningMatrices(const Skeleton& skeleton,
+                             const Math::Matrix4* modelMatrices,
+                             Math::Matrix4* outMatrices);
+} // namespace Engine::Graphics
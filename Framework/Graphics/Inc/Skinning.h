@@ -0,0 +1,105 @@
+#pragma once
+
+#include "MeshTypes.h"
+#include "Skeleton.h"
+
+namespace Engine::Graphics
+{
+struct Model;
+class MeshBuffer;
+class RenderGroup;
+
+// Rigid transform as a unit dual quaternion, blends without the volume loss of linear skinning.
+// Scale is not represented.
+struct DualQuaternion
+{
+    Math::Quaternion real = Math::Quaternion::Identity;
+    Math::Quaternion dual = Math::Quaternion::Zero;
+};
+
+enum class SkinningMethod
+{
+    Linear,
+    DualQuaternion
+};
+
+// Converts skinning matrices, scale is removed from the rotation
+void ComputeDualQuaternions(const Math::Matrix4* skinningMatrices,
+                            uint32_t count,
+                            DualQuaternion* outDualQuaternions);
+
+// Bind pose of one mesh, one array per component so four vertices are skinned per SSE step.
+// Arrays are padded to a multiple of four vertices with zero weights.
+class SkinnedMesh
+{
+  public:
+    void Initialize(const Mesh& mesh, const std::vector<BoneWeights>& boneWeights);
+    void Terminate();
+
+    // Replaces the bind pose positions and normals of vertices [begin, end), such as the changed
+    // ranges of a Morpher, so blend shapes are applied before skinning
+    void SetBindPose(const Vertex* vertices, uint32_t begin, uint32_t end);
+
+    // Writes vertices [begin, end) of output, begin must be a multiple of four. Output is only
+    // written to, so it can point into a mapped vertex buffer.
+    void SkinLinear(const Math::Matrix4* skinningMatrices,
+                    uint32_t begin,
+                    uint32_t end,
+                    Vertex* output) const;
+    void SkinDualQuaternion(const DualQuaternion* dualQuaternions,
+                            uint32_t begin,
+                            uint32_t end,
+                            Vertex* output) const;
+
+    uint32_t GetVertexCount() const;
+
+  private:
+    static constexpr uint32_t MaxInfluences = BoneWeights::MaxInfluences;
+
+    std::vector<float> mPositions[3];
+    std::vector<float> mNormals[3];
+    std::vector<float> mTangents[3];
+    std::vector<Math::Vector2> mUVs;
+    std::vector<uint16_t> mBoneIndices[MaxInfluences];
+    std::vector<float> mWeights[MaxInfluences];
+    uint32_t mVertexCount = 0;
+};
+
+struct SkinningJob
+{
+    const SkinnedMesh* mesh = nullptr;
+    const Math::Matrix4* skinningMatrices = nullptr;   // Used by SkinningMethod::Linear
+    const DualQuaternion* dualQuaternions = nullptr; // Used by SkinningMethod::DualQuaternion
+    Vertex* output = nullptr;
+};
+
+// Splits the vertices of every job into ranges and skins them on the JobSystem, blocking until
+// all of them are done
+void SkinMeshes(const SkinningJob* jobs, uint32_t jobCount, SkinningMethod method);
+
+// Deforms the skinned meshes of a render group on the CPU. Their mesh buffers are recreated with
+// dynamic vertex buffers and every update maps each buffer once and skins into it directly.
+class Skinner
+{
+  public:
+    // The group must have been initialized from the model
+    void Initialize(const Model& model, RenderGroup& renderGroup);
+    void Terminate();
+
+    void Update(const Math::Matrix4* skinningMatrices, SkinningMethod method);
+
+    // Skins several characters with one split of the work, matrices are indexed like skinners
+    static void Update(Skinner* const* skinners,
+                       const Math::Matrix4* const* skinningMatrices,
+                       uint32_t count,
+                       SkinningMethod method);
+
+    uint32_t GetVertexCount() const;
+
+  private:
+    std::vector<SkinnedMesh> mMeshes;
+    std::vector<MeshBuffer*> mMeshBuffers;
+    std::vector<DualQuaternion> mDualQuaternions;
+    uint32_t mBoneCount = 0;
+};
+} // namespace Engine::Graphics
@@ -27,6 +27,10 @@ class StandardEffect final
     void Render(const RenderObject& renderObject);
     void Render(const RenderGroup& renderGroup);
 
+    // Same as above but with a world matrix supplied by the caller, e.g. from an ECS::World
+    void Render(const RenderObject& renderObject, const Math::Matrix4& matWorld);
+    void Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld);
+
     void SetCamera(const Camera& camera);
 
     void SetDirectionalLight(const DirectionalLight& directionalLight);
@@ -5,6 +5,13 @@ namespace Engine::Graphics
 class Texture
 {
   public:
+    enum class PixelFormat
+    {
+        RGBA_U8,  // Unsigned normalized
+        RGBA_U16, // Unsigned normalized
+        RGBA_S8   // Signed normalized
+    };
+
     static void UnbindPS(uint32_t slot);
 
     Texture() = default;
@@ -19,6 +26,13 @@ class Texture
     Texture& operator=(Texture&& rhs) noexcept;
 
     virtual void Initialize(const std::filesystem::path& fileName);
+    // Immutable texture from tightly packed rows of pixels. The name shows up in the memory
+    // breakdown and must outlive the texture.
+    void Initialize(uint32_t width,
+                    uint32_t height,
+                    PixelFormat format,
+                    const void* pixels,
+                    const char* name = "Texture");
 
     virtual void Terminate();
 
@@ -29,5 +43,6 @@ class Texture
 
   protected:
     ID3D11ShaderResourceView* mShaderResourceView = nullptr;
+    Core::MemoryAllocationId mMemoryId = Core::InvalidHandle;
 };
 } // namespace Engine::Graphics
@@ -4,7 +4,8 @@
 
 namespace Engine::Graphics
 {
-using TextureId = std::size_t;
+// Generation checked index into the manager's texture array, 0 means no texture
+using TextureId = Core::Handle;
 
 class TextureManager final
 {
@@ -23,6 +24,13 @@ class TextureManager final
 
     void SetRootDirectory(const std::filesystem::path& root);
     TextureId LoadTexture(const std::filesystem::path& filename, bool useRootDir = true);
+    // Takes a reference like LoadTexture on a texture initialized elsewhere, e.g. on a worker from
+    // GetFilePath. When the name was loaded meanwhile the new texture is terminated.
+    TextureId AddTexture(const std::filesystem::path& filename, Texture&& texture);
+    // Id of a loaded texture without taking a reference, 0 if it is not loaded
+    TextureId FindTexture(const std::filesystem::path& filename) const;
+    std::filesystem::path GetFilePath(const std::filesystem::path& filename, bool useRootDir) const;
+    // Textures are stored inline, the pointer is only valid until the next LoadTexture
     const Texture* GetTexture(TextureId id);
     void ReleaseTexture(TextureId id);
 
@@ -32,11 +40,13 @@ class TextureManager final
   private:
     struct Entry
     {
-        std::unique_ptr<Texture> texture;
+        Texture texture;
+        Core::StringId pathId = 0;
         uint32_t refCount = 0;
     };
-    using Inventory = std::unordered_map<TextureId, Entry>;
+    using Inventory = Core::HandlePool<Entry>;
     Inventory mInventory;
+    Core::FlatHashMap<Core::StringId, TextureId> mLookup; // Interned path to id
     std::filesystem::path mRootDirectory;
 };
 } // namespace Engine::Graphics
@@ -10,8 +10,11 @@ struct Transform
 
     [[nodiscard]] Math::Matrix4 GetMatrix4() const
     {
-        return Math::Matrix4::Scaling(scale) * Math::Matrix4::MatrixRotationQuaternion(rotation) *
-               Math::Matrix4::Translation(position);
+        return Math::Matrix4::Transformation(position, rotation, scale);
     }
 };
+
+// Same as calling GetMatrix4 on each transform. Transforms are split into small structure of
+// arrays chunks on the stack and handed to Math::ComposeTransformations.
+void ComputeMatrices(const Transform* transforms, uint32_t count, Math::Matrix4* outMatrices);
 } // namespace Engine::Graphics
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Transform.h"
+
+namespace Engine::Graphics
+{
+using TransformNodeId = uint32_t;
+constexpr TransformNodeId InvalidTransformNode = UINT32_MAX;
+
+// Scene graph of transforms. Local and world matrices are cached and only recomputed for nodes
+// whose local transform changed, or whose parent moved. Node data is kept in breadth first order
+// so Update walks memory linearly, one depth level at a time, and large levels are split across
+// the JobSystem.
+class TransformHierarchy
+{
+  public:
+    TransformNodeId Create(TransformNodeId parent = InvalidTransformNode);
+    void Destroy(TransformNodeId node); // Destroys the node's children too
+    void Clear();
+
+    void SetParent(TransformNodeId node, TransformNodeId parent);
+    TransformNodeId GetParent(TransformNodeId node) const;
+
+    const Transform& GetLocal(TransformNodeId node) const;
+    void SetLocal(TransformNodeId node, const Transform& local);
+    void SetPosition(TransformNodeId node, const Math::Vector3& position);
+    void SetRotation(TransformNodeId node, const Math::Quaternion& rotation);
+    void SetScale(TransformNodeId node, const Math::Vector3& scale);
+
+    // Valid after Update
+    const Math::Matrix4& GetLocalMatrix(TransformNodeId node) const;
+    const Math::Matrix4& GetWorldMatrix(TransformNodeId node) const;
+
+    void Update();
+
+    uint32_t GetNodeCount() const;
+    uint32_t GetLevelCount() const;
+
+  private:
+    enum Flags : uint8_t
+    {
+        LocalDirty = 1 << 0,
+        WorldChanged = 1 << 1,
+    };
+
+    uint32_t GetIndex(TransformNodeId node) const;
+    void UpdateRange(uint32_t begin, uint32_t end);
+    void RebuildOrder();
+
+    // Indexed by position in breadth first order
+    std::vector<Transform> mLocals;
+    std::vector<Math::Matrix4> mLocalMatrices;
+    std::vector<Math::Matrix4> mWorldMatrices;
+    std::vector<TransformNodeId> mParents;
+    std::vector<uint32_t> mParentIndices; // Rebuilt with the order
+    std::vector<uint8_t> mFlags;
+    std::vector<TransformNodeId> mNodeIds;
+
+    // Indexed by node id
+    std::vector<uint32_t> mIndices;
+    std::vector<TransformNodeId> mFreeIds;
+
+    std::vector<uint32_t> mLevelOffsets; // First index of each depth level, plus the end
+    bool mOrderDirty = false;
+};
+} // namespace Engine::Graphics
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Texture.h"
+
+namespace Engine::Graphics
+{
+struct Model;
+
+struct VertexAnimationClip
+{
+    std::string name;
+    uint32_t firstFrame = 0;
+    uint32_t frameCount = 0; // Includes both ends, playback lerps between neighbouring frames
+    float duration = 0.0f;
+};
+
+// Skinned vertex positions and normals of every clip frame, laid out as texture rows so a vertex
+// shader can play them back without bones. Vertex v of frame f is texel
+// (v % textureWidth, f * rowsPerFrame + v / textureWidth).
+//  - Positions are 16 bits per component, normalized to the bounds of all frames.
+//  - Normals are 8 bit signed normalized.
+struct VertexAnimationData
+{
+    static constexpr uint32_t MaxTextureWidth = 4096;
+    static constexpr uint32_t MaxTextureHeight = 16384;
+
+    uint32_t vertexCount = 0; // Every mesh of the model, one after another
+    uint32_t textureWidth = 0;
+    uint32_t rowsPerFrame = 0;
+    uint32_t frameCount = 0;
+    Math::Vector3 boundsMin = Math::Vector3::Zero;
+    Math::Vector3 boundsExtent = Math::Vector3::Zero;
+    std::vector<uint32_t> meshVertexOffsets; // First vertex of each mesh
+    std::vector<VertexAnimationClip> clips;
+    std::vector<uint16_t> positions; // RGBA per texel
+    std::vector<int8_t> normals;     // RGBA per texel
+
+    // Samples every clip of the model at the frame rate and skins all its meshes. Returns empty
+    // data when the model has no skeleton or the frames do not fit in a texture.
+    static VertexAnimationData Bake(const Model& model, float frameRate = 30.0f);
+
+    bool IsEmpty() const;
+    uint32_t GetTextureHeight() const;
+    size_t GetMemorySize() const;
+
+    // Binary serialization, used by ModelIO
+    void Write(FILE* file) const;
+    bool Read(FILE* file);
+};
+
+// Baked data uploaded as two immutable textures
+class VertexAnimationTexture
+{
+  public:
+    void Initialize(const VertexAnimationData& data);
+    void Terminate();
+
+    // Positions at slot, normals at slot + 1
+    void BindVS(uint32_t slot) const;
+
+    const VertexAnimationData& GetData() const;
+
+  private:
+    Texture mPositions;
+    Texture mNormals;
+    VertexAnimationData mData; // Layout and clips, the texel arrays are released after upload
+};
+
+// One character of a crowd, the clip plays from timeOffset at speed
+struct VertexAnimationInstance
+{
+    Math::Matrix4 world = Math::Matrix4::Identity;
+    uint32_t clipIndex = 0;
+    float timeOffset = 0.0f;
+    float speed = 1.0f;
+    float padding = 0.0f;
+};
+} // namespace Engine::Graphics
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Common.h"
+#include "ConstantBuffer.h"
+#include "PixelShader.h"
+#include "VertexShader.h"
+#include "DirectionalLight.h"
+#include "Material.h"
+#include "Sampler.h"
+#include "VertexAnimation.h"
+
+namespace Engine::Graphics
+{
+class Camera;
+class RenderGroup;
+
+// Draws crowds of a model from its vertex animation texture. The vertex shader reads each
+// vertex of each instance from the baked frames, so characters cost no CPU skinning and every
+// batch of instances is one instanced draw per mesh.
+class VertexAnimationEffect final
+{
+  public:
+    static constexpr uint32_t MaxInstancesPerDraw = 512;
+    static constexpr uint32_t MaxClips = 64;
+
+    void Initialize(const std::filesystem::path& path);
+    void Terminate();
+
+    void Begin();
+    void End();
+
+    // The group must have been initialized from the model the texture was baked from
+    void Render(const RenderGroup& renderGroup,
+                const VertexAnimationTexture& animationTexture,
+                const VertexAnimationInstance* instances,
+                uint32_t instanceCount);
+
+    void SetCamera(const Camera& camera);
+    void SetDirectionalLight(const DirectionalLight& directionalLight);
+    void SetTime(float time); // Seconds, shared by every instance
+
+    uint32_t GetDrawCount() const; // Draw calls issued since Begin
+
+  private:
+    struct FrameData
+    {
+        Math::Matrix4 viewProjection;
+        Math::Vector3 viewPosition;
+        float time = 0.0f;
+        Math::Vector3 boundsMin;
+        uint32_t textureWidth = 0;
+        Math::Vector3 boundsExtent;
+        uint32_t rowsPerFrame = 0;
+        uint32_t vertexOffset = 0;
+        int useDiffuseMap = 0;
+        float padding[2] = {};
+    };
+
+    struct ClipData
+    {
+        Math::Vector4 clips[MaxClips]; // First frame, frame count, duration
+    };
+
+    struct InstanceData
+    {
+        VertexAnimationInstance instances[MaxInstancesPerDraw]; // World matrices transposed
+    };
+
+    using FrameBuffer = TypedConstantBuffer<FrameData>;
+    using LightBuffer = TypedConstantBuffer<DirectionalLight>;
+    using MaterialBuffer = TypedConstantBuffer<Material>;
+    using ClipBuffer = TypedConstantBuffer<ClipData>;
+    using InstanceBuffer = TypedConstantBuffer<InstanceData>;
+
+    FrameBuffer mFrameBuffer;
+    LightBuffer mLightBuffer;
+    MaterialBuffer mMaterialBuffer;
+    ClipBuffer mClipBuffer;
+    InstanceBuffer mInstanceBuffer;
+
+    VertexShader mVertexShader;
+    PixelShader mPixelShader;
+    Sampler mSampler;
+
+    const Camera* mCamera = nullptr;
+    const DirectionalLight* mDirectionalLight = nullptr;
+    float mTime = 0.0f;
+    uint32_t mDrawCount = 0;
+
+    std::unique_ptr<InstanceData> mInstanceData; // Staging for one batch, too big for the stack
+};
+} // namespace Engine::Graphics
@@ -0,0 +1,578 @@
+#include "Precompiled.h"
+#include "AnimationClip.h"
+
+#include "BinaryIO.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+// The three smallest components of a unit quaternion are never larger than 1 / sqrt(2)
+constexpr float SmallestThreeRange = 0.70710678f;
+constexpr float RotationQuantizeMax = 32767.0f;
+constexpr float RotationDequantizeScale = 2.0f * SmallestThreeRange / RotationQuantizeMax;
+constexpr float VectorQuantizeMax = 65535.0f;
+
+constexpr uint32_t WordsPerTrack = 3;
+
+enum class ChannelType
+{
+    Rest,
+    Constant,
+    Animated
+};
+
+uint16_t QuantizeRotationComponent(float value)
+{
+    const float normalized = (value + SmallestThreeRange) / (2.0f * SmallestThreeRange);
+    const float clamped = Math::Clamp(normalized, 0.0f, 1.0f);
+    return static_cast<uint16_t>(clamped * RotationQuantizeMax + 0.5f);
+}
+
+// Two bits of the largest component's index go into the top bits of the first two words
+void EncodeRotation(const Math::Quaternion& rotation, uint16_t* words)
+{
+    const Math::Quaternion q = Math::Quaternion::Normalize(rotation);
+    float components[4] = {q.x, q.y, q.z, q.w};
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (fabsf(components[i]) > fabsf(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, keep the dropped component positive
+    const float sign = (components[largest] < 0.0f) ? -1.0f : 1.0f;
+    uint16_t quantized[3];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            quantized[count++] = QuantizeRotationComponent(components[i] * sign);
+        }
+    }
+
+    words[0] = static_cast<uint16_t>(quantized[0] | ((largest >> 1) << 15));
+    words[1] = static_cast<uint16_t>(quantized[1] | ((largest & 1) << 15));
+    words[2] = quantized[2];
+}
+
+Math::Quaternion DecodeRotation(const uint16_t* words)
+{
+    const uint32_t largest = ((words[0] >> 15) << 1) | (words[1] >> 15);
+    const float a = (words[0] & 0x7fff) * RotationDequantizeScale - SmallestThreeRange;
+    const float b = (words[1] & 0x7fff) * RotationDequantizeScale - SmallestThreeRange;
+    const float c = (words[2] & 0x7fff) * RotationDequantizeScale - SmallestThreeRange;
+    const float d = sqrtf(Math::Max(0.0f, 1.0f - a * a - b * b - c * c));
+    switch (largest)
+    {
+    case 0:
+        return {d, a, b, c};
+    case 1:
+        return {a, d, b, c};
+    case 2:
+        return {a, b, d, c};
+    default:
+        return {a, b, c, d};
+    }
+}
+
+float AngleBetween(const Math::Quaternion& a, const Math::Quaternion& b)
+{
+    const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    return 2.0f * acosf(Math::Min(1.0f, fabsf(dot)));
+}
+
+template <class T, class LerpFn>
+T SampleKeys(const std::vector<RawAnimationClip::Key<T>>& keys, float time, LerpFn lerp)
+{
+    if (time <= keys.front().time)
+    {
+        return keys.front().value;
+    }
+    if (time >= keys.back().time)
+    {
+        return keys.back().value;
+    }
+
+    auto next = std::upper_bound(keys.begin(),
+                                 keys.end(),
+                                 time,
+                                 [](float t, const RawAnimationClip::Key<T>& key)
+                                 { return t < key.time; });
+    const RawAnimationClip::Key<T>& k1 = *next;
+    const RawAnimationClip::Key<T>& k0 = *(next - 1);
+    const float span = k1.time - k0.time;
+    return lerp(k0.value, k1.value, (span > 0.0f) ? (time - k0.time) / span : 0.0f);
+}
+
+template <class T, class DistanceFn>
+ChannelType Classify(const std::vector<T>& samples,
+                     const T& rest,
+                     float tolerance,
+                     DistanceFn distance)
+{
+    bool isRest = true;
+    bool isConstant = true;
+    for (const T& sample : samples)
+    {
+        isRest = isRest && distance(sample, rest) <= tolerance;
+        isConstant = isConstant && distance(sample, samples.front()) <= tolerance;
+    }
+    if (isRest)
+    {
+        return ChannelType::Rest;
+    }
+    return isConstant ? ChannelType::Constant : ChannelType::Animated;
+}
+
+template <class T> size_t GetByteSize(const std::vector<T>& values)
+{
+    return values.size() * sizeof(T);
+}
+} // namespace
+
+size_t RawAnimationClip::GetMemorySize() const
+{
+    size_t size = sizeof(RawAnimationClip) + name.size();
+    for (const Track& track : tracks)
+    {
+        size += sizeof(Track) + GetByteSize(track.positionKeys) + GetByteSize(track.rotationKeys) +
+                GetByteSize(track.scaleKeys);
+    }
+    return size;
+}
+
+AnimationClip AnimationClip::Compress(const RawAnimationClip& rawClip,
+                                      const Skeleton& skeleton,
+                                      const AnimationCompressionSettings& settings)
+{
+    AnimationClip clip;
+    clip.mName = rawClip.name;
+    clip.mDuration = Math::Max(rawClip.duration, 0.0f);
+    clip.mBoneCount = static_cast<uint32_t>(skeleton.bones.size());
+    clip.mSegmentFrameCount = Math::Max(settings.segmentFrameCount, 1u);
+
+    // Frames are spread evenly over the clip so the last one lands exactly on the duration
+    const float frameSpan = clip.mDuration * settings.sampleRate;
+    clip.mFrameCount = static_cast<uint32_t>(ceilf(frameSpan - 0.001f)) + 1;
+    clip.mFrameCount = (clip.mDuration > 0.0f) ? Math::Max(clip.mFrameCount, 2u) : 1;
+    clip.mSampleRate =
+        (clip.mFrameCount > 1) ? static_cast<float>(clip.mFrameCount - 1) / clip.mDuration : 0.0f;
+
+    const uint32_t frameCount = clip.mFrameCount;
+    auto frameTime = [&](uint32_t frame)
+    { return (frame + 1 < frameCount) ? frame / clip.mSampleRate : clip.mDuration; };
+
+    auto lerpVector = [](const Math::Vector3& a, const Math::Vector3& b, float t)
+    { return a + (b - a) * t; };
+    auto vectorDistance = [](const Math::Vector3& a, const Math::Vector3& b)
+    { return Math::Magnitude(a - b); };
+
+    std::vector<std::vector<Math::Quaternion>> animatedRotations;
+    std::vector<std::vector<Math::Vector3>> animatedPositions;
+    std::vector<std::vector<Math::Vector3>> animatedScales;
+
+    std::vector<Math::Quaternion> rotations(frameCount);
+    std::vector<Math::Vector3> vectors(frameCount);
+    for (uint32_t bone = 0; bone < clip.mBoneCount; ++bone)
+    {
+        if (bone >= rawClip.tracks.size())
+        {
+            break;
+        }
+
+        const RawAnimationClip::Track& track = rawClip.tracks[bone];
+        const Transform& rest = skeleton.bones[bone].restTransform;
+        const uint16_t boneIndex = static_cast<uint16_t>(bone);
+
+        if (!track.rotationKeys.empty())
+        {
+            for (uint32_t f = 0; f < frameCount; ++f)
+            {
+                rotations[f] = Math::Quaternion::Normalize(
+                    SampleKeys(track.rotationKeys, frameTime(f), Math::Quaternion::Slerp));
+            }
+
+            switch (Classify(rotations, rest.rotation, settings.rotationTolerance, AngleBetween))
+            {
+            case ChannelType::Constant:
+                clip.mConstantRotationBones.push_back(boneIndex);
+                clip.mConstantRotations.push_back(rotations.front());
+                break;
+            case ChannelType::Animated:
+                clip.mAnimatedRotationBones.push_back(boneIndex);
+                animatedRotations.push_back(rotations);
+                break;
+            default:
+                break;
+            }
+        }
+
+        auto addVectorChannel = [&](const std::vector<RawAnimationClip::Key<Math::Vector3>>& keys,
+                                    const Math::Vector3& restValue,
+                                    float tolerance,
+                                    std::vector<uint16_t>& constantBones,
+                                    std::vector<Math::Vector3>& constantValues,
+                                    std::vector<uint16_t>& animatedBones,
+                                    std::vector<std::vector<Math::Vector3>>& animatedValues)
+        {
+            if (keys.empty())
+            {
+                return;
+            }
+
+            for (uint32_t f = 0; f < frameCount; ++f)
+            {
+                vectors[f] = SampleKeys(keys, frameTime(f), lerpVector);
+            }
+
+            switch (Classify(vectors, restValue, tolerance, vectorDistance))
+            {
+            case ChannelType::Constant:
+                constantBones.push_back(boneIndex);
+                constantValues.push_back(vectors.front());
+                break;
+            case ChannelType::Animated:
+                animatedBones.push_back(boneIndex);
+                animatedValues.push_back(vectors);
+                break;
+            default:
+                break;
+            }
+        };
+        addVectorChannel(track.positionKeys,
+                         rest.position,
+                         settings.positionTolerance,
+                         clip.mConstantPositionBones,
+                         clip.mConstantPositions,
+                         clip.mAnimatedPositionBones,
+                         animatedPositions);
+        addVectorChannel(track.scaleKeys,
+                         rest.scale,
+                         settings.scaleTolerance,
+                         clip.mConstantScaleBones,
+                         clip.mConstantScales,
+                         clip.mAnimatedScaleBones,
+                         animatedScales);
+    }
+
+    const uint32_t rotationCount = static_cast<uint32_t>(animatedRotations.size());
+    const uint32_t vectorCount =
+        static_cast<uint32_t>(animatedPositions.size() + animatedScales.size());
+    const uint32_t stride = (rotationCount + vectorCount) * WordsPerTrack;
+    clip.mFrameData.resize(static_cast<size_t>(frameCount) * stride);
+
+    for (uint32_t f = 0; f < frameCount; ++f)
+    {
+        uint16_t* words = clip.mFrameData.data() + static_cast<size_t>(f) * stride;
+        for (uint32_t r = 0; r < rotationCount; ++r)
+        {
+            EncodeRotation(animatedRotations[r][f], words + r * WordsPerTrack);
+        }
+    }
+
+    // Positions then scales share one range table, each track quantized per segment
+    std::vector<const std::vector<Math::Vector3>*> vectorTracks;
+    for (const std::vector<Math::Vector3>& values : animatedPositions)
+    {
+        vectorTracks.push_back(&values);
+    }
+    for (const std::vector<Math::Vector3>& values : animatedScales)
+    {
+        vectorTracks.push_back(&values);
+    }
+
+    const uint32_t segmentFrames = clip.mSegmentFrameCount;
+    const uint32_t segmentCount = (frameCount + segmentFrames - 1) / segmentFrames;
+    clip.mSegmentRanges.resize(static_cast<size_t>(segmentCount) * vectorCount * 6);
+    for (uint32_t segment = 0; segment < segmentCount; ++segment)
+    {
+        const uint32_t begin = segment * clip.mSegmentFrameCount;
+        const uint32_t end = Math::Min(begin + clip.mSegmentFrameCount, frameCount);
+        for (uint32_t v = 0; v < vectorCount; ++v)
+        {
+            const std::vector<Math::Vector3>& values = *vectorTracks[v];
+            Math::Vector3 minValue = values[begin];
+            Math::Vector3 maxValue = values[begin];
+            for (uint32_t f = begin + 1; f < end; ++f)
+            {
+                minValue = Math::Min(minValue, values[f]);
+                maxValue = Math::Max(maxValue, values[f]);
+            }
+            const Math::Vector3 extent = maxValue - minValue;
+
+            const size_t rangeIndex = static_cast<size_t>(segment) * vectorCount + v;
+            float* range = &clip.mSegmentRanges[rangeIndex * 6];
+            for (uint32_t axis = 0; axis < 3; ++axis)
+            {
+                range[axis] = minValue.v[axis];
+                range[axis + 3] = extent.v[axis];
+            }
+
+            for (uint32_t f = begin; f < end; ++f)
+            {
+                uint16_t* words = clip.mFrameData.data() + static_cast<size_t>(f) * stride +
+                                  (rotationCount + v) * WordsPerTrack;
+                for (uint32_t axis = 0; axis < 3; ++axis)
+                {
+                    const float normalized = (extent.v[axis] > 0.0f)
+                                                 ? (values[f].v[axis] - minValue.v[axis]) /
+                                                       extent.v[axis]
+                                                 : 0.0f;
+                    words[axis] = static_cast<uint16_t>(
+                        Math::Clamp(normalized, 0.0f, 1.0f) * VectorQuantizeMax + 0.5f);
+                }
+            }
+        }
+    }
+
+    return clip;
+}
+
+void AnimationClip::Sample(const Skeleton& skeleton, float time, bool looping, Pose& outPose) const
+{
+    ASSERT(skeleton.bones.size() == mBoneCount, "AnimationClip: Clip does not fit the skeleton");
+    ASSERT(skeleton.restPose.GetBoneCount() == mBoneCount, "AnimationClip: Missing rest pose");
+
+    outPose.rotations = skeleton.restPose.rotations;
+    outPose.positions = skeleton.restPose.positions;
+    outPose.scales = skeleton.restPose.scales;
+
+    for (size_t i = 0; i < mConstantRotationBones.size(); ++i)
+    {
+        outPose.rotations[mConstantRotationBones[i]] = mConstantRotations[i];
+    }
+    for (size_t i = 0; i < mConstantPositionBones.size(); ++i)
+    {
+        outPose.positions[mConstantPositionBones[i]] = mConstantPositions[i];
+    }
+    for (size_t i = 0; i < mConstantScaleBones.size(); ++i)
+    {
+        outPose.scales[mConstantScaleBones[i]] = mConstantScales[i];
+    }
+
+    if (mFrameCount == 0 || mFrameData.empty())
+    {
+        return;
+    }
+
+    float clipTime = Math::Clamp(time, 0.0f, mDuration);
+    if (looping && mDuration > 0.0f)
+    {
+        clipTime = fmodf(time, mDuration);
+        clipTime = (clipTime < 0.0f) ? clipTime + mDuration : clipTime;
+    }
+
+    const float framePosition = clipTime * mSampleRate;
+    const uint32_t frame0 = Math::Min(static_cast<uint32_t>(framePosition), mFrameCount - 1);
+    const uint32_t frame1 = Math::Min(frame0 + 1, mFrameCount - 1);
+    const float alpha = Math::Clamp(framePosition - frame0, 0.0f, 1.0f);
+
+    // Rotations are decoded in blocks, so the scratch space stays on the stack
+    constexpr uint32_t BlockSize = 64;
+    Math::Quaternion from[BlockSize];
+    Math::Quaternion to[BlockSize];
+    const uint32_t rotationCount = static_cast<uint32_t>(mAnimatedRotationBones.size());
+    for (uint32_t first = 0; first < rotationCount; first += BlockSize)
+    {
+        const uint32_t count = Math::Min(BlockSize, rotationCount - first);
+        DecodeRotations(frame0, first, count, from);
+        DecodeRotations(frame1, first, count, to);
+        Math::NlerpQuaternions(from, to, alpha, count, from);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            outPose.rotations[mAnimatedRotationBones[first + i]] = from[i];
+        }
+    }
+
+    const uint32_t positionCount = static_cast<uint32_t>(mAnimatedPositionBones.size());
+    for (uint32_t i = 0; i < positionCount; ++i)
+    {
+        outPose.positions[mAnimatedPositionBones[i]] =
+            Math::Lerp(DecodeVector(frame0, i), DecodeVector(frame1, i), alpha);
+    }
+
+    const uint32_t scaleCount = static_cast<uint32_t>(mAnimatedScaleBones.size());
+    for (uint32_t i = 0; i < scaleCount; ++i)
+    {
+        const uint32_t track = positionCount + i;
+        outPose.scales[mAnimatedScaleBones[i]] =
+            Math::Lerp(DecodeVector(frame0, track), DecodeVector(frame1, track), alpha);
+    }
+}
+
+const std::string& AnimationClip::GetName() const
+{
+    return mName;
+}
+
+float AnimationClip::GetDuration() const
+{
+    return mDuration;
+}
+
+uint32_t AnimationClip::GetFrameCount() const
+{
+    return mFrameCount;
+}
+
+uint32_t AnimationClip::GetBoneCount() const
+{
+    return mBoneCount;
+}
+
+AnimationClip::Stats AnimationClip::GetStats() const
+{
+    Stats stats;
+    stats.animatedRotations = static_cast<uint32_t>(mAnimatedRotationBones.size());
+    stats.animatedPositions = static_cast<uint32_t>(mAnimatedPositionBones.size());
+    stats.animatedScales = static_cast<uint32_t>(mAnimatedScaleBones.size());
+    stats.constantChannels = static_cast<uint32_t>(mConstantRotationBones.size() +
+                                                   mConstantPositionBones.size() +
+                                                   mConstantScaleBones.size());
+    stats.restChannels = mBoneCount * 3 - stats.animatedRotations - stats.animatedPositions -
+                         stats.animatedScales - stats.constantChannels;
+    return stats;
+}
+
+size_t AnimationClip::GetMemorySize() const
+{
+    return sizeof(AnimationClip) + mName.size() + GetByteSize(mConstantRotationBones) +
+           GetByteSize(mConstantRotations) + GetByteSize(mConstantPositionBones) +
+           GetByteSize(mConstantPositions) + GetByteSize(mConstantScaleBones) +
+           GetByteSize(mConstantScales) + GetByteSize(mAnimatedRotationBones) +
+           GetByteSize(mAnimatedPositionBones) + GetByteSize(mAnimatedScaleBones) +
+           GetByteSize(mSegmentRanges) + GetByteSize(mFrameData);
+}
+
+void AnimationClip::Write(FILE* file) const
+{
+    BinaryIO::WriteString(file, mName);
+
+    fwrite(&mDuration, sizeof(mDuration), 1, file);
+    fwrite(&mSampleRate, sizeof(mSampleRate), 1, file);
+    fwrite(&mFrameCount, sizeof(mFrameCount), 1, file);
+    fwrite(&mSegmentFrameCount, sizeof(mSegmentFrameCount), 1, file);
+    fwrite(&mBoneCount, sizeof(mBoneCount), 1, file);
+
+    BinaryIO::WriteVector(file, mConstantRotationBones);
+    BinaryIO::WriteVector(file, mConstantRotations);
+    BinaryIO::WriteVector(file, mConstantPositionBones);
+    BinaryIO::WriteVector(file, mConstantPositions);
+    BinaryIO::WriteVector(file, mConstantScaleBones);
+    BinaryIO::WriteVector(file, mConstantScales);
+    BinaryIO::WriteVector(file, mAnimatedRotationBones);
+    BinaryIO::WriteVector(file, mAnimatedPositionBones);
+    BinaryIO::WriteVector(file, mAnimatedScaleBones);
+    BinaryIO::WriteVector(file, mSegmentRanges);
+    BinaryIO::WriteVector(file, mFrameData);
+}
+
+bool AnimationClip::Read(FILE* file)
+{
+    bool success = BinaryIO::ReadString(file, mName);
+    success = success && fread(&mDuration, sizeof(mDuration), 1, file) == 1;
+    success = success && fread(&mSampleRate, sizeof(mSampleRate), 1, file) == 1;
+    success = success && fread(&mFrameCount, sizeof(mFrameCount), 1, file) == 1;
+    success = success && fread(&mSegmentFrameCount, sizeof(mSegmentFrameCount), 1, file) == 1;
+    success = success && fread(&mBoneCount, sizeof(mBoneCount), 1, file) == 1;
+
+    success = success && BinaryIO::ReadVector(file, mConstantRotationBones);
+    success = success && BinaryIO::ReadVector(file, mConstantRotations);
+    success = success && BinaryIO::ReadVector(file, mConstantPositionBones);
+    success = success && BinaryIO::ReadVector(file, mConstantPositions);
+    success = success && BinaryIO::ReadVector(file, mConstantScaleBones);
+    success = success && BinaryIO::ReadVector(file, mConstantScales);
+    success = success && BinaryIO::ReadVector(file, mAnimatedRotationBones);
+    success = success && BinaryIO::ReadVector(file, mAnimatedPositionBones);
+    success = success && BinaryIO::ReadVector(file, mAnimatedScaleBones);
+    success = success && BinaryIO::ReadVector(file, mSegmentRanges);
+    success = success && BinaryIO::ReadVector(file, mFrameData);
+    return success;
+}
+
+void AnimationClip::DecodeRotations(uint32_t frame,
+                                    uint32_t first,
+                                    uint32_t count,
+                                    Math::Quaternion* out) const
+{
+    const uint32_t stride = static_cast<uint32_t>(mAnimatedRotationBones.size() +
+                                                  mAnimatedPositionBones.size() +
+                                                  mAnimatedScaleBones.size()) *
+                            WordsPerTrack;
+    const uint16_t* words =
+        mFrameData.data() + static_cast<size_t>(frame) * stride + first * WordsPerTrack;
+
+    uint32_t i = 0;
+#ifdef MATH_USE_SSE
+    const __m128i low15 = _mm_set1_epi32(0x7fff);
+    const __m128 scale = _mm_set1_ps(RotationDequantizeScale);
+    const __m128 range = _mm_set1_ps(SmallestThreeRange);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    auto select = [](__m128 mask, __m128 a, __m128 b)
+    { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+    auto dequantize = [&](__m128i words)
+    { return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(words, low15)), scale), range); };
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint16_t* w = words + i * WordsPerTrack;
+        const __m128i w0 = _mm_set_epi32(w[9], w[6], w[3], w[0]);
+        const __m128i w1 = _mm_set_epi32(w[10], w[7], w[4], w[1]);
+        const __m128i w2 = _mm_set_epi32(w[11], w[8], w[5], w[2]);
+
+        const __m128i largest =
+            _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(w0, 15), 1), _mm_srli_epi32(w1, 15));
+        const __m128 a = dequantize(w0);
+        const __m128 b = dequantize(w1);
+        const __m128 c = dequantize(w2);
+        const __m128 sumSq =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c));
+        const __m128 d = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, sumSq)));
+
+        // Put the rebuilt component back in its slot, the others keep their order
+        const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(0)));
+        const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+        const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+        const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+        __m128 x = select(is0, d, a);
+        __m128 y = select(is0, a, select(is1, d, b));
+        __m128 z = select(_mm_or_ps(is0, is1), b, select(is2, d, c));
+        __m128 qw = select(is3, d, c);
+
+        _MM_TRANSPOSE4_PS(x, y, z, qw);
+        _mm_storeu_ps(&out[i + 0].x, x);
+        _mm_storeu_ps(&out[i + 1].x, y);
+        _mm_storeu_ps(&out[i + 2].x, z);
+        _mm_storeu_ps(&out[i + 3].x, qw);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        out[i] = DecodeRotation(words + i * WordsPerTrack);
+    }
+}
+
+Math::Vector3 AnimationClip::DecodeVector(uint32_t frame, uint32_t track) const
+{
+    const uint32_t rotationCount = static_cast<uint32_t>(mAnimatedRotationBones.size());
+    const uint32_t vectorCount =
+        static_cast<uint32_t>(mAnimatedPositionBones.size() + mAnimatedScaleBones.size());
+    const uint32_t stride = (rotationCount + vectorCount) * WordsPerTrack;
+    const uint16_t* words = mFrameData.data() + static_cast<size_t>(frame) * stride +
+                            (rotationCount + track) * WordsPerTrack;
+
+    const uint32_t segment = frame / mSegmentFrameCount;
+    const float* range = &mSegmentRanges[(static_cast<size_t>(segment) * vectorCount + track) * 6];
+    constexpr float invMax = 1.0f / VectorQuantizeMax;
+    return {range[0] + words[0] * invMax * range[3],
+            range[1] + words[1] * invMax * range[4],
+            range[2] + words[2] * invMax * range[5]};
+}
@@ -0,0 +1,922 @@
+#include "Precompiled.h"
+#include "AnimationGraph.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+using NodeType = AnimationGraphDesc::NodeType;
+
+// Characters per job, one evaluation costs a few microseconds
+constexpr uint32_t CharacterGrainSize = 8;
+
+std::atomic<uint32_t> sInstanceCount{0};
+
+float Saturate(float value)
+{
+    return Math::Clamp(value, 0.0f, 1.0f);
+}
+
+float AdvancePhase(float phase, float step, bool looping)
+{
+    phase += step;
+    return looping ? phase - floorf(phase) : Math::Min(phase, 1.0f);
+}
+
+// Clip whose first frame is the reference of an additive input
+int FindFirstClip(const AnimationGraphDesc& desc, uint32_t nodeIndex, uint32_t depth = 0)
+{
+    if (nodeIndex >= desc.nodes.size() || depth > desc.nodes.size())
+    {
+        return -1;
+    }
+
+    const AnimationGraphDesc::Node& node = desc.nodes[nodeIndex];
+    switch (node.type)
+    {
+    case NodeType::Clip:
+        return static_cast<int>(node.clipIndex);
+    case NodeType::BlendSpace1D:
+    case NodeType::BlendSpace2D:
+        return node.samples.empty() ? -1 : static_cast<int>(node.samples[0].clipIndex);
+    case NodeType::StateMachine:
+        return node.states.empty() ? -1 : FindFirstClip(desc, node.states[0], depth + 1);
+    default:
+        return FindFirstClip(desc, node.inputs[0], depth + 1);
+    }
+}
+} // namespace
+
+uint32_t AnimationGraphDesc::AddParameter(const std::string& name)
+{
+    parameters.push_back(name);
+    return static_cast<uint32_t>(parameters.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddClip(uint32_t clipIndex, bool looping, float speed)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::Clip;
+    node.clipIndex = clipIndex;
+    node.looping = looping;
+    node.speed = speed;
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddBlend(uint32_t from, uint32_t to, int weightParameter, float weight)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::Blend;
+    node.inputs[0] = from;
+    node.inputs[1] = to;
+    node.weightParameter = weightParameter;
+    node.weight = weight;
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddBlendSpace1D(uint32_t parameter, std::vector<BlendSample> samples)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::BlendSpace1D;
+    node.parameters[0] = parameter;
+    node.samples = std::move(samples);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddBlendSpace2D(uint32_t parameterX,
+                                             uint32_t parameterY,
+                                             std::vector<BlendSample> samples)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::BlendSpace2D;
+    node.parameters[0] = parameterX;
+    node.parameters[1] = parameterY;
+    node.samples = std::move(samples);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddAdditive(uint32_t base,
+                                         uint32_t additive,
+                                         int weightParameter,
+                                         float weight)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::Additive;
+    node.inputs[0] = base;
+    node.inputs[1] = additive;
+    node.weightParameter = weightParameter;
+    node.weight = weight;
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddLayered(uint32_t base,
+                                        uint32_t layer,
+                                        std::vector<float> boneMask,
+                                        int weightParameter,
+                                        float weight)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::Layered;
+    node.inputs[0] = base;
+    node.inputs[1] = layer;
+    node.boneMask = std::move(boneMask);
+    node.weightParameter = weightParameter;
+    node.weight = weight;
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t AnimationGraphDesc::AddStateMachine(std::vector<uint32_t> states)
+{
+    Node& node = nodes.emplace_back();
+    node.type = NodeType::StateMachine;
+    node.states = std::move(states);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void AnimationGraphDesc::AddTransition(uint32_t stateMachine, const Transition& transition)
+{
+    ASSERT(stateMachine < nodes.size() && nodes[stateMachine].type == NodeType::StateMachine,
+           "AnimationGraphDesc: Node %u is not a state machine",
+           stateMachine);
+    nodes[stateMachine].transitions.push_back(transition);
+}
+
+struct AnimationGraph::CompileContext
+{
+    const AnimationGraphDesc& desc;
+    std::vector<bool> visiting;
+};
+
+bool AnimationGraph::Compile(const AnimationGraphDesc& desc,
+                             const Skeleton& skeleton,
+                             const std::vector<AnimationClip>& clips)
+{
+    mSkeleton = &skeleton;
+    mClips = &clips;
+    mInstructions.clear();
+    mParameterNames = desc.parameters;
+    mInitialWeights.assign(1, 1.0f); // Slot 0 is a full weight, instructions default to it
+    mClocks.clear();
+    mBlendSpaces.clear();
+    mStateMachines.clear();
+    mAdditiveReferences.clear();
+    mBoneMasks.clear();
+    mRegisterCount = 0;
+
+    CompileContext context{desc, std::vector<bool>(desc.nodes.size(), false)};
+    if (!CompileNode(context, desc.root, 0))
+    {
+        mInstructions.clear();
+        return false;
+    }
+    return true;
+}
+
+bool AnimationGraph::CompileNode(CompileContext& context, uint32_t nodeIndex, uint16_t target)
+{
+    const AnimationGraphDesc& desc = context.desc;
+    if (nodeIndex >= desc.nodes.size())
+    {
+        LOG_ERROR(Animation, "AnimationGraph: Invalid node index %u", nodeIndex);
+        return false;
+    }
+    if (context.visiting[nodeIndex])
+    {
+        LOG_ERROR(Animation, "AnimationGraph: Node %u is reachable from itself", nodeIndex);
+        return false;
+    }
+    context.visiting[nodeIndex] = true;
+
+    const uint32_t boneCount = static_cast<uint32_t>(mSkeleton->bones.size());
+    const uint32_t parameterCount = static_cast<uint32_t>(desc.parameters.size());
+    const AnimationGraphDesc::Node& node = desc.nodes[nodeIndex];
+    const auto isValidClip = [&](uint32_t clipIndex)
+    {
+        if (clipIndex >= mClips->size() || (*mClips)[clipIndex].GetBoneCount() != boneCount)
+        {
+            LOG_ERROR(Animation,
+                      "AnimationGraph: Clip %u is missing or does not fit the skeleton",
+                      clipIndex);
+            return false;
+        }
+        return true;
+    };
+    const auto emit = [this](const Instruction& instruction)
+    {
+        mInstructions.push_back(instruction);
+        return mInstructions.size() - 1;
+    };
+    const auto patchSkip = [this](size_t skipIndex)
+    {
+        mInstructions[skipIndex].count =
+            static_cast<uint16_t>(mInstructions.size() - skipIndex - 1);
+    };
+    const auto addWeight = [this](float initialWeight)
+    {
+        mInitialWeights.push_back(initialWeight);
+        return static_cast<uint16_t>(mInitialWeights.size() - 1);
+    };
+
+    mRegisterCount = Math::Max(mRegisterCount, target + 1u);
+
+    bool result = true;
+    switch (node.type)
+    {
+    case NodeType::Clip:
+    {
+        if (!isValidClip(node.clipIndex))
+        {
+            result = false;
+            break;
+        }
+        const uint16_t clock = static_cast<uint16_t>(mClocks.size());
+        mClocks.push_back({node.looping, node.speed});
+        const uint16_t clip = static_cast<uint16_t>(node.clipIndex);
+        emit({Op::AdvanceClock, 0, 0, clip, clock});
+        emit({Op::Sample, target, 0, clip, clock});
+        break;
+    }
+    case NodeType::Blend:
+    case NodeType::Additive:
+    case NodeType::Layered:
+    {
+        if (node.weightParameter >= static_cast<int>(parameterCount))
+        {
+            LOG_ERROR(Animation,
+                      "AnimationGraph: Invalid weight parameter %d",
+                      node.weightParameter);
+            result = false;
+            break;
+        }
+
+        // Constant weights drop the branch they never use
+        const bool isConstant = node.weightParameter < 0;
+        if (isConstant && node.weight <= 0.0f)
+        {
+            result = CompileNode(context, node.inputs[0], target);
+            break;
+        }
+        if (isConstant && node.weight >= 1.0f && node.type == NodeType::Blend)
+        {
+            result = CompileNode(context, node.inputs[1], target);
+            break;
+        }
+
+        const uint16_t weight = addWeight(isConstant ? Saturate(node.weight) : 0.0f);
+        if (!isConstant)
+        {
+            emit({Op::LoadParameter, 0, 0, static_cast<uint16_t>(node.weightParameter), 0, weight});
+        }
+
+        Instruction combine{Op::Blend, target, static_cast<uint16_t>(target + 1), 0, 0, weight};
+        if (node.type == NodeType::Additive)
+        {
+            const int clipIndex = FindFirstClip(desc, node.inputs[1]);
+            if (clipIndex < 0 || !isValidClip(clipIndex))
+            {
+                result = false;
+                break;
+            }
+            Pose& reference = mAdditiveReferences.emplace_back();
+            (*mClips)[clipIndex].Sample(*mSkeleton, 0.0f, false, reference);
+            combine.op = Op::Additive;
+            combine.index = static_cast<uint16_t>(mAdditiveReferences.size() - 1);
+        }
+        else if (node.type == NodeType::Layered)
+        {
+            if (node.boneMask.size() != boneCount)
+            {
+                LOG_ERROR(Animation,
+                          "AnimationGraph: Bone mask of node %u does not fit the skeleton",
+                          nodeIndex);
+                result = false;
+                break;
+            }
+            mBoneMasks.push_back(node.boneMask);
+            combine.op = Op::Layered;
+            combine.index = static_cast<uint16_t>(mBoneMasks.size() - 1);
+        }
+
+        // A full blend does not need the first input
+        const size_t skipFirst = (node.type == NodeType::Blend)
+                                     ? emit({Op::SkipIfOne, 0, 0, 0, 0, weight})
+                                     : SIZE_MAX;
+        result = CompileNode(context, node.inputs[0], target);
+        if (skipFirst != SIZE_MAX)
+        {
+            patchSkip(skipFirst);
+        }
+
+        const size_t skipSecond = emit({Op::SkipIfZero, 0, 0, 0, 0, weight});
+        result = result && CompileNode(context, node.inputs[1], target + 1);
+        emit(combine);
+        patchSkip(skipSecond);
+        break;
+    }
+    case NodeType::BlendSpace1D:
+    case NodeType::BlendSpace2D:
+    {
+        const bool twoDimensional = node.type == NodeType::BlendSpace2D;
+        if (node.samples.empty() || node.parameters[0] >= parameterCount ||
+            (twoDimensional && node.parameters[1] >= parameterCount))
+        {
+            LOG_ERROR(Animation,
+                      "AnimationGraph: Blend space %u has no samples or invalid parameters",
+                      nodeIndex);
+            result = false;
+            break;
+        }
+
+        std::vector<AnimationGraphDesc::BlendSample> samples = node.samples;
+        if (!twoDimensional)
+        {
+            std::sort(samples.begin(),
+                      samples.end(),
+                      [](const auto& a, const auto& b) { return a.position.x < b.position.x; });
+        }
+
+        BlendSpace& space = mBlendSpaces.emplace_back();
+        space.parameters[0] = static_cast<uint16_t>(node.parameters[0]);
+        space.parameters[1] = static_cast<uint16_t>(node.parameters[1]);
+        space.clock = static_cast<uint16_t>(mClocks.size());
+        mClocks.push_back({true, 1.0f});
+        space.firstWeight = static_cast<uint16_t>(mInitialWeights.size());
+        for (const AnimationGraphDesc::BlendSample& sample : samples)
+        {
+            if (!isValidClip(sample.clipIndex))
+            {
+                result = false;
+                break;
+            }
+            space.clipIndices.push_back(sample.clipIndex);
+            space.positions.push_back(sample.position);
+            addWeight(0.0f);
+        }
+        if (!result)
+        {
+            break;
+        }
+
+        mRegisterCount = Math::Max(mRegisterCount, target + 2u);
+        const uint16_t spaceIndex = static_cast<uint16_t>(mBlendSpaces.size() - 1);
+        emit({twoDimensional ? Op::BlendSpace2D : Op::BlendSpace1D, 0, 0, spaceIndex});
+        emit({Op::Clear, target});
+        for (size_t i = 0; i < space.clipIndices.size(); ++i)
+        {
+            emit({Op::AccumulateSample,
+                  target,
+                  static_cast<uint16_t>(target + 1),
+                  static_cast<uint16_t>(space.clipIndices[i]),
+                  space.clock,
+                  static_cast<uint16_t>(space.firstWeight + i)});
+        }
+        break;
+    }
+    case NodeType::StateMachine:
+    {
+        const uint32_t stateCount = static_cast<uint32_t>(node.states.size());
+        for (const AnimationGraphDesc::Transition& transition : node.transitions)
+        {
+            if (transition.toState >= stateCount || transition.parameter >= parameterCount ||
+                transition.fromState >= static_cast<int>(stateCount))
+            {
+                LOG_ERROR(Animation,
+                          "AnimationGraph: Invalid transition in state machine %u",
+                          nodeIndex);
+                result = false;
+            }
+        }
+        if (stateCount == 0 || !result)
+        {
+            result = false;
+            break;
+        }
+
+        // Nested state machines are compiled first, so this one is added after its states
+        StateMachine machine;
+        machine.transitions = node.transitions;
+        machine.stateCount = static_cast<uint16_t>(stateCount);
+        machine.firstWeight = static_cast<uint16_t>(mInitialWeights.size());
+        for (uint32_t s = 0; s < stateCount; ++s)
+        {
+            addWeight(0.0f);
+        }
+
+        const size_t machineInstruction = emit({Op::StateMachine});
+        emit({Op::Clear, target});
+        for (uint32_t s = 0; s < stateCount && result; ++s)
+        {
+            const uint16_t weight = static_cast<uint16_t>(machine.firstWeight + s);
+            const uint16_t firstClock = static_cast<uint16_t>(mClocks.size());
+            const size_t skip = emit({Op::SkipIfZero, 0, 0, 0, 0, weight});
+            result = CompileNode(context, node.states[s], target + 1);
+            emit({Op::Accumulate, target, static_cast<uint16_t>(target + 1), 0, 0, weight});
+            patchSkip(skip);
+            machine.stateClocks.emplace_back(firstClock, static_cast<uint16_t>(mClocks.size()));
+        }
+        mStateMachines.push_back(std::move(machine));
+        mInstructions[machineInstruction].index =
+            static_cast<uint16_t>(mStateMachines.size() - 1);
+        break;
+    }
+    }
+
+    context.visiting[nodeIndex] = false;
+    return result;
+}
+
+int AnimationGraph::FindParameter(const std::string& name) const
+{
+    for (size_t i = 0; i < mParameterNames.size(); ++i)
+    {
+        if (mParameterNames[i] == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+uint32_t AnimationGraph::GetParameterCount() const
+{
+    return static_cast<uint32_t>(mParameterNames.size());
+}
+
+uint32_t AnimationGraph::GetInstructionCount() const
+{
+    return static_cast<uint32_t>(mInstructions.size());
+}
+
+uint32_t AnimationGraph::GetRegisterCount() const
+{
+    return mRegisterCount;
+}
+
+const Skeleton* AnimationGraph::GetSkeleton() const
+{
+    return mSkeleton;
+}
+
+uint32_t AnimationLodSettings::GetInterval(float distance) const
+{
+    if (distance >= lowRateDistance)
+    {
+        return Math::Max(lowRateInterval, 1u);
+    }
+    if (distance >= reducedRateDistance)
+    {
+        return Math::Max(reducedRateInterval, 1u);
+    }
+    return 1;
+}
+
+// Pose registers, one set per thread and reused by every character it evaluates
+struct AnimationGraphInstance::Scratch
+{
+    std::vector<Pose> registers;
+    std::vector<float> weightSums;
+};
+
+void AnimationGraphInstance::Initialize(const AnimationGraph& graph)
+{
+    ASSERT(graph.GetInstructionCount() > 0, "AnimationGraphInstance: Graph is not compiled");
+    mGraph = &graph;
+    mParameters.assign(graph.GetParameterCount(), 0.0f);
+    mWeights = graph.mInitialWeights;
+    mClocks.assign(graph.mClocks.size(), 0.0f);
+    mMachineStates.assign(graph.mStateMachines.size(), {});
+
+    mLodDistance = 0.0f;
+    mInterval = 1;
+    mFramesSinceEvaluation = 0;
+    mEvaluationCount = 0;
+    mStagger = sInstanceCount.fetch_add(1, std::memory_order_relaxed);
+    mPendingTime = 0.0f;
+
+    const Skeleton& skeleton = *graph.mSkeleton;
+    const uint32_t boneCount = static_cast<uint32_t>(skeleton.bones.size());
+    mPose = skeleton.restPose;
+    mPreviousPose = skeleton.restPose;
+    mNextPose = skeleton.restPose;
+    mModelMatrices.resize(boneCount);
+    mSkinningMatrices.resize(boneCount);
+    ComputeModelMatrices(skeleton, mPose, mModelMatrices.data());
+    ComputeSkinningMatrices(skeleton, mModelMatrices.data(), mSkinningMatrices.data());
+}
+
+void AnimationGraphInstance::Terminate()
+{
+    mGraph = nullptr;
+}
+
+void AnimationGraphInstance::SetParameter(uint32_t parameter, float value)
+{
+    ASSERT(parameter < mParameters.size(),
+           "AnimationGraphInstance: Invalid parameter %u",
+           parameter);
+    mParameters[parameter] = value;
+}
+
+float AnimationGraphInstance::GetParameter(uint32_t parameter) const
+{
+    ASSERT(parameter < mParameters.size(),
+           "AnimationGraphInstance: Invalid parameter %u",
+           parameter);
+    return mParameters[parameter];
+}
+
+void AnimationGraphInstance::SetLodDistance(float distance)
+{
+    mLodDistance = distance;
+}
+
+void AnimationGraphInstance::Update(float deltaTime, const AnimationLodSettings& lodSettings)
+{
+    if (mGraph == nullptr)
+    {
+        return;
+    }
+
+    thread_local Scratch scratch;
+
+    const uint32_t interval = lodSettings.GetInterval(mLodDistance);
+    mPendingTime += deltaTime;
+    ++mFramesSinceEvaluation;
+
+    // Moving closer takes effect right away, the previous interval is kept otherwise
+    if (mEvaluationCount == 0 || mFramesSinceEvaluation >= Math::Min(mInterval, interval))
+    {
+        std::swap(mPreviousPose, mNextPose);
+        Evaluate(mPendingTime, scratch);
+        mPendingTime = 0.0f;
+        mFramesSinceEvaluation = 0;
+        mInterval = interval;
+        if (mEvaluationCount++ == 0)
+        {
+            mPreviousPose = mNextPose;
+            mFramesSinceEvaluation = mStagger % interval;
+        }
+    }
+
+    // Evaluations land one interval ahead of what is shown, the pose catches up to them
+    const float t = static_cast<float>(mFramesSinceEvaluation + 1) / mInterval;
+    if (t >= 1.0f)
+    {
+        mPose = mNextPose;
+    }
+    else
+    {
+        BlendPoses(mPreviousPose, mNextPose, t, mPose);
+    }
+
+    const Skeleton& skeleton = *mGraph->mSkeleton;
+    ComputeModelMatrices(skeleton, mPose, mModelMatrices.data());
+    ComputeSkinningMatrices(skeleton, mModelMatrices.data(), mSkinningMatrices.data());
+}
+
+void AnimationGraphInstance::Update(AnimationGraphInstance* const* instances,
+                                    uint32_t count,
+                                    float deltaTime,
+                                    const AnimationLodSettings& lodSettings)
+{
+    Core::JobSystem::Get()->ParallelFor(
+        count,
+        CharacterGrainSize,
+        [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                instances[i]->Update(deltaTime, lodSettings);
+            }
+        });
+}
+
+const Pose& AnimationGraphInstance::GetPose() const
+{
+    return mPose;
+}
+
+const std::vector<Math::Matrix4>& AnimationGraphInstance::GetModelMatrices() const
+{
+    return mModelMatrices;
+}
+
+const std::vector<Math::Matrix4>& AnimationGraphInstance::GetSkinningMatrices() const
+{
+    return mSkinningMatrices;
+}
+
+int AnimationGraphInstance::GetCurrentState(uint32_t stateMachine) const
+{
+    ASSERT(stateMachine < mMachineStates.size(), "AnimationGraphInstance: Invalid state machine");
+    return mMachineStates[stateMachine].current;
+}
+
+uint32_t AnimationGraphInstance::GetUpdateInterval() const
+{
+    return mInterval;
+}
+
+uint32_t AnimationGraphInstance::GetEvaluationCount() const
+{
+    return mEvaluationCount;
+}
+
+void AnimationGraphInstance::Evaluate(float deltaTime, Scratch& scratch)
+{
+    using Op = AnimationGraph::Op;
+
+    const AnimationGraph& graph = *mGraph;
+    const Skeleton& skeleton = *graph.mSkeleton;
+    const std::vector<AnimationClip>& clips = *graph.mClips;
+    const uint32_t boneCount = static_cast<uint32_t>(skeleton.bones.size());
+
+    if (scratch.registers.size() < graph.mRegisterCount)
+    {
+        scratch.registers.resize(graph.mRegisterCount);
+        scratch.weightSums.resize(graph.mRegisterCount);
+    }
+    std::vector<Pose>& registers = scratch.registers;
+    std::vector<float>& weightSums = scratch.weightSums;
+    for (uint32_t r = 0; r < graph.mRegisterCount; ++r)
+    {
+        registers[r].Resize(boneCount);
+    }
+
+    const uint32_t instructionCount = static_cast<uint32_t>(graph.mInstructions.size());
+    for (uint32_t pc = 0; pc < instructionCount; ++pc)
+    {
+        const AnimationGraph::Instruction& instruction = graph.mInstructions[pc];
+        Pose& target = registers[instruction.target];
+        Pose& source = registers[instruction.source];
+        const float weight = mWeights[instruction.weight];
+
+        switch (instruction.op)
+        {
+        case Op::LoadParameter:
+            mWeights[instruction.weight] = Saturate(mParameters[instruction.index]);
+            break;
+        case Op::StateMachine:
+            RunStateMachine(instruction.index, deltaTime);
+            break;
+        case Op::BlendSpace1D:
+        case Op::BlendSpace2D:
+        {
+            // Every clip of the space moves through its cycle at the blended rate
+            const AnimationGraph::BlendSpace& space = graph.mBlendSpaces[instruction.index];
+            ComputeBlendSpaceWeights(space, instruction.op == Op::BlendSpace2D);
+            float duration = 0.0f;
+            for (size_t i = 0; i < space.clipIndices.size(); ++i)
+            {
+                duration += mWeights[space.firstWeight + i] *
+                            clips[space.clipIndices[i]].GetDuration();
+            }
+            if (duration > 0.0f)
+            {
+                mClocks[space.clock] =
+                    AdvancePhase(mClocks[space.clock], deltaTime / duration, true);
+            }
+            break;
+        }
+        case Op::AdvanceClock:
+        {
+            const AnimationGraph::Clock& clock = graph.mClocks[instruction.clock];
+            const float duration = clips[instruction.index].GetDuration();
+            if (duration > 0.0f)
+            {
+                mClocks[instruction.clock] = AdvancePhase(
+                    mClocks[instruction.clock], deltaTime * clock.speed / duration, clock.looping);
+            }
+            break;
+        }
+        case Op::SkipIfZero:
+            if (weight <= 0.0f)
+            {
+                pc += instruction.count;
+            }
+            break;
+        case Op::SkipIfOne:
+            if (weight >= 1.0f)
+            {
+                pc += instruction.count;
+            }
+            break;
+        case Op::Clear:
+            weightSums[instruction.target] = 0.0f;
+            break;
+        case Op::Sample:
+            clips[instruction.index].Sample(skeleton,
+                                            GetClipTime(instruction.index, instruction.clock),
+                                            graph.mClocks[instruction.clock].looping,
+                                            target);
+            break;
+        case Op::AccumulateSample:
+        case Op::Accumulate:
+        {
+            if (weight <= 0.0f)
+            {
+                break;
+            }
+
+            // The first input lands in the target directly, later ones blend in by their share
+            const float sum = weightSums[instruction.target];
+            if (instruction.op == Op::AccumulateSample)
+            {
+                const float time = GetClipTime(instruction.index, instruction.clock);
+                const bool looping = graph.mClocks[instruction.clock].looping;
+                clips[instruction.index].Sample(
+                    skeleton, time, looping, (sum > 0.0f) ? source : target);
+            }
+            else if (sum <= 0.0f)
+            {
+                std::swap(target, source);
+            }
+
+            if (sum > 0.0f)
+            {
+                BlendPoses(target, source, weight / (sum + weight), target);
+            }
+            weightSums[instruction.target] = sum + weight;
+            break;
+        }
+        case Op::Blend:
+            if (weight >= 1.0f)
+            {
+                std::swap(target, source);
+            }
+            else if (weight > 0.0f)
+            {
+                BlendPoses(target, source, weight, target);
+            }
+            break;
+        case Op::Additive:
+        {
+            const Pose& reference = graph.mAdditiveReferences[instruction.index];
+            using Math::Quaternion;
+            for (uint32_t b = 0; b < boneCount; ++b)
+            {
+                const Quaternion delta = Quaternion::Multiply(
+                    Quaternion::Conjugate(reference.rotations[b]), source.rotations[b]);
+                target.rotations[b] = Quaternion::Normalize(Quaternion::Multiply(
+                    target.rotations[b], Quaternion::Nlerp(Quaternion::Identity, delta, weight)));
+                target.positions[b] += (source.positions[b] - reference.positions[b]) * weight;
+                target.scales[b] += (source.scales[b] - reference.scales[b]) * weight;
+            }
+            break;
+        }
+        case Op::Layered:
+        {
+            const std::vector<float>& mask = graph.mBoneMasks[instruction.index];
+            for (uint32_t b = 0; b < boneCount; ++b)
+            {
+                const float t = mask[b] * weight;
+                if (t <= 0.0f)
+                {
+                    continue;
+                }
+                target.rotations[b] =
+                    Math::Quaternion::Nlerp(target.rotations[b], source.rotations[b], t);
+                target.positions[b] = Math::Lerp(target.positions[b], source.positions[b], t);
+                target.scales[b] = Math::Lerp(target.scales[b], source.scales[b], t);
+            }
+            break;
+        }
+        }
+    }
+
+    std::swap(mNextPose, registers[0]);
+}
+
+void AnimationGraphInstance::RunStateMachine(uint32_t machineIndex, float deltaTime)
+{
+    const AnimationGraph::StateMachine& machine = mGraph->mStateMachines[machineIndex];
+    MachineState& state = mMachineStates[machineIndex];
+
+    if (state.previous >= 0)
+    {
+        state.transitionTime += deltaTime;
+        if (state.transitionTime >= state.transitionDuration)
+        {
+            state.previous = -1;
+        }
+    }
+
+    for (const AnimationGraphDesc::Transition& transition : machine.transitions)
+    {
+        const int toState = static_cast<int>(transition.toState);
+        if (toState == state.current ||
+            (transition.fromState >= 0 && transition.fromState != state.current))
+        {
+            continue;
+        }
+
+        const float value = mParameters[transition.parameter];
+        const bool passed = (transition.comparison == AnimationGraphDesc::Comparison::Greater)
+                                ? value > transition.threshold
+                                : value < transition.threshold;
+        if (!passed)
+        {
+            continue;
+        }
+
+        // An interrupted transition drops the state it was fading out
+        state.previous = (transition.duration > 0.0f) ? state.current : -1;
+        state.current = toState;
+        state.transitionTime = 0.0f;
+        state.transitionDuration = transition.duration;
+        const auto [firstClock, lastClock] = machine.stateClocks[toState];
+        std::fill(mClocks.begin() + firstClock, mClocks.begin() + lastClock, 0.0f);
+        break;
+    }
+
+    float* weights = mWeights.data() + machine.firstWeight;
+    std::fill(weights, weights + machine.stateCount, 0.0f);
+    if (state.previous >= 0)
+    {
+        const float t = state.transitionTime / state.transitionDuration;
+        weights[state.previous] = 1.0f - t;
+        weights[state.current] = t;
+    }
+    else
+    {
+        weights[state.current] = 1.0f;
+    }
+}
+
+void AnimationGraphInstance::ComputeBlendSpaceWeights(const AnimationGraph::BlendSpace& space,
+                                                      bool twoDimensional)
+{
+    const uint32_t sampleCount = static_cast<uint32_t>(space.positions.size());
+    float* weights = mWeights.data() + space.firstWeight;
+    std::fill(weights, weights + sampleCount, 0.0f);
+
+    if (!twoDimensional)
+    {
+        // Two neighbours around the parameter, clamped at the ends
+        const float x = mParameters[space.parameters[0]];
+        if (x <= space.positions.front().x)
+        {
+            weights[0] = 1.0f;
+            return;
+        }
+        if (x >= space.positions.back().x)
+        {
+            weights[sampleCount - 1] = 1.0f;
+            return;
+        }
+        for (uint32_t i = 0; i + 1 < sampleCount; ++i)
+        {
+            const float from = space.positions[i].x;
+            const float to = space.positions[i + 1].x;
+            if (x < to)
+            {
+                const float t = (to > from) ? (x - from) / (to - from) : 1.0f;
+                weights[i] = 1.0f - t;
+                weights[i + 1] = t;
+                return;
+            }
+        }
+        return;
+    }
+
+    // Gradient band interpolation: each sample fades out along the direction to every other one
+    const Math::Vector2 point(mParameters[space.parameters[0]], mParameters[space.parameters[1]]);
+    float total = 0.0f;
+    for (uint32_t i = 0; i < sampleCount; ++i)
+    {
+        const Math::Vector2 offset = point - space.positions[i];
+        float weight = 1.0f;
+        for (uint32_t j = 0; j < sampleCount; ++j)
+        {
+            if (j == i)
+            {
+                continue;
+            }
+            const Math::Vector2 edge = space.positions[j] - space.positions[i];
+            const float lengthSqr = edge.x * edge.x + edge.y * edge.y;
+            if (lengthSqr > 0.0f)
+            {
+                const float projection = offset.x * edge.x + offset.y * edge.y;
+                weight = Math::Min(weight, 1.0f - projection / lengthSqr);
+            }
+        }
+        weights[i] = Math::Max(weight, 0.0f);
+        total += weights[i];
+    }
+
+    if (total <= 0.0f)
+    {
+        weights[0] = 1.0f;
+        return;
+    }
+    for (uint32_t i = 0; i < sampleCount; ++i)
+    {
+        weights[i] /= total;
+    }
+}
+
+float AnimationGraphInstance::GetClipTime(uint32_t clipIndex, uint32_t clock) const
+{
+    return mClocks[clock] * (*mGraph->mClips)[clipIndex].GetDuration();
+}
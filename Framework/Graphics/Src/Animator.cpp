@@ -0,0 +1,148 @@
+#include "Precompiled.h"
+#include "Animator.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+void Animator::Initialize(const Skeleton& skeleton, const std::vector<AnimationClip>& clips)
+{
+    mSkeleton = &skeleton;
+    mClips = &clips;
+    mClipIndex = -1;
+    mPreviousClipIndex = -1;
+    mTime = 0.0f;
+    mBlendTime = 0.0f;
+    mBlendDuration = 0.0f;
+
+    const uint32_t boneCount = static_cast<uint32_t>(skeleton.bones.size());
+    mPose = skeleton.restPose;
+    mModelMatrices.resize(boneCount);
+    mSkinningMatrices.resize(boneCount);
+    ComputeModelMatrices(skeleton, mPose, mModelMatrices.data());
+    ComputeSkinningMatrices(skeleton, mModelMatrices.data(), mSkinningMatrices.data());
+}
+
+void Animator::Terminate()
+{
+    mSkeleton = nullptr;
+    mClips = nullptr;
+    mClipIndex = -1;
+    mPreviousClipIndex = -1;
+}
+
+void Animator::Play(uint32_t clipIndex, bool looping, float blendDuration)
+{
+    ASSERT(mClips != nullptr, "Animator: Not initialized");
+    ASSERT(clipIndex < mClips->size(), "Animator: Invalid clip index %u", clipIndex);
+    ASSERT((*mClips)[clipIndex].GetBoneCount() == mSkeleton->bones.size(),
+           "Animator: Clip does not fit the skeleton");
+
+    if (blendDuration > 0.0f && mClipIndex >= 0)
+    {
+        mPreviousClipIndex = mClipIndex;
+        mPreviousTime = mTime;
+        mPreviousLooping = mLooping;
+        mBlendTime = 0.0f;
+        mBlendDuration = blendDuration;
+    }
+    else
+    {
+        mPreviousClipIndex = -1;
+        mBlendDuration = 0.0f;
+    }
+
+    mClipIndex = static_cast<int>(clipIndex);
+    mTime = 0.0f;
+    mLooping = looping;
+}
+
+void Animator::Update(float deltaTime)
+{
+    if (mSkeleton == nullptr || mClipIndex < 0)
+    {
+        return;
+    }
+
+    const float step = deltaTime * mSpeed;
+    mTime += step;
+    const AnimationClip& clip = (*mClips)[mClipIndex];
+    if (!mLooping)
+    {
+        mTime = Math::Min(mTime, clip.GetDuration());
+    }
+
+    if (mPreviousClipIndex >= 0)
+    {
+        mBlendTime += step;
+        mPreviousTime += step;
+        if (mBlendTime >= mBlendDuration)
+        {
+            mPreviousClipIndex = -1;
+        }
+    }
+
+    if (mPreviousClipIndex >= 0)
+    {
+        const float t = mBlendTime / mBlendDuration;
+        const AnimationClip& previousClip = (*mClips)[mPreviousClipIndex];
+        previousClip.Sample(*mSkeleton, mPreviousTime, mPreviousLooping, mPreviousPose);
+        clip.Sample(*mSkeleton, mTime, mLooping, mCurrentPose);
+        BlendPoses(mPreviousPose, mCurrentPose, t, mPose);
+    }
+    else
+    {
+        clip.Sample(*mSkeleton, mTime, mLooping, mPose);
+    }
+
+    ComputeModelMatrices(*mSkeleton, mPose, mModelMatrices.data());
+    ComputeSkinningMatrices(*mSkeleton, mModelMatrices.data(), mSkinningMatrices.data());
+}
+
+void Animator::SetSpeed(float speed)
+{
+    mSpeed = speed;
+}
+
+float Animator::GetSpeed() const
+{
+    return mSpeed;
+}
+
+const Pose& Animator::GetPose() const
+{
+    return mPose;
+}
+
+const std::vector<Math::Matrix4>& Animator::GetModelMatrices() const
+{
+    return mModelMatrices;
+}
+
+const std::vector<Math::Matrix4>& Animator::GetSkinningMatrices() const
+{
+    return mSkinningMatrices;
+}
+
+uint32_t Animator::GetClipCount() const
+{
+    return (mClips != nullptr) ? static_cast<uint32_t>(mClips->size()) : 0;
+}
+
+int Animator::GetClipIndex() const
+{
+    return mClipIndex;
+}
+
+float Animator::GetTime() const
+{
+    return mTime;
+}
+
+bool Animator::IsFinished() const
+{
+    if (mClipIndex < 0)
+    {
+        return true;
+    }
+    return !mLooping && mTime >= (*mClips)[mClipIndex].GetDuration();
+}
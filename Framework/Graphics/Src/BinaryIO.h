@@ -0,0 +1,66 @@
+#pragma once
+
+// Helpers for the binary asset files (.animset, .morph, .vat), internal to the Graphics library.
+// Vectors are stored as a uint32_t count followed by the raw elements.
+
+namespace Engine::Graphics::BinaryIO
+{
+// Bytes left between the read position and the end of the file
+inline size_t GetRemainingSize(FILE* file)
+{
+    const long position = ftell(file);
+    if (position < 0 || fseek(file, 0L, SEEK_END) != 0)
+    {
+        return 0;
+    }
+    const long end = ftell(file);
+    fseek(file, position, SEEK_SET);
+    return (end > position) ? static_cast<size_t>(end - position) : 0;
+}
+
+template <class T> void WriteVector(FILE* file, const std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "BinaryIO: Elements are written as raw bytes");
+    const uint32_t count = static_cast<uint32_t>(values.size());
+    fwrite(&count, sizeof(count), 1, file);
+    if (count > 0)
+    {
+        fwrite(values.data(), sizeof(T), count, file);
+    }
+}
+
+inline void WriteString(FILE* file, const std::string& value)
+{
+    const uint32_t length = static_cast<uint32_t>(value.size());
+    fwrite(&length, sizeof(length), 1, file);
+    fwrite(value.data(), 1, length, file);
+}
+
+// Fails without allocating when the count is more than the rest of the file can hold, so a
+// corrupt count can't trigger a huge resize
+template <class T> bool ReadVector(FILE* file, std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "BinaryIO: Elements are read as raw bytes");
+    uint32_t count = 0;
+    if (fread(&count, sizeof(count), 1, file) != 1 || count > GetRemainingSize(file) / sizeof(T))
+    {
+        values.clear();
+        return false;
+    }
+    values.resize(count);
+    return count == 0 || fread(values.data(), sizeof(T), count, file) == count;
+}
+
+// Bounded by the rest of the file like ReadVector
+inline bool ReadString(FILE* file, std::string& value)
+{
+    uint32_t length = 0;
+    if (fread(&length, sizeof(length), 1, file) != 1 || length > GetRemainingSize(file))
+    {
+        value.clear();
+        return false;
+    }
+    value.resize(length);
+    return length == 0 || fread(value.data(), 1, length, file) == length;
+}
+} // namespace Engine::Graphics::BinaryIO
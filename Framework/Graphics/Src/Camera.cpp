@@ -10,6 +10,11 @@ void Camera::SetMode(ProjectionMode mode)
     mProjectionMode = mode;
 }
 
+Camera::ProjectionMode Camera::GetMode() const
+{
+    return mProjectionMode;
+}
+
 void Camera::SetPosition(const Math::Vector3& position)
 {
     mPosition = position;
@@ -166,3 +171,29 @@ Math::Matrix4 Camera::GetOrthographicMatrix() const
             n / (n - f),
             1.0f};
 }
+
+Math::Ray Camera::ScreenPointToRay(int screenX, int screenY) const
+{
+    GraphicsSystem* gs = GraphicsSystem::Get();
+    const float screenWidth = static_cast<float>(gs->GetBackBufferWidth());
+    const float screenHeight = static_cast<float>(gs->GetBackBufferHeight());
+    const float ndcX = (2.0f * screenX / screenWidth) - 1.0f;
+    const float ndcY = 1.0f - (2.0f * screenY / screenHeight);
+
+    const Math::Vector3 l = mDirection;
+    const Math::Vector3 r = Math::Normalize(Math::Cross(Math::Vector3::YAxis, mDirection));
+    const Math::Vector3 u = Math::Normalize(Math::Cross(l, r));
+
+    if (mProjectionMode == ProjectionMode::Orthographic)
+    {
+        const float w = (mWidth == 0.0f) ? screenWidth : mWidth;
+        const float h = (mHeight == 0.0f) ? screenHeight : mHeight;
+        const Math::Vector3 origin = mPosition + r * (ndcX * w * 0.5f) + u * (ndcY * h * 0.5f);
+        return {origin, l};
+    }
+
+    const float a = (mAspectRatio == 0.0f) ? gs->GetBackBufferAspectRatio() : mAspectRatio;
+    const float t = tanf(mFov * 0.5f);
+    const Math::Vector3 direction = l + r * (ndcX * t * a) + u * (ndcY * t);
+    return {mPosition, Math::Normalize(direction)};
+}
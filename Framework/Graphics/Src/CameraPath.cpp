@@ -0,0 +1,150 @@
+#include "Precompiled.h"
+#include "CameraPath.h"
+
+#include "Camera.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+bool CameraPath::Load(const std::filesystem::path& filePath)
+{
+    Clear();
+    FILE* file = fopen(filePath.u8string().c_str(), "r");
+    if (file == nullptr)
+    {
+        LOG_WARNING(Graphics, "CameraPath: Failed to open %s", filePath.u8string().c_str());
+        return false;
+    }
+
+    bool isValid = true;
+    char line[256];
+    for (uint32_t lineNumber = 1; fgets(line, sizeof(line), file) != nullptr; ++lineNumber)
+    {
+        const char* text = line + strspn(line, " \t");
+        if (*text == '#' || *text == '\n' || *text == '\r' || *text == '\0')
+        {
+            continue;
+        }
+
+        Math::Vector3 position;
+        Math::Vector3 target;
+        if (sscanf(text,
+                   "%f %f %f %f %f %f",
+                   &position.x,
+                   &position.y,
+                   &position.z,
+                   &target.x,
+                   &target.y,
+                   &target.z) != 6)
+        {
+            LOG_WARNING(Graphics,
+                        "CameraPath: %s line %u is not a key",
+                        filePath.u8string().c_str(),
+                        lineNumber);
+            isValid = false;
+            break;
+        }
+        AddKey(position, target);
+    }
+    fclose(file);
+
+    if (isValid && mKeys.size() < 2)
+    {
+        LOG_WARNING(Graphics, "CameraPath: %s needs two keys", filePath.u8string().c_str());
+        isValid = false;
+    }
+    if (!isValid)
+    {
+        Clear();
+    }
+    return isValid;
+}
+
+void CameraPath::AddKey(const Math::Vector3& position, const Math::Vector3& target)
+{
+    Key& key = mKeys.emplace_back();
+    key.position = position;
+    key.target = target;
+    if (mKeys.size() > 1)
+    {
+        const Key& previous = mKeys[mKeys.size() - 2];
+        key.distance = previous.distance + Math::Distance(previous.position, position);
+    }
+}
+
+void CameraPath::Clear()
+{
+    mKeys.clear();
+}
+
+uint32_t CameraPath::GetKeyCount() const
+{
+    return static_cast<uint32_t>(mKeys.size());
+}
+
+float CameraPath::GetLength() const
+{
+    return mKeys.empty() ? 0.0f : mKeys.back().distance;
+}
+
+Math::Vector3 CameraPath::GetPosition(float t) const
+{
+    return Sample(&Key::position, t);
+}
+
+Math::Vector3 CameraPath::GetTarget(float t) const
+{
+    return Sample(&Key::target, t);
+}
+
+void CameraPath::Apply(Camera& camera, float t) const
+{
+    if (mKeys.empty())
+    {
+        return;
+    }
+    camera.SetPosition(GetPosition(t));
+    camera.SetLookAt(GetTarget(t));
+}
+
+size_t CameraPath::Locate(float t, float& segmentT) const
+{
+    const size_t lastSegment = mKeys.size() - 2;
+    const float length = GetLength();
+    if (length <= 0.0f)
+    {
+        // Keys on one spot, e.g. a camera turning in place, are spread evenly
+        const float segment = Math::Clamp(t, 0.0f, 1.0f) * (lastSegment + 1);
+        const size_t index = std::min(static_cast<size_t>(segment), lastSegment);
+        segmentT = segment - index;
+        return index;
+    }
+
+    const float distance = Math::Clamp(t, 0.0f, 1.0f) * length;
+    auto next = std::upper_bound(mKeys.begin() + 1,
+                                 mKeys.end() - 1,
+                                 distance,
+                                 [](float value, const Key& key) { return value < key.distance; });
+    const size_t index = static_cast<size_t>(next - mKeys.begin()) - 1;
+    const float segmentLength = mKeys[index + 1].distance - mKeys[index].distance;
+    segmentT = (segmentLength > 0.0f) ? (distance - mKeys[index].distance) / segmentLength : 0.0f;
+    return index;
+}
+
+// The ends repeat the first and last key for their tangents
+template <class T> T CameraPath::Sample(T Key::*member, float t) const
+{
+    if (mKeys.size() < 2)
+    {
+        return mKeys.empty() ? T() : mKeys[0].*member;
+    }
+
+    float segmentT = 0.0f;
+    const size_t index = Locate(t, segmentT);
+    const size_t last = mKeys.size() - 1;
+    const T& p0 = mKeys[(index > 0) ? index - 1 : 0].*member;
+    const T& p1 = mKeys[index].*member;
+    const T& p2 = mKeys[index + 1].*member;
+    const T& p3 = mKeys[std::min(index + 2, last)].*member;
+    return Math::CatmullRom(p0, p1, p2, p3, segmentT);
+}
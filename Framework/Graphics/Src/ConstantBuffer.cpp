@@ -6,6 +6,12 @@
 using namespace Engine;
 using namespace Engine::Graphics;
 
+namespace
+{
+const Core::PerfCounter sBufferUpdates("Graphics.BufferUpdates");
+const Core::PerfCounter sBytesUploaded("Graphics.BytesUploaded");
+} // namespace
+
 ConstantBuffer::~ConstantBuffer()
 {
     ASSERT(mConstantBuffer == nullptr, "ConstantBuffer: Terminate must be called");
@@ -13,6 +19,7 @@ ConstantBuffer::~ConstantBuffer()
 
 void ConstantBuffer::Initialize(uint32_t bufferSize)
 {
+    mBufferSize = bufferSize;
     auto device = GraphicsSystem::Get()->GetDevice();
 
     D3D11_BUFFER_DESC desc{};
@@ -25,17 +32,22 @@ void ConstantBuffer::Initialize(uint32_t bufferSize)
 
     HRESULT hr = device->CreateBuffer(&desc, nullptr, &mConstantBuffer);
     ASSERT(SUCCEEDED(hr), "ConstantBuffer: Failed to create Constant Buffer");
+    mMemoryId =
+        Core::MemoryTracker::Track(Core::MemoryTag::Buffers, bufferSize, "Constant buffer");
 }
 
 void ConstantBuffer::Terminate()
 {
     SafeRelease(mConstantBuffer);
+    Core::MemoryTracker::Untrack(std::exchange(mMemoryId, Core::InvalidHandle));
 }
 
 void ConstantBuffer::Update(const void* data) const
 {
     auto context = GraphicsSystem::Get()->GetContext();
     context->UpdateSubresource(mConstantBuffer, 0, nullptr, data, 0, 0);
+    sBufferUpdates.Add();
+    sBytesUploaded.Add(mBufferSize);
 }
 
 void ConstantBuffer::BindVS(uint32_t slot) const
@@ -13,6 +13,47 @@ using namespace Engine::Graphics::DebugUI;
 namespace
 {
 Theme sCurrentTheme = Theme::Dark;
+
+constexpr double MegaByte = 1024.0 * 1024.0;
+constexpr uint32_t MaxListedAssets = 32; // Per tag in the memory window
+
+struct AssetMemory
+{
+    const char* name = nullptr;
+    size_t bytes = 0;
+    uint32_t count = 0;
+    Core::MemoryTag tag = Core::MemoryTag::General;
+};
+
+// Reused every frame the memory window is open
+std::vector<Core::MemoryAllocationInfo> sAllocations;
+std::vector<AssetMemory> sAssets;
+
+// Allocations with the same name belong to the same asset and are added up
+void GatherAssets()
+{
+    Core::MemoryTracker::GetAllocations(sAllocations);
+    std::sort(sAllocations.begin(),
+              sAllocations.end(),
+              [](const Core::MemoryAllocationInfo& a, const Core::MemoryAllocationInfo& b)
+              { return (a.tag != b.tag) ? a.tag < b.tag : strcmp(a.name, b.name) < 0; });
+
+    sAssets.clear();
+    for (const Core::MemoryAllocationInfo& info : sAllocations)
+    {
+        if (sAssets.empty() || sAssets.back().tag != info.tag ||
+            strcmp(sAssets.back().name, info.name) != 0)
+        {
+            sAssets.push_back({info.name, 0, 0, info.tag});
+        }
+        sAssets.back().bytes += info.bytes;
+        ++sAssets.back().count;
+    }
+    std::sort(sAssets.begin(),
+              sAssets.end(),
+              [](const AssetMemory& a, const AssetMemory& b)
+              { return (a.tag != b.tag) ? a.tag < b.tag : a.bytes > b.bytes; });
+}
 } // namespace
 
 void DebugUI::StaticInitialize(GLFWwindow* window, bool docking, bool multiViewport)
@@ -84,3 +125,145 @@ void DebugUI::EndRender()
         ImGui::RenderPlatformWindowsDefault();
     }
 }
+
+void DebugUI::ShowPerfCounters()
+{
+    using namespace Engine::Core;
+
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    if (!ImGui::Begin("Performance", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const uint32_t offset = PerfCounters::GetHistoryOffset();
+    const ImVec2 graphSize(240.0f, 40.0f);
+    char overlay[32];
+    snprintf(overlay, std::size(overlay), "%.2f ms", PerfCounters::GetLastFrameTime());
+    ImGui::PlotLines("Frame Time",
+                     PerfCounters::GetFrameTimeHistory(),
+                     PerfCounters::HistoryLength,
+                     offset,
+                     overlay,
+                     0.0f,
+                     FLT_MAX,
+                     ImVec2(graphSize.x, graphSize.y * 1.5f));
+
+    const uint32_t count = PerfCounters::GetCount();
+    for (PerfCounterId id = 0; id < count; ++id)
+    {
+        snprintf(overlay,
+                 std::size(overlay),
+                 "%lld",
+                 static_cast<long long>(PerfCounters::GetLastFrameValue(id)));
+        ImGui::PlotLines(PerfCounters::GetName(id),
+                         PerfCounters::GetHistory(id),
+                         PerfCounters::HistoryLength,
+                         offset,
+                         overlay,
+                         0.0f,
+                         FLT_MAX,
+                         graphSize);
+    }
+    ImGui::End();
+}
+
+void DebugUI::ShowMemory()
+{
+    using namespace Engine::Core;
+
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    if (!ImGui::Begin("Memory", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("CPU tracked %.2f MB, GPU %.2f MB",
+                MemoryTracker::GetCpuBytes() / MegaByte,
+                MemoryTracker::GetGpuBytes() / MegaByte);
+
+    GatherAssets();
+    constexpr uint32_t TagCount = static_cast<uint32_t>(MemoryTag::Count);
+    const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("MemoryTags", 5, tableFlags))
+    {
+        ImGui::TableSetupColumn("Tag");
+        ImGui::TableSetupColumn("Live MB");
+        ImGui::TableSetupColumn("Peak MB");
+        ImGui::TableSetupColumn("Budget MB");
+        ImGui::TableSetupColumn("Assets");
+        ImGui::TableHeadersRow();
+        for (uint32_t t = 0; t < TagCount; ++t)
+        {
+            const MemoryTag tag = static_cast<MemoryTag>(t);
+            const size_t live = MemoryTracker::GetLiveBytes(tag);
+            const size_t budget = MemoryTracker::GetBudget(tag);
+            const uint32_t assetCount = static_cast<uint32_t>(
+                std::count_if(sAssets.begin(),
+                              sAssets.end(),
+                              [tag](const AssetMemory& asset) { return asset.tag == tag; }));
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s %s",
+                        MemoryTracker::IsGpuTag(tag) ? "GPU" : "CPU",
+                        MemoryTracker::GetTagName(tag));
+            ImGui::TableNextColumn();
+            if (budget > 0 && live > budget)
+            {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.2f", live / MegaByte);
+            }
+            else
+            {
+                ImGui::Text("%.2f", live / MegaByte);
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", MemoryTracker::GetPeakBytes(tag) / MegaByte);
+            ImGui::TableNextColumn();
+            if (budget > 0)
+            {
+                ImGui::Text("%.2f", budget / MegaByte);
+            }
+            else
+            {
+                ImGui::TextUnformatted("-");
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", assetCount);
+        }
+        ImGui::EndTable();
+    }
+
+    size_t first = 0;
+    while (first < sAssets.size())
+    {
+        const MemoryTag tag = sAssets[first].tag;
+        size_t last = first;
+        while (last < sAssets.size() && sAssets[last].tag == tag)
+        {
+            ++last;
+        }
+        if (ImGui::TreeNode(MemoryTracker::GetTagName(tag)))
+        {
+            for (size_t i = first; i < std::min(last, first + MaxListedAssets); ++i)
+            {
+                const AssetMemory& asset = sAssets[i];
+                ImGui::Text("%9.3f MB  %s", asset.bytes / MegaByte, asset.name);
+                if (asset.count > 1)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("x%u", asset.count);
+                }
+            }
+            if (last - first > MaxListedAssets)
+            {
+                ImGui::TextDisabled("%zu more", last - first - MaxListedAssets);
+            }
+            ImGui::TreePop();
+        }
+        first = last;
+    }
+    ImGui::End();
+}
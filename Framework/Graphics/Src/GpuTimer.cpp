@@ -0,0 +1,131 @@
+#include "Precompiled.h"
+#include "GpuTimer.h"
+
+#include "GraphicsSystem.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+// S_FALSE until the GPU got to the query
+template <class T> HRESULT GetQueryData(ID3D11Query* query, T& data, bool isWaiting)
+{
+    ID3D11DeviceContext* context = GraphicsSystem::Get()->GetContext();
+    const UINT flags = isWaiting ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH;
+    HRESULT hr = context->GetData(query, &data, sizeof(T), flags);
+    while (isWaiting && hr == S_FALSE)
+    {
+        std::this_thread::yield();
+        hr = context->GetData(query, &data, sizeof(T), flags);
+    }
+    return hr;
+}
+} // namespace
+
+GpuTimer::~GpuTimer()
+{
+    ASSERT(!mIsAvailable, "GpuTimer: Terminate must be called");
+}
+
+void GpuTimer::Initialize()
+{
+    ID3D11Device* device = GraphicsSystem::Get()->GetDevice();
+    D3D11_QUERY_DESC disjointDesc{};
+    disjointDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    D3D11_QUERY_DESC timestampDesc{};
+    timestampDesc.Query = D3D11_QUERY_TIMESTAMP;
+
+    mIsAvailable = true;
+    for (Slot& slot : mSlots)
+    {
+        mIsAvailable = mIsAvailable &&
+                       SUCCEEDED(device->CreateQuery(&disjointDesc, &slot.disjoint)) &&
+                       SUCCEEDED(device->CreateQuery(&timestampDesc, &slot.begin)) &&
+                       SUCCEEDED(device->CreateQuery(&timestampDesc, &slot.end));
+    }
+    if (!mIsAvailable)
+    {
+        LOG_WARNING(Graphics, "GpuTimer: Timestamp queries are not supported, no GPU times");
+        Terminate();
+    }
+}
+
+void GpuTimer::Terminate()
+{
+    for (Slot& slot : mSlots)
+    {
+        SafeRelease(slot.disjoint);
+        SafeRelease(slot.begin);
+        SafeRelease(slot.end);
+    }
+    mNext = 0;
+    mPendingCount = 0;
+    mIsMeasuring = false;
+    mIsAvailable = false;
+}
+
+bool GpuTimer::IsAvailable() const
+{
+    return mIsAvailable;
+}
+
+void GpuTimer::Begin(uint32_t frame)
+{
+    mIsMeasuring = mIsAvailable && mPendingCount < FramesInFlight;
+    if (!mIsMeasuring)
+    {
+        return;
+    }
+
+    Slot& slot = mSlots[mNext];
+    slot.frame = frame;
+    ID3D11DeviceContext* context = GraphicsSystem::Get()->GetContext();
+    context->Begin(slot.disjoint);
+    context->End(slot.begin);
+}
+
+void GpuTimer::End()
+{
+    if (!mIsMeasuring)
+    {
+        return;
+    }
+
+    const Slot& slot = mSlots[mNext];
+    ID3D11DeviceContext* context = GraphicsSystem::Get()->GetContext();
+    context->End(slot.end);
+    context->End(slot.disjoint);
+    mNext = (mNext + 1) % FramesInFlight;
+    ++mPendingCount;
+    mIsMeasuring = false;
+}
+
+bool GpuTimer::Read(uint32_t& frame, float& milliseconds, bool isWaiting)
+{
+    while (mPendingCount > 0)
+    {
+        const Slot& slot = mSlots[(mNext + FramesInFlight - mPendingCount) % FramesInFlight];
+
+        // The timestamps end before the disjoint query, so they are done once it is
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint{};
+        if (GetQueryData(slot.disjoint, disjoint, isWaiting) == S_FALSE)
+        {
+            return false;
+        }
+        UINT64 beginTime = 0;
+        UINT64 endTime = 0;
+        const bool isValid = GetQueryData(slot.begin, beginTime, true) == S_OK &&
+                             GetQueryData(slot.end, endTime, true) == S_OK &&
+                             !disjoint.Disjoint && disjoint.Frequency > 0;
+        --mPendingCount;
+        if (isValid)
+        {
+            frame = slot.frame;
+            milliseconds = static_cast<float>(
+                static_cast<double>(endTime - beginTime) * 1000.0 / disjoint.Frequency);
+            return true;
+        }
+    }
+    return false;
+}
@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "GraphicsSystem.h"
 
+#include "NullDevice.h"
+
 #if !defined(_WIN32) && !defined(__APPLE__)
 #include <cstdlib>
 #endif
@@ -33,6 +35,24 @@ using namespace Engine::Graphics;
 namespace
 {
 std::unique_ptr<GraphicsSystem> sGraphicsSystem;
+
+uint32_t GetBytesPerPixel(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+        return 16;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R32G32_FLOAT:
+        return 8;
+    case DXGI_FORMAT_R8_UNORM:
+        return 1;
+    default:
+        return 4; // RGBA8 and the 32 bit depth formats, everything this engine creates
+    }
+}
 } // namespace
 
 void GraphicsSystem::FramebufferSizeCallback(GLFWwindow* window, int width, int height)
@@ -50,6 +70,13 @@ void GraphicsSystem::StaticInitialize(GLFWwindow* window, bool fullscreen)
     sGraphicsSystem->Initialize(window, fullscreen);
 }
 
+void GraphicsSystem::StaticInitialize(uint32_t width, uint32_t height)
+{
+    ASSERT(sGraphicsSystem == nullptr, "GraphicsSystem: is already installed");
+    sGraphicsSystem = std::make_unique<GraphicsSystem>();
+    sGraphicsSystem->Initialize(width, height);
+}
+
 void GraphicsSystem::StaticTerminate()
 {
     if (sGraphicsSystem != nullptr)
@@ -65,6 +92,25 @@ GraphicsSystem* GraphicsSystem::Get()
     return sGraphicsSystem.get();
 }
 
+size_t GraphicsSystem::GetTextureMemorySize(const D3D11_TEXTURE2D_DESC& desc)
+{
+    const uint32_t bytesPerPixel = GetBytesPerPixel(desc.Format);
+    size_t size = 0;
+    uint32_t width = desc.Width;
+    uint32_t height = desc.Height;
+    for (uint32_t mip = 0; desc.MipLevels == 0 || mip < desc.MipLevels; ++mip)
+    {
+        size += static_cast<size_t>(width) * height * bytesPerPixel;
+        if (width == 1 && height == 1)
+        {
+            break; // End of a full chain, which is what 0 mip levels asks for
+        }
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    return size * std::max(desc.ArraySize, 1u) * std::max(desc.SampleDesc.Count, 1u);
+}
+
 GraphicsSystem::~GraphicsSystem()
 {
     ASSERT(mD3DDevice == nullptr, "GraphicsSystem: must be terminated!");
@@ -128,14 +174,29 @@ void GraphicsSystem::Initialize(GLFWwindow* window, bool fullscreen)
     glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
 }
 
+void GraphicsSystem::Initialize(uint32_t width, uint32_t height)
+{
+    NullDevice::Create(&mD3DDevice, &mImmediateContext);
+    mIsNullDevice = true;
+
+    // Only what the getters and Resize read, there is no swap chain
+    mSwapChainDesc.BufferCount = 1;
+    mSwapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    mSwapChainDesc.SampleDesc.Count = 1;
+    Resize(width, height);
+}
+
 void GraphicsSystem::Terminate()
 {
+    Core::MemoryTracker::Untrack(std::exchange(mBackBufferMemoryId, Core::InvalidHandle));
+    Core::MemoryTracker::Untrack(std::exchange(mDepthStencilMemoryId, Core::InvalidHandle));
     SafeRelease(mDepthStencilView);
     SafeRelease(mDepthStencilBuffer);
     SafeRelease(mRenderTargetView);
     SafeRelease(mSwapChain);
     SafeRelease(mImmediateContext);
     SafeRelease(mD3DDevice);
+    mIsNullDevice = false;
 }
 
 void GraphicsSystem::BeginRender()
@@ -148,11 +209,21 @@ void GraphicsSystem::BeginRender()
 
 void GraphicsSystem::EndRender()
 {
+    if (mIsNullDevice)
+    {
+        NullDevice::EndFrame();
+        return;
+    }
     mSwapChain->Present(mVSync, 0);
 }
 
 void GraphicsSystem::ToggleFullScreen()
 {
+    if (mIsNullDevice)
+    {
+        return;
+    }
+
     BOOL fullscreen;
     mSwapChain->GetFullscreenState(&fullscreen, nullptr);
     mSwapChain->SetFullscreenState(!fullscreen, nullptr);
@@ -165,19 +236,48 @@ void GraphicsSystem::Resize(uint32_t width, uint32_t height)
     SafeRelease(mRenderTargetView);
     SafeRelease(mDepthStencilView);
     SafeRelease(mDepthStencilBuffer);
+    Core::MemoryTracker::Untrack(std::exchange(mBackBufferMemoryId, Core::InvalidHandle));
+    Core::MemoryTracker::Untrack(std::exchange(mDepthStencilMemoryId, Core::InvalidHandle));
 
     HRESULT hr;
-    if (width != GetBackBufferWidth() || height != GetBackBufferHeight())
+    ID3D11Texture2D* backBuffer = nullptr;
+    if (mIsNullDevice)
+    {
+        // A plain texture stands in for the back buffer
+        mSwapChainDesc.BufferDesc.Width = width;
+        mSwapChainDesc.BufferDesc.Height = height;
+
+        D3D11_TEXTURE2D_DESC descBackBuffer = {};
+        descBackBuffer.Width = width;
+        descBackBuffer.Height = height;
+        descBackBuffer.MipLevels = 1;
+        descBackBuffer.ArraySize = 1;
+        descBackBuffer.Format = mSwapChainDesc.BufferDesc.Format;
+        descBackBuffer.SampleDesc.Count = 1;
+        descBackBuffer.BindFlags = D3D11_BIND_RENDER_TARGET;
+        hr = mD3DDevice->CreateTexture2D(&descBackBuffer, nullptr, &backBuffer);
+        ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to create the null back buffer");
+    }
+    else
     {
-        hr = mSwapChain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, 0);
-        ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to access swap chain view");
+        if (width != GetBackBufferWidth() || height != GetBackBufferHeight())
+        {
+            hr = mSwapChain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, 0);
+            ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to access swap chain view");
+
+            mSwapChain->GetDesc(&mSwapChainDesc);
+        }
 
-        mSwapChain->GetDesc(&mSwapChainDesc);
+        hr = mSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*) &backBuffer);
+        ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to access swap chain buffer");
     }
 
-    ID3D11Texture2D* backBuffer = nullptr;
-    hr = mSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*) &backBuffer);
-    ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to access swap chain buffer");
+    D3D11_TEXTURE2D_DESC descBackBuffer = {};
+    backBuffer->GetDesc(&descBackBuffer);
+    mBackBufferMemoryId = Core::MemoryTracker::Track(
+        Core::MemoryTag::RenderTargets,
+        GetTextureMemorySize(descBackBuffer) * mSwapChainDesc.BufferCount,
+        "Swap chain");
 
     hr = mD3DDevice->CreateRenderTargetView(backBuffer, nullptr, &mRenderTargetView);
     SafeRelease(backBuffer);
@@ -197,6 +297,8 @@ void GraphicsSystem::Resize(uint32_t width, uint32_t height)
     descDepth.MiscFlags = 0;
     hr = mD3DDevice->CreateTexture2D(&descDepth, nullptr, &mDepthStencilBuffer);
     ASSERT(SUCCEEDED(hr), "GraphicsSystem: Failed to create depth stencil buffer!");
+    mDepthStencilMemoryId = Core::MemoryTracker::Track(
+        Core::MemoryTag::RenderTargets, GetTextureMemorySize(descDepth), "Depth stencil");
 
     D3D11_DEPTH_STENCIL_VIEW_DESC descDSV = {};
     descDSV.Format = descDepth.Format;
@@ -253,6 +355,11 @@ float GraphicsSystem::GetBackBufferAspectRatio() const
     return static_cast<float>(GetBackBufferWidth()) / static_cast<float>(GetBackBufferHeight());
 }
 
+bool GraphicsSystem::IsNullDevice() const
+{
+    return mIsNullDevice;
+}
+
 ID3D11Device* GraphicsSystem::GetDevice()
 {
     ASSERT(mD3DDevice != nullptr, "GraphicsSystem: not initialized!");
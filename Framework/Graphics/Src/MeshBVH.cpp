@@ -0,0 +1,569 @@
+#include "Precompiled.h"
+#include "MeshBVH.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+constexpr uint32_t BinCount = 16;
+constexpr uint32_t MaxLeafTriangles = 4;
+
+// Traversal uses a fixed size stack, so the build stops splitting before it could overflow
+constexpr uint32_t MaxDepth = 48;
+constexpr uint32_t StackSize = 64;
+
+Math::Vector3 Reciprocal(const Math::Vector3& v)
+{
+    return {1.0f / v.x, 1.0f / v.y, 1.0f / v.z};
+}
+
+float IntersectNode(const Math::Ray& ray,
+                    const Math::Vector3& invDirection,
+                    const MeshBVH::Node& node,
+                    float maxDistance)
+{
+    return Math::Intersect(ray, invDirection, {node.min, node.max}, maxDistance);
+}
+
+struct Bin
+{
+    Math::AABB bounds;
+    uint32_t triangleCount = 0;
+};
+} // namespace
+
+void MeshBVH::Build(const Mesh& mesh)
+{
+    Terminate();
+
+    const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // Gather positions and centroids by source triangle
+    mPositions.resize(triangleCount * 3);
+    mCentroids.resize(triangleCount);
+    mTriangleIds.resize(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            mPositions[t * 3 + k] = mesh.vertices[mesh.indices[t * 3 + k]].position;
+        }
+        mCentroids[t] = (mPositions[t * 3] + mPositions[t * 3 + 1] + mPositions[t * 3 + 2]) / 3.0f;
+        mTriangleIds[t] = t;
+    }
+
+    mNodes.reserve(triangleCount * 2);
+    Node& root = mNodes.emplace_back();
+    root.leftFirst = 0;
+    root.triangleCount = triangleCount;
+    UpdateBounds(0);
+    Subdivide(0);
+    mNodes.shrink_to_fit();
+
+    // Put positions in leaf order so leaves read contiguous memory
+    std::vector<Math::Vector3> positions(triangleCount * 3);
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        const uint32_t t = mTriangleIds[i];
+        positions[i * 3] = mPositions[t * 3];
+        positions[i * 3 + 1] = mPositions[t * 3 + 1];
+        positions[i * 3 + 2] = mPositions[t * 3 + 2];
+    }
+    mPositions = std::move(positions);
+    mCentroids = {};
+}
+
+bool MeshBVH::Initialize(const Mesh& mesh,
+                         std::vector<Node> nodes,
+                         std::vector<uint32_t> triangleIds)
+{
+    Terminate();
+
+    // Saved for a different version of the mesh, or corrupt
+    const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    if (nodes.empty() || triangleIds.size() != triangleCount)
+    {
+        return false;
+    }
+    for (uint32_t t : triangleIds)
+    {
+        if (t >= triangleCount)
+        {
+            return false;
+        }
+    }
+
+    // Every node but the root is the child of exactly one earlier node, no deeper than the build
+    // goes, so traversal ends and fits its stack
+    std::vector<uint32_t> depths(nodes.size(), 0);
+    std::vector<bool> isReached(nodes.size(), false);
+    isReached[0] = true;
+    for (uint32_t n = 0; n < nodes.size(); ++n)
+    {
+        const Node& node = nodes[n];
+        if (!isReached[n])
+        {
+            return false;
+        }
+        if (node.triangleCount > 0)
+        {
+            if (node.leftFirst > triangleCount ||
+                node.triangleCount > triangleCount - node.leftFirst)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        const uint32_t left = node.leftFirst;
+        if (left <= n || left >= nodes.size() - 1 || isReached[left] || isReached[left + 1] ||
+            depths[n] >= MaxDepth)
+        {
+            return false;
+        }
+        isReached[left] = isReached[left + 1] = true;
+        depths[left] = depths[left + 1] = depths[n] + 1;
+    }
+
+    mNodes = std::move(nodes);
+    mTriangleIds = std::move(triangleIds);
+    mPositions.resize(triangleCount * 3);
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        const uint32_t t = mTriangleIds[i];
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            mPositions[i * 3 + k] = mesh.vertices[mesh.indices[t * 3 + k]].position;
+        }
+    }
+    RefitBounds();
+    return true;
+}
+
+void MeshBVH::Terminate()
+{
+    mNodes.clear();
+    mTriangleIds.clear();
+    mPositions.clear();
+    mCentroids.clear();
+}
+
+bool MeshBVH::IsBuilt() const
+{
+    return !mNodes.empty();
+}
+
+bool MeshBVH::Raycast(const Math::Ray& ray, float maxDistance, RayHit& hit) const
+{
+    hit = {};
+    hit.distance = maxDistance;
+    if (mNodes.empty())
+    {
+        return false;
+    }
+
+    const Math::Vector3 invDirection = Reciprocal(ray.direction);
+    if (IntersectNode(ray, invDirection, mNodes[0], maxDistance) < 0.0f)
+    {
+        return false;
+    }
+
+    uint32_t stack[StackSize];
+    uint32_t stackSize = 0;
+    const Node* node = &mNodes[0];
+    while (true)
+    {
+        if (node->triangleCount > 0)
+        {
+            TestLeaf(*node, ray, hit);
+            if (stackSize == 0)
+            {
+                break;
+            }
+            node = &mNodes[stack[--stackSize]];
+            continue;
+        }
+
+        // Visit the nearer child first, the farther one is often culled by the hit distance
+        uint32_t nearIndex = node->leftFirst;
+        uint32_t farIndex = node->leftFirst + 1;
+        float nearDistance = IntersectNode(ray, invDirection, mNodes[nearIndex], hit.distance);
+        float farDistance = IntersectNode(ray, invDirection, mNodes[farIndex], hit.distance);
+        if (farDistance >= 0.0f && (nearDistance < 0.0f || farDistance < nearDistance))
+        {
+            std::swap(nearIndex, farIndex);
+            std::swap(nearDistance, farDistance);
+        }
+
+        if (nearDistance < 0.0f)
+        {
+            if (stackSize == 0)
+            {
+                break;
+            }
+            node = &mNodes[stack[--stackSize]];
+            continue;
+        }
+
+        node = &mNodes[nearIndex];
+        if (farDistance >= 0.0f)
+        {
+            stack[stackSize++] = farIndex;
+        }
+    }
+
+    return hit.distance < maxDistance;
+}
+
+bool MeshBVH::Occluded(const Math::Ray& ray, float maxDistance) const
+{
+    if (mNodes.empty())
+    {
+        return false;
+    }
+
+    const Math::Vector3 invDirection = Reciprocal(ray.direction);
+    uint32_t stack[StackSize];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const Node& node = mNodes[stack[--stackSize]];
+        if (IntersectNode(ray, invDirection, node, maxDistance) < 0.0f)
+        {
+            continue;
+        }
+
+        if (node.triangleCount == 0)
+        {
+            stack[stackSize++] = node.leftFirst + 1;
+            stack[stackSize++] = node.leftFirst;
+            continue;
+        }
+
+        for (uint32_t i = node.leftFirst; i < node.leftFirst + node.triangleCount; ++i)
+        {
+            const Math::Vector3* p = &mPositions[i * 3];
+            float distance, u, v;
+            if (Math::Intersect(ray, p[0], p[1], p[2], distance, u, v) && distance < maxDistance)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint32_t MeshBVH::RaycastPacket(const Math::Ray* rays, float maxDistance, RayHit* hits) const
+{
+#ifdef MATH_USE_SSE
+    alignas(16) float tMax[PacketSize];
+    alignas(16) float origin[3][PacketSize];
+    alignas(16) float invDirection[3][PacketSize];
+    Math::Vector3 packetDirection = Math::Vector3::Zero;
+    for (uint32_t r = 0; r < PacketSize; ++r)
+    {
+        hits[r] = {};
+        hits[r].distance = maxDistance;
+        tMax[r] = maxDistance;
+
+        const Math::Vector3 inv = Reciprocal(rays[r].direction);
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            origin[axis][r] = rays[r].origin.v[axis];
+            invDirection[axis][r] = inv.v[axis];
+        }
+        packetDirection += rays[r].direction;
+    }
+
+    if (mNodes.empty())
+    {
+        return 0;
+    }
+
+    const __m128 ox = _mm_load_ps(origin[0]);
+    const __m128 oy = _mm_load_ps(origin[1]);
+    const __m128 oz = _mm_load_ps(origin[2]);
+    const __m128 idx = _mm_load_ps(invDirection[0]);
+    const __m128 idy = _mm_load_ps(invDirection[1]);
+    const __m128 idz = _mm_load_ps(invDirection[2]);
+    const __m128 zero = _mm_setzero_ps();
+
+    // Slab test for all rays at once, returns one bit per ray that overlaps the node
+    auto testNode = [&](const Node& node) -> int
+    {
+        const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.x), ox), idx);
+        const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.x), ox), idx);
+        const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.y), oy), idy);
+        const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.y), oy), idy);
+        const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.z), oz), idz);
+        const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.z), oz), idz);
+
+        const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)),
+                                        _mm_max_ps(_mm_min_ps(t0z, t1z), zero));
+        const __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)),
+                                       _mm_min_ps(_mm_max_ps(t0z, t1z), _mm_load_ps(tMax)));
+        return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+    };
+
+    uint32_t stack[StackSize];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const Node& node = mNodes[stack[--stackSize]];
+        const int mask = testNode(node);
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        if (node.triangleCount > 0)
+        {
+            for (uint32_t r = 0; r < PacketSize; ++r)
+            {
+                if (mask & (1 << r))
+                {
+                    TestLeaf(node, rays[r], hits[r]);
+                    tMax[r] = hits[r].distance;
+                }
+            }
+            continue;
+        }
+
+        // Rays in a packet are coherent, so order the children by the packet's average direction
+        const Node& left = mNodes[node.leftFirst];
+        const Node& right = mNodes[node.leftFirst + 1];
+        const Math::Vector3 leftToRight = (right.min + right.max) - (left.min + left.max);
+        if (Math::Dot(leftToRight, packetDirection) < 0.0f)
+        {
+            stack[stackSize++] = node.leftFirst;
+            stack[stackSize++] = node.leftFirst + 1;
+        }
+        else
+        {
+            stack[stackSize++] = node.leftFirst + 1;
+            stack[stackSize++] = node.leftFirst;
+        }
+    }
+
+    uint32_t hitMask = 0;
+    for (uint32_t r = 0; r < PacketSize; ++r)
+    {
+        if (hits[r].distance < maxDistance)
+        {
+            hitMask |= 1 << r;
+        }
+    }
+    return hitMask;
+#else
+    uint32_t hitMask = 0;
+    for (uint32_t r = 0; r < PacketSize; ++r)
+    {
+        if (Raycast(rays[r], maxDistance, hits[r]))
+        {
+            hitMask |= 1 << r;
+        }
+    }
+    return hitMask;
+#endif
+}
+
+const std::vector<MeshBVH::Node>& MeshBVH::GetNodes() const
+{
+    return mNodes;
+}
+
+const std::vector<uint32_t>& MeshBVH::GetTriangleIds() const
+{
+    return mTriangleIds;
+}
+
+void MeshBVH::Subdivide(uint32_t rootIndex)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pending; // node, depth
+    pending.push_back({rootIndex, 0});
+    while (!pending.empty())
+    {
+        const auto [nodeIndex, depth] = pending.back();
+        pending.pop_back();
+
+        const uint32_t first = mNodes[nodeIndex].leftFirst;
+        const uint32_t count = mNodes[nodeIndex].triangleCount;
+        if (count <= 2 || depth >= MaxDepth)
+        {
+            continue;
+        }
+
+        // Bin by centroid, the centroid bounds give tighter bins than the node bounds
+        Math::AABB centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            centroidBounds = Math::Union(centroidBounds, mCentroids[mTriangleIds[i]]);
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        uint32_t bestAxis = 0;
+        uint32_t bestSplit = 0;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            const float boundsMin = centroidBounds.min.v[axis];
+            const float extent = centroidBounds.max.v[axis] - boundsMin;
+            if (extent <= 0.0f)
+            {
+                continue;
+            }
+
+            Bin bins[BinCount];
+            const float scale = BinCount / extent;
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const uint32_t t = mTriangleIds[i];
+                const float offset = (mCentroids[t].v[axis] - boundsMin) * scale;
+                const uint32_t b = Math::Min(BinCount - 1, static_cast<uint32_t>(offset));
+                bins[b].triangleCount++;
+                bins[b].bounds = Math::Union(bins[b].bounds, mPositions[t * 3]);
+                bins[b].bounds = Math::Union(bins[b].bounds, mPositions[t * 3 + 1]);
+                bins[b].bounds = Math::Union(bins[b].bounds, mPositions[t * 3 + 2]);
+            }
+
+            // Sweep from both ends to get the cost of every split plane in one pass
+            float leftArea[BinCount - 1];
+            float rightArea[BinCount - 1];
+            uint32_t leftCount[BinCount - 1];
+            uint32_t rightCount[BinCount - 1];
+            Math::AABB leftBox, rightBox;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t i = 0; i < BinCount - 1; ++i)
+            {
+                leftSum += bins[i].triangleCount;
+                leftCount[i] = leftSum;
+                leftBox = Math::Union(leftBox, bins[i].bounds);
+                leftArea[i] = leftSum > 0 ? Math::SurfaceArea(leftBox) : 0.0f;
+
+                rightSum += bins[BinCount - 1 - i].triangleCount;
+                rightCount[BinCount - 2 - i] = rightSum;
+                rightBox = Math::Union(rightBox, bins[BinCount - 1 - i].bounds);
+                rightArea[BinCount - 2 - i] = rightSum > 0 ? Math::SurfaceArea(rightBox) : 0.0f;
+            }
+
+            for (uint32_t i = 0; i < BinCount - 1; ++i)
+            {
+                const float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        const Node& node = mNodes[nodeIndex];
+        const float leafCost = count * Math::SurfaceArea({node.min, node.max});
+        if (count <= MaxLeafTriangles && bestCost >= leafCost)
+        {
+            continue;
+        }
+        if (bestCost == std::numeric_limits<float>::max())
+        {
+            // Every centroid is in the same spot, nothing to split on
+            continue;
+        }
+
+        // Partition in place around the chosen plane
+        const float boundsMin = centroidBounds.min.v[bestAxis];
+        const float scale = BinCount / (centroidBounds.max.v[bestAxis] - boundsMin);
+        const auto begin = mTriangleIds.begin() + first;
+        const auto middle = std::partition(begin, begin + count, [&](uint32_t t)
+        {
+            const float offset = (mCentroids[t].v[bestAxis] - boundsMin) * scale;
+            return Math::Min(BinCount - 1, static_cast<uint32_t>(offset)) <= bestSplit;
+        });
+
+        const uint32_t leftTriangles = static_cast<uint32_t>(middle - begin);
+        if (leftTriangles == 0 || leftTriangles == count)
+        {
+            continue;
+        }
+
+        const uint32_t leftIndex = static_cast<uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+        mNodes.emplace_back();
+        mNodes[leftIndex].leftFirst = first;
+        mNodes[leftIndex].triangleCount = leftTriangles;
+        mNodes[leftIndex + 1].leftFirst = first + leftTriangles;
+        mNodes[leftIndex + 1].triangleCount = count - leftTriangles;
+        mNodes[nodeIndex].leftFirst = leftIndex;
+        mNodes[nodeIndex].triangleCount = 0;
+
+        UpdateBounds(leftIndex);
+        UpdateBounds(leftIndex + 1);
+        pending.push_back({leftIndex, depth + 1});
+        pending.push_back({leftIndex + 1, depth + 1});
+    }
+}
+
+void MeshBVH::UpdateBounds(uint32_t nodeIndex)
+{
+    // Only called while building, positions are still indexed by source triangle
+    Node& node = mNodes[nodeIndex];
+    Math::AABB bounds;
+    for (uint32_t i = node.leftFirst; i < node.leftFirst + node.triangleCount; ++i)
+    {
+        const uint32_t t = mTriangleIds[i];
+        bounds = Math::Union(bounds, mPositions[t * 3]);
+        bounds = Math::Union(bounds, mPositions[t * 3 + 1]);
+        bounds = Math::Union(bounds, mPositions[t * 3 + 2]);
+    }
+    node.min = bounds.min;
+    node.max = bounds.max;
+}
+
+void MeshBVH::RefitBounds()
+{
+    // Children are always stored after their parent, so a reverse sweep is bottom up
+    for (size_t n = mNodes.size(); n-- > 0;)
+    {
+        Node& node = mNodes[n];
+        Math::AABB bounds;
+        if (node.triangleCount > 0)
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.triangleCount; ++i)
+            {
+                bounds = Math::Union(bounds, mPositions[i * 3]);
+                bounds = Math::Union(bounds, mPositions[i * 3 + 1]);
+                bounds = Math::Union(bounds, mPositions[i * 3 + 2]);
+            }
+        }
+        else
+        {
+            const Node& left = mNodes[node.leftFirst];
+            const Node& right = mNodes[node.leftFirst + 1];
+            bounds = Math::Union(Math::AABB(left.min, left.max), Math::AABB(right.min, right.max));
+        }
+        node.min = bounds.min;
+        node.max = bounds.max;
+    }
+}
+
+void MeshBVH::TestLeaf(const Node& node, const Math::Ray& ray, RayHit& hit) const
+{
+    for (uint32_t i = node.leftFirst; i < node.leftFirst + node.triangleCount; ++i)
+    {
+        const Math::Vector3* p = &mPositions[i * 3];
+        float distance, u, v;
+        if (Math::Intersect(ray, p[0], p[1], p[2], distance, u, v) && distance < hit.distance)
+        {
+            hit.distance = distance;
+            hit.triangleIndex = mTriangleIds[i];
+            hit.u = u;
+            hit.v = v;
+        }
+    }
+}
@@ -5,6 +5,13 @@
 using namespace Engine;
 using namespace Engine::Graphics;
 
+namespace
+{
+const Core::PerfCounter sDrawCalls("Graphics.DrawCalls");
+const Core::PerfCounter sBufferUpdates("Graphics.BufferUpdates");
+const Core::PerfCounter sBytesUploaded("Graphics.BytesUploaded");
+} // namespace
+
 void MeshBuffer::Initialize(const void* vertices, uint32_t vertexSize, uint32_t vertexCount)
 {
     CreateVertexBuffer(vertices, vertexSize, vertexCount);
@@ -14,15 +21,19 @@ void MeshBuffer::Initialize(const void* vertices,
                             uint32_t vertexSize,
                             uint32_t vertexCount,
                             const void* indices,
-                            uint32_t indexCount)
+                            uint32_t indexCount,
+                            bool dynamicIndices)
 {
     CreateVertexBuffer(vertices, vertexSize, vertexCount);
-    CreateIndexBuffer(indices, indexCount);
+    CreateIndexBuffer(indices, indexCount, dynamicIndices);
 }
 
 void MeshBuffer::Terminate()
 {
+    SafeRelease(mIndexBuffer);
     SafeRelease(mVertexBuffer);
+    Core::MemoryTracker::Untrack(std::exchange(mIndexMemoryId, Core::InvalidHandle));
+    Core::MemoryTracker::Untrack(std::exchange(mVertexMemoryId, Core::InvalidHandle));
 }
 
 void MeshBuffer::SetTopology(Topology topology)
@@ -52,6 +63,46 @@ void MeshBuffer::Update(const void* vertices, uint32_t vertexCount)
     context->Map(mVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
     memcpy(resource.pData, vertices, (mVertexSize * vertexCount));
     context->Unmap(mVertexBuffer, 0);
+    sBufferUpdates.Add();
+    sBytesUploaded.Add(mVertexSize * vertexCount);
+}
+
+void* MeshBuffer::Map()
+{
+    auto context = GraphicsSystem::Get()->GetContext();
+
+    D3D11_MAPPED_SUBRESOURCE resource;
+    HRESULT hr = context->Map(mVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
+    ASSERT(SUCCEEDED(hr), "MeshBuffer: Failed to map the vertex buffer, is it dynamic?");
+    sBufferUpdates.Add();
+    sBytesUploaded.Add(mVertexSize * mVertexCount); // Discarded, the caller rewrites all of it
+    return SUCCEEDED(hr) ? resource.pData : nullptr;
+}
+
+void MeshBuffer::Unmap()
+{
+    auto context = GraphicsSystem::Get()->GetContext();
+    context->Unmap(mVertexBuffer, 0);
+}
+
+void MeshBuffer::UpdateIndices(const uint32_t* indices, uint32_t indexCount)
+{
+    ASSERT(mDynamicIndices, "MeshBuffer: Index buffer was not created as dynamic");
+    ASSERT(indexCount <= mIndexCapacity, "MeshBuffer: Too many indices for the index buffer");
+    mIndexCount = indexCount;
+    if (indexCount == 0)
+    {
+        return;
+    }
+
+    auto context = GraphicsSystem::Get()->GetContext();
+
+    D3D11_MAPPED_SUBRESOURCE resource;
+    context->Map(mIndexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
+    memcpy(resource.pData, indices, indexCount * sizeof(uint32_t));
+    context->Unmap(mIndexBuffer, 0);
+    sBufferUpdates.Add();
+    sBytesUploaded.Add(indexCount * sizeof(uint32_t));
 }
 
 void MeshBuffer::Render() const
@@ -71,6 +122,27 @@ void MeshBuffer::Render() const
     {
         context->Draw(static_cast<UINT>(mVertexCount), 0);
     }
+    sDrawCalls.Add();
+}
+
+void MeshBuffer::RenderInstanced(uint32_t instanceCount) const
+{
+    auto context = GraphicsSystem::Get()->GetContext();
+
+    context->IASetPrimitiveTopology(mTopology);
+    UINT offset = 0;
+    context->IASetVertexBuffers(0, 1, &mVertexBuffer, &mVertexSize, &offset);
+
+    if (mIndexBuffer != nullptr)
+    {
+        context->IASetIndexBuffer(mIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+        context->DrawIndexedInstanced(mIndexCount, instanceCount, 0, 0, 0);
+    }
+    else
+    {
+        context->DrawInstanced(mVertexCount, instanceCount, 0, 0);
+    }
+    sDrawCalls.Add();
 }
 
 void MeshBuffer::CreateVertexBuffer(const void* vertices, uint32_t vertexSize, uint32_t vertexCount)
@@ -97,9 +169,13 @@ void MeshBuffer::CreateVertexBuffer(const void* vertices, uint32_t vertexSize, u
     HRESULT hr =
         device->CreateBuffer(&bufferDesc, (isDynamic ? nullptr : &initData), &mVertexBuffer);
     ASSERT(SUCCEEDED(hr), "Failed to create vertex buffer");
+    mVertexMemoryId = Core::MemoryTracker::Track(
+        Core::MemoryTag::Buffers, bufferDesc.ByteWidth, "Vertex buffer");
 }
 
-void Engine::Graphics::MeshBuffer::CreateIndexBuffer(const void* indices, uint32_t indexCount)
+void Engine::Graphics::MeshBuffer::CreateIndexBuffer(const void* indices,
+                                                     uint32_t indexCount,
+                                                     bool isDynamic)
 {
     if (indexCount == 0)
     {
@@ -107,20 +183,25 @@ void Engine::Graphics::MeshBuffer::CreateIndexBuffer(const void* indices, uint32
     }
 
     mIndexCount = indexCount;
+    mIndexCapacity = indexCount;
+    mDynamicIndices = isDynamic;
 
     auto device = GraphicsSystem::Get()->GetDevice();
 
     // Index Buffer
     D3D11_BUFFER_DESC bufferDesc{};
     bufferDesc.ByteWidth = static_cast<UINT>(indexCount) * sizeof(uint32_t);
-    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.Usage = (isDynamic) ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
     bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     bufferDesc.MiscFlags = 0;
     bufferDesc.StructureByteStride = 0;
+    bufferDesc.CPUAccessFlags = (isDynamic) ? D3D11_CPU_ACCESS_WRITE : 0;
 
     D3D11_SUBRESOURCE_DATA initData = {};
     initData.pSysMem = indices;
 
     HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &mIndexBuffer);
     ASSERT(SUCCEEDED(hr), "Failed to create Index Buffer");
+    mIndexMemoryId =
+        Core::MemoryTracker::Track(Core::MemoryTag::Buffers, bufferDesc.ByteWidth, "Index buffer");
 }
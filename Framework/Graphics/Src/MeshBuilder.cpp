@@ -67,6 +67,7 @@ void CreateCubeIndices(std::vector<uint32_t>& indices)
 
 void CreatePlaneIndices(std::vector<uint32_t>& indices, int numRows, int numColums)
 {
+    indices.reserve(indices.size() + numRows * numColums * 6);
     for (int r = 0; r < numRows; ++r)
     {
         for (int c = 0; c < numColums; ++c)
@@ -88,6 +89,7 @@ void CreatePlaneIndices(std::vector<uint32_t>& indices, int numRows, int numColu
 
 void CreateCapIndices(std::vector<uint32_t>& indices, int slices, int topIndex, int bottomIndex)
 {
+    indices.reserve(indices.size() + slices * 6);
     for (int s = 0; s < slices; ++s)
     {
         // Botoom Triangle
@@ -245,6 +247,7 @@ MeshPC MeshBuilder::CreatePlanePC(int numRows, int numColums, float spacing, boo
     float w = -hpw;
     float h = -hph;
 
+    mesh.vertices.reserve((numRows + 1) * (numColums + 1));
     for (int r = 0; r <= numRows; ++r)
     {
         for (int c = 0; c <= numColums; ++c)
@@ -277,6 +280,7 @@ MeshPX MeshBuilder::CreatePlanePX(int numRows, int numColums, float spacing, boo
     float u = 0.0f;
     float v = 1.0f;
 
+    mesh.vertices.reserve((numRows + 1) * (numColums + 1));
     for (int r = 0; r <= numRows; ++r)
     {
         for (int c = 0; c <= numColums; ++c)
@@ -315,6 +319,7 @@ Mesh MeshBuilder::CreatePlane(int numRows, int numColums, float spacing, bool ho
     Math::Vector3 normal = (horizontal) ? Math::Vector3::YAxis : -Math::Vector3::ZAxis;
     Math::Vector3 tan = Math::Vector3::XAxis;
 
+    mesh.vertices.reserve((numRows + 1) * (numColums + 1));
     for (int r = 0; r <= numRows; ++r)
     {
         for (int c = 0; c <= numColums; ++c)
@@ -345,6 +350,7 @@ MeshPC MeshBuilder::CreateCylinderPC(int slices, int rings)
     const float hh = static_cast<float>(rings) * 0.5f;
     const float fSlices = static_cast<float>(slices);
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1) + 2);
     for (int r = 0; r <= rings; ++r)
     {
         float ring = static_cast<float>(r);
@@ -376,6 +382,7 @@ MeshPC MeshBuilder::CreateSpherePC(int slices, int rings, float radius)
     float vertRotation = (Math::Constants::Pi / static_cast<float>(rings));
     float horzRotation = (Math::Constants::TwoPi / static_cast<float>(slices));
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1));
     for (int r = 0; r <= rings; ++r)
     {
         float ring = static_cast<float>(r);
@@ -408,6 +415,7 @@ MeshPX MeshBuilder::CreateSpherePX(int slices, int rings, float radius)
     float uStep = 1.0f / static_cast<float>(slices);
     float vStep = 1.0f / static_cast<float>(rings);
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1));
     for (int r = 0; r <= rings; ++r)
     {
         float ring = static_cast<float>(r);
@@ -443,6 +451,7 @@ Mesh MeshBuilder::CreateSphere(int slices, int rings, float radius)
     float uStep = 1.0f / static_cast<float>(slices);
     float vStep = 1.0f / static_cast<float>(rings);
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1));
     for (int r = 0; r <= rings; ++r)
     {
         auto ring = static_cast<float>(r);
@@ -483,6 +492,7 @@ MeshPX MeshBuilder::CreateSkySpherePX(int slices, int rings, float radius)
     float uStep = 1.0f / static_cast<float>(slices);
     float vStep = 1.0f / static_cast<float>(rings);
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1));
     for (int r = 0; r <= rings; ++r)
     {
         float ring = static_cast<float>(r);
@@ -518,6 +528,7 @@ Mesh MeshBuilder::CreateSkySphere(int slices, int rings, float radius)
     const float uInc = 1.0f / static_cast<float>(slices);
     const float vInc = 1.0f / static_cast<float>(rings);
 
+    mesh.vertices.reserve((rings + 1) * (slices + 1));
     for (uint32_t r = 0; r <= rings; ++r)
     {
         const float ring = static_cast<float>(r);
@@ -0,0 +1,133 @@
+#include "Precompiled.h"
+#include "Meshlet.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+void ComputeBounds(const Mesh& mesh, Meshlet& meshlet)
+{
+    const uint32_t indexCount = meshlet.triangleCount * 3;
+    const uint32_t* indices = mesh.indices.data() + meshlet.indexOffset;
+
+    // Sphere around the center of the AABB
+    Math::Vector3 min = mesh.vertices[indices[0]].position;
+    Math::Vector3 max = min;
+    for (uint32_t i = 1; i < indexCount; ++i)
+    {
+        const Math::Vector3& p = mesh.vertices[indices[i]].position;
+        min = {Math::Min(min.x, p.x), Math::Min(min.y, p.y), Math::Min(min.z, p.z)};
+        max = {Math::Max(max.x, p.x), Math::Max(max.y, p.y), Math::Max(max.z, p.z)};
+    }
+    meshlet.center = (min + max) * 0.5f;
+
+    float radiusSqr = 0.0f;
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+        const Math::Vector3& p = mesh.vertices[indices[i]].position;
+        radiusSqr = Math::Max(radiusSqr, Math::DistanceSqr(meshlet.center, p));
+    }
+    meshlet.radius = sqrt(radiusSqr);
+
+    // Normal cone from the face normals (clockwise winding, left handed)
+    std::array<Math::Vector3, MeshletBuilder::MaxTriangles> faceNormals;
+    uint32_t faceCount = 0;
+    Math::Vector3 axis = Math::Vector3::Zero;
+    for (uint32_t i = 0; i < indexCount && faceCount < faceNormals.size(); i += 3)
+    {
+        const Math::Vector3& a = mesh.vertices[indices[i]].position;
+        const Math::Vector3& b = mesh.vertices[indices[i + 1]].position;
+        const Math::Vector3& c = mesh.vertices[indices[i + 2]].position;
+        const Math::Vector3 n = Math::Cross(b - a, c - a);
+        const float area = Math::Magnitude(n);
+        if (area > 1e-12f)
+        {
+            faceNormals[faceCount] = n / area;
+            axis += faceNormals[faceCount];
+            ++faceCount;
+        }
+    }
+
+    meshlet.coneAxis = Math::Vector3::Zero;
+    meshlet.coneCutoff = 1.0f;
+    const float axisLength = Math::Magnitude(axis);
+    if (faceCount == 0 || axisLength < 1e-6f)
+    {
+        return;
+    }
+    axis = axis / axisLength;
+
+    float minDot = 1.0f;
+    for (uint32_t f = 0; f < faceCount; ++f)
+    {
+        minDot = Math::Min(minDot, Math::Dot(axis, faceNormals[f]));
+    }
+
+    // Cones wider than ~84 degrees are almost never rejected, don't bother testing them
+    meshlet.coneAxis = axis;
+    if (minDot > 0.1f)
+    {
+        meshlet.coneCutoff = sqrt(1.0f - (minDot * minDot));
+    }
+}
+} // namespace
+
+std::vector<Meshlet> MeshletBuilder::Build(const Mesh& mesh,
+                                           uint32_t maxVertices,
+                                           uint32_t maxTriangles)
+{
+    ASSERT(maxVertices >= 3 && maxTriangles >= 1, "MeshletBuilder: Invalid meshlet limits");
+    ASSERT(maxTriangles <= MaxTriangles, "MeshletBuilder: At most %d triangles", MaxTriangles);
+
+    std::vector<Meshlet> meshlets;
+    const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    if (triangleCount == 0)
+    {
+        return meshlets;
+    }
+
+    // Stores the id of the last meshlet that referenced each vertex
+    std::vector<uint32_t> vertexOwner(mesh.vertices.size(), UINT32_MAX);
+    uint32_t meshletId = 0;
+    Meshlet current;
+
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const uint32_t a = mesh.indices[(t * 3) + 0];
+        const uint32_t b = mesh.indices[(t * 3) + 1];
+        const uint32_t c = mesh.indices[(t * 3) + 2];
+
+        auto CountNewVertices = [&]()
+        {
+            uint32_t count = (vertexOwner[a] != meshletId) ? 1 : 0;
+            count += (b != a && vertexOwner[b] != meshletId) ? 1 : 0;
+            count += (c != a && c != b && vertexOwner[c] != meshletId) ? 1 : 0;
+            return count;
+        };
+
+        uint32_t newVertices = CountNewVertices();
+        if (current.triangleCount > 0 && (current.vertexCount + newVertices > maxVertices ||
+                                          current.triangleCount + 1 > maxTriangles))
+        {
+            meshlets.push_back(current);
+            current = Meshlet();
+            current.indexOffset = t * 3;
+            ++meshletId;
+            newVertices = CountNewVertices();
+        }
+
+        vertexOwner[a] = meshletId;
+        vertexOwner[b] = meshletId;
+        vertexOwner[c] = meshletId;
+        current.vertexCount += newVertices;
+        ++current.triangleCount;
+    }
+    meshlets.push_back(current);
+
+    for (Meshlet& meshlet : meshlets)
+    {
+        ComputeBounds(mesh, meshlet);
+    }
+    return meshlets;
+}
@@ -0,0 +1,119 @@
+#include "Precompiled.h"
+#include "MeshletCuller.h"
+
+#include "Camera.h"
+#include "ModelManager.h"
+#include "RenderObject.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+void MeshletCuller::Begin(const Camera& camera)
+{
+    mCamera = &camera;
+    mStats = {};
+}
+
+void MeshletCuller::Cull(RenderGroup& renderGroup)
+{
+    Cull(renderGroup, renderGroup.GetWorldMatrix());
+}
+
+void MeshletCuller::Cull(RenderGroup& renderGroup, const Math::Matrix4& matWorld)
+{
+    ASSERT(mCamera != nullptr, "MeshletCuller: Begin must be called before Cull");
+
+    const Model* model = ModelManager::Get()->GetModel(renderGroup.modelId);
+    if (model == nullptr)
+    {
+        return;
+    }
+
+    // Work in model space so meshlet bounds never need transforming
+    const Math::Matrix4 matFinal =
+        matWorld * mCamera->GetViewMatrix() * mCamera->GetProjectionMatrix();
+    const Math::Frustum frustum = Math::ExtractFrustum(matFinal);
+
+    const Math::Matrix4 matInvWorld = Math::Inverse(matWorld);
+    const bool isOrthographic = mCamera->GetMode() == Camera::ProjectionMode::Orthographic;
+    const Math::Vector3 cameraPosition = Math::TransformCoord(mCamera->GetPosition(), matInvWorld);
+    const Math::Vector3 cameraDirection =
+        Math::Normalize(Math::TransformNormal(mCamera->GetDirection(), matInvWorld));
+
+    const size_t objectCount = Math::Min(renderGroup.renderObjects.size(), model->meshData.size());
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        const Model::MeshData& meshData = model->meshData[i];
+        if (meshData.meshlets.size() <= 1)
+        {
+            continue;
+        }
+
+        mIndices.clear();
+        for (const Meshlet& meshlet : meshData.meshlets)
+        {
+            ++mStats.totalMeshlets;
+            mStats.totalTriangles += meshlet.triangleCount;
+
+            if (mEnabled)
+            {
+                if (!Math::IsSphereInFrustum(frustum, meshlet.center, meshlet.radius))
+                {
+                    ++mStats.frustumCulled;
+                    continue;
+                }
+
+                // Every triangle faces away when the view ray lies inside the back facing cone
+                if (mUseConeCulling && meshlet.coneCutoff < 1.0f)
+                {
+                    bool backFacing = false;
+                    if (isOrthographic)
+                    {
+                        backFacing =
+                            Math::Dot(cameraDirection, meshlet.coneAxis) >= meshlet.coneCutoff;
+                    }
+                    else
+                    {
+                        const Math::Vector3 toMeshlet = meshlet.center - cameraPosition;
+                        const float limit =
+                            meshlet.coneCutoff * Math::Magnitude(toMeshlet) + meshlet.radius;
+                        backFacing = Math::Dot(toMeshlet, meshlet.coneAxis) >= limit;
+                    }
+
+                    if (backFacing)
+                    {
+                        ++mStats.coneCulled;
+                        continue;
+                    }
+                }
+            }
+
+            ++mStats.visibleMeshlets;
+            mStats.visibleTriangles += meshlet.triangleCount;
+
+            const uint32_t* begin = meshData.mesh.indices.data() + meshlet.indexOffset;
+            mIndices.insert(mIndices.end(), begin, begin + meshlet.triangleCount * 3);
+        }
+
+        renderGroup.renderObjects[i].meshBuffer.UpdateIndices(
+            mIndices.data(), static_cast<uint32_t>(mIndices.size()));
+    }
+}
+
+const MeshletCuller::Stats& MeshletCuller::GetStats() const
+{
+    return mStats;
+}
+
+void MeshletCuller::DebugUI()
+{
+    if (ImGui::CollapsingHeader("MeshletCuller", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Checkbox("Enabled##MeshletCuller", &mEnabled);
+        ImGui::Checkbox("ConeCulling##MeshletCuller", &mUseConeCulling);
+        ImGui::Text("Meshlets: %u / %u", mStats.visibleMeshlets, mStats.totalMeshlets);
+        ImGui::Text("Frustum Culled: %u", mStats.frustumCulled);
+        ImGui::Text("Cone Culled: %u", mStats.coneCulled);
+        ImGui::Text("Triangles: %u / %u", mStats.visibleTriangles, mStats.totalTriangles);
+    }
+}
@@ -1,5 +1,6 @@
 #include "Precompiled.h"
 #include "ModelIO.h"
+#include "BinaryIO.h"
 #include "Model.h"
 
 #ifndef MAX_PATH
@@ -195,3 +196,482 @@ void ModelIO::LoadMaterial(std::filesystem::path filePath, Model& model)
     fclose(file);
 }
 
+void ModelIO::SaveMeshlets(std::filesystem::path filePath, const Model& model)
+{
+    if (model.meshData.empty())
+    {
+        return;
+    }
+
+    filePath.replace_extension("meshlet");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "w");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t meshCount = static_cast<uint32_t>(model.meshData.size());
+    fprintf_s(file, "MeshCount: %d\n", meshCount);
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        const uint32_t meshletCount = static_cast<uint32_t>(meshData.meshlets.size());
+        fprintf_s(file, "MeshletCount: %d\n", meshletCount);
+        for (const Meshlet& m : meshData.meshlets)
+        {
+            fprintf_s(file, "%d %d %d %f %f %f %f %f %f %f %f\n",
+                m.indexOffset, m.triangleCount, m.vertexCount,
+                m.center.x, m.center.y, m.center.z, m.radius,
+                m.coneAxis.x, m.coneAxis.y, m.coneAxis.z, m.coneCutoff);
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::LoadMeshlets(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("meshlet");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "r");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t meshCount = 0;
+    bool success = fscanf_s(file, "MeshCount: %d\n", &meshCount) == 1 &&
+                   meshCount == model.meshData.size();
+    for (uint32_t i = 0; i < meshCount && success; ++i)
+    {
+        Model::MeshData& meshData = model.meshData[i];
+        const std::vector<uint32_t>& indices = meshData.mesh.indices;
+        const size_t vertexCount = meshData.mesh.vertices.size();
+
+        uint32_t meshletCount = 0;
+        success = fscanf_s(file, "MeshletCount: %d\n", &meshletCount) == 1 &&
+                  meshletCount <= indices.size();
+        meshData.meshlets.resize(success ? meshletCount : 0);
+        for (Meshlet& m : meshData.meshlets)
+        {
+            success = success &&
+                      fscanf_s(file, "%d %d %d %f %f %f %f %f %f %f %f\n",
+                          &m.indexOffset, &m.triangleCount, &m.vertexCount,
+                          &m.center.x, &m.center.y, &m.center.z, &m.radius,
+                          &m.coneAxis.x, &m.coneAxis.y, &m.coneAxis.z, &m.coneCutoff) == 11 &&
+                      m.indexOffset <= indices.size() &&
+                      m.triangleCount <= (indices.size() - m.indexOffset) / 3;
+            if (success)
+            {
+                const auto begin = indices.begin() + m.indexOffset;
+                const auto end = begin + m.triangleCount * 3;
+                success = std::all_of(
+                    begin, end, [vertexCount](uint32_t index) { return index < vertexCount; });
+            }
+        }
+    }
+
+    // Truncated file, or saved for a different version of the meshes. The ModelManager builds
+    // the meshlets again for every mesh left without any.
+    if (!success)
+    {
+        for (Model::MeshData& meshData : model.meshData)
+        {
+            meshData.meshlets.clear();
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::SaveBVH(std::filesystem::path filePath, const Model& model)
+{
+    if (model.meshData.empty())
+    {
+        return;
+    }
+
+    filePath.replace_extension("bvh");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "w");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    // Only the topology is saved, node bounds are refit from the mesh on load
+    const uint32_t meshCount = static_cast<uint32_t>(model.meshData.size());
+    fprintf_s(file, "MeshCount: %d\n", meshCount);
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        const std::vector<MeshBVH::Node>& nodes = meshData.bvh.GetNodes();
+        const uint32_t nodeCount = static_cast<uint32_t>(nodes.size());
+        fprintf_s(file, "NodeCount: %d\n", nodeCount);
+        for (const MeshBVH::Node& node : nodes)
+        {
+            fprintf_s(file, "%d %d\n", node.leftFirst, node.triangleCount);
+        }
+
+        const std::vector<uint32_t>& triangleIds = meshData.bvh.GetTriangleIds();
+        const uint32_t triangleCount = static_cast<uint32_t>(triangleIds.size());
+        fprintf_s(file, "TriangleCount: %d\n", triangleCount);
+        for (uint32_t triangleId : triangleIds)
+        {
+            fprintf_s(file, "%d\n", triangleId);
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::LoadBVH(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("bvh");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "r");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t meshCount = 0;
+    bool success = fscanf_s(file, "MeshCount: %d\n", &meshCount) == 1 &&
+                   meshCount == model.meshData.size();
+    for (uint32_t i = 0; i < meshCount && success; ++i)
+    {
+        Model::MeshData& meshData = model.meshData[i];
+        const size_t meshTriangleCount = meshData.mesh.indices.size() / 3;
+
+        // A binary tree over the mesh's triangles has at most twice as many nodes
+        uint32_t nodeCount = 0;
+        success = fscanf_s(file, "NodeCount: %d\n", &nodeCount) == 1 &&
+                  nodeCount <= meshTriangleCount * 2;
+        std::vector<MeshBVH::Node> nodes(success ? nodeCount : 0);
+        for (MeshBVH::Node& node : nodes)
+        {
+            success = success &&
+                      fscanf_s(file, "%d %d\n", &node.leftFirst, &node.triangleCount) == 2;
+        }
+
+        uint32_t triangleCount = 0;
+        success = success && fscanf_s(file, "TriangleCount: %d\n", &triangleCount) == 1 &&
+                  triangleCount == meshTriangleCount;
+        std::vector<uint32_t> triangleIds(success ? triangleCount : 0);
+        for (uint32_t& triangleId : triangleIds)
+        {
+            success = success && fscanf_s(file, "%d\n", &triangleId) == 1;
+        }
+
+        // Empty meshes save no nodes
+        if (success && nodeCount > 0)
+        {
+            success =
+                meshData.bvh.Initialize(meshData.mesh, std::move(nodes), std::move(triangleIds));
+        }
+    }
+
+    // Truncated file, or saved for a different version of the meshes. Empty hierarchies are
+    // built the first time the model is ray cast, see ModelManager::GetModelWithBVH.
+    if (!success)
+    {
+        for (Model::MeshData& meshData : model.meshData)
+        {
+            meshData.bvh.Terminate();
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::SaveSkeleton(std::filesystem::path filePath, const Model& model)
+{
+    if (model.skeleton.IsEmpty())
+    {
+        return;
+    }
+
+    filePath.replace_extension("skeleton");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "w");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t boneCount = static_cast<uint32_t>(model.skeleton.bones.size());
+    fprintf_s(file, "BoneCount: %d\n", boneCount);
+    for (const Bone& bone : model.skeleton.bones)
+    {
+        // Names are read back with %s, so they can't contain spaces
+        std::string name = bone.name.empty() ? "<NONE>" : bone.name;
+        std::replace(name.begin(), name.end(), ' ', '_');
+
+        const Transform& t = bone.restTransform;
+        const Math::Matrix4& m = bone.offsetTransform;
+        fprintf_s(file, "%s %d\n", name.c_str(), bone.parentIndex);
+        fprintf_s(file, "%f %f %f %f %f %f %f %f %f %f\n",
+            t.position.x, t.position.y, t.position.z,
+            t.rotation.x, t.rotation.y, t.rotation.z, t.rotation.w,
+            t.scale.x, t.scale.y, t.scale.z);
+        fprintf_s(file, "%f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n",
+            m._11, m._12, m._13, m._14,
+            m._21, m._22, m._23, m._24,
+            m._31, m._32, m._33, m._34,
+            m._41, m._42, m._43, m._44);
+    }
+
+    const uint32_t meshCount = static_cast<uint32_t>(model.meshData.size());
+    fprintf_s(file, "MeshCount: %d\n", meshCount);
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        const uint32_t weightCount = static_cast<uint32_t>(meshData.boneWeights.size());
+        fprintf_s(file, "WeightCount: %d\n", weightCount);
+        for (const BoneWeights& w : meshData.boneWeights)
+        {
+            fprintf_s(file, "%d %d %d %d %f %f %f %f\n",
+                w.boneIndices[0], w.boneIndices[1], w.boneIndices[2], w.boneIndices[3],
+                w.weights[0], w.weights[1], w.weights[2], w.weights[3]);
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::LoadSkeleton(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("skeleton");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "r");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t boneCount = 0;
+    fscanf_s(file, "BoneCount: %d\n", &boneCount);
+    model.skeleton.bones.resize(boneCount);
+    for (Bone& bone : model.skeleton.bones)
+    {
+        char buffer[MAX_PATH];
+#ifdef _WIN32
+        fscanf_s(file, "%s %d\n", buffer, (uint32_t)sizeof(buffer), &bone.parentIndex);
+#else
+        fscanf(file, "%s %d\n", buffer, &bone.parentIndex);
+#endif
+        bone.name = (strcmp(buffer, "<NONE>") != 0) ? buffer : "";
+
+        Transform& t = bone.restTransform;
+        Math::Matrix4& m = bone.offsetTransform;
+        fscanf_s(file, "%f %f %f %f %f %f %f %f %f %f\n",
+            &t.position.x, &t.position.y, &t.position.z,
+            &t.rotation.x, &t.rotation.y, &t.rotation.z, &t.rotation.w,
+            &t.scale.x, &t.scale.y, &t.scale.z);
+        fscanf_s(file, "%f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n",
+            &m._11, &m._12, &m._13, &m._14,
+            &m._21, &m._22, &m._23, &m._24,
+            &m._31, &m._32, &m._33, &m._34,
+            &m._41, &m._42, &m._43, &m._44);
+    }
+    model.skeleton.BuildRestPose();
+
+    uint32_t meshCount = 0;
+    fscanf_s(file, "MeshCount: %d\n", &meshCount);
+    if (meshCount != model.meshData.size())
+    {
+        fclose(file);
+        return;
+    }
+
+    for (Model::MeshData& meshData : model.meshData)
+    {
+        uint32_t weightCount = 0;
+        fscanf_s(file, "WeightCount: %d\n", &weightCount);
+        meshData.boneWeights.resize(weightCount);
+        for (BoneWeights& w : meshData.boneWeights)
+        {
+            uint32_t i[BoneWeights::MaxInfluences] = {};
+            fscanf_s(file, "%d %d %d %d %f %f %f %f\n",
+                &i[0], &i[1], &i[2], &i[3],
+                &w.weights[0], &w.weights[1], &w.weights[2], &w.weights[3]);
+            for (uint32_t n = 0; n < BoneWeights::MaxInfluences; ++n)
+            {
+                w.boneIndices[n] = static_cast<uint16_t>(i[n]);
+            }
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::SaveAnimations(std::filesystem::path filePath, const Model& model)
+{
+    if (model.animationClips.empty())
+    {
+        return;
+    }
+
+    filePath.replace_extension("animset");
+
+    // Binary, compressed clips are mostly quantized frame data
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t clipCount = static_cast<uint32_t>(model.animationClips.size());
+    fwrite(&clipCount, sizeof(clipCount), 1, file);
+    for (const AnimationClip& clip : model.animationClips)
+    {
+        clip.Write(file);
+    }
+    fclose(file);
+}
+
+void ModelIO::LoadAnimations(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("animset");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "rb");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t clipCount = 0;
+    if (fread(&clipCount, sizeof(clipCount), 1, file) == 1)
+    {
+        model.animationClips.resize(clipCount);
+        for (AnimationClip& clip : model.animationClips)
+        {
+            if (!clip.Read(file) || clip.GetBoneCount() != model.skeleton.bones.size())
+            {
+                // Truncated file, or clips saved for a different skeleton
+                model.animationClips.clear();
+                break;
+            }
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::SaveMorphTargets(std::filesystem::path filePath, const Model& model)
+{
+    const bool hasTargets = std::any_of(model.meshData.begin(),
+                                        model.meshData.end(),
+                                        [](const Model::MeshData& meshData)
+                                        { return !meshData.morphTargets.empty(); });
+    if (!hasTargets)
+    {
+        return;
+    }
+
+    filePath.replace_extension("morph");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t meshCount = static_cast<uint32_t>(model.meshData.size());
+    fwrite(&meshCount, sizeof(meshCount), 1, file);
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        const uint32_t targetCount = static_cast<uint32_t>(meshData.morphTargets.size());
+        fwrite(&targetCount, sizeof(targetCount), 1, file);
+        for (const MorphTarget& target : meshData.morphTargets)
+        {
+            target.Write(file);
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::LoadMorphTargets(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("morph");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "rb");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t meshCount = 0;
+    bool success = fread(&meshCount, sizeof(meshCount), 1, file) == 1 &&
+                   meshCount == model.meshData.size();
+    for (uint32_t m = 0; m < meshCount && success; ++m)
+    {
+        Model::MeshData& meshData = model.meshData[m];
+        const size_t vertexCount = meshData.mesh.vertices.size();
+        uint32_t targetCount = 0;
+        // Every target stores at least its name length
+        success = fread(&targetCount, sizeof(targetCount), 1, file) == 1 &&
+                  targetCount <= BinaryIO::GetRemainingSize(file) / sizeof(uint32_t);
+        meshData.morphTargets.resize(success ? targetCount : 0);
+        for (MorphTarget& target : meshData.morphTargets)
+        {
+            success = success && target.Read(file) &&
+                      (target.vertexIndices.empty() || target.vertexIndices.back() < vertexCount);
+        }
+    }
+
+    // Truncated file, or saved for a different version of the meshes
+    if (!success)
+    {
+        for (Model::MeshData& meshData : model.meshData)
+        {
+            meshData.morphTargets.clear();
+        }
+    }
+    fclose(file);
+}
+
+void ModelIO::SaveVertexAnimation(std::filesystem::path filePath, const Model& model)
+{
+    if (model.vertexAnimation.IsEmpty())
+    {
+        return;
+    }
+
+    filePath.replace_extension("vat");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        return;
+    }
+    model.vertexAnimation.Write(file);
+    fclose(file);
+}
+
+void ModelIO::LoadVertexAnimation(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("vat");
+
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "rb");
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    uint32_t meshVertexCount = 0;
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        meshVertexCount += static_cast<uint32_t>(meshData.mesh.vertices.size());
+    }
+
+    // Truncated file, or baked from a different version of the meshes
+    if (!model.vertexAnimation.Read(file) || model.vertexAnimation.vertexCount != meshVertexCount)
+    {
+        model.vertexAnimation = {};
+    }
+    fclose(file);
+}
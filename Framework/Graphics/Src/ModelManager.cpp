@@ -8,6 +8,41 @@ using namespace Engine::Graphics;
 namespace 
 {
     std::unique_ptr<ModelManager> sModelManger;
+
+    const Core::PerfCounter sModelsLoaded("Assets.ModelsLoaded");
+    const Core::PerfCounter sLoadTime("Assets.LoadTimeUs");
+    const Core::PerfCounter sModelCount("Assets.Models", Core::PerfCounterType::Gauge);
+
+    template <class T> size_t GetVectorSize(const std::vector<T>& values)
+    {
+        return values.capacity() * sizeof(T);
+    }
+
+    size_t GetMemorySize(const Model& model)
+    {
+        size_t size = 0;
+        for (const Model::MeshData& meshData : model.meshData)
+        {
+            size += GetVectorSize(meshData.mesh.vertices) + GetVectorSize(meshData.mesh.indices);
+            size += GetVectorSize(meshData.meshlets) + GetVectorSize(meshData.boneWeights);
+            size += GetVectorSize(meshData.bvh.GetNodes());
+            // Every leaf slot has its triangle id and a copy of the three positions
+            const size_t leafSlotSize = sizeof(uint32_t) + 3 * sizeof(Math::Vector3);
+            size += meshData.bvh.GetTriangleIds().size() * leafSlotSize;
+            for (const MorphTarget& target : meshData.morphTargets)
+            {
+                size += GetVectorSize(target.vertexIndices) + GetVectorSize(target.deltas);
+            }
+        }
+        size += GetVectorSize(model.skeleton.bones);
+        for (const AnimationClip& clip : model.animationClips)
+        {
+            size += clip.GetMemorySize();
+        }
+        size += GetVectorSize(model.vertexAnimation.positions);
+        size += GetVectorSize(model.vertexAnimation.normals);
+        return size;
+    }
 }
 
 void ModelManager::StaticInitialize(const std::filesystem::path& rootPath)
@@ -28,39 +63,153 @@ ModelManager* ModelManager::Get()
     return sModelManger.get();
 }
 
+ModelManager::~ModelManager()
+{
+    mInventory.ForEach([](ModelId, Entry& entry) { Core::MemoryTracker::Untrack(entry.memoryId); });
+}
+
 void ModelManager::SetRootDirectory(const std::filesystem::path& rootPath)
 {
     mRootDirectory = rootPath;
 }
 
-ModelId ModelManager::GetModelId(const std::filesystem::path& filePath)
+ModelId ModelManager::GetModelId(const std::filesystem::path& filePath) const
 {
-    return std::filesystem::hash_value(mRootDirectory / filePath);
+    const ModelId* modelId = mLookup.Find(Core::HashPath(mRootDirectory / filePath));
+    return (modelId != nullptr) ? *modelId : Core::InvalidHandle;
 }
 
 ModelId ModelManager::LoadModel(const std::filesystem::path& filePath)
 {
     const ModelId modelId = GetModelId(filePath);
-    auto [iter, success] = mInventory.insert({ modelId, nullptr });
-    if (success)
+    if (modelId != Core::InvalidHandle)
     {
-        std::filesystem::path fullPath = mRootDirectory / filePath;
-        auto& modelPtr = iter->second;
-        modelPtr = std::make_unique<Model>();
-        ModelIO::LoadModel(fullPath, *modelPtr);
-        ModelIO::LoadMaterial(fullPath, *modelPtr);
+        return modelId;
     }
-    return modelId;
+    return AddModel(filePath, ReadModel(filePath));
+}
+
+std::unique_ptr<Model> ModelManager::ReadModel(const std::filesystem::path& filePath) const
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const std::filesystem::path fullPath = mRootDirectory / filePath;
+    auto modelPtr = std::make_unique<Model>();
+    ModelIO::LoadModel(fullPath, *modelPtr);
+    ModelIO::LoadMaterial(fullPath, *modelPtr);
+    ModelIO::LoadMeshlets(fullPath, *modelPtr);
+    ModelIO::LoadBVH(fullPath, *modelPtr);
+    ModelIO::LoadSkeleton(fullPath, *modelPtr);
+    ModelIO::LoadAnimations(fullPath, *modelPtr);
+    ModelIO::LoadMorphTargets(fullPath, *modelPtr);
+    ModelIO::LoadVertexAnimation(fullPath, *modelPtr);
+
+    // Models imported before meshlets existed get them built on load
+    for (Model::MeshData& meshData : modelPtr->meshData)
+    {
+        if (meshData.meshlets.empty())
+        {
+            meshData.meshlets = MeshletBuilder::Build(meshData.mesh);
+        }
+    }
+
+    const auto loadTime = std::chrono::steady_clock::now() - startTime;
+    sLoadTime.Add(std::chrono::duration_cast<std::chrono::microseconds>(loadTime).count());
+    return modelPtr;
+}
+
+ModelId ModelManager::AddModel(const std::filesystem::path& filePath, std::unique_ptr<Model> model)
+{
+    const Core::StringId pathId = Core::StringTable::InternPath(mRootDirectory / filePath);
+    auto [modelId, inserted] = mLookup.TryEmplace(pathId, Core::InvalidHandle);
+    if (inserted)
+    {
+        *modelId = mInventory.Add(Entry{std::move(model), pathId});
+        TrackModelMemory(*mInventory.Get(*modelId));
+        sModelsLoaded.Add();
+        sModelCount.Set(mInventory.GetCount());
+    }
+    return *modelId;
 }
 
 const Model* ModelManager::GetModel(ModelId id)
 {
-    auto model = mInventory.find(id);
-    if (model != mInventory.end())
+    const Entry* entry = mInventory.Get(id);
+    if (entry != nullptr)
     {
-        return model->second.get();
+        return entry->model.get();
     }
     return nullptr;
 }
 
+bool ModelManager::Raycast(ModelId id, const Math::Ray& ray, float maxDistance, RayHit& hit)
+{
+    hit = {};
+    hit.distance = maxDistance;
+    Model* model = GetModelWithBVH(id);
+    if (model == nullptr)
+    {
+        return false;
+    }
 
+    for (uint32_t i = 0; i < model->meshData.size(); ++i)
+    {
+        RayHit meshHit;
+        if (model->meshData[i].bvh.Raycast(ray, hit.distance, meshHit))
+        {
+            hit = meshHit;
+            hit.meshIndex = i;
+        }
+    }
+    return hit.distance < maxDistance;
+}
+
+bool ModelManager::Occluded(ModelId id, const Math::Ray& ray, float maxDistance)
+{
+    Model* model = GetModelWithBVH(id);
+    if (model == nullptr)
+    {
+        return false;
+    }
+
+    for (const Model::MeshData& meshData : model->meshData)
+    {
+        if (meshData.bvh.Occluded(ray, maxDistance))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Model* ModelManager::GetModelWithBVH(ModelId id)
+{
+    Entry* entry = mInventory.Get(id);
+    if (entry == nullptr || entry->model == nullptr)
+    {
+        return nullptr;
+    }
+
+    bool isBuilt = false;
+    for (Model::MeshData& meshData : entry->model->meshData)
+    {
+        if (!meshData.bvh.IsBuilt())
+        {
+            meshData.bvh.Build(meshData.mesh);
+            isBuilt = true;
+        }
+    }
+    if (isBuilt)
+    {
+        TrackModelMemory(*entry);
+    }
+    return entry->model.get();
+}
+
+// Lazily built BVHs change the size after the load, so the record is replaced
+void ModelManager::TrackModelMemory(Entry& entry)
+{
+    Core::MemoryTracker::Untrack(entry.memoryId);
+    entry.memoryId = Core::MemoryTracker::Track(Core::MemoryTag::Models,
+                                                GetMemorySize(*entry.model),
+                                                Core::StringTable::GetString(entry.pathId));
+}
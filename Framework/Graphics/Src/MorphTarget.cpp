@@ -0,0 +1,259 @@
+#include "Precompiled.h"
+#include "MorphTarget.h"
+
+#include "BinaryIO.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+// Vertex indices closer than this join one range, writing a few unmoved vertices is cheaper than
+// walking many tiny ranges
+constexpr uint32_t RangeMergeGap = 16;
+
+int16_t Quantize(float value, float scale)
+{
+    return (scale > 0.0f) ? static_cast<int16_t>(lroundf(value / scale)) : 0;
+}
+
+// Sorts and joins overlapping or nearly adjacent ranges in place
+void MergeRanges(std::vector<VertexRange>& ranges)
+{
+    if (ranges.size() < 2)
+    {
+        return;
+    }
+
+    std::sort(ranges.begin(),
+              ranges.end(),
+              [](const VertexRange& a, const VertexRange& b) { return a.begin < b.begin; });
+    size_t last = 0;
+    for (size_t i = 1; i < ranges.size(); ++i)
+    {
+        if (ranges[i].begin <= ranges[last].end + RangeMergeGap)
+        {
+            ranges[last].end = Math::Max(ranges[last].end, ranges[i].end);
+        }
+        else
+        {
+            ranges[++last] = ranges[i];
+        }
+    }
+    ranges.resize(last + 1);
+}
+} // namespace
+
+MorphTarget MorphTarget::Build(std::string name,
+                               const Mesh& mesh,
+                               const Math::Vector3* positions,
+                               const Math::Vector3* normals)
+{
+    MorphTarget target;
+    target.name = std::move(name);
+
+    const size_t vertexCount = mesh.vertices.size();
+    float maxPosition = 0.0f;
+    float maxNormal = 0.0f;
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        const Math::Vector3 position = positions[v] - mesh.vertices[v].position;
+        const Math::Vector3 normal = normals[v] - mesh.vertices[v].normal;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            maxPosition = Math::Max(maxPosition, Math::Abs(position.v[axis]));
+            maxNormal = Math::Max(maxNormal, Math::Abs(normal.v[axis]));
+        }
+    }
+    target.positionScale = maxPosition / 32767.0f;
+    target.normalScale = maxNormal / 32767.0f;
+
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        const Math::Vector3 position = positions[v] - mesh.vertices[v].position;
+        const Math::Vector3 normal = normals[v] - mesh.vertices[v].normal;
+        MorphDelta delta;
+        bool moved = false;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            delta.values[axis] = Quantize(position.v[axis], target.positionScale);
+            delta.values[axis + 3] = Quantize(normal.v[axis], target.normalScale);
+            moved = moved || delta.values[axis] != 0 || delta.values[axis + 3] != 0;
+        }
+        if (moved)
+        {
+            target.vertexIndices.push_back(static_cast<uint32_t>(v));
+            target.deltas.push_back(delta);
+        }
+    }
+    return target;
+}
+
+uint32_t MorphTarget::GetVertexCount() const
+{
+    return static_cast<uint32_t>(vertexIndices.size());
+}
+
+size_t MorphTarget::GetMemorySize() const
+{
+    return sizeof(MorphTarget) + name.size() + vertexIndices.size() * sizeof(uint32_t) +
+           deltas.size() * sizeof(MorphDelta);
+}
+
+void MorphTarget::Write(FILE* file) const
+{
+    BinaryIO::WriteString(file, name);
+    fwrite(&positionScale, sizeof(positionScale), 1, file);
+    fwrite(&normalScale, sizeof(normalScale), 1, file);
+    BinaryIO::WriteVector(file, vertexIndices);
+    BinaryIO::WriteVector(file, deltas);
+}
+
+bool MorphTarget::Read(FILE* file)
+{
+    bool success = BinaryIO::ReadString(file, name);
+    success = success && fread(&positionScale, sizeof(positionScale), 1, file) == 1;
+    success = success && fread(&normalScale, sizeof(normalScale), 1, file) == 1;
+    success = success && BinaryIO::ReadVector(file, vertexIndices);
+    success = success && BinaryIO::ReadVector(file, deltas);
+    return success && vertexIndices.size() == deltas.size();
+}
+
+void Morpher::Initialize(const Mesh& mesh, const std::vector<MorphTarget>& targets)
+{
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    mPositions.resize(vertexCount);
+    mNormals.resize(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        mPositions[v] = mesh.vertices[v].position;
+        mNormals[v] = mesh.vertices[v].normal;
+    }
+    mOffsets.assign(static_cast<size_t>(vertexCount) * 8, 0.0f);
+
+    mTargets.resize(targets.size());
+    for (size_t t = 0; t < targets.size(); ++t)
+    {
+        Target& target = mTargets[t];
+        target.data = targets[t];
+        for (uint32_t index : target.data.vertexIndices)
+        {
+            ASSERT(index < vertexCount,
+                   "Morpher: Target %s was built for a different mesh",
+                   target.data.name.c_str());
+            target.ranges.push_back({index, index + 1});
+        }
+        MergeRanges(target.ranges);
+    }
+
+    mActiveRanges.clear();
+    mChangedRanges.clear();
+}
+
+void Morpher::Terminate()
+{
+    mTargets.clear();
+    mPositions.clear();
+    mNormals.clear();
+    mOffsets.clear();
+    mActiveRanges.clear();
+    mChangedRanges.clear();
+    mScratch.clear();
+}
+
+void Morpher::Apply(const float* weights, Vertex* output)
+{
+    // Vertices moved now, plus the ones moved last time so they go back to the mesh
+    mScratch.clear();
+    for (size_t t = 0; t < mTargets.size(); ++t)
+    {
+        if (weights[t] != 0.0f)
+        {
+            const std::vector<VertexRange>& ranges = mTargets[t].ranges;
+            mScratch.insert(mScratch.end(), ranges.begin(), ranges.end());
+        }
+    }
+    MergeRanges(mScratch);
+    mChangedRanges = mScratch;
+    mChangedRanges.insert(mChangedRanges.end(), mActiveRanges.begin(), mActiveRanges.end());
+    MergeRanges(mChangedRanges);
+    std::swap(mActiveRanges, mScratch);
+
+    for (const VertexRange& range : mChangedRanges)
+    {
+        std::fill(mOffsets.begin() + range.begin * 8, mOffsets.begin() + range.end * 8, 0.0f);
+    }
+    for (size_t t = 0; t < mTargets.size(); ++t)
+    {
+        if (weights[t] != 0.0f)
+        {
+            AccumulateTarget(mTargets[t], weights[t]);
+        }
+    }
+
+    for (const VertexRange& range : mChangedRanges)
+    {
+        for (uint32_t v = range.begin; v < range.end; ++v)
+        {
+            const float* offset = &mOffsets[static_cast<size_t>(v) * 8];
+            const Math::Vector3 normal =
+                mNormals[v] + Math::Vector3(offset[3], offset[4], offset[5]);
+            const float lengthSqr = Math::MagnitudeSqr(normal);
+            output[v].position = mPositions[v] + Math::Vector3(offset[0], offset[1], offset[2]);
+            output[v].normal = (lengthSqr > 1e-12f) ? normal / sqrtf(lengthSqr) : mNormals[v];
+        }
+    }
+}
+
+void Morpher::AccumulateTarget(const Target& target, float weight)
+{
+    const MorphTarget& data = target.data;
+    const uint32_t count = data.GetVertexCount();
+    const float positionScale = data.positionScale * weight;
+    const float normalScale = data.normalScale * weight;
+
+#ifdef MATH_USE_SSE
+    // Lanes hold position xyz and normal x, then normal yz and the padding
+    const __m128 scaleLow = _mm_setr_ps(positionScale, positionScale, positionScale, normalScale);
+    const __m128 scaleHigh = _mm_setr_ps(normalScale, normalScale, 0.0f, 0.0f);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // Sign extends the 16 bit values by unpacking them into the high halves
+        const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(&data.deltas[i]));
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+
+        float* offset = &mOffsets[static_cast<size_t>(data.vertexIndices[i]) * 8];
+        const __m128 offsetLow = _mm_mul_ps(_mm_cvtepi32_ps(low), scaleLow);
+        const __m128 offsetHigh = _mm_mul_ps(_mm_cvtepi32_ps(high), scaleHigh);
+        _mm_storeu_ps(offset, _mm_add_ps(_mm_loadu_ps(offset), offsetLow));
+        _mm_storeu_ps(offset + 4, _mm_add_ps(_mm_loadu_ps(offset + 4), offsetHigh));
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const int16_t* values = data.deltas[i].values;
+        float* offset = &mOffsets[static_cast<size_t>(data.vertexIndices[i]) * 8];
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            offset[c] += values[c] * positionScale;
+            offset[c + 3] += values[c + 3] * normalScale;
+        }
+    }
+#endif
+}
+
+const std::vector<VertexRange>& Morpher::GetChangedRanges() const
+{
+    return mChangedRanges;
+}
+
+uint32_t Morpher::GetTargetCount() const
+{
+    return static_cast<uint32_t>(mTargets.size());
+}
+
+uint32_t Morpher::GetVertexCount() const
+{
+    return static_cast<uint32_t>(mPositions.size());
+}
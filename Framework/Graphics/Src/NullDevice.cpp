@@ -0,0 +1,1770 @@
+#include "Precompiled.h"
+#include "NullDevice.h"
+
+#include "GraphicsSystem.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+constexpr size_t CallCount = static_cast<size_t>(GraphicsApiCall::Count);
+
+const char* const sCallNames[] = {"Draw",
+                                  "SetShader",
+                                  "SetState",
+                                  "SetResource",
+                                  "Map",
+                                  "Update",
+                                  "Clear",
+                                  "Create",
+                                  "Query",
+                                  "Present",
+                                  "Other"};
+static_assert(std::size(sCallNames) == CallCount);
+
+// Resources can be created from loading threads while the render thread draws
+std::atomic<uint64_t> sCalls[CallCount];
+std::atomic<uint64_t> sFrameCalls[CallCount];
+std::atomic<uint64_t> sUploadedBytes{0};
+std::atomic<uint64_t> sFrameUploadedBytes{0};
+std::atomic<uint32_t> sLiveObjects{0};
+std::atomic<size_t> sBufferBytes{0};
+std::atomic<size_t> sTextureBytes{0};
+
+const Core::PerfCounter sApiCalls("Graphics.ApiCalls");
+
+void RecordCall(GraphicsApiCall call)
+{
+    sCalls[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// IUnknown and ID3D11DeviceChild for everything the device hands out
+template <class Interface> class RecordingDeviceChild : public Interface
+{
+  public:
+    explicit RecordingDeviceChild(ID3D11Device* device)
+        : mDevice(device)
+    {
+    }
+
+    virtual ~RecordingDeviceChild() = default;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (object == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        bool isSupported = (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11DeviceChild) ||
+                            riid == __uuidof(Interface));
+        if constexpr (std::is_base_of_v<ID3D11Resource, Interface>)
+        {
+            isSupported |= (riid == __uuidof(ID3D11Resource));
+        }
+        if constexpr (std::is_base_of_v<ID3D11View, Interface>)
+        {
+            isSupported |= (riid == __uuidof(ID3D11View));
+        }
+        if (!isSupported)
+        {
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+        AddRef();
+        *object = static_cast<Interface*>(this);
+        return S_OK;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return mRefCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = mRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    void STDMETHODCALLTYPE GetDevice(ID3D11Device** device) override
+    {
+        mDevice->AddRef();
+        *device = mDevice;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) override
+    {
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) override
+    {
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) override
+    {
+        return S_OK;
+    }
+
+  private:
+    ID3D11Device* mDevice = nullptr;
+    std::atomic<ULONG> mRefCount{1};
+};
+
+// Shaders and input layouts have nothing beyond the device child, the other objects build on it
+template <class Interface> class RecordingObject : public RecordingDeviceChild<Interface>
+{
+  public:
+    explicit RecordingObject(ID3D11Device* device)
+        : RecordingDeviceChild<Interface>(device)
+    {
+        sLiveObjects.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~RecordingObject() override
+    {
+        sLiveObjects.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+// What Map and UpdateSubresource need to know about a buffer or texture
+struct ResourceData
+{
+    D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    size_t bytes = 0;
+    UINT rowPitch = 0;
+    UINT depthPitch = 0;
+    std::vector<uint8_t> mapped; // Allocated by the first Map
+};
+
+template <class Interface, class Desc, D3D11_RESOURCE_DIMENSION Dimension>
+class RecordingResource final : public RecordingObject<Interface>
+{
+  public:
+    RecordingResource(ID3D11Device* device,
+                      const Desc& desc,
+                      size_t bytes,
+                      size_t rowPitch,
+                      UINT rowCount)
+        : RecordingObject<Interface>(device),
+          mDesc(desc)
+    {
+        mData.dimension = Dimension;
+        mData.bytes = bytes;
+        mData.rowPitch = static_cast<UINT>(rowPitch);
+        mData.depthPitch = static_cast<UINT>(rowPitch * rowCount);
+        GetLiveBytes().fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    ~RecordingResource() override
+    {
+        GetLiveBytes().fetch_sub(mData.bytes, std::memory_order_relaxed);
+    }
+
+    void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override
+    {
+        *dimension = Dimension;
+    }
+
+    void STDMETHODCALLTYPE SetEvictionPriority(UINT evictionPriority) override
+    {
+    }
+
+    UINT STDMETHODCALLTYPE GetEvictionPriority() override
+    {
+        return 0;
+    }
+
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override
+    {
+        *desc = mDesc;
+    }
+
+    ResourceData& GetData()
+    {
+        return mData;
+    }
+
+  private:
+    static std::atomic<size_t>& GetLiveBytes()
+    {
+        return (Dimension == D3D11_RESOURCE_DIMENSION_BUFFER) ? sBufferBytes : sTextureBytes;
+    }
+
+    Desc mDesc;
+    ResourceData mData;
+};
+
+using Buffer = RecordingResource<ID3D11Buffer, D3D11_BUFFER_DESC, D3D11_RESOURCE_DIMENSION_BUFFER>;
+using Texture2D = RecordingResource<ID3D11Texture2D,
+                                    D3D11_TEXTURE2D_DESC,
+                                    D3D11_RESOURCE_DIMENSION_TEXTURE2D>;
+
+ResourceData* GetResourceData(ID3D11Resource* resource)
+{
+    if (resource == nullptr)
+    {
+        return nullptr;
+    }
+
+    D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    resource->GetType(&dimension);
+    switch (dimension)
+    {
+    case D3D11_RESOURCE_DIMENSION_BUFFER:
+        return &static_cast<Buffer*>(static_cast<ID3D11Buffer*>(resource))->GetData();
+    case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+        return &static_cast<Texture2D*>(static_cast<ID3D11Texture2D*>(resource))->GetData();
+    default:
+        return nullptr; // The device creates no other kind
+    }
+}
+
+// A view keeps its resource alive, like a real one
+template <class Interface, class Desc> class RecordingView final : public RecordingObject<Interface>
+{
+  public:
+    RecordingView(ID3D11Device* device, ID3D11Resource* resource, const Desc* desc)
+        : RecordingObject<Interface>(device),
+          mResource(resource)
+    {
+        mResource->AddRef();
+        if (desc != nullptr)
+        {
+            mDesc = *desc;
+        }
+    }
+
+    ~RecordingView() override
+    {
+        SafeRelease(mResource);
+    }
+
+    void STDMETHODCALLTYPE GetResource(ID3D11Resource** resource) override
+    {
+        mResource->AddRef();
+        *resource = mResource;
+    }
+
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override
+    {
+        *desc = mDesc;
+    }
+
+  private:
+    ID3D11Resource* mResource = nullptr;
+    Desc mDesc{};
+};
+
+using ShaderResourceView =
+    RecordingView<ID3D11ShaderResourceView, D3D11_SHADER_RESOURCE_VIEW_DESC>;
+using UnorderedAccessView =
+    RecordingView<ID3D11UnorderedAccessView, D3D11_UNORDERED_ACCESS_VIEW_DESC>;
+using RenderTargetView = RecordingView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>;
+using DepthStencilView = RecordingView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>;
+
+template <class Interface, class Desc>
+class RecordingState final : public RecordingObject<Interface>
+{
+  public:
+    RecordingState(ID3D11Device* device, const Desc& desc)
+        : RecordingObject<Interface>(device),
+          mDesc(desc)
+    {
+    }
+
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override
+    {
+        *desc = mDesc;
+    }
+
+  private:
+    Desc mDesc;
+};
+
+using BlendState = RecordingState<ID3D11BlendState, D3D11_BLEND_DESC>;
+using DepthStencilState = RecordingState<ID3D11DepthStencilState, D3D11_DEPTH_STENCIL_DESC>;
+using RasterizerState = RecordingState<ID3D11RasterizerState, D3D11_RASTERIZER_DESC>;
+using SamplerState = RecordingState<ID3D11SamplerState, D3D11_SAMPLER_DESC>;
+
+// Counts every call and keeps only the state that code reads back: render targets and viewports
+class RecordingContext final : public RecordingDeviceChild<ID3D11DeviceContext>
+{
+  public:
+    explicit RecordingContext(ID3D11Device* device)
+        : RecordingDeviceChild<ID3D11DeviceContext>(device)
+    {
+    }
+
+    ~RecordingContext() override
+    {
+        SetRenderTargets(0, nullptr, nullptr);
+    }
+
+    void STDMETHODCALLTYPE VSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE
+    PSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* pixelShader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE PSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* vertexShader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE DrawIndexed(UINT indexCount,
+                                       UINT startIndexLocation,
+                                       INT baseVertexLocation) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE Draw(UINT vertexCount, UINT startVertexLocation) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* resource,
+                                  UINT subresource,
+                                  D3D11_MAP mapType,
+                                  UINT mapFlags,
+                                  D3D11_MAPPED_SUBRESOURCE* mappedResource) override
+    {
+        RecordCall(GraphicsApiCall::Map);
+        ResourceData* data = GetResourceData(resource);
+        if (data == nullptr || mappedResource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        if (data->mapped.empty())
+        {
+            data->mapped.resize(data->bytes);
+        }
+        mappedResource->pData = data->mapped.data();
+        mappedResource->RowPitch = data->rowPitch;
+        mappedResource->DepthPitch = data->depthPitch;
+        if (mapType != D3D11_MAP_READ)
+        {
+            sUploadedBytes.fetch_add(data->bytes, std::memory_order_relaxed);
+        }
+        return S_OK;
+    }
+
+    void STDMETHODCALLTYPE Unmap(ID3D11Resource* resource, UINT subresource) override
+    {
+        RecordCall(GraphicsApiCall::Map);
+    }
+
+    void STDMETHODCALLTYPE PSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* inputLayout) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE IASetVertexBuffers(UINT startSlot,
+                                              UINT numBuffers,
+                                              ID3D11Buffer* const* vertexBuffers,
+                                              const UINT* strides,
+                                              const UINT* offsets) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* indexBuffer,
+                                            DXGI_FORMAT format,
+                                            UINT offset) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE DrawIndexedInstanced(UINT indexCountPerInstance,
+                                                UINT instanceCount,
+                                                UINT startIndexLocation,
+                                                INT baseVertexLocation,
+                                                UINT startInstanceLocation) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE DrawInstanced(UINT vertexCountPerInstance,
+                                         UINT instanceCount,
+                                         UINT startVertexLocation,
+                                         UINT startInstanceLocation) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE GSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader* shader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE
+    VSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE VSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* async) override
+    {
+        RecordCall(GraphicsApiCall::Other);
+    }
+
+    void STDMETHODCALLTYPE End(ID3D11Asynchronous* async) override
+    {
+        RecordCall(GraphicsApiCall::Other);
+    }
+
+    HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* async,
+                                      void* data,
+                                      UINT dataSize,
+                                      UINT getDataFlags) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        return E_INVALIDARG; // The device creates no queries
+    }
+
+    void STDMETHODCALLTYPE SetPredication(ID3D11Predicate* predicate,
+                                          WINBOOL predicateValue) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE
+    GSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE GSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE
+    OMSetRenderTargets(UINT numViews,
+                       ID3D11RenderTargetView* const* renderTargetViews,
+                       ID3D11DepthStencilView* depthStencilView) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+        SetRenderTargets(numViews, renderTargetViews, depthStencilView);
+    }
+
+    void STDMETHODCALLTYPE
+    OMSetRenderTargetsAndUnorderedAccessViews(
+        UINT numRTVs,
+        ID3D11RenderTargetView* const* renderTargetViews,
+        ID3D11DepthStencilView* depthStencilView,
+        UINT uavStartSlot,
+        UINT numUAVs,
+        ID3D11UnorderedAccessView* const* unorderedAccessViews,
+        const UINT* uavInitialCounts) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+        if (numRTVs != D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL)
+        {
+            SetRenderTargets(numRTVs, renderTargetViews, depthStencilView);
+        }
+    }
+
+    void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* blendState,
+                                           const FLOAT blendFactor[4],
+                                           UINT sampleMask) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE
+    OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE SOSetTargets(UINT numBuffers,
+                                        ID3D11Buffer* const* soTargets,
+                                        const UINT* offsets) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE DrawAuto() override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer* bufferForArgs,
+                                                        UINT alignedByteOffsetForArgs) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer* bufferForArgs,
+                                                 UINT alignedByteOffsetForArgs) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE Dispatch(UINT threadGroupCountX,
+                                    UINT threadGroupCountY,
+                                    UINT threadGroupCountZ) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer* bufferForArgs,
+                                            UINT alignedByteOffsetForArgs) override
+    {
+        RecordCall(GraphicsApiCall::Draw);
+    }
+
+    void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* rasterizerState) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE RSSetViewports(UINT numViewports,
+                                          const D3D11_VIEWPORT* viewports) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+        mViewportCount = std::min<UINT>(numViewports, std::size(mViewports));
+        std::copy_n(viewports, mViewportCount, mViewports);
+    }
+
+    void STDMETHODCALLTYPE RSSetScissorRects(UINT numRects, const D3D11_RECT* rects) override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+    }
+
+    void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* dstResource,
+                                                 UINT dstSubresource,
+                                                 UINT dstX,
+                                                 UINT dstY,
+                                                 UINT dstZ,
+                                                 ID3D11Resource* srcResource,
+                                                 UINT srcSubresource,
+                                                 const D3D11_BOX* srcBox) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    void STDMETHODCALLTYPE CopyResource(ID3D11Resource* dstResource,
+                                        ID3D11Resource* srcResource) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* dstResource,
+                                             UINT dstSubresource,
+                                             const D3D11_BOX* dstBox,
+                                             const void* srcData,
+                                             UINT srcRowPitch,
+                                             UINT srcDepthPitch) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+        const ResourceData* data = GetResourceData(dstResource);
+        if (data == nullptr)
+        {
+            return;
+        }
+        size_t bytes = data->depthPitch; // The whole first subresource
+        if (dstBox != nullptr)
+        {
+            bytes = (data->dimension == D3D11_RESOURCE_DIMENSION_BUFFER)
+                        ? dstBox->right - dstBox->left
+                        : static_cast<size_t>(srcRowPitch) * (dstBox->bottom - dstBox->top);
+        }
+        sUploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer* dstBuffer,
+                                              UINT dstAlignedByteOffset,
+                                              ID3D11UnorderedAccessView* srcView) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView,
+                                                 const FLOAT colorRGBA[4]) override
+    {
+        RecordCall(GraphicsApiCall::Clear);
+    }
+
+    void STDMETHODCALLTYPE
+    ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView* unorderedAccessView,
+                                 const UINT values[4]) override
+    {
+        RecordCall(GraphicsApiCall::Clear);
+    }
+
+    void STDMETHODCALLTYPE
+    ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView* unorderedAccessView,
+                                  const FLOAT values[4]) override
+    {
+        RecordCall(GraphicsApiCall::Clear);
+    }
+
+    void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView,
+                                                 UINT clearFlags,
+                                                 FLOAT depth,
+                                                 UINT8 stencil) override
+    {
+        RecordCall(GraphicsApiCall::Clear);
+    }
+
+    void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView* shaderResourceView) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource* resource, FLOAT minLOD) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource* resource) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        return 0.0f;
+    }
+
+    void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* dstResource,
+                                              UINT dstSubresource,
+                                              ID3D11Resource* srcResource,
+                                              UINT srcSubresource,
+                                              DXGI_FORMAT format) override
+    {
+        RecordCall(GraphicsApiCall::Update);
+    }
+
+    void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList* commandList,
+                                              WINBOOL restoreContextState) override
+    {
+        RecordCall(GraphicsApiCall::Other);
+    }
+
+    void STDMETHODCALLTYPE
+    HSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader* hullShader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE HSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE HSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE
+    DSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader* domainShader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE DSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE DSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE
+    CSSetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView* const* shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE
+    CSSetUnorderedAccessViews(UINT startSlot,
+                              UINT numUAVs,
+                              ID3D11UnorderedAccessView* const* unorderedAccessViews,
+                              const UINT* uavInitialCounts) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader* computeShader,
+                                       ID3D11ClassInstance* const* classInstances,
+                                       UINT numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::SetShader);
+    }
+
+    void STDMETHODCALLTYPE CSSetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState* const* samplers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE CSSetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer* const* constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::SetResource);
+    }
+
+    void STDMETHODCALLTYPE VSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE
+    PSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** pixelShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *pixelShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE PSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** vertexShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *vertexShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE PSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** inputLayout) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *inputLayout = nullptr;
+    }
+
+    void STDMETHODCALLTYPE IAGetVertexBuffers(UINT startSlot,
+                                              UINT numBuffers,
+                                              ID3D11Buffer** vertexBuffers,
+                                              UINT* strides,
+                                              UINT* offsets) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        for (UINT i = 0; i < numBuffers; ++i)
+        {
+            if (vertexBuffers != nullptr)
+            {
+                vertexBuffers[i] = nullptr;
+            }
+            if (strides != nullptr)
+            {
+                strides[i] = 0;
+            }
+            if (offsets != nullptr)
+            {
+                offsets[i] = 0;
+            }
+        }
+    }
+
+    void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** indexBuffer,
+                                            DXGI_FORMAT* format,
+                                            UINT* offset) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        if (indexBuffer != nullptr)
+        {
+            *indexBuffer = nullptr;
+        }
+        if (format != nullptr)
+        {
+            *format = DXGI_FORMAT_UNKNOWN;
+        }
+        if (offset != nullptr)
+        {
+            *offset = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE GSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** geometryShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *geometryShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* topology) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    }
+
+    void STDMETHODCALLTYPE
+    VSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE VSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** predicate,
+                                          WINBOOL* predicateValue) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        if (predicate != nullptr)
+        {
+            *predicate = nullptr;
+        }
+        if (predicateValue != nullptr)
+        {
+            *predicateValue = FALSE;
+        }
+    }
+
+    void STDMETHODCALLTYPE
+    GSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE GSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE OMGetRenderTargets(UINT numViews,
+                                              ID3D11RenderTargetView** renderTargetViews,
+                                              ID3D11DepthStencilView** depthStencilView) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        GetRenderTargets(numViews, renderTargetViews, depthStencilView);
+    }
+
+    void STDMETHODCALLTYPE
+    OMGetRenderTargetsAndUnorderedAccessViews(
+        UINT numRTVs,
+        ID3D11RenderTargetView** renderTargetViews,
+        ID3D11DepthStencilView** depthStencilView,
+        UINT uavStartSlot,
+        UINT numUAVs,
+        ID3D11UnorderedAccessView** unorderedAccessViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        GetRenderTargets(numRTVs, renderTargetViews, depthStencilView);
+        if (unorderedAccessViews != nullptr)
+        {
+            std::fill_n(unorderedAccessViews, numUAVs, nullptr);
+        }
+    }
+
+    void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** blendState,
+                                           FLOAT blendFactor[4],
+                                           UINT* sampleMask) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        if (blendState != nullptr)
+        {
+            *blendState = nullptr;
+        }
+        if (blendFactor != nullptr)
+        {
+            std::fill_n(blendFactor, 4, 1.0f);
+        }
+        if (sampleMask != nullptr)
+        {
+            *sampleMask = 0xffffffff;
+        }
+    }
+
+    void STDMETHODCALLTYPE
+    OMGetDepthStencilState(ID3D11DepthStencilState** depthStencilState, UINT* stencilRef) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        if (depthStencilState != nullptr)
+        {
+            *depthStencilState = nullptr;
+        }
+        if (stencilRef != nullptr)
+        {
+            *stencilRef = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE SOGetTargets(UINT numBuffers, ID3D11Buffer** soTargets) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(soTargets, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** rasterizerState) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *rasterizerState = nullptr;
+    }
+
+    void STDMETHODCALLTYPE RSGetViewports(UINT* numViewports, D3D11_VIEWPORT* viewports) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        if (viewports != nullptr)
+        {
+            *numViewports = std::min(*numViewports, mViewportCount);
+            std::copy_n(mViewports, *numViewports, viewports);
+        }
+        else
+        {
+            *numViewports = mViewportCount;
+        }
+    }
+
+    void STDMETHODCALLTYPE RSGetScissorRects(UINT* numRects, D3D11_RECT* rects) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *numRects = 0;
+    }
+
+    void STDMETHODCALLTYPE
+    HSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** hullShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *hullShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE HSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE HSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE
+    DSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** domainShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *domainShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE DSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE DSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE
+    CSGetShaderResources(UINT startSlot,
+                         UINT numViews,
+                         ID3D11ShaderResourceView** shaderResourceViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(shaderResourceViews, numViews, nullptr);
+    }
+
+    void STDMETHODCALLTYPE
+    CSGetUnorderedAccessViews(UINT startSlot,
+                              UINT numUAVs,
+                              ID3D11UnorderedAccessView** unorderedAccessViews) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(unorderedAccessViews, numUAVs, nullptr);
+    }
+
+    void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** computeShader,
+                                       ID3D11ClassInstance** classInstances,
+                                       UINT* numClassInstances) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *computeShader = nullptr;
+        if (numClassInstances != nullptr)
+        {
+            *numClassInstances = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE CSGetSamplers(UINT startSlot,
+                                         UINT numSamplers,
+                                         ID3D11SamplerState** samplers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(samplers, numSamplers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE CSGetConstantBuffers(UINT startSlot,
+                                                UINT numBuffers,
+                                                ID3D11Buffer** constantBuffers) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        std::fill_n(constantBuffers, numBuffers, nullptr);
+    }
+
+    void STDMETHODCALLTYPE ClearState() override
+    {
+        RecordCall(GraphicsApiCall::SetState);
+        SetRenderTargets(0, nullptr, nullptr);
+        mViewportCount = 0;
+    }
+
+    void STDMETHODCALLTYPE Flush() override
+    {
+        RecordCall(GraphicsApiCall::Other);
+    }
+
+    D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() override
+    {
+        return D3D11_DEVICE_CONTEXT_IMMEDIATE;
+    }
+
+    UINT STDMETHODCALLTYPE GetContextFlags() override
+    {
+        return 0;
+    }
+
+    HRESULT STDMETHODCALLTYPE FinishCommandList(WINBOOL restoreDeferredContextState,
+                                                ID3D11CommandList** commandList) override
+    {
+        RecordCall(GraphicsApiCall::Other);
+        return DXGI_ERROR_INVALID_CALL; // Only deferred contexts record command lists
+    }
+
+  private:
+    void SetRenderTargets(UINT numViews,
+                          ID3D11RenderTargetView* const* renderTargetViews,
+                          ID3D11DepthStencilView* depthStencilView)
+    {
+        for (UINT i = 0; i < std::size(mRenderTargetViews); ++i)
+        {
+            ID3D11RenderTargetView* view =
+                (i < numViews && renderTargetViews != nullptr) ? renderTargetViews[i] : nullptr;
+            if (view != nullptr)
+            {
+                view->AddRef();
+            }
+            SafeRelease(mRenderTargetViews[i]);
+            mRenderTargetViews[i] = view;
+        }
+        if (depthStencilView != nullptr)
+        {
+            depthStencilView->AddRef();
+        }
+        SafeRelease(mDepthStencilView);
+        mDepthStencilView = depthStencilView;
+    }
+
+    // Like the real getters, every view returned comes with a reference for the caller
+    void GetRenderTargets(UINT numViews,
+                          ID3D11RenderTargetView** renderTargetViews,
+                          ID3D11DepthStencilView** depthStencilView)
+    {
+        for (UINT i = 0; renderTargetViews != nullptr && i < numViews; ++i)
+        {
+            renderTargetViews[i] = (i < std::size(mRenderTargetViews)) ? mRenderTargetViews[i]
+                                                                       : nullptr;
+            if (renderTargetViews[i] != nullptr)
+            {
+                renderTargetViews[i]->AddRef();
+            }
+        }
+        if (depthStencilView != nullptr)
+        {
+            *depthStencilView = mDepthStencilView;
+            if (mDepthStencilView != nullptr)
+            {
+                mDepthStencilView->AddRef();
+            }
+        }
+    }
+
+    ID3D11RenderTargetView* mRenderTargetViews[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+    ID3D11DepthStencilView* mDepthStencilView = nullptr;
+    D3D11_VIEWPORT mViewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE] = {};
+    UINT mViewportCount = 0;
+};
+
+class RecordingDevice final : public ID3D11Device
+{
+  public:
+    RecordingDevice()
+        : mContext(new RecordingContext(this))
+    {
+    }
+
+    ~RecordingDevice()
+    {
+        SafeRelease(mContext);
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (object == nullptr)
+        {
+            return E_POINTER;
+        }
+        if (riid != __uuidof(IUnknown) && riid != __uuidof(ID3D11Device))
+        {
+            *object = nullptr;
+            return E_NOINTERFACE;
+        }
+        AddRef();
+        *object = static_cast<ID3D11Device*>(this);
+        return S_OK;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return mRefCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = mRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (refCount == 0)
+        {
+            delete this;
+        }
+        return refCount;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* desc,
+                                           const D3D11_SUBRESOURCE_DATA* initialData,
+                                           ID3D11Buffer** buffer) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (desc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        if (initialData != nullptr)
+        {
+            sUploadedBytes.fetch_add(desc->ByteWidth, std::memory_order_relaxed);
+        }
+        return CreateObject<Buffer>(buffer, *desc, desc->ByteWidth, desc->ByteWidth, 1);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC* desc,
+                                              const D3D11_SUBRESOURCE_DATA* initialData,
+                                              ID3D11Texture1D** texture1D) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc,
+                                              const D3D11_SUBRESOURCE_DATA* initialData,
+                                              ID3D11Texture2D** texture2D) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (desc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+
+        // A single row of the top mip gives the pitch Map hands out
+        D3D11_TEXTURE2D_DESC rowDesc = *desc;
+        rowDesc.Height = 1;
+        rowDesc.MipLevels = 1;
+        rowDesc.ArraySize = 1;
+        rowDesc.SampleDesc.Count = 1;
+        const size_t bytes = GraphicsSystem::GetTextureMemorySize(*desc);
+        const size_t rowPitch = GraphicsSystem::GetTextureMemorySize(rowDesc);
+        if (initialData != nullptr)
+        {
+            sUploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        return CreateObject<Texture2D>(texture2D, *desc, bytes, rowPitch, desc->Height);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC* desc,
+                                              const D3D11_SUBRESOURCE_DATA* initialData,
+                                              ID3D11Texture3D** texture3D) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateShaderResourceView(ID3D11Resource* resource,
+                             const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                             ID3D11ShaderResourceView** srView) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (resource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<ShaderResourceView>(srView, resource, desc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateUnorderedAccessView(ID3D11Resource* resource,
+                              const D3D11_UNORDERED_ACCESS_VIEW_DESC* desc,
+                              ID3D11UnorderedAccessView** uaView) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (resource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<UnorderedAccessView>(uaView, resource, desc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateRenderTargetView(ID3D11Resource* resource,
+                           const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                           ID3D11RenderTargetView** rtView) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (resource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<RenderTargetView>(rtView, resource, desc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateDepthStencilView(ID3D11Resource* resource,
+                           const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                           ID3D11DepthStencilView** depthStencilView) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (resource == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<DepthStencilView>(depthStencilView, resource, desc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* inputElementDescs,
+                      UINT numElements,
+                      const void* shaderBytecodeWithInputSignature,
+                      SIZE_T bytecodeLength,
+                      ID3D11InputLayout** inputLayout) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11InputLayout>>(inputLayout);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateVertexShader(const void* shaderBytecode,
+                                                 SIZE_T bytecodeLength,
+                                                 ID3D11ClassLinkage* classLinkage,
+                                                 ID3D11VertexShader** vertexShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11VertexShader>>(vertexShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void* shaderBytecode,
+                                                   SIZE_T bytecodeLength,
+                                                   ID3D11ClassLinkage* classLinkage,
+                                                   ID3D11GeometryShader** geometryShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11GeometryShader>>(geometryShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateGeometryShaderWithStreamOutput(const void* shaderBytecode,
+                                         SIZE_T bytecodeLength,
+                                         const D3D11_SO_DECLARATION_ENTRY* soDeclaration,
+                                         UINT numEntries,
+                                         const UINT* bufferStrides,
+                                         UINT numStrides,
+                                         UINT rasterizedStream,
+                                         ID3D11ClassLinkage* classLinkage,
+                                         ID3D11GeometryShader** geometryShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11GeometryShader>>(geometryShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreatePixelShader(const void* shaderBytecode,
+                                                SIZE_T bytecodeLength,
+                                                ID3D11ClassLinkage* classLinkage,
+                                                ID3D11PixelShader** pixelShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11PixelShader>>(pixelShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateHullShader(const void* shaderBytecode,
+                                               SIZE_T bytecodeLength,
+                                               ID3D11ClassLinkage* classLinkage,
+                                               ID3D11HullShader** hullShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11HullShader>>(hullShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateDomainShader(const void* shaderBytecode,
+                                                 SIZE_T bytecodeLength,
+                                                 ID3D11ClassLinkage* classLinkage,
+                                                 ID3D11DomainShader** domainShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11DomainShader>>(domainShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateComputeShader(const void* shaderBytecode,
+                                                  SIZE_T bytecodeLength,
+                                                  ID3D11ClassLinkage* classLinkage,
+                                                  ID3D11ComputeShader** computeShader) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return CreateObject<RecordingObject<ID3D11ComputeShader>>(computeShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** linkage) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* blendStateDesc,
+                                               ID3D11BlendState** blendState) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (blendStateDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<BlendState>(blendState, *blendStateDesc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* depthStencilDesc,
+                            ID3D11DepthStencilState** depthStencilState) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (depthStencilDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<DepthStencilState>(depthStencilState, *depthStencilDesc);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CreateRasterizerState(const D3D11_RASTERIZER_DESC* rasterizerDesc,
+                          ID3D11RasterizerState** rasterizerState) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (rasterizerDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<RasterizerState>(rasterizerState, *rasterizerDesc);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* samplerDesc,
+                                                 ID3D11SamplerState** samplerState) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        if (samplerDesc == nullptr)
+        {
+            return E_INVALIDARG;
+        }
+        return CreateObject<SamplerState>(samplerState, *samplerDesc);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* queryDesc,
+                                          ID3D11Query** query) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC* predicateDesc,
+                                              ID3D11Predicate** predicate) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC* counterDesc,
+                                            ID3D11Counter** counter) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT contextFlags,
+                                                    ID3D11DeviceContext** deferredContext) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE hResource,
+                                                 REFIID returnedInterface,
+                                                 void** resource) override
+    {
+        RecordCall(GraphicsApiCall::Create);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT format, UINT* formatSupport) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *formatSupport = ~0u; // Every format supports everything
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT format,
+                                                            UINT sampleCount,
+                                                            UINT* numQualityLevels) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *numQualityLevels = 1;
+        return S_OK;
+    }
+
+    void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* counterInfo) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        *counterInfo = {};
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC* desc,
+                                           D3D11_COUNTER_TYPE* type,
+                                           UINT* activeCounters,
+                                           LPSTR szName,
+                                           UINT* nameLength,
+                                           LPSTR szUnits,
+                                           UINT* unitsLength,
+                                           LPSTR szDescription,
+                                           UINT* descriptionLength) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE feature,
+                                                  void* featureSupportData,
+                                                  UINT featureSupportDataSize) override
+    {
+        RecordCall(GraphicsApiCall::Query);
+        // Every optional feature is unsupported
+        memset(featureSupportData, 0, featureSupportDataSize);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) override
+    {
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) override
+    {
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) override
+    {
+        return S_OK;
+    }
+
+    D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() override
+    {
+        return D3D_FEATURE_LEVEL_11_1;
+    }
+
+    UINT STDMETHODCALLTYPE GetCreationFlags() override
+    {
+        return 0;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override
+    {
+        return S_OK;
+    }
+
+    void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** immediateContext) override
+    {
+        mContext->AddRef();
+        *immediateContext = mContext;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT raiseFlags) override
+    {
+        return S_OK;
+    }
+
+    UINT STDMETHODCALLTYPE GetExceptionMode() override
+    {
+        return 0;
+    }
+
+  private:
+    template <class Object, class Interface, class... Args>
+    HRESULT CreateObject(Interface** object, Args&&... args)
+    {
+        if (object == nullptr)
+        {
+            return S_FALSE; // Only validates the arguments, like the real device
+        }
+        *object = new Object(this, std::forward<Args>(args)...);
+        return S_OK;
+    }
+
+    RecordingContext* mContext = nullptr;
+    std::atomic<ULONG> mRefCount{1};
+};
+} // namespace
+
+void NullDevice::Create(ID3D11Device** device, ID3D11DeviceContext** context)
+{
+    RecordingDevice* recordingDevice = new RecordingDevice();
+    recordingDevice->GetImmediateContext(context);
+    *device = recordingDevice;
+}
+
+void NullDevice::EndFrame()
+{
+    RecordCall(GraphicsApiCall::Present);
+
+    uint64_t callCount = 0;
+    for (size_t i = 0; i < CallCount; ++i)
+    {
+        const uint64_t count = sCalls[i].exchange(0, std::memory_order_relaxed);
+        sFrameCalls[i].store(count, std::memory_order_relaxed);
+        callCount += count;
+    }
+    sFrameUploadedBytes.store(sUploadedBytes.exchange(0, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+    sApiCalls.Add(static_cast<int64_t>(callCount));
+}
+
+uint64_t NullDevice::GetFrameCallCount(GraphicsApiCall call)
+{
+    return sFrameCalls[static_cast<size_t>(call)].load(std::memory_order_relaxed);
+}
+
+uint64_t NullDevice::GetFrameCallCount()
+{
+    uint64_t callCount = 0;
+    for (const std::atomic<uint64_t>& count : sFrameCalls)
+    {
+        callCount += count.load(std::memory_order_relaxed);
+    }
+    return callCount;
+}
+
+uint64_t NullDevice::GetFrameUploadedBytes()
+{
+    return sFrameUploadedBytes.load(std::memory_order_relaxed);
+}
+
+uint32_t NullDevice::GetLiveObjectCount()
+{
+    return sLiveObjects.load(std::memory_order_relaxed);
+}
+
+size_t NullDevice::GetLiveBufferBytes()
+{
+    return sBufferBytes.load(std::memory_order_relaxed);
+}
+
+size_t NullDevice::GetLiveTextureBytes()
+{
+    return sTextureBytes.load(std::memory_order_relaxed);
+}
+
+const char* NullDevice::GetCallName(GraphicsApiCall call)
+{
+    return sCallNames[static_cast<size_t>(call)];
+}
@@ -8,30 +8,48 @@ using namespace Engine::Graphics;
 
 namespace
 {
-    std::string ReadFileContents(const std::filesystem::path& path)
+    // Into the calling thread's scratch stack, freed with the scope. Shaders compile on
+    // workers too.
+    std::string_view ReadFileContents(const std::filesystem::path& path,
+                                      Core::ScratchScope& scratch)
     {
-        std::ifstream file(path);
-        if (!file.is_open())
-            return "";
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        FILE* file = fopen(path.u8string().c_str(), "rb");
+        if (file == nullptr)
+        {
+            return {};
+        }
+        fseek(file, 0L, SEEK_END);
+        const long length = ftell(file);
+        fseek(file, 0L, SEEK_SET);
+        char* text = scratch.Allocate<char>(static_cast<size_t>(std::max(length, 0L)));
+        const size_t size = fread(text, 1, static_cast<size_t>(std::max(length, 0L)), file);
+        fclose(file);
+        return { text, size };
     }
 }
 
 void PixelShader::Initialize(const std::filesystem::path& shaderPath)
 {
     auto device = GraphicsSystem::Get()->GetDevice();
+    if (GraphicsSystem::Get()->IsNullDevice())
+    {
+        // Shaders never run on the null device, so they are not compiled either
+        HRESULT hr = device->CreatePixelShader(nullptr, 0, nullptr, &mPixelShader);
+        ASSERT(SUCCEEDED(hr), "Failed to create Pixel Shader");
+        return;
+    }
+
     DWORD shaderFlags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG;
     ID3DBlob* shaderBlob = nullptr;
     ID3DBlob* errorBlob = nullptr;
 
     // Read shader source and compile
-    std::string shaderSource = ReadFileContents(shaderPath);
+    Core::ScratchScope scratch;
+    const std::string_view shaderSource = ReadFileContents(shaderPath, scratch);
     ASSERT(!shaderSource.empty(), "Failed to read shader file: %s", shaderPath.string().c_str());
 
     std::string fileName = shaderPath.filename().string();
-    HRESULT hr = D3DCompile(shaderSource.c_str(),
+    HRESULT hr = D3DCompile(shaderSource.data(),
                             shaderSource.size(),
                             fileName.c_str(),
                             nullptr,
@@ -45,7 +63,7 @@ void PixelShader::Initialize(const std::filesystem::path& shaderPath)
 
     if (errorBlob != nullptr && errorBlob->GetBufferPointer() != nullptr)
     {
-        LOG("%s", static_cast<const char*>(errorBlob->GetBufferPointer()));
+        LOG_ERROR(Graphics, "%s", static_cast<const char*>(errorBlob->GetBufferPointer()));
     }
     ASSERT(SUCCEEDED(hr), "Failed to create Pixel Shader");
 
@@ -14,6 +14,15 @@ void RenderObject::Terminate()
     tm->ReleaseTexture(bumpMapId);
 }
 
+Math::Matrix4 RenderObject::GetWorldMatrix() const
+{
+    if (hierarchy != nullptr && transformNode != InvalidTransformNode)
+    {
+        return hierarchy->GetWorldMatrix(transformNode);
+    }
+    return transform.GetMatrix4();
+}
+
 void RenderGroup::Initialize(const std::filesystem::path& modelFilePath)
 {
     modelId = ModelManager::Get()->LoadModel(modelFilePath);
@@ -33,7 +42,8 @@ void RenderGroup::Initialize(const std::filesystem::path& modelFilePath)
     for (const Model::MeshData& meshData : model->meshData)
     {
         RenderObject& renderObject = renderObjects.emplace_back();
-        renderObject.meshBuffer.Initialize(meshData.mesh);
+        // Meshes split into several meshlets get an index buffer the MeshletCuller can rewrite
+        renderObject.meshBuffer.Initialize(meshData.mesh, meshData.meshlets.size() > 1);
         if (meshData.materialIndex < model->materialData.size())
         {
             // Add Material Data
@@ -57,4 +67,28 @@ void RenderGroup::Terminate()
     renderObjects.clear();
 }
 
+bool RenderGroup::Raycast(const Math::Ray& ray, float maxDistance, RayHit& hit) const
+{
+    return Raycast(GetWorldMatrix(), ray, maxDistance, hit);
+}
+
+bool RenderGroup::Raycast(const Math::Matrix4& matWorld,
+                          const Math::Ray& ray,
+                          float maxDistance,
+                          RayHit& hit) const
+{
+    // The direction is transformed but not normalized, so distances stay in world units
+    const Math::Matrix4 matInvWorld = Math::Inverse(matWorld);
+    const Math::Ray localRay(Math::TransformCoord(ray.origin, matInvWorld),
+                             Math::TransformNormal(ray.direction, matInvWorld));
+    return ModelManager::Get()->Raycast(modelId, localRay, maxDistance, hit);
+}
 
+Math::Matrix4 RenderGroup::GetWorldMatrix() const
+{
+    if (hierarchy != nullptr && transformNode != InvalidTransformNode)
+    {
+        return hierarchy->GetWorldMatrix(transformNode);
+    }
+    return transform.GetMatrix4();
+}
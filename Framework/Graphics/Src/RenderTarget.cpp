@@ -35,7 +35,7 @@ void RenderTarget::Initialize(const std::filesystem::path& fileName)
     ASSERT(false, "RenderTarget: Initialize with file name is not supported");
 }
 
-void RenderTarget::Initialize(uint32_t width, uint32_t height, Format format)
+void RenderTarget::Initialize(uint32_t width, uint32_t height, Format format, const char* name)
 {
     D3D11_TEXTURE2D_DESC desc{};
     desc.Width = width;
@@ -62,6 +62,7 @@ void RenderTarget::Initialize(uint32_t width, uint32_t height, Format format)
     ASSERT(SUCCEEDED(hr), "RenderTarget: Failed to create render target view!");
 
     SafeRelease(texture);
+    size_t memorySize = GraphicsSystem::GetTextureMemorySize(desc);
 
     desc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
     desc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
@@ -72,6 +73,8 @@ void RenderTarget::Initialize(uint32_t width, uint32_t height, Format format)
     ASSERT(SUCCEEDED(hr), "RenderTarget: Failed to create depth stencil view!");
 
     SafeRelease(texture);
+    memorySize += GraphicsSystem::GetTextureMemorySize(desc);
+    mMemoryId = Core::MemoryTracker::Track(Core::MemoryTag::RenderTargets, memorySize, name);
 
     mViewport.TopLeftX = 0.0f;
     mViewport.TopLeftY = 0.0f;
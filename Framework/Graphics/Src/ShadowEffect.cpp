@@ -19,7 +19,8 @@ void ShadowEffect::Initialize()
     mLightCamera.SetFarPlane(2000.0f);
 
     constexpr uint32_t depthMapResolution = 4096;
-    mDepthMapRenderTarget.Initialize(depthMapResolution, depthMapResolution, RenderTarget::Format::RGBA_U32);
+    mDepthMapRenderTarget.Initialize(
+        depthMapResolution, depthMapResolution, RenderTarget::Format::RGBA_U32, "Shadow map");
 }
 
 void ShadowEffect::Terminate()
@@ -48,7 +49,16 @@ void ShadowEffect::End()
 
 void ShadowEffect::Render(const RenderObject& renderObject)
 {
-    const Math::Matrix4 matWorld = renderObject.transform.GetMatrix4();
+    Render(renderObject, renderObject.GetWorldMatrix());
+}
+
+void ShadowEffect::Render(const RenderGroup& renderGroup)
+{
+    Render(renderGroup, renderGroup.GetWorldMatrix());
+}
+
+void ShadowEffect::Render(const RenderObject& renderObject, const Math::Matrix4& matWorld)
+{
     const Math::Matrix4 matView = mLightCamera.GetViewMatrix();
     const Math::Matrix4 matProj = mLightCamera.GetProjectionMatrix();
 
@@ -59,9 +69,8 @@ void ShadowEffect::Render(const RenderObject& renderObject)
     renderObject.meshBuffer.Render();
 }
 
-void ShadowEffect::Render(const RenderGroup& renderGroup)
+void ShadowEffect::Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld)
 {
-    const Math::Matrix4 matWorld = renderGroup.transform.GetMatrix4();
     const Math::Matrix4 matView = mLightCamera.GetViewMatrix();
     const Math::Matrix4 matProj = mLightCamera.GetProjectionMatrix();
 
@@ -0,0 +1,90 @@
+#include "Precompiled.h"
+#include "Skeleton.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+void Pose::Resize(uint32_t boneCount)
+{
+    rotations.resize(boneCount, Math::Quaternion::Identity);
+    positions.resize(boneCount, Math::Vector3::Zero);
+    scales.resize(boneCount, Math::Vector3::One);
+}
+
+uint32_t Pose::GetBoneCount() const
+{
+    return static_cast<uint32_t>(rotations.size());
+}
+
+void Skeleton::BuildRestPose()
+{
+    const uint32_t boneCount = static_cast<uint32_t>(bones.size());
+    restPose.Resize(boneCount);
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+        const Transform& rest = bones[i].restTransform;
+        restPose.rotations[i] = rest.rotation;
+        restPose.positions[i] = rest.position;
+        restPose.scales[i] = rest.scale;
+    }
+}
+
+int Skeleton::FindBone(const std::string& name) const
+{
+    for (size_t i = 0; i < bones.size(); ++i)
+    {
+        if (bones[i].name == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool Skeleton::IsEmpty() const
+{
+    return bones.empty();
+}
+
+void Graphics::BlendPoses(const Pose& from, const Pose& to, float t, Pose& result)
+{
+    const uint32_t boneCount = from.GetBoneCount();
+    ASSERT(to.GetBoneCount() == boneCount, "BlendPoses: Poses have different bone counts");
+    result.Resize(boneCount);
+    if (boneCount == 0)
+    {
+        return;
+    }
+
+    Math::NlerpQuaternions(
+        from.rotations.data(), to.rotations.data(), t, boneCount, result.rotations.data());
+    Math::LerpFloats(
+        &from.positions[0].x, &to.positions[0].x, t, boneCount * 3, &result.positions[0].x);
+    Math::LerpFloats(&from.scales[0].x, &to.scales[0].x, t, boneCount * 3, &result.scales[0].x);
+}
+
+void Graphics::ComputeModelMatrices(const Skeleton& skeleton,
+                                    const Pose& pose,
+                                    Math::Matrix4* outMatrices)
+{
+    const uint32_t boneCount = static_cast<uint32_t>(skeleton.bones.size());
+    ASSERT(pose.GetBoneCount() == boneCount, "ComputeModelMatrices: Pose does not fit skeleton");
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+        const Math::Matrix4 local =
+            Math::Matrix4::Transformation(pose.positions[i], pose.rotations[i], pose.scales[i]);
+        const int parentIndex = skeleton.bones[i].parentIndex;
+        outMatrices[i] = (parentIndex < 0) ? local : local * outMatrices[parentIndex];
+    }
+}
+
+void Graphics::ComputeSkinningMatrices(const Skeleton& skeleton,
+                                       const Math::Matrix4* modelMatrices,
+                                       Math::Matrix4* outMatrices)
+{
+    const size_t boneCount = skeleton.bones.size();
+    for (size_t i = 0; i < boneCount; ++i)
+    {
+        outMatrices[i] = skeleton.bones[i].offsetTransform * modelMatrices[i];
+    }
+}
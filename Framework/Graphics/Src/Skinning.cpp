@@ -0,0 +1,623 @@
+#include "Precompiled.h"
+#include "Skinning.h"
+
+#include "MeshBuffer.h"
+#include "Model.h"
+#include "RenderObject.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+using namespace Engine::Graphics;
+
+namespace
+{
+// Vertices per job range, a multiple of four
+constexpr uint32_t RangeSize = 1024;
+
+Math::Quaternion RotationFromMatrix(const Math::Matrix4& m)
+{
+    // Rows are the transformed axes, normalizing them removes scale. With row vectors, element
+    // (i, j) of the usual column vector rotation matrix is component i of row j.
+    const Math::Vector3 r0 = Math::Normalize({m._11, m._12, m._13});
+    const Math::Vector3 r1 = Math::Normalize({m._21, m._22, m._23});
+    const Math::Vector3 r2 = Math::Normalize({m._31, m._32, m._33});
+    const float m00 = r0.x, m01 = r1.x, m02 = r2.x;
+    const float m10 = r0.y, m11 = r1.y, m12 = r2.y;
+    const float m20 = r0.z, m21 = r1.z, m22 = r2.z;
+
+    Math::Quaternion q;
+    const float trace = m00 + m11 + m22;
+    if (trace > 0.0f)
+    {
+        const float s = sqrtf(trace + 1.0f) * 2.0f;
+        q = {(m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s, 0.25f * s};
+    }
+    else if (m00 > m11 && m00 > m22)
+    {
+        const float s = sqrtf(1.0f + m00 - m11 - m22) * 2.0f;
+        q = {0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s};
+    }
+    else if (m11 > m22)
+    {
+        const float s = sqrtf(1.0f + m11 - m00 - m22) * 2.0f;
+        q = {(m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s};
+    }
+    else
+    {
+        const float s = sqrtf(1.0f + m22 - m00 - m11) * 2.0f;
+        q = {(m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s};
+    }
+    return Math::Quaternion::Normalize(q);
+}
+
+struct InfluenceStreams
+{
+    const uint16_t* indices[BoneWeights::MaxInfluences];
+    const float* weights[BoneWeights::MaxInfluences];
+};
+
+#ifdef MATH_USE_SSE
+// Weighted sum of the bone matrices of one vertex, one register per matrix row
+void BlendMatrices(const Math::Matrix4* bones,
+                   const InfluenceStreams& influences,
+                   uint32_t vertex,
+                   __m128 rows[4])
+{
+#ifdef __AVX__
+    __m256 rows01 = _mm256_setzero_ps();
+    __m256 rows23 = _mm256_setzero_ps();
+    for (uint32_t k = 0; k < BoneWeights::MaxInfluences; ++k)
+    {
+        const __m256 weight = _mm256_set1_ps(influences.weights[k][vertex]);
+        const float* m = bones[influences.indices[k][vertex]].v.data();
+        rows01 = _mm256_add_ps(rows01, _mm256_mul_ps(weight, _mm256_loadu_ps(m)));
+        rows23 = _mm256_add_ps(rows23, _mm256_mul_ps(weight, _mm256_loadu_ps(m + 8)));
+    }
+    rows[0] = _mm256_castps256_ps128(rows01);
+    rows[1] = _mm256_extractf128_ps(rows01, 1);
+    rows[2] = _mm256_castps256_ps128(rows23);
+    rows[3] = _mm256_extractf128_ps(rows23, 1);
+#else
+    rows[0] = rows[1] = rows[2] = rows[3] = _mm_setzero_ps();
+    for (uint32_t k = 0; k < BoneWeights::MaxInfluences; ++k)
+    {
+        const __m128 weight = _mm_set1_ps(influences.weights[k][vertex]);
+        const float* m = bones[influences.indices[k][vertex]].v.data();
+        rows[0] = _mm_add_ps(rows[0], _mm_mul_ps(weight, _mm_loadu_ps(m)));
+        rows[1] = _mm_add_ps(rows[1], _mm_mul_ps(weight, _mm_loadu_ps(m + 4)));
+        rows[2] = _mm_add_ps(rows[2], _mm_mul_ps(weight, _mm_loadu_ps(m + 8)));
+        rows[3] = _mm_add_ps(rows[3], _mm_mul_ps(weight, _mm_loadu_ps(m + 12)));
+    }
+#endif
+}
+
+// Weighted sum of the dual quaternions of one vertex, flipped into the first influence's
+// hemisphere so blends take the short way around
+void BlendDualQuaternions(const DualQuaternion* bones,
+                          const InfluenceStreams& influences,
+                          uint32_t vertex,
+                          __m128& real,
+                          __m128& dual)
+{
+    const Math::Quaternion& pivot = bones[influences.indices[0][vertex]].real;
+    real = _mm_setzero_ps();
+    dual = _mm_setzero_ps();
+    for (uint32_t k = 0; k < BoneWeights::MaxInfluences; ++k)
+    {
+        const DualQuaternion& dq = bones[influences.indices[k][vertex]];
+        const float dot = pivot.x * dq.real.x + pivot.y * dq.real.y + pivot.z * dq.real.z +
+                          pivot.w * dq.real.w;
+        const float weight = (dot < 0.0f) ? -influences.weights[k][vertex]
+                                          : influences.weights[k][vertex];
+        const __m128 w = _mm_set1_ps(weight);
+        real = _mm_add_ps(real, _mm_mul_ps(w, _mm_loadu_ps(&dq.real.x)));
+        dual = _mm_add_ps(dual, _mm_mul_ps(w, _mm_loadu_ps(&dq.dual.x)));
+    }
+}
+
+inline __m128 MultiplyAdd(__m128 a, __m128 b, __m128 c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+// Zero vectors, like missing tangents, stay zero
+void Normalize(__m128& x, __m128& y, __m128& z)
+{
+    const __m128 lengthSqr = MultiplyAdd(x, x, MultiplyAdd(y, y, _mm_mul_ps(z, z)));
+    const __m128 valid = _mm_cmpgt_ps(lengthSqr, _mm_set1_ps(1e-12f));
+    const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSqr));
+    const __m128 scale = _mm_and_ps(valid, invLength);
+    x = _mm_mul_ps(x, scale);
+    y = _mm_mul_ps(y, scale);
+    z = _mm_mul_ps(z, scale);
+}
+
+// v + 2 * u x (u x v + w * v), four vectors at once
+void Rotate(const __m128 q[4], __m128& x, __m128& y, __m128& z)
+{
+    const __m128 tx = MultiplyAdd(q[3], x, _mm_sub_ps(_mm_mul_ps(q[1], z), _mm_mul_ps(q[2], y)));
+    const __m128 ty = MultiplyAdd(q[3], y, _mm_sub_ps(_mm_mul_ps(q[2], x), _mm_mul_ps(q[0], z)));
+    const __m128 tz = MultiplyAdd(q[3], z, _mm_sub_ps(_mm_mul_ps(q[0], y), _mm_mul_ps(q[1], x)));
+    const __m128 two = _mm_set1_ps(2.0f);
+    x = MultiplyAdd(two, _mm_sub_ps(_mm_mul_ps(q[1], tz), _mm_mul_ps(q[2], ty)), x);
+    y = MultiplyAdd(two, _mm_sub_ps(_mm_mul_ps(q[2], tx), _mm_mul_ps(q[0], tz)), y);
+    z = MultiplyAdd(two, _mm_sub_ps(_mm_mul_ps(q[0], ty), _mm_mul_ps(q[1], tx)), z);
+}
+
+// Skinned components in order: position xyz, normal xyz, tangent xyz
+void WriteVertices(const __m128 values[9], const Math::Vector2* uvs, uint32_t count, Vertex* output)
+{
+    alignas(16) float lanes[9][4];
+    for (uint32_t i = 0; i < 9; ++i)
+    {
+        _mm_store_ps(lanes[i], values[i]);
+    }
+    for (uint32_t lane = 0; lane < count; ++lane)
+    {
+        Vertex& vertex = output[lane];
+        vertex.position = {lanes[0][lane], lanes[1][lane], lanes[2][lane]};
+        vertex.normal = {lanes[3][lane], lanes[4][lane], lanes[5][lane]};
+        vertex.tangent = {lanes[6][lane], lanes[7][lane], lanes[8][lane]};
+        vertex.uvCoord = uvs[lane];
+    }
+}
+#else
+Math::Vector3 Rotate(const Math::Quaternion& q, const Math::Vector3& v)
+{
+    const Math::Vector3 u(q.x, q.y, q.z);
+    return v + Math::Cross(u, Math::Cross(u, v) + v * q.w) * 2.0f;
+}
+
+Math::Vector3 SafeNormalize(const Math::Vector3& v)
+{
+    const float lengthSqr = Math::MagnitudeSqr(v);
+    return (lengthSqr > 1e-12f) ? v / sqrtf(lengthSqr) : Math::Vector3::Zero;
+}
+#endif
+} // namespace
+
+void Graphics::ComputeDualQuaternions(const Math::Matrix4* skinningMatrices,
+                                      uint32_t count,
+                                      DualQuaternion* outDualQuaternions)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const Math::Matrix4& m = skinningMatrices[i];
+        const Math::Quaternion real = RotationFromMatrix(m);
+        const Math::Quaternion translation(m._41, m._42, m._43, 0.0f);
+        outDualQuaternions[i].real = real;
+        outDualQuaternions[i].dual = Math::Quaternion::Multiply(translation, real) * 0.5f;
+    }
+}
+
+void SkinnedMesh::Initialize(const Mesh& mesh, const std::vector<BoneWeights>& boneWeights)
+{
+    ASSERT(mesh.vertices.size() == boneWeights.size(),
+           "SkinnedMesh: Expected one set of bone weights per vertex");
+
+    mVertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    const uint32_t paddedCount = (mVertexCount + 3) & ~3u;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        mPositions[axis].assign(paddedCount, 0.0f);
+        mNormals[axis].assign(paddedCount, 0.0f);
+        mTangents[axis].assign(paddedCount, 0.0f);
+    }
+    mUVs.assign(paddedCount, Math::Vector2::Zero);
+    for (uint32_t k = 0; k < MaxInfluences; ++k)
+    {
+        mBoneIndices[k].assign(paddedCount, 0);
+        mWeights[k].assign(paddedCount, 0.0f);
+    }
+
+    for (uint32_t v = 0; v < mVertexCount; ++v)
+    {
+        const Vertex& vertex = mesh.vertices[v];
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            mPositions[axis][v] = vertex.position.v[axis];
+            mNormals[axis][v] = vertex.normal.v[axis];
+            mTangents[axis][v] = vertex.tangent.v[axis];
+        }
+        mUVs[v] = vertex.uvCoord;
+
+        float totalWeight = 0.0f;
+        for (uint32_t k = 0; k < MaxInfluences; ++k)
+        {
+            mBoneIndices[k][v] = boneWeights[v].boneIndices[k];
+            mWeights[k][v] = boneWeights[v].weights[k];
+            totalWeight += boneWeights[v].weights[k];
+        }
+
+        // Unweighted vertices follow the root instead of collapsing to the origin
+        if (totalWeight <= 0.0f)
+        {
+            mBoneIndices[0][v] = 0;
+            mWeights[0][v] = 1.0f;
+        }
+    }
+}
+
+void SkinnedMesh::Terminate()
+{
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        mPositions[axis].clear();
+        mNormals[axis].clear();
+        mTangents[axis].clear();
+    }
+    mUVs.clear();
+    for (uint32_t k = 0; k < MaxInfluences; ++k)
+    {
+        mBoneIndices[k].clear();
+        mWeights[k].clear();
+    }
+    mVertexCount = 0;
+}
+
+void SkinnedMesh::SetBindPose(const Vertex* vertices, uint32_t begin, uint32_t end)
+{
+    ASSERT(begin <= end && end <= mVertexCount, "SkinnedMesh: Range is past the last vertex");
+    for (uint32_t v = begin; v < end; ++v)
+    {
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            mPositions[axis][v] = vertices[v].position.v[axis];
+            mNormals[axis][v] = vertices[v].normal.v[axis];
+        }
+    }
+}
+
+void SkinnedMesh::SkinLinear(const Math::Matrix4* skinningMatrices,
+                             uint32_t begin,
+                             uint32_t end,
+                             Vertex* output) const
+{
+    ASSERT((begin & 3) == 0, "SkinnedMesh: Ranges must start on a multiple of four vertices");
+    ASSERT(end <= mVertexCount, "SkinnedMesh: Range is past the last vertex");
+
+    InfluenceStreams influences;
+    for (uint32_t k = 0; k < MaxInfluences; ++k)
+    {
+        influences.indices[k] = mBoneIndices[k].data();
+        influences.weights[k] = mWeights[k].data();
+    }
+
+#ifdef MATH_USE_SSE
+    for (uint32_t v = begin; v < end; v += 4)
+    {
+        __m128 rows[4][4];
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            BlendMatrices(skinningMatrices, influences, v + lane, rows[lane]);
+        }
+
+        // Transposed, m[r][c] holds element (r, c) of the four blended matrices
+        __m128 m[4][4];
+        for (uint32_t r = 0; r < 4; ++r)
+        {
+            m[r][0] = rows[0][r];
+            m[r][1] = rows[1][r];
+            m[r][2] = rows[2][r];
+            m[r][3] = rows[3][r];
+            _MM_TRANSPOSE4_PS(m[r][0], m[r][1], m[r][2], m[r][3]);
+        }
+
+        __m128 values[9];
+        const std::vector<float>* streams[3] = {mPositions, mNormals, mTangents};
+        for (uint32_t s = 0; s < 3; ++s)
+        {
+            const __m128 x = _mm_loadu_ps(&streams[s][0][v]);
+            const __m128 y = _mm_loadu_ps(&streams[s][1][v]);
+            const __m128 z = _mm_loadu_ps(&streams[s][2][v]);
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                const __m128 offset = (s == 0) ? m[3][c] : _mm_setzero_ps();
+                const __m128 zc = MultiplyAdd(z, m[2][c], offset);
+                values[s * 3 + c] = MultiplyAdd(x, m[0][c], MultiplyAdd(y, m[1][c], zc));
+            }
+        }
+        Normalize(values[3], values[4], values[5]);
+        Normalize(values[6], values[7], values[8]);
+
+        WriteVertices(values, &mUVs[v], Math::Min(4u, end - v), output + v);
+    }
+#else
+    for (uint32_t v = begin; v < end; ++v)
+    {
+        Math::Matrix4 blended(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                              0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        for (uint32_t k = 0; k < MaxInfluences; ++k)
+        {
+            const Math::Matrix4& bone = skinningMatrices[influences.indices[k][v]];
+            const float weight = influences.weights[k][v];
+            for (uint32_t e = 0; e < 16; ++e)
+            {
+                blended.v[e] += bone.v[e] * weight;
+            }
+        }
+
+        const Math::Vector3 position(mPositions[0][v], mPositions[1][v], mPositions[2][v]);
+        const Math::Vector3 normal(mNormals[0][v], mNormals[1][v], mNormals[2][v]);
+        const Math::Vector3 tangent(mTangents[0][v], mTangents[1][v], mTangents[2][v]);
+        Vertex& vertex = output[v];
+        vertex.position = Math::TransformCoord(position, blended);
+        vertex.normal = SafeNormalize(Math::TransformNormal(normal, blended));
+        vertex.tangent = SafeNormalize(Math::TransformNormal(tangent, blended));
+        vertex.uvCoord = mUVs[v];
+    }
+#endif
+}
+
+void SkinnedMesh::SkinDualQuaternion(const DualQuaternion* dualQuaternions,
+                                     uint32_t begin,
+                                     uint32_t end,
+                                     Vertex* output) const
+{
+    ASSERT((begin & 3) == 0, "SkinnedMesh: Ranges must start on a multiple of four vertices");
+    ASSERT(end <= mVertexCount, "SkinnedMesh: Range is past the last vertex");
+
+    InfluenceStreams influences;
+    for (uint32_t k = 0; k < MaxInfluences; ++k)
+    {
+        influences.indices[k] = mBoneIndices[k].data();
+        influences.weights[k] = mWeights[k].data();
+    }
+
+#ifdef MATH_USE_SSE
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (uint32_t v = begin; v < end; v += 4)
+    {
+        // q and d hold x, y, z, w of the blended real and dual parts for the four vertices
+        __m128 q[4];
+        __m128 d[4];
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            BlendDualQuaternions(dualQuaternions, influences, v + lane, q[lane], d[lane]);
+        }
+        _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+        _MM_TRANSPOSE4_PS(d[0], d[1], d[2], d[3]);
+
+        const __m128 zw = MultiplyAdd(q[2], q[2], _mm_mul_ps(q[3], q[3]));
+        const __m128 lengthSqr = MultiplyAdd(q[0], q[0], MultiplyAdd(q[1], q[1], zw));
+        const __m128 invLength =
+            _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSqr, _mm_set1_ps(1e-12f))));
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            q[i] = _mm_mul_ps(q[i], invLength);
+            d[i] = _mm_mul_ps(d[i], invLength);
+        }
+
+        // Translation = 2 * (w * d.xyz - d.w * q.xyz + q.xyz x d.xyz)
+        const __m128 tx = _mm_mul_ps(
+            two,
+            _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q[3], d[0]), _mm_mul_ps(d[3], q[0])),
+                       _mm_sub_ps(_mm_mul_ps(q[1], d[2]), _mm_mul_ps(q[2], d[1]))));
+        const __m128 ty = _mm_mul_ps(
+            two,
+            _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q[3], d[1]), _mm_mul_ps(d[3], q[1])),
+                       _mm_sub_ps(_mm_mul_ps(q[2], d[0]), _mm_mul_ps(q[0], d[2]))));
+        const __m128 tz = _mm_mul_ps(
+            two,
+            _mm_add_ps(_mm_sub_ps(_mm_mul_ps(q[3], d[2]), _mm_mul_ps(d[3], q[2])),
+                       _mm_sub_ps(_mm_mul_ps(q[0], d[1]), _mm_mul_ps(q[1], d[0]))));
+
+        __m128 values[9];
+        const std::vector<float>* streams[3] = {mPositions, mNormals, mTangents};
+        for (uint32_t s = 0; s < 3; ++s)
+        {
+            values[s * 3 + 0] = _mm_loadu_ps(&streams[s][0][v]);
+            values[s * 3 + 1] = _mm_loadu_ps(&streams[s][1][v]);
+            values[s * 3 + 2] = _mm_loadu_ps(&streams[s][2][v]);
+            Rotate(q, values[s * 3 + 0], values[s * 3 + 1], values[s * 3 + 2]);
+        }
+        values[0] = _mm_add_ps(values[0], tx);
+        values[1] = _mm_add_ps(values[1], ty);
+        values[2] = _mm_add_ps(values[2], tz);
+
+        WriteVertices(values, &mUVs[v], Math::Min(4u, end - v), output + v);
+    }
+#else
+    for (uint32_t v = begin; v < end; ++v)
+    {
+        const Math::Quaternion& pivot = dualQuaternions[influences.indices[0][v]].real;
+        Math::Quaternion real = Math::Quaternion::Zero;
+        Math::Quaternion dual = Math::Quaternion::Zero;
+        for (uint32_t k = 0; k < MaxInfluences; ++k)
+        {
+            const DualQuaternion& dq = dualQuaternions[influences.indices[k][v]];
+            const float dot = pivot.x * dq.real.x + pivot.y * dq.real.y + pivot.z * dq.real.z +
+                              pivot.w * dq.real.w;
+            const float weight =
+                (dot < 0.0f) ? -influences.weights[k][v] : influences.weights[k][v];
+            real = real + dq.real * weight;
+            dual = dual + dq.dual * weight;
+        }
+        const float invLength = 1.0f / Math::Max(Math::Quaternion::Magnitude(real), 1e-6f);
+        real = real * invLength;
+        dual = dual * invLength;
+
+        const Math::Vector3 u(real.x, real.y, real.z);
+        const Math::Vector3 du(dual.x, dual.y, dual.z);
+        const Math::Vector3 translation = (du * real.w - u * dual.w + Math::Cross(u, du)) * 2.0f;
+
+        const Math::Vector3 position(mPositions[0][v], mPositions[1][v], mPositions[2][v]);
+        const Math::Vector3 normal(mNormals[0][v], mNormals[1][v], mNormals[2][v]);
+        const Math::Vector3 tangent(mTangents[0][v], mTangents[1][v], mTangents[2][v]);
+        Vertex& vertex = output[v];
+        vertex.position = Rotate(real, position) + translation;
+        vertex.normal = Rotate(real, normal);
+        vertex.tangent = Rotate(real, tangent);
+        vertex.uvCoord = mUVs[v];
+    }
+#endif
+}
+
+uint32_t SkinnedMesh::GetVertexCount() const
+{
+    return mVertexCount;
+}
+
+void Graphics::SkinMeshes(const SkinningJob* jobs, uint32_t jobCount, SkinningMethod method)
+{
+    struct Range
+    {
+        uint32_t job;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    // Ranges cut across every mesh, so a crowd of small meshes still spreads evenly
+    ScratchScope scratch;
+    uint32_t rangeCount = 0;
+    for (uint32_t j = 0; j < jobCount; ++j)
+    {
+        rangeCount += (jobs[j].mesh->GetVertexCount() + RangeSize - 1) / RangeSize;
+    }
+    ArenaVector<Range> ranges{ArenaStlAllocator<Range>(scratch.GetAllocator())};
+    ranges.reserve(rangeCount);
+    for (uint32_t j = 0; j < jobCount; ++j)
+    {
+        const uint32_t vertexCount = jobs[j].mesh->GetVertexCount();
+        for (uint32_t begin = 0; begin < vertexCount; begin += RangeSize)
+        {
+            ranges.push_back({j, begin, Math::Min(begin + RangeSize, vertexCount)});
+        }
+    }
+
+    JobSystem::Get()->ParallelFor(
+        static_cast<uint32_t>(ranges.size()),
+        1,
+        [&](uint32_t first, uint32_t last)
+        {
+            for (uint32_t r = first; r < last; ++r)
+            {
+                const Range& range = ranges[r];
+                const SkinningJob& job = jobs[range.job];
+                if (method == SkinningMethod::Linear)
+                {
+                    job.mesh->SkinLinear(job.skinningMatrices, range.begin, range.end, job.output);
+                }
+                else
+                {
+                    job.mesh->SkinDualQuaternion(
+                        job.dualQuaternions, range.begin, range.end, job.output);
+                }
+            }
+        });
+}
+
+void Skinner::Initialize(const Model& model, RenderGroup& renderGroup)
+{
+    ASSERT(renderGroup.renderObjects.size() == model.meshData.size(),
+           "Skinner: Render group was not initialized from this model");
+
+    mBoneCount = static_cast<uint32_t>(model.skeleton.bones.size());
+    mDualQuaternions.resize(mBoneCount);
+    for (size_t i = 0; i < model.meshData.size(); ++i)
+    {
+        const Model::MeshData& meshData = model.meshData[i];
+        if (meshData.boneWeights.empty())
+        {
+            continue;
+        }
+
+        const Mesh& mesh = meshData.mesh;
+        mMeshes.emplace_back().Initialize(mesh, meshData.boneWeights);
+
+        // Same indices, but the vertices now come from the CPU every frame. Starts in bind pose.
+        MeshBuffer& meshBuffer = renderGroup.renderObjects[i].meshBuffer;
+        const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        meshBuffer.Terminate();
+        meshBuffer.Initialize(nullptr,
+                              static_cast<uint32_t>(sizeof(Vertex)),
+                              vertexCount,
+                              mesh.indices.data(),
+                              static_cast<uint32_t>(mesh.indices.size()),
+                              meshData.meshlets.size() > 1);
+        meshBuffer.Update(mesh.vertices.data(), vertexCount);
+        mMeshBuffers.push_back(&meshBuffer);
+    }
+}
+
+void Skinner::Terminate()
+{
+    mMeshes.clear();
+    mMeshBuffers.clear();
+    mDualQuaternions.clear();
+    mBoneCount = 0;
+}
+
+void Skinner::Update(const Math::Matrix4* skinningMatrices, SkinningMethod method)
+{
+    Skinner* self = this;
+    Update(&self, &skinningMatrices, 1, method);
+}
+
+void Skinner::Update(Skinner* const* skinners,
+                     const Math::Matrix4* const* skinningMatrices,
+                     uint32_t count,
+                     SkinningMethod method)
+{
+    if (method == SkinningMethod::DualQuaternion)
+    {
+        auto convert = [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                Skinner* skinner = skinners[i];
+                ComputeDualQuaternions(
+                    skinningMatrices[i], skinner->mBoneCount, skinner->mDualQuaternions.data());
+            }
+        };
+        JobSystem::Get()->ParallelFor(count, 16, convert);
+    }
+
+    // Buffers are mapped on this thread, the workers only write into them
+    ScratchScope scratch;
+    uint32_t meshCount = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        meshCount += static_cast<uint32_t>(skinners[i]->mMeshes.size());
+    }
+    ArenaVector<SkinningJob> jobs{ArenaStlAllocator<SkinningJob>(scratch.GetAllocator())};
+    ArenaVector<MeshBuffer*> mapped{ArenaStlAllocator<MeshBuffer*>(scratch.GetAllocator())};
+    jobs.reserve(meshCount);
+    mapped.reserve(meshCount);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Skinner* skinner = skinners[i];
+        for (size_t m = 0; m < skinner->mMeshes.size(); ++m)
+        {
+            Vertex* output = static_cast<Vertex*>(skinner->mMeshBuffers[m]->Map());
+            if (output == nullptr)
+            {
+                continue;
+            }
+
+            SkinningJob& job = jobs.emplace_back();
+            job.mesh = &skinner->mMeshes[m];
+            job.skinningMatrices = skinningMatrices[i];
+            job.dualQuaternions = skinner->mDualQuaternions.data();
+            job.output = output;
+            mapped.push_back(skinner->mMeshBuffers[m]);
+        }
+    }
+
+    SkinMeshes(jobs.data(), static_cast<uint32_t>(jobs.size()), method);
+
+    for (MeshBuffer* meshBuffer : mapped)
+    {
+        meshBuffer->Unmap();
+    }
+}
+
+uint32_t Skinner::GetVertexCount() const
+{
+    uint32_t vertexCount = 0;
+    for (const SkinnedMesh& mesh : mMeshes)
+    {
+        vertexCount += mesh.GetVertexCount();
+    }
+    return vertexCount;
+}
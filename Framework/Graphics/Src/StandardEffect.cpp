@@ -60,7 +60,16 @@ void StandardEffect::End()
 
 void StandardEffect::Render(const RenderObject& renderObject)
 {
-    const Math::Matrix4 matWorld = renderObject.transform.GetMatrix4();
+    Render(renderObject, renderObject.GetWorldMatrix());
+}
+
+void StandardEffect::Render(const RenderGroup& renderGroup)
+{
+    Render(renderGroup, renderGroup.GetWorldMatrix());
+}
+
+void StandardEffect::Render(const RenderObject& renderObject, const Math::Matrix4& matWorld)
+{
     const Math::Matrix4 matView = mCamera->GetViewMatrix();
     const Math::Matrix4 matProj = mCamera->GetProjectionMatrix();
     const Math::Matrix4 matFinal = matWorld * matView * matProj;
@@ -104,9 +113,8 @@ void StandardEffect::Render(const RenderObject& renderObject)
     renderObject.meshBuffer.Render();
 }
 
-void StandardEffect::Render(const RenderGroup& renderGroup)
+void StandardEffect::Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld)
 {
-    const Math::Matrix4 matWorld = renderGroup.transform.GetMatrix4();
     const Math::Matrix4 matView = mCamera->GetViewMatrix();
     const Math::Matrix4 matProj = mCamera->GetProjectionMatrix();
     const Math::Matrix4 matFinal = matWorld * matView * matProj;
@@ -66,7 +66,7 @@ void TerrainEffect::Render(const RenderObject& renderObject)
     ASSERT(mCamera != nullptr, "TerrainEffect: Camera not specified!");
     ASSERT(mDirectionalLight != nullptr, "TerrainEffect: Light not specified!");
 
-    Math::Matrix4 matWorld = renderObject.transform.GetMatrix4();
+    Math::Matrix4 matWorld = renderObject.GetWorldMatrix();
     Math::Matrix4 matView = mCamera->GetViewMatrix();
     Math::Matrix4 matProj = mCamera->GetProjectionMatrix();
 
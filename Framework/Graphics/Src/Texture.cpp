@@ -17,6 +17,8 @@ using namespace Engine::Graphics;
 // Helper: Load image using stb_image
 namespace
 {
+const Core::PerfCounter sBytesUploaded("Graphics.BytesUploaded");
+
 struct ImageData
 {
     unsigned char* pixels = nullptr;
@@ -59,15 +61,19 @@ Texture::~Texture()
 }
 
 Texture::Texture(Texture&& rhs) noexcept
-    : mShaderResourceView(rhs.mShaderResourceView)
+    : mShaderResourceView(rhs.mShaderResourceView),
+      mMemoryId(rhs.mMemoryId)
 {
     rhs.mShaderResourceView = nullptr;
+    rhs.mMemoryId = Core::InvalidHandle;
 }
 
 Texture& Texture::operator=(Texture&& rhs) noexcept
 {
     mShaderResourceView = rhs.mShaderResourceView;
+    mMemoryId = rhs.mMemoryId;
     rhs.mShaderResourceView = nullptr;
+    rhs.mMemoryId = Core::InvalidHandle;
     return *this;
 }
 
@@ -112,6 +118,11 @@ void Texture::Initialize(const std::filesystem::path& fileName)
         ASSERT(false, "Texture: Failed to create D3D11 texture from %ls", fileName.c_str());
         return;
     }
+    sBytesUploaded.Add(static_cast<int64_t>(imageData.width) * imageData.height * 4);
+    mMemoryId = Core::MemoryTracker::Track(
+        Core::MemoryTag::Textures,
+        GraphicsSystem::GetTextureMemorySize(textureDesc),
+        Core::StringTable::GetString(Core::StringTable::InternPath(fileName)));
     
     // Create shader resource view
     D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
@@ -128,9 +139,62 @@ void Texture::Initialize(const std::filesystem::path& fileName)
     ASSERT(SUCCEEDED(hr), "Texture: Failed to create shader resource view for %ls", fileName.c_str());
 }
 
+void Texture::Initialize(uint32_t width,
+                         uint32_t height,
+                         PixelFormat format,
+                         const void* pixels,
+                         const char* name)
+{
+    DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+    uint32_t pixelSize = 4;
+    switch (format)
+    {
+    case PixelFormat::RGBA_U8:
+        break;
+    case PixelFormat::RGBA_U16:
+        dxgiFormat = DXGI_FORMAT_R16G16B16A16_UNORM;
+        pixelSize = 8;
+        break;
+    case PixelFormat::RGBA_S8:
+        dxgiFormat = DXGI_FORMAT_R8G8B8A8_SNORM;
+        break;
+    }
+
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width = width;
+    textureDesc.Height = height;
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = dxgiFormat;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = pixels;
+    initData.SysMemPitch = width * pixelSize;
+
+    auto device = GraphicsSystem::Get()->GetDevice();
+    ID3D11Texture2D* texture = nullptr;
+    HRESULT hr = device->CreateTexture2D(&textureDesc, &initData, &texture);
+    if (FAILED(hr))
+    {
+        ASSERT(false, "Texture: Failed to create %ux%u texture", width, height);
+        return;
+    }
+    sBytesUploaded.Add(static_cast<int64_t>(width) * height * pixelSize);
+    mMemoryId = Core::MemoryTracker::Track(
+        Core::MemoryTag::Textures, GraphicsSystem::GetTextureMemorySize(textureDesc), name);
+
+    hr = device->CreateShaderResourceView(texture, nullptr, &mShaderResourceView);
+    SafeRelease(texture);
+    ASSERT(SUCCEEDED(hr), "Texture: Failed to create shader resource view");
+}
+
 void Texture::Terminate()
 {
     SafeRelease(mShaderResourceView);
+    Core::MemoryTracker::Untrack(std::exchange(mMemoryId, Core::InvalidHandle));
 }
 
 void Texture::BindVS(uint32_t slot) const
@@ -7,7 +7,12 @@ using namespace Engine::Graphics;
 namespace
 {
 std::unique_ptr<TextureManager> sInstance;
-}
+
+const Core::PerfCounter sTextureBinds("Graphics.TextureBinds");
+const Core::PerfCounter sTexturesLoaded("Assets.TexturesLoaded");
+const Core::PerfCounter sLoadTime("Assets.LoadTimeUs");
+const Core::PerfCounter sTextureCount("Assets.Textures", Core::PerfCounterType::Gauge);
+} // namespace
 
 void TextureManager::StaticInitialize(const std::filesystem::path& root)
 {
@@ -32,7 +37,7 @@ TextureManager* TextureManager::Get()
 
 TextureManager::~TextureManager()
 {
-    ASSERT(mInventory.empty(), "TextureManager: Not all textured are cleared!");
+    ASSERT(mInventory.GetCount() == 0, "TextureManager: Not all textured are cleared!");
 }
 
 void TextureManager::SetRootDirectory(const std::filesystem::path& root)
@@ -42,60 +47,99 @@ void TextureManager::SetRootDirectory(const std::filesystem::path& root)
 
 TextureId TextureManager::LoadTexture(const std::filesystem::path& filename, bool useRootDir)
 {
-    const size_t textureId = std::filesystem::hash_value(filename);
-    auto [iter, success] = mInventory.insert({textureId, Entry()});
-    if (success)
+    const Core::StringId pathId = Core::StringTable::InternPath(filename);
+    auto [textureId, inserted] = mLookup.TryEmplace(pathId, Core::InvalidHandle);
+    if (!inserted)
     {
-        iter->second.texture = std::make_unique<Texture>();
-        iter->second.texture->Initialize((useRootDir) ? mRootDirectory / filename : filename);
-        iter->second.refCount = 1;
+        ++mInventory.Get(*textureId)->refCount;
+        return *textureId;
     }
-    else
+
+    const auto startTime = std::chrono::steady_clock::now();
+    Entry entry;
+    entry.texture.Initialize(GetFilePath(filename, useRootDir));
+    entry.pathId = pathId;
+    entry.refCount = 1;
+    *textureId = mInventory.Add(std::move(entry));
+
+    const auto loadTime = std::chrono::steady_clock::now() - startTime;
+    sLoadTime.Add(std::chrono::duration_cast<std::chrono::microseconds>(loadTime).count());
+    sTexturesLoaded.Add();
+    sTextureCount.Set(mInventory.GetCount());
+    return *textureId;
+}
+
+TextureId TextureManager::AddTexture(const std::filesystem::path& filename, Texture&& texture)
+{
+    const Core::StringId pathId = Core::StringTable::InternPath(filename);
+    auto [textureId, inserted] = mLookup.TryEmplace(pathId, Core::InvalidHandle);
+    if (!inserted)
     {
-        ++iter->second.refCount;
+        texture.Terminate();
+        ++mInventory.Get(*textureId)->refCount;
+        return *textureId;
     }
-    return textureId;
+
+    Entry entry;
+    entry.texture = std::move(texture);
+    entry.pathId = pathId;
+    entry.refCount = 1;
+    *textureId = mInventory.Add(std::move(entry));
+    sTexturesLoaded.Add();
+    sTextureCount.Set(mInventory.GetCount());
+    return *textureId;
+}
+
+TextureId TextureManager::FindTexture(const std::filesystem::path& filename) const
+{
+    const TextureId* textureId = mLookup.Find(Core::HashPath(filename));
+    return (textureId != nullptr) ? *textureId : Core::InvalidHandle;
+}
+
+std::filesystem::path TextureManager::GetFilePath(const std::filesystem::path& filename,
+                                                  bool useRootDir) const
+{
+    return (useRootDir) ? mRootDirectory / filename : filename;
 }
 
 const Texture* TextureManager::GetTexture(TextureId id)
 {
-    auto iter = mInventory.find(id);
-    if (iter != mInventory.end())
-    {
-        return iter->second.texture.get();
-    }
-    return nullptr;
+    const Entry* entry = mInventory.Get(id);
+    return (entry != nullptr) ? &entry->texture : nullptr;
 }
 
 void TextureManager::ReleaseTexture(TextureId id)
 {
-    auto iter = mInventory.find(id);
-    if (iter != mInventory.end())
+    Entry* entry = mInventory.Get(id);
+    if (entry != nullptr)
     {
-        --iter->second.refCount;
-        if (iter->second.refCount == 0)
+        --entry->refCount;
+        if (entry->refCount == 0)
         {
-            iter->second.texture->Terminate();
-            iter->second.texture.release();
-            mInventory.erase(id);
+            entry->texture.Terminate();
+            mLookup.Erase(entry->pathId);
+            mInventory.Remove(id);
+            sTextureCount.Set(mInventory.GetCount());
         }
     }
 }
 
 void TextureManager::BindVS(TextureId id, uint32_t slot) const
 {
-    auto iter = mInventory.find(id);
-    if (iter != mInventory.end())
+    const Entry* entry = mInventory.Get(id);
+    if (entry != nullptr)
     {
-        iter->second.texture->BindVS(slot);
+        entry->texture.BindVS(slot);
+        sTextureBinds.Add();
     }
 }
 
 void TextureManager::BindPS(TextureId id, uint32_t slot) const
 {
-    auto iter = mInventory.find(id);
-    if (iter != mInventory.end())
+    const Entry* entry = mInventory.Get(id);
+    if (entry != nullptr)
     {
-        iter->second.texture->BindPS(slot);
+        entry->texture.BindPS(slot);
+        sTextureBinds.Add();
     }
 }
@@ -0,0 +1,48 @@
+#include "Precompiled.h"
+#include "Transform.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+constexpr uint32_t ChunkSize = 64;
+} // namespace
+
+void Graphics::ComputeMatrices(const Transform* transforms,
+                               uint32_t count,
+                               Math::Matrix4* outMatrices)
+{
+    float streams[10][ChunkSize];
+    Math::TransformStreams view;
+    view.positionX = streams[0];
+    view.positionY = streams[1];
+    view.positionZ = streams[2];
+    view.rotationX = streams[3];
+    view.rotationY = streams[4];
+    view.rotationZ = streams[5];
+    view.rotationW = streams[6];
+    view.scaleX = streams[7];
+    view.scaleY = streams[8];
+    view.scaleZ = streams[9];
+
+    for (uint32_t begin = 0; begin < count; begin += ChunkSize)
+    {
+        const uint32_t chunkCount = std::min(ChunkSize, count - begin);
+        for (uint32_t i = 0; i < chunkCount; ++i)
+        {
+            const Transform& t = transforms[begin + i];
+            streams[0][i] = t.position.x;
+            streams[1][i] = t.position.y;
+            streams[2][i] = t.position.z;
+            streams[3][i] = t.rotation.x;
+            streams[4][i] = t.rotation.y;
+            streams[5][i] = t.rotation.z;
+            streams[6][i] = t.rotation.w;
+            streams[7][i] = t.scale.x;
+            streams[8][i] = t.scale.y;
+            streams[9][i] = t.scale.z;
+        }
+        Math::ComposeTransformations(view, chunkCount, outMatrices + begin);
+    }
+}
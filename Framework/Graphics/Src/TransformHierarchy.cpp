@@ -0,0 +1,332 @@
+#include "Precompiled.h"
+#include "TransformHierarchy.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+using namespace Engine::Graphics;
+
+namespace
+{
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+// Levels smaller than this are cheaper to update than to hand out to workers
+constexpr uint32_t ParallelThreshold = 1024;
+constexpr uint32_t ParallelGrainSize = 256;
+} // namespace
+
+TransformNodeId TransformHierarchy::Create(TransformNodeId parent)
+{
+    ASSERT(parent == InvalidTransformNode || GetIndex(parent) != InvalidIndex,
+           "TransformHierarchy: invalid parent");
+
+    TransformNodeId node;
+    if (mFreeIds.empty())
+    {
+        node = static_cast<TransformNodeId>(mIndices.size());
+        mIndices.push_back(InvalidIndex);
+    }
+    else
+    {
+        node = mFreeIds.back();
+        mFreeIds.pop_back();
+    }
+
+    mIndices[node] = static_cast<uint32_t>(mNodeIds.size());
+    mLocals.emplace_back();
+    mLocalMatrices.push_back(Math::Matrix4::Identity);
+    mWorldMatrices.push_back(Math::Matrix4::Identity);
+    mParents.push_back(parent);
+    mParentIndices.push_back(InvalidIndex);
+    mFlags.push_back(LocalDirty);
+    mNodeIds.push_back(node);
+
+    mOrderDirty = true;
+    return node;
+}
+
+void TransformHierarchy::Destroy(TransformNodeId node)
+{
+    if (mOrderDirty)
+    {
+        RebuildOrder();
+    }
+
+    const uint32_t index = GetIndex(node);
+    ASSERT(index != InvalidIndex, "TransformHierarchy: invalid node");
+    if (index == InvalidIndex)
+    {
+        return;
+    }
+
+    // Parents always come before their children, so one forward pass finds every descendant
+    const uint32_t count = static_cast<uint32_t>(mNodeIds.size());
+    std::vector<bool> removed(count, false);
+    removed[index] = true;
+    for (uint32_t i = index + 1; i < count; ++i)
+    {
+        const uint32_t parentIndex = mParentIndices[i];
+        removed[i] = parentIndex != InvalidIndex && removed[parentIndex];
+    }
+
+    // Compact in place, which keeps the remaining nodes in breadth first order
+    uint32_t write = 0;
+    for (uint32_t read = 0; read < count; ++read)
+    {
+        if (removed[read])
+        {
+            mIndices[mNodeIds[read]] = InvalidIndex;
+            mFreeIds.push_back(mNodeIds[read]);
+            continue;
+        }
+
+        if (write != read)
+        {
+            mLocals[write] = mLocals[read];
+            mLocalMatrices[write] = mLocalMatrices[read];
+            mWorldMatrices[write] = mWorldMatrices[read];
+            mParents[write] = mParents[read];
+            mFlags[write] = mFlags[read];
+            mNodeIds[write] = mNodeIds[read];
+            mIndices[mNodeIds[write]] = write;
+        }
+        ++write;
+    }
+
+    mLocals.resize(write);
+    mLocalMatrices.resize(write);
+    mWorldMatrices.resize(write);
+    mParents.resize(write);
+    mParentIndices.resize(write);
+    mFlags.resize(write);
+    mNodeIds.resize(write);
+    mOrderDirty = true;
+}
+
+void TransformHierarchy::Clear()
+{
+    mLocals.clear();
+    mLocalMatrices.clear();
+    mWorldMatrices.clear();
+    mParents.clear();
+    mParentIndices.clear();
+    mFlags.clear();
+    mNodeIds.clear();
+    mIndices.clear();
+    mFreeIds.clear();
+    mLevelOffsets.clear();
+    mOrderDirty = false;
+}
+
+void TransformHierarchy::SetParent(TransformNodeId node, TransformNodeId parent)
+{
+    const uint32_t index = GetIndex(node);
+    ASSERT(index != InvalidIndex, "TransformHierarchy: invalid node");
+
+    // Refuse to create a cycle
+    for (TransformNodeId ancestor = parent; ancestor != InvalidTransformNode;
+         ancestor = mParents[GetIndex(ancestor)])
+    {
+        if (ancestor == node)
+        {
+            ASSERT(false, "TransformHierarchy: node can not be parented to its own child");
+            return;
+        }
+    }
+
+    mParents[index] = parent;
+    mFlags[index] |= LocalDirty;
+    mOrderDirty = true;
+}
+
+TransformNodeId TransformHierarchy::GetParent(TransformNodeId node) const
+{
+    return mParents[GetIndex(node)];
+}
+
+const Transform& TransformHierarchy::GetLocal(TransformNodeId node) const
+{
+    return mLocals[GetIndex(node)];
+}
+
+void TransformHierarchy::SetLocal(TransformNodeId node, const Transform& local)
+{
+    const uint32_t index = GetIndex(node);
+    mLocals[index] = local;
+    mFlags[index] |= LocalDirty;
+}
+
+void TransformHierarchy::SetPosition(TransformNodeId node, const Math::Vector3& position)
+{
+    const uint32_t index = GetIndex(node);
+    mLocals[index].position = position;
+    mFlags[index] |= LocalDirty;
+}
+
+void TransformHierarchy::SetRotation(TransformNodeId node, const Math::Quaternion& rotation)
+{
+    const uint32_t index = GetIndex(node);
+    mLocals[index].rotation = rotation;
+    mFlags[index] |= LocalDirty;
+}
+
+void TransformHierarchy::SetScale(TransformNodeId node, const Math::Vector3& scale)
+{
+    const uint32_t index = GetIndex(node);
+    mLocals[index].scale = scale;
+    mFlags[index] |= LocalDirty;
+}
+
+const Math::Matrix4& TransformHierarchy::GetLocalMatrix(TransformNodeId node) const
+{
+    return mLocalMatrices[GetIndex(node)];
+}
+
+const Math::Matrix4& TransformHierarchy::GetWorldMatrix(TransformNodeId node) const
+{
+    return mWorldMatrices[GetIndex(node)];
+}
+
+void TransformHierarchy::Update()
+{
+    if (mOrderDirty)
+    {
+        RebuildOrder();
+    }
+
+    // Each level only reads the level above it, so a level can be split freely
+    const uint32_t levelCount = GetLevelCount();
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        const uint32_t begin = mLevelOffsets[level];
+        const uint32_t end = mLevelOffsets[level + 1];
+        if (end - begin < ParallelThreshold)
+        {
+            UpdateRange(begin, end);
+            continue;
+        }
+
+        JobSystem::Get()->ParallelFor(end - begin,
+                                      ParallelGrainSize,
+                                      [this, begin](uint32_t rangeBegin, uint32_t rangeEnd)
+                                      { UpdateRange(begin + rangeBegin, begin + rangeEnd); });
+    }
+}
+
+uint32_t TransformHierarchy::GetNodeCount() const
+{
+    return static_cast<uint32_t>(mNodeIds.size());
+}
+
+uint32_t TransformHierarchy::GetLevelCount() const
+{
+    return mLevelOffsets.empty() ? 0 : static_cast<uint32_t>(mLevelOffsets.size()) - 1;
+}
+
+uint32_t TransformHierarchy::GetIndex(TransformNodeId node) const
+{
+    return (node < mIndices.size()) ? mIndices[node] : InvalidIndex;
+}
+
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const uint32_t parentIndex = mParentIndices[i];
+        const bool localDirty = (mFlags[i] & LocalDirty) != 0;
+        const bool parentChanged =
+            parentIndex != InvalidIndex && (mFlags[parentIndex] & WorldChanged) != 0;
+
+        if (localDirty)
+        {
+            mLocalMatrices[i] = mLocals[i].GetMatrix4();
+        }
+
+        if (localDirty || parentChanged)
+        {
+            mWorldMatrices[i] = (parentIndex == InvalidIndex)
+                                    ? mLocalMatrices[i]
+                                    : mLocalMatrices[i] * mWorldMatrices[parentIndex];
+            mFlags[i] = WorldChanged;
+        }
+        else
+        {
+            mFlags[i] = 0;
+        }
+    }
+}
+
+void TransformHierarchy::RebuildOrder()
+{
+    const uint32_t count = static_cast<uint32_t>(mNodeIds.size());
+
+    // Depth of every node, walking up only until a known depth is found
+    std::vector<uint32_t> depths(count, InvalidIndex);
+    Core::SmallVector<uint32_t, 32> chain;
+    uint32_t levelCount = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t index = i;
+        while (index != InvalidIndex && depths[index] == InvalidIndex)
+        {
+            chain.push_back(index);
+            const TransformNodeId parent = mParents[index];
+            index = (parent == InvalidTransformNode) ? InvalidIndex : mIndices[parent];
+        }
+
+        uint32_t depth = (index == InvalidIndex) ? 0 : depths[index] + 1;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            depths[*it] = depth++;
+        }
+        levelCount = std::max(levelCount, depth);
+        chain.clear();
+    }
+
+    // Counting sort by depth, stable so siblings keep their relative order
+    mLevelOffsets.assign(levelCount + 1, 0);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ++mLevelOffsets[depths[i] + 1];
+    }
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        mLevelOffsets[level + 1] += mLevelOffsets[level];
+    }
+
+    std::vector<uint32_t> order(count);
+    std::vector<uint32_t> cursor(mLevelOffsets.begin(), mLevelOffsets.end() - 1);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        order[cursor[depths[i]]++] = i;
+    }
+
+    auto permute = [&order](auto& values)
+    {
+        std::remove_reference_t<decltype(values)> sorted;
+        sorted.reserve(values.size());
+        for (uint32_t index : order)
+        {
+            sorted.push_back(values[index]);
+        }
+        values = std::move(sorted);
+    };
+    permute(mLocals);
+    permute(mLocalMatrices);
+    permute(mWorldMatrices);
+    permute(mParents);
+    permute(mFlags);
+    permute(mNodeIds);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        mIndices[mNodeIds[i]] = i;
+    }
+    mParentIndices.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const TransformNodeId parent = mParents[i];
+        mParentIndices[i] = (parent == InvalidTransformNode) ? InvalidIndex : mIndices[parent];
+    }
+
+    mOrderDirty = false;
+}
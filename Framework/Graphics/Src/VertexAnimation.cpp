@@ -0,0 +1,275 @@
+#include "Precompiled.h"
+#include "VertexAnimation.h"
+
+#include "BinaryIO.h"
+#include "Model.h"
+#include "Skinning.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+uint16_t QuantizeUnsigned(float value, float min, float extent)
+{
+    const float t = Math::Clamp((value - min) / extent, 0.0f, 1.0f);
+    return static_cast<uint16_t>(t * 65535.0f + 0.5f);
+}
+
+int8_t QuantizeSigned(float value)
+{
+    return static_cast<int8_t>(lroundf(Math::Clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+} // namespace
+
+VertexAnimationData VertexAnimationData::Bake(const Model& model, float frameRate)
+{
+    VertexAnimationData data;
+    const Skeleton& skeleton = model.skeleton;
+    if (skeleton.IsEmpty() || model.animationClips.empty() || frameRate <= 0.0f)
+    {
+        return data;
+    }
+
+    // Meshes without bone weights keep their bind pose in every frame
+    const size_t meshCount = model.meshData.size();
+    std::vector<SkinnedMesh> skinnedMeshes(meshCount);
+    uint32_t vertexCount = 0;
+    for (size_t m = 0; m < meshCount; ++m)
+    {
+        const Model::MeshData& meshData = model.meshData[m];
+        data.meshVertexOffsets.push_back(vertexCount);
+        vertexCount += static_cast<uint32_t>(meshData.mesh.vertices.size());
+        if (meshData.boneWeights.size() == meshData.mesh.vertices.size())
+        {
+            skinnedMeshes[m].Initialize(meshData.mesh, meshData.boneWeights);
+        }
+    }
+    if (vertexCount == 0)
+    {
+        return {};
+    }
+
+    uint32_t frameCount = 0;
+    for (const AnimationClip& clip : model.animationClips)
+    {
+        VertexAnimationClip& bakedClip = data.clips.emplace_back();
+        bakedClip.name = clip.GetName();
+        bakedClip.firstFrame = frameCount;
+        bakedClip.frameCount = static_cast<uint32_t>(ceilf(clip.GetDuration() * frameRate)) + 1;
+        bakedClip.frameCount = Math::Max(bakedClip.frameCount, 2u);
+        bakedClip.duration = clip.GetDuration();
+        frameCount += bakedClip.frameCount;
+    }
+
+    data.vertexCount = vertexCount;
+
+    // As few rows per frame as the width limit allows, split evenly so the last is not mostly empty
+    data.rowsPerFrame = (vertexCount + MaxTextureWidth - 1) / MaxTextureWidth;
+    data.textureWidth = (vertexCount + data.rowsPerFrame - 1) / data.rowsPerFrame;
+    data.frameCount = frameCount;
+    if (data.GetTextureHeight() > MaxTextureHeight)
+    {
+        LOG_ERROR(Graphics,
+                  "VertexAnimationData: %u frames of %u vertices do not fit in a texture",
+                  frameCount,
+                  vertexCount);
+        return {};
+    }
+
+    const uint32_t boneCount = static_cast<uint32_t>(skeleton.bones.size());
+    std::vector<Math::Vector3> positions(static_cast<size_t>(frameCount) * vertexCount);
+    std::vector<Math::Vector3> normals(positions.size());
+    std::vector<Math::Matrix4> modelMatrices(boneCount);
+    std::vector<Math::Matrix4> skinningMatrices(boneCount);
+    std::vector<Vertex> vertices;
+    Pose pose;
+    Math::Vector3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+    Math::Vector3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (size_t c = 0; c < data.clips.size(); ++c)
+    {
+        const AnimationClip& clip = model.animationClips[c];
+        const VertexAnimationClip& bakedClip = data.clips[c];
+        for (uint32_t f = 0; f < bakedClip.frameCount; ++f)
+        {
+            const float time = bakedClip.duration * f / (bakedClip.frameCount - 1);
+            clip.Sample(skeleton, time, false, pose);
+            ComputeModelMatrices(skeleton, pose, modelMatrices.data());
+            ComputeSkinningMatrices(skeleton, modelMatrices.data(), skinningMatrices.data());
+
+            const size_t frameOffset = static_cast<size_t>(bakedClip.firstFrame + f) * vertexCount;
+            for (size_t m = 0; m < meshCount; ++m)
+            {
+                const Mesh& mesh = model.meshData[m].mesh;
+                const uint32_t meshVertexCount = static_cast<uint32_t>(mesh.vertices.size());
+                const Vertex* source = mesh.vertices.data();
+                if (skinnedMeshes[m].GetVertexCount() > 0)
+                {
+                    vertices.resize(meshVertexCount);
+                    skinnedMeshes[m].SkinLinear(
+                        skinningMatrices.data(), 0, meshVertexCount, vertices.data());
+                    source = vertices.data();
+                }
+
+                const size_t first = frameOffset + data.meshVertexOffsets[m];
+                for (uint32_t v = 0; v < meshVertexCount; ++v)
+                {
+                    positions[first + v] = source[v].position;
+                    normals[first + v] = source[v].normal;
+                    boundsMin = Math::Min(boundsMin, source[v].position);
+                    boundsMax = Math::Max(boundsMax, source[v].position);
+                }
+            }
+        }
+    }
+
+    // Flat axes still need a non zero extent to divide by
+    data.boundsMin = boundsMin;
+    data.boundsExtent = boundsMax - boundsMin;
+    data.boundsExtent.x = Math::Max(data.boundsExtent.x, 1e-6f);
+    data.boundsExtent.y = Math::Max(data.boundsExtent.y, 1e-6f);
+    data.boundsExtent.z = Math::Max(data.boundsExtent.z, 1e-6f);
+
+    const size_t texelCount = static_cast<size_t>(data.textureWidth) * data.GetTextureHeight();
+    data.positions.assign(texelCount * 4, 0);
+    data.normals.assign(texelCount * 4, 0);
+    for (uint32_t f = 0; f < frameCount; ++f)
+    {
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            const size_t sample = static_cast<size_t>(f) * vertexCount + v;
+            const size_t row = static_cast<size_t>(f) * data.rowsPerFrame + v / data.textureWidth;
+            const size_t texel = row * data.textureWidth + v % data.textureWidth;
+
+            const Math::Vector3& position = positions[sample];
+            uint16_t* outPosition = &data.positions[texel * 4];
+            outPosition[0] = QuantizeUnsigned(position.x, data.boundsMin.x, data.boundsExtent.x);
+            outPosition[1] = QuantizeUnsigned(position.y, data.boundsMin.y, data.boundsExtent.y);
+            outPosition[2] = QuantizeUnsigned(position.z, data.boundsMin.z, data.boundsExtent.z);
+            outPosition[3] = 65535;
+
+            const Math::Vector3& normal = normals[sample];
+            int8_t* outNormal = &data.normals[texel * 4];
+            outNormal[0] = QuantizeSigned(normal.x);
+            outNormal[1] = QuantizeSigned(normal.y);
+            outNormal[2] = QuantizeSigned(normal.z);
+            outNormal[3] = 0;
+        }
+    }
+    return data;
+}
+
+bool VertexAnimationData::IsEmpty() const
+{
+    return vertexCount == 0 || frameCount == 0;
+}
+
+uint32_t VertexAnimationData::GetTextureHeight() const
+{
+    return frameCount * rowsPerFrame;
+}
+
+size_t VertexAnimationData::GetMemorySize() const
+{
+    size_t size = sizeof(VertexAnimationData) + positions.size() * sizeof(uint16_t) +
+                  normals.size() * sizeof(int8_t) + meshVertexOffsets.size() * sizeof(uint32_t);
+    for (const VertexAnimationClip& clip : clips)
+    {
+        size += sizeof(VertexAnimationClip) + clip.name.size();
+    }
+    return size;
+}
+
+void VertexAnimationData::Write(FILE* file) const
+{
+    fwrite(&vertexCount, sizeof(vertexCount), 1, file);
+    fwrite(&textureWidth, sizeof(textureWidth), 1, file);
+    fwrite(&rowsPerFrame, sizeof(rowsPerFrame), 1, file);
+    fwrite(&frameCount, sizeof(frameCount), 1, file);
+    fwrite(&boundsMin, sizeof(boundsMin), 1, file);
+    fwrite(&boundsExtent, sizeof(boundsExtent), 1, file);
+    BinaryIO::WriteVector(file, meshVertexOffsets);
+
+    const uint32_t clipCount = static_cast<uint32_t>(clips.size());
+    fwrite(&clipCount, sizeof(clipCount), 1, file);
+    for (const VertexAnimationClip& clip : clips)
+    {
+        BinaryIO::WriteString(file, clip.name);
+        fwrite(&clip.firstFrame, sizeof(clip.firstFrame), 1, file);
+        fwrite(&clip.frameCount, sizeof(clip.frameCount), 1, file);
+        fwrite(&clip.duration, sizeof(clip.duration), 1, file);
+    }
+
+    BinaryIO::WriteVector(file, positions);
+    BinaryIO::WriteVector(file, normals);
+}
+
+bool VertexAnimationData::Read(FILE* file)
+{
+    bool success = fread(&vertexCount, sizeof(vertexCount), 1, file) == 1;
+    success = success && fread(&textureWidth, sizeof(textureWidth), 1, file) == 1;
+    success = success && fread(&rowsPerFrame, sizeof(rowsPerFrame), 1, file) == 1;
+    success = success && fread(&frameCount, sizeof(frameCount), 1, file) == 1;
+    success = success && fread(&boundsMin, sizeof(boundsMin), 1, file) == 1;
+    success = success && fread(&boundsExtent, sizeof(boundsExtent), 1, file) == 1;
+    success = success && BinaryIO::ReadVector(file, meshVertexOffsets);
+
+    uint32_t clipCount = 0;
+    success = success && fread(&clipCount, sizeof(clipCount), 1, file) == 1;
+    // Every clip stores at least its name length
+    success = success && clipCount <= BinaryIO::GetRemainingSize(file) / sizeof(uint32_t);
+    clips.resize(success ? clipCount : 0);
+    for (VertexAnimationClip& clip : clips)
+    {
+        success = success && BinaryIO::ReadString(file, clip.name);
+        success = success && fread(&clip.firstFrame, sizeof(clip.firstFrame), 1, file) == 1;
+        success = success && fread(&clip.frameCount, sizeof(clip.frameCount), 1, file) == 1;
+        success = success && fread(&clip.duration, sizeof(clip.duration), 1, file) == 1;
+    }
+
+    success = success && BinaryIO::ReadVector(file, positions);
+    success = success && BinaryIO::ReadVector(file, normals);
+
+    const size_t texelCount = static_cast<size_t>(textureWidth) * GetTextureHeight();
+    return success && positions.size() == texelCount * 4 && normals.size() == texelCount * 4;
+}
+
+void VertexAnimationTexture::Initialize(const VertexAnimationData& data)
+{
+    ASSERT(!data.IsEmpty() && !data.positions.empty(), "VertexAnimationTexture: No baked frames");
+    const uint32_t height = data.GetTextureHeight();
+    mPositions.Initialize(data.textureWidth,
+                          height,
+                          Texture::PixelFormat::RGBA_U16,
+                          data.positions.data(),
+                          "Vertex animation positions");
+    mNormals.Initialize(data.textureWidth,
+                        height,
+                        Texture::PixelFormat::RGBA_S8,
+                        data.normals.data(),
+                        "Vertex animation normals");
+
+    mData = data;
+    mData.positions.clear();
+    mData.positions.shrink_to_fit();
+    mData.normals.clear();
+    mData.normals.shrink_to_fit();
+}
+
+void VertexAnimationTexture::Terminate()
+{
+    mNormals.Terminate();
+    mPositions.Terminate();
+}
+
+void VertexAnimationTexture::BindVS(uint32_t slot) const
+{
+    mPositions.BindVS(slot);
+    mNormals.BindVS(slot + 1);
+}
+
+const VertexAnimationData& VertexAnimationTexture::GetData() const
+{
+    return mData;
+}
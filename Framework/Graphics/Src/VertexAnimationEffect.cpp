@@ -0,0 +1,146 @@
+#include "Precompiled.h"
+#include "VertexAnimationEffect.h"
+
+#include "VertexTypes.h"
+#include "Camera.h"
+#include "RenderObject.h"
+#include "TextureManager.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+void VertexAnimationEffect::Initialize(const std::filesystem::path& path)
+{
+    mFrameBuffer.Initialize();
+    mLightBuffer.Initialize();
+    mMaterialBuffer.Initialize();
+    mClipBuffer.Initialize();
+    mInstanceBuffer.Initialize();
+
+    mVertexShader.Initialize<Vertex>(path);
+    mPixelShader.Initialize(path);
+    mSampler.Initialize(Sampler::Filter::Linear, Sampler::AddressMode::Wrap);
+
+    mInstanceData = std::make_unique<InstanceData>();
+}
+
+void VertexAnimationEffect::Terminate()
+{
+    mInstanceData.reset();
+    mSampler.Terminate();
+    mPixelShader.Terminate();
+    mVertexShader.Terminate();
+    mInstanceBuffer.Terminate();
+    mClipBuffer.Terminate();
+    mMaterialBuffer.Terminate();
+    mLightBuffer.Terminate();
+    mFrameBuffer.Terminate();
+}
+
+void VertexAnimationEffect::Begin()
+{
+    mVertexShader.Bind();
+    mPixelShader.Bind();
+    mSampler.BindPS(0);
+
+    mFrameBuffer.BindVS(0);
+    mFrameBuffer.BindPS(0);
+
+    mLightBuffer.BindVS(1);
+    mLightBuffer.BindPS(1);
+
+    mMaterialBuffer.BindPS(2);
+
+    mClipBuffer.BindVS(3);
+    mInstanceBuffer.BindVS(4);
+
+    mDrawCount = 0;
+}
+
+void VertexAnimationEffect::End()
+{
+}
+
+void VertexAnimationEffect::Render(const RenderGroup& renderGroup,
+                                   const VertexAnimationTexture& animationTexture,
+                                   const VertexAnimationInstance* instances,
+                                   uint32_t instanceCount)
+{
+    const VertexAnimationData& data = animationTexture.GetData();
+    ASSERT(data.clips.size() <= MaxClips, "VertexAnimationEffect: Too many clips");
+    ASSERT(data.meshVertexOffsets.size() >= renderGroup.renderObjects.size(),
+           "VertexAnimationEffect: Texture was baked from a different model");
+    if (instanceCount == 0 || data.IsEmpty())
+    {
+        return;
+    }
+
+    FrameData frame;
+    frame.viewProjection =
+        Math::Transpose(mCamera->GetViewMatrix() * mCamera->GetProjectionMatrix());
+    frame.viewPosition = mCamera->GetPosition();
+    frame.time = mTime;
+    frame.boundsMin = data.boundsMin;
+    frame.textureWidth = data.textureWidth;
+    frame.boundsExtent = data.boundsExtent;
+    frame.rowsPerFrame = data.rowsPerFrame;
+
+    ClipData clipData;
+    for (size_t c = 0; c < data.clips.size() && c < MaxClips; ++c)
+    {
+        const VertexAnimationClip& clip = data.clips[c];
+        clipData.clips[c] = {static_cast<float>(clip.firstFrame),
+                             static_cast<float>(clip.frameCount),
+                             clip.duration,
+                             0.0f};
+    }
+    mClipBuffer.Update(clipData);
+    mLightBuffer.Update(*mDirectionalLight);
+    animationTexture.BindVS(0);
+
+    TextureManager* tm = TextureManager::Get();
+    for (uint32_t first = 0; first < instanceCount; first += MaxInstancesPerDraw)
+    {
+        const uint32_t batchCount = Math::Min(instanceCount - first, MaxInstancesPerDraw);
+        for (uint32_t i = 0; i < batchCount; ++i)
+        {
+            VertexAnimationInstance& instance = mInstanceData->instances[i];
+            instance = instances[first + i];
+            instance.world = Math::Transpose(instance.world);
+        }
+        mInstanceBuffer.Update(*mInstanceData);
+
+        for (size_t m = 0; m < renderGroup.renderObjects.size(); ++m)
+        {
+            const RenderObject& renderObject = renderGroup.renderObjects[m];
+            frame.vertexOffset = data.meshVertexOffsets[m];
+            frame.useDiffuseMap = (renderObject.diffuseMapId > 0) ? 1 : 0;
+            mFrameBuffer.Update(frame);
+            mMaterialBuffer.Update(renderObject.material);
+            tm->BindPS(renderObject.diffuseMapId, 2);
+
+            renderObject.meshBuffer.RenderInstanced(batchCount);
+            ++mDrawCount;
+        }
+    }
+}
+
+void VertexAnimationEffect::SetCamera(const Camera& camera)
+{
+    mCamera = &camera;
+}
+
+void VertexAnimationEffect::SetDirectionalLight(const DirectionalLight& directionalLight)
+{
+    mDirectionalLight = &directionalLight;
+}
+
+void VertexAnimationEffect::SetTime(float time)
+{
+    mTime = time;
+}
+
+uint32_t VertexAnimationEffect::GetDrawCount() const
+{
+    return mDrawCount;
+}
@@ -9,68 +9,87 @@ using namespace Engine::Graphics;
 
 namespace
 {
-std::string ReadFileContents(const std::filesystem::path& path)
+// Into the calling thread's scratch stack, freed with the scope. Shaders compile on workers too.
+std::string_view ReadFileContents(const std::filesystem::path& path, Core::ScratchScope& scratch)
 {
-    std::ifstream file(path);
-    if (!file.is_open())
-        return "";
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    FILE* file = fopen(path.u8string().c_str(), "rb");
+    if (file == nullptr)
+    {
+        return {};
+    }
+    fseek(file, 0L, SEEK_END);
+    const long length = ftell(file);
+    fseek(file, 0L, SEEK_SET);
+    char* text = scratch.Allocate<char>(static_cast<size_t>(std::max(length, 0L)));
+    const size_t size = fread(text, 1, static_cast<size_t>(std::max(length, 0L)), file);
+    fclose(file);
+    return {text, size};
 }
 
-std::vector<D3D11_INPUT_ELEMENT_DESC> GetVertexLayout(uint32_t format)
+// At most one element per vertex element flag, built on the stack
+struct VertexLayout
 {
-    std::vector<D3D11_INPUT_ELEMENT_DESC> vertexLayout;
+    std::array<D3D11_INPUT_ELEMENT_DESC, 5> elements;
+    uint32_t count = 0;
+
+    void Add(const D3D11_INPUT_ELEMENT_DESC& element)
+    {
+        elements[count++] = element;
+    }
+};
+
+VertexLayout GetVertexLayout(uint32_t format)
+{
+    VertexLayout vertexLayout;
     if (format & VE_Position)
     {
-        vertexLayout.push_back({"POSITION",
-                                0,
-                                DXGI_FORMAT_R32G32B32_FLOAT,
-                                0,
-                                D3D11_APPEND_ALIGNED_ELEMENT,
-                                D3D11_INPUT_PER_VERTEX_DATA,
-                                0});
+        vertexLayout.Add({"POSITION",
+                          0,
+                          DXGI_FORMAT_R32G32B32_FLOAT,
+                          0,
+                          D3D11_APPEND_ALIGNED_ELEMENT,
+                          D3D11_INPUT_PER_VERTEX_DATA,
+                          0});
     }
     if (format & VE_Normal)
     {
-        vertexLayout.push_back({"NORMAL",
-                                0,
-                                DXGI_FORMAT_R32G32B32_FLOAT,
-                                0,
-                                D3D11_APPEND_ALIGNED_ELEMENT,
-                                D3D11_INPUT_PER_VERTEX_DATA,
-                                0});
+        vertexLayout.Add({"NORMAL",
+                          0,
+                          DXGI_FORMAT_R32G32B32_FLOAT,
+                          0,
+                          D3D11_APPEND_ALIGNED_ELEMENT,
+                          D3D11_INPUT_PER_VERTEX_DATA,
+                          0});
     }
     if (format & VE_Tangent)
     {
-        vertexLayout.push_back({"TANGENT",
-                                0,
-                                DXGI_FORMAT_R32G32B32_FLOAT,
-                                0,
-                                D3D11_APPEND_ALIGNED_ELEMENT,
-                                D3D11_INPUT_PER_VERTEX_DATA,
-                                0});
+        vertexLayout.Add({"TANGENT",
+                          0,
+                          DXGI_FORMAT_R32G32B32_FLOAT,
+                          0,
+                          D3D11_APPEND_ALIGNED_ELEMENT,
+                          D3D11_INPUT_PER_VERTEX_DATA,
+                          0});
     }
     if (format & VE_Color)
     {
-        vertexLayout.push_back({"COLOR",
-                                0,
-                                DXGI_FORMAT_R32G32B32A32_FLOAT,
-                                0,
-                                D3D11_APPEND_ALIGNED_ELEMENT,
-                                D3D11_INPUT_PER_VERTEX_DATA,
-                                0});
+        vertexLayout.Add({"COLOR",
+                          0,
+                          DXGI_FORMAT_R32G32B32A32_FLOAT,
+                          0,
+                          D3D11_APPEND_ALIGNED_ELEMENT,
+                          D3D11_INPUT_PER_VERTEX_DATA,
+                          0});
     }
     if (format & VE_TexCoord)
     {
-        vertexLayout.push_back({"TEXCOORD",
-                                0,
-                                DXGI_FORMAT_R32G32_FLOAT,
-                                0,
-                                D3D11_APPEND_ALIGNED_ELEMENT,
-                                D3D11_INPUT_PER_VERTEX_DATA,
-                                0});
+        vertexLayout.Add({"TEXCOORD",
+                          0,
+                          DXGI_FORMAT_R32G32_FLOAT,
+                          0,
+                          D3D11_APPEND_ALIGNED_ELEMENT,
+                          D3D11_INPUT_PER_VERTEX_DATA,
+                          0});
     }
 
     return vertexLayout;
@@ -80,17 +99,29 @@ std::vector<D3D11_INPUT_ELEMENT_DESC> GetVertexLayout(uint32_t format)
 void VertexShader::Initialize(const std::filesystem::path& shaderPath, uint32_t format)
 {
     auto device = GraphicsSystem::Get()->GetDevice();
+    if (GraphicsSystem::Get()->IsNullDevice())
+    {
+        // Shaders never run on the null device, so they are not compiled either
+        const VertexLayout vertexLayout = GetVertexLayout(format);
+        HRESULT hr = device->CreateVertexShader(nullptr, 0, nullptr, &mVertexShader);
+        ASSERT(SUCCEEDED(hr), "Failed to create Vertex Shader");
+        hr = device->CreateInputLayout(
+            vertexLayout.elements.data(), vertexLayout.count, nullptr, 0, &mInputLayout);
+        ASSERT(SUCCEEDED(hr), "Failed to create Input Layout");
+        return;
+    }
 
     DWORD shaderFlags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG;
     ID3DBlob* shaderBlob = nullptr;
     ID3DBlob* errorBlob = nullptr;
 
     // Read shader source and compile
-    std::string shaderSource = ReadFileContents(shaderPath);
+    Core::ScratchScope scratch;
+    const std::string_view shaderSource = ReadFileContents(shaderPath, scratch);
     ASSERT(!shaderSource.empty(), "Failed to read shader file: %s", shaderPath.string().c_str());
 
     std::string fileName = shaderPath.filename().string();
-    HRESULT hr = D3DCompile(shaderSource.c_str(),
+    HRESULT hr = D3DCompile(shaderSource.data(),
                             shaderSource.size(),
                             fileName.c_str(),
                             nullptr,
@@ -104,7 +135,9 @@ void VertexShader::Initialize(const std::filesystem::path& shaderPath, uint32_t
 
     if (errorBlob != nullptr && errorBlob->GetBufferPointer() != nullptr)
     {
-        LOG("Vertex Shader Error: %s", static_cast<const char*>(errorBlob->GetBufferPointer()));
+        LOG_ERROR(Graphics,
+                  "Vertex Shader Error: %s",
+                  static_cast<const char*>(errorBlob->GetBufferPointer()));
     }
     ASSERT(SUCCEEDED(hr), "Failed to create Vertex Shader");
 
@@ -114,10 +147,10 @@ void VertexShader::Initialize(const std::filesystem::path& shaderPath, uint32_t
     //======================================================================================================
 
     // STATE WHAT THE VERTEX VARIABLES ARE
-    std::vector<D3D11_INPUT_ELEMENT_DESC> vertexLayout = GetVertexLayout(format);
+    const VertexLayout vertexLayout = GetVertexLayout(format);
 
-    hr = device->CreateInputLayout(vertexLayout.data(),
-                                   static_cast<UINT>(vertexLayout.size()),
+    hr = device->CreateInputLayout(vertexLayout.elements.data(),
+                                   vertexLayout.count,
                                    shaderBlob->GetBufferPointer(),
                                    shaderBlob->GetBufferSize(),
                                    &mInputLayout);
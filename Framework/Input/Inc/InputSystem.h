@@ -21,8 +21,38 @@ class InputSystem final
     void Initialize(GLFWwindow* window);
     void Terminate();
 
+    // Turns the events since the last Update into this frame's state. A press and release inside
+    // one frame still counts as pressed.
     void Update();
 
+    // Events of this frame in arrival order. Past EventCapacity runs of cursor moves are merged
+    // into their last position, keys, buttons and the wheel are always kept.
+    const std::vector<InputEvent>& GetEvents() const;
+
+    // Reads the cursor again after Update and returns the movement since, so the camera can turn
+    // to the newest position right before the frame is submitted. The next Update only reports
+    // the movement after the latch, so only call it when the movement is used.
+    void LatchMouse(int& moveX, int& moveY);
+
+    // After present: the age of the frame's oldest event goes to Input.LatencyUs, and a
+    // recording gets the frame
+    void OnFramePresented();
+
+    // Recordings keep every frame's events, cursor and delta time. A replay feeds them back in
+    // place of the window, so the frames see the InputSystem state of the recorded run. ImGui
+    // reads the window through its own callbacks and is not replayed. The replay stops by itself
+    // at the end of the file.
+    bool StartRecording(const std::filesystem::path& filePath);
+    void StopRecording();
+    bool IsRecording() const;
+    bool StartReplay(const std::filesystem::path& filePath);
+    void StopReplay();
+    bool IsReplaying() const;
+
+    // The delta time the frame runs with: the recorded one when replaying, otherwise the given
+    // one, which a recording keeps. Call once per frame after Update.
+    float GetFrameDeltaTime(float deltaTime);
+
     bool IsKeyDown(KeyCode key) const;
     bool IsKeyPressed(KeyCode key) const;
 
@@ -46,13 +76,30 @@ class InputSystem final
     bool IsMouseClipToWindow() const;
 
   private:
+    static constexpr uint32_t EventCapacity = 256;
+
     static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
     static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     static void ScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     static void CursorPosCallback(GLFWwindow* window, double xpos, double ypos);
 
+    void OnWindowEvent(InputEventType type, uint32_t code, float x, float y);
+    void ApplyEvent(const InputEvent& event);
+    void ReadReplayFrame();
+
     GLFWwindow* mWindow = nullptr;
 
+    // Callbacks append to mPendingEvents, Update swaps it into mEvents
+    std::vector<InputEvent> mPendingEvents;
+    std::vector<InputEvent> mEvents;
+    int64_t mUpdateTimeUs = 0;
+
+    FILE* mRecordFile = nullptr;
+    FILE* mReplayFile = nullptr;
+    float mFrameDeltaTime = 0.0f;
+    int mReplayMouseX = 0; // Cursor after the recorded frame's late latch
+    int mReplayMouseY = 0;
+
     bool mCurrKeys[512]{};
     bool mPrevKeys[512]{};
     bool mPressedKeys[512]{};
@@ -110,4 +110,24 @@ enum class MouseButton : uint32_t
     RBUTTON = 1,
     MBUTTON = 2,
 };
+
+enum class InputEventType : uint8_t
+{
+    KeyDown, // Not repeated while the key is held
+    KeyUp,
+    MouseDown,
+    MouseUp,
+    MouseMove,
+    MouseWheel
+};
+
+// One window callback, in arrival order
+struct InputEvent
+{
+    int64_t timeUs = 0; // steady_clock
+    InputEventType type = InputEventType::KeyDown;
+    uint32_t code = 0; // KeyCode or MouseButton
+    float x = 0.0f;    // Cursor position, the wheel offset is in y
+    float y = 0.0f;
+};
 } // namespace Engine::Input
\ No newline at end of file
@@ -8,6 +8,88 @@ namespace
 {
 std::unique_ptr<InputSystem> sInputSystem;
 
+const Core::PerfCounter sEventCount("Input.Events");
+const Core::PerfCounter sMergedEvents("Input.EventsMerged");
+const Core::PerfCounter sLatency("Input.LatencyUs", Core::PerfCounterType::Gauge);
+const Core::PerfCounter sLateLatch("Input.LateLatchUs", Core::PerfCounterType::Gauge);
+
+// "DWIN" little endian. A recording is this header, the cursor position and held keys and buttons
+// as events, then per frame the delta time, the cursor after the late latch and the events.
+constexpr uint32_t RecordingMagic = 0x4E495744;
+constexpr uint32_t RecordingVersion = 1;
+
+int64_t GetTimeUs()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+template <class T> void Write(FILE* file, const T& value)
+{
+    fwrite(&value, sizeof(T), 1, file);
+}
+
+template <class T> bool Read(FILE* file, T& value)
+{
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+// 15 bytes, the time is stored as the age at the frame's Update
+void WriteEvent(FILE* file, const InputEvent& event, int64_t updateTimeUs)
+{
+    const int64_t age = std::clamp<int64_t>(updateTimeUs - event.timeUs, 0, UINT32_MAX);
+    Write(file, static_cast<uint32_t>(age));
+    Write(file, static_cast<uint8_t>(event.type));
+    Write(file, static_cast<uint16_t>(event.code));
+    Write(file, event.x);
+    Write(file, event.y);
+}
+
+// Merges every cursor move followed by another into the later one, which keeps the earlier
+// time so the frame's latency still starts at the oldest event. Returns the events removed.
+size_t MergeMouseMoves(std::vector<InputEvent>& events)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const bool isMerged = i + 1 < events.size() &&
+                              events[i].type == InputEventType::MouseMove &&
+                              events[i + 1].type == InputEventType::MouseMove;
+        if (isMerged)
+        {
+            events[i + 1].timeUs = events[i].timeUs;
+        }
+        else
+        {
+            events[count++] = events[i];
+        }
+    }
+    const size_t removed = events.size() - count;
+    events.resize(count);
+    return removed;
+}
+
+bool ReadEvent(FILE* file, InputEvent& event, int64_t updateTimeUs)
+{
+    uint32_t age = 0;
+    uint8_t type = 0;
+    uint16_t code = 0;
+    if (!Read(file, age) || !Read(file, type) || !Read(file, code) || !Read(file, event.x) ||
+        !Read(file, event.y))
+    {
+        return false;
+    }
+    event.timeUs = updateTimeUs - age;
+    event.type = static_cast<InputEventType>(type);
+    event.code = code;
+
+    // Codes index the state arrays
+    const bool isMouseButton =
+        (event.type == InputEventType::MouseDown || event.type == InputEventType::MouseUp);
+    return type <= static_cast<uint8_t>(InputEventType::MouseWheel) &&
+           code < (isMouseButton ? 3u : 512u);
+}
+
 // GLFW to Engine KeyCode mapping
 KeyCode GLFWKeyToKeyCode(int glfwKey)
 {
@@ -41,9 +123,11 @@ void InputSystem::KeyCallback(GLFWwindow* window, int key, int scancode, int act
     {
         KeyCode keyCode = GLFWKeyToKeyCode(key);
         int index = static_cast<int>(keyCode);
-        if (index >= 0 && index < 512)
+        if (index >= 0 && index < 512 && action != GLFW_REPEAT)
         {
-            sInputSystem->mCurrKeys[index] = (action != GLFW_RELEASE);
+            const InputEventType type =
+                (action == GLFW_PRESS) ? InputEventType::KeyDown : InputEventType::KeyUp;
+            sInputSystem->OnWindowEvent(type, index, 0.0f, 0.0f);
         }
     }
 }
@@ -52,12 +136,23 @@ void InputSystem::MouseButtonCallback(GLFWwindow* window, int button, int action
 {
     if (sInputSystem)
     {
+        int index = -1;
         if (button == GLFW_MOUSE_BUTTON_LEFT)
-            sInputSystem->mCurrMouseButtons[0] = (action == GLFW_PRESS);
+            index = 0;
         else if (button == GLFW_MOUSE_BUTTON_RIGHT)
-            sInputSystem->mCurrMouseButtons[1] = (action == GLFW_PRESS);
+            index = 1;
         else if (button == GLFW_MOUSE_BUTTON_MIDDLE)
-            sInputSystem->mCurrMouseButtons[2] = (action == GLFW_PRESS);
+            index = 2;
+
+        if (index >= 0)
+        {
+            const InputEventType type =
+                (action == GLFW_PRESS) ? InputEventType::MouseDown : InputEventType::MouseUp;
+            sInputSystem->OnWindowEvent(type,
+                                        index,
+                                        static_cast<float>(sInputSystem->mCurrMouseX),
+                                        static_cast<float>(sInputSystem->mCurrMouseY));
+        }
     }
 }
 
@@ -65,7 +160,10 @@ void InputSystem::ScrollCallback(GLFWwindow* window, double xoffset, double yoff
 {
     if (sInputSystem)
     {
-        sInputSystem->mMouseWheel = static_cast<float>(yoffset);
+        sInputSystem->OnWindowEvent(InputEventType::MouseWheel,
+                                    0,
+                                    static_cast<float>(xoffset),
+                                    static_cast<float>(yoffset));
     }
 }
 
@@ -73,8 +171,8 @@ void InputSystem::CursorPosCallback(GLFWwindow* window, double xpos, double ypos
 {
     if (sInputSystem)
     {
-        sInputSystem->mCurrMouseX = static_cast<int>(xpos);
-        sInputSystem->mCurrMouseY = static_cast<int>(ypos);
+        sInputSystem->OnWindowEvent(
+            InputEventType::MouseMove, 0, static_cast<float>(xpos), static_cast<float>(ypos));
     }
 }
 
@@ -121,6 +219,8 @@ void InputSystem::Initialize(GLFWwindow* window)
     mCurrMouseX = mPrevMouseX = static_cast<int>(xpos);
     mCurrMouseY = mPrevMouseY = static_cast<int>(ypos);
 
+    mPendingEvents.reserve(EventCapacity);
+    mEvents.reserve(EventCapacity);
     mInitialized = true;
 }
 
@@ -135,12 +235,27 @@ void InputSystem::Terminate()
         glfwSetCursorPosCallback(mWindow, nullptr);
     }
 
+    StopRecording();
+    StopReplay();
     mWindow = nullptr;
     mInitialized = false;
 }
 
 void InputSystem::Update()
 {
+    mUpdateTimeUs = GetTimeUs();
+    mEvents.clear();
+    if (mReplayFile != nullptr)
+    {
+        ReadReplayFrame();
+    }
+    else
+    {
+        std::swap(mEvents, mPendingEvents);
+    }
+    mPendingEvents.clear();
+    sEventCount.Add(static_cast<int64_t>(mEvents.size()));
+
     // Update previous state
     std::memcpy(mPrevKeys, mCurrKeys, sizeof(mCurrKeys));
     std::memcpy(mPrevMouseButtons, mCurrMouseButtons, sizeof(mCurrMouseButtons));
@@ -157,6 +272,24 @@ void InputSystem::Update()
         mPressedMouseButtons[i] = !mPrevMouseButtons[i] && mCurrMouseButtons[i];
     }
 
+    // Presses released within the frame only show up as events
+    mMouseWheel = 0.0f;
+    for (const InputEvent& event : mEvents)
+    {
+        if (event.type == InputEventType::KeyDown)
+        {
+            mPressedKeys[event.code] = true;
+        }
+        else if (event.type == InputEventType::MouseDown)
+        {
+            mPressedMouseButtons[event.code] = true;
+        }
+        else if (event.type == InputEventType::MouseWheel)
+        {
+            mMouseWheel += event.y;
+        }
+    }
+
     // Calculate mouse movement
     mMouseMoveX = mCurrMouseX - mPrevMouseX;
     mMouseMoveY = mCurrMouseY - mPrevMouseY;
@@ -175,9 +308,259 @@ void InputSystem::Update()
         mMouseTopEdge = (mCurrMouseY < edgeThreshold);
         mMouseBottomEdge = (mCurrMouseY > windowHeight - edgeThreshold);
     }
+}
 
-    // Reset mouse wheel after processing
-    mMouseWheel = 0.0f;
+const std::vector<InputEvent>& InputSystem::GetEvents() const
+{
+    return mEvents;
+}
+
+void InputSystem::LatchMouse(int& moveX, int& moveY)
+{
+    moveX = 0;
+    moveY = 0;
+    int x = mReplayMouseX;
+    int y = mReplayMouseY;
+    if (mReplayFile == nullptr)
+    {
+        if (mWindow == nullptr)
+        {
+            return;
+        }
+        double xpos, ypos;
+        glfwGetCursorPos(mWindow, &xpos, &ypos);
+        x = static_cast<int>(xpos);
+        y = static_cast<int>(ypos);
+    }
+    moveX = x - mPrevMouseX;
+    moveY = y - mPrevMouseY;
+    mCurrMouseX = mPrevMouseX = x;
+    mCurrMouseY = mPrevMouseY = y;
+    sLateLatch.Set(GetTimeUs() - mUpdateTimeUs);
+}
+
+void InputSystem::OnFramePresented()
+{
+    if (!mEvents.empty())
+    {
+        sLatency.Set(GetTimeUs() - mEvents.front().timeUs);
+    }
+
+    if (mRecordFile != nullptr)
+    {
+        Write(mRecordFile, mFrameDeltaTime);
+        Write(mRecordFile, static_cast<int32_t>(mCurrMouseX));
+        Write(mRecordFile, static_cast<int32_t>(mCurrMouseY));
+        Write(mRecordFile, static_cast<uint16_t>(mEvents.size()));
+        for (const InputEvent& event : mEvents)
+        {
+            WriteEvent(mRecordFile, event, mUpdateTimeUs);
+        }
+    }
+}
+
+float InputSystem::GetFrameDeltaTime(float deltaTime)
+{
+    if (mReplayFile == nullptr)
+    {
+        mFrameDeltaTime = deltaTime;
+    }
+    return mFrameDeltaTime;
+}
+
+bool InputSystem::StartRecording(const std::filesystem::path& filePath)
+{
+    StopRecording();
+    mRecordFile = fopen(filePath.u8string().c_str(), "wb");
+    if (mRecordFile == nullptr)
+    {
+        LOG_WARNING(Input, "InputSystem: Failed to open %s", filePath.u8string().c_str());
+        return false;
+    }
+
+    // Keys and buttons already held are written as presses
+    std::vector<InputEvent> heldEvents;
+    for (uint32_t i = 0; i < 512; ++i)
+    {
+        if (mCurrKeys[i])
+        {
+            heldEvents.push_back({mUpdateTimeUs, InputEventType::KeyDown, i});
+        }
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        if (mCurrMouseButtons[i])
+        {
+            heldEvents.push_back({mUpdateTimeUs, InputEventType::MouseDown, i});
+        }
+    }
+
+    Write(mRecordFile, RecordingMagic);
+    Write(mRecordFile, RecordingVersion);
+    Write(mRecordFile, static_cast<int32_t>(mCurrMouseX));
+    Write(mRecordFile, static_cast<int32_t>(mCurrMouseY));
+    Write(mRecordFile, static_cast<uint16_t>(heldEvents.size()));
+    for (const InputEvent& event : heldEvents)
+    {
+        WriteEvent(mRecordFile, event, mUpdateTimeUs);
+    }
+    LOG_INFO(Input, "InputSystem: Recording to %s", filePath.u8string().c_str());
+    return true;
+}
+
+void InputSystem::StopRecording()
+{
+    if (mRecordFile != nullptr)
+    {
+        fclose(mRecordFile);
+        mRecordFile = nullptr;
+    }
+}
+
+bool InputSystem::IsRecording() const
+{
+    return mRecordFile != nullptr;
+}
+
+bool InputSystem::StartReplay(const std::filesystem::path& filePath)
+{
+    StopReplay();
+    mReplayFile = fopen(filePath.u8string().c_str(), "rb");
+    if (mReplayFile == nullptr)
+    {
+        LOG_WARNING(Input, "InputSystem: Failed to open %s", filePath.u8string().c_str());
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    int32_t mouseX = 0;
+    int32_t mouseY = 0;
+    uint16_t heldCount = 0;
+    bool isValid = Read(mReplayFile, magic) && Read(mReplayFile, version) &&
+                   Read(mReplayFile, mouseX) && Read(mReplayFile, mouseY) &&
+                   Read(mReplayFile, heldCount);
+    isValid = isValid && magic == RecordingMagic && version == RecordingVersion;
+
+    // The window's state is dropped, the replay starts from the recorded one
+    std::memset(mCurrKeys, 0, sizeof(mCurrKeys));
+    std::memset(mCurrMouseButtons, 0, sizeof(mCurrMouseButtons));
+    mCurrMouseX = mPrevMouseX = mReplayMouseX = mouseX;
+    mCurrMouseY = mPrevMouseY = mReplayMouseY = mouseY;
+    mPendingEvents.clear();
+    for (uint16_t i = 0; i < heldCount && isValid; ++i)
+    {
+        InputEvent event;
+        isValid = ReadEvent(mReplayFile, event, mUpdateTimeUs);
+        if (isValid)
+        {
+            ApplyEvent(event);
+        }
+    }
+
+    if (!isValid)
+    {
+        LOG_WARNING(
+            Input, "InputSystem: %s is not an input recording", filePath.u8string().c_str());
+        StopReplay();
+        return false;
+    }
+    LOG_INFO(Input, "InputSystem: Replaying %s", filePath.u8string().c_str());
+    return true;
+}
+
+void InputSystem::StopReplay()
+{
+    if (mReplayFile != nullptr)
+    {
+        fclose(mReplayFile);
+        mReplayFile = nullptr;
+    }
+}
+
+bool InputSystem::IsReplaying() const
+{
+    return mReplayFile != nullptr;
+}
+
+void InputSystem::OnWindowEvent(InputEventType type, uint32_t code, float x, float y)
+{
+    // A replay ignores the window, everything comes from the recording
+    if (mReplayFile != nullptr)
+    {
+        return;
+    }
+
+    const InputEvent event{GetTimeUs(), type, code, x, y};
+    ApplyEvent(event);
+
+    // Past the capacity only the cursor's latest position is worth keeping. Everything else is
+    // appended even if the vector has to grow, a lost release would leave a key held.
+    if (mPendingEvents.size() >= EventCapacity)
+    {
+        if (event.type == InputEventType::MouseMove &&
+            mPendingEvents.back().type == InputEventType::MouseMove)
+        {
+            mPendingEvents.back().x = event.x;
+            mPendingEvents.back().y = event.y;
+            sMergedEvents.Add();
+            return;
+        }
+        sMergedEvents.Add(static_cast<int64_t>(MergeMouseMoves(mPendingEvents)));
+    }
+    mPendingEvents.push_back(event);
+}
+
+// Wheel offsets are summed per frame by Update
+void InputSystem::ApplyEvent(const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case InputEventType::KeyDown:
+    case InputEventType::KeyUp:
+        mCurrKeys[event.code] = (event.type == InputEventType::KeyDown);
+        break;
+    case InputEventType::MouseDown:
+    case InputEventType::MouseUp:
+        mCurrMouseButtons[event.code] = (event.type == InputEventType::MouseDown);
+        break;
+    case InputEventType::MouseMove:
+        mCurrMouseX = static_cast<int>(event.x);
+        mCurrMouseY = static_cast<int>(event.y);
+        break;
+    default:
+        break;
+    }
+}
+
+// Ends the replay when the file runs out
+void InputSystem::ReadReplayFrame()
+{
+    int32_t mouseX = 0;
+    int32_t mouseY = 0;
+    uint16_t eventCount = 0;
+    if (!Read(mReplayFile, mFrameDeltaTime) || !Read(mReplayFile, mouseX) ||
+        !Read(mReplayFile, mouseY) || !Read(mReplayFile, eventCount))
+    {
+        LOG_INFO(Input, "InputSystem: Replay finished");
+        StopReplay();
+        return;
+    }
+
+    mReplayMouseX = mouseX;
+    mReplayMouseY = mouseY;
+    for (uint16_t i = 0; i < eventCount; ++i)
+    {
+        InputEvent event;
+        if (!ReadEvent(mReplayFile, event, mUpdateTimeUs))
+        {
+            LOG_WARNING(Input, "InputSystem: Replay is truncated");
+            StopReplay();
+            return;
+        }
+        ApplyEvent(event);
+        mEvents.push_back(event);
+    }
 }
 
 bool InputSystem::IsKeyDown(KeyCode key) const
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace Engine::Math
+{
+struct AABB
+{
+    // Default box is inverted so growing it by any point or box yields that point or box
+    Vector3 min = Vector3(std::numeric_limits<float>::max());
+    Vector3 max = Vector3(-std::numeric_limits<float>::max());
+
+    constexpr AABB() noexcept = default;
+    constexpr AABB(const Vector3& min, const Vector3& max) noexcept
+        : min(min),
+          max(max)
+    {
+    }
+};
+} // namespace Engine::Math
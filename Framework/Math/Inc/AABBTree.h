@@ -0,0 +1,200 @@
+#pragma once
+
+#include "DWMath.h"
+
+namespace Engine::Math
+{
+// Dynamic bounding volume tree for broadphase queries. Each proxy stores a fat AABB, enlarged by a
+// margin and the predicted movement, so small moves do not touch the tree. Reinsertion picks the
+// cheapest sibling by surface area and keeps the tree balanced with AVL style rotations.
+class AABBTree
+{
+  public:
+    static constexpr int NullNode = -1;
+
+    int CreateProxy(const AABB& aabb, void* userData);
+    void DestroyProxy(int proxyId);
+
+    // Returns true when the proxy left its fat AABB and was reinserted
+    bool MoveProxy(int proxyId, const AABB& aabb, const Vector3& displacement);
+
+    void* GetUserData(int proxyId) const;
+    const AABB& GetFatAABB(int proxyId) const;
+    bool WasMoved(int proxyId) const;
+
+    // Callback is bool(int proxyId), return false to stop the query
+    template <class Callback> void Query(const AABB& aabb, Callback&& callback) const;
+    template <class Callback> void Query(const Frustum& frustum, Callback&& callback) const;
+
+    // Callback is float(int proxyId, float maxDistance). Return the hit distance to clip the ray,
+    // maxDistance to ignore the proxy, or 0 to stop
+    template <class Callback>
+    void Raycast(const Ray& ray, float maxDistance, Callback&& callback) const;
+
+    // Appends every overlapping pair where at least one proxy moved since the last call
+    void UpdatePairs(std::vector<std::pair<int, int>>& pairs);
+
+    void SetMargin(float margin);
+    void SetDisplacementMultiplier(float multiplier);
+
+    int GetProxyCount() const;
+    int GetHeight() const;
+    float GetAreaRatio() const; // Total node area / root area, lower is a better tree
+
+  private:
+    struct Node
+    {
+        AABB aabb;
+        void* userData = nullptr;
+        int parent = NullNode; // Next free node while on the free list
+        int child1 = NullNode;
+        int child2 = NullNode;
+        int height = -1; // 0 for leaves, -1 when free
+        bool moved = false;
+
+        bool IsLeaf() const
+        {
+            return child1 == NullNode;
+        }
+    };
+
+    static constexpr int StackSize = 256;
+
+    int AllocateNode();
+    void FreeNode(int nodeId);
+
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int nodeId);
+
+    std::vector<Node> mNodes;
+    std::vector<int> mMoveBuffer;
+    int mRoot = NullNode;
+    int mFreeList = NullNode;
+    int mProxyCount = 0;
+
+    float mMargin = 0.1f;
+    float mDisplacementMultiplier = 4.0f;
+};
+
+template <class Callback> void AABBTree::Query(const AABB& aabb, Callback&& callback) const
+{
+    int stack[StackSize];
+    int stackSize = 0;
+    stack[stackSize++] = mRoot;
+    while (stackSize > 0)
+    {
+        const int nodeId = stack[--stackSize];
+        if (nodeId == NullNode)
+        {
+            continue;
+        }
+
+        const Node& node = mNodes[nodeId];
+        if (!Overlaps(node.aabb, aabb))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(nodeId))
+            {
+                return;
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+    }
+}
+
+template <class Callback> void AABBTree::Query(const Frustum& frustum, Callback&& callback) const
+{
+    // Nodes fully inside the frustum report their whole subtree without further plane tests
+    struct Entry
+    {
+        int nodeId;
+        bool inside;
+    };
+
+    Entry stack[StackSize];
+    int stackSize = 0;
+    stack[stackSize++] = {mRoot, false};
+    while (stackSize > 0)
+    {
+        const Entry entry = stack[--stackSize];
+        if (entry.nodeId == NullNode)
+        {
+            continue;
+        }
+
+        const Node& node = mNodes[entry.nodeId];
+        bool inside = entry.inside;
+        if (!inside)
+        {
+            const FrustumTest result = TestAABB(frustum, node.aabb);
+            if (result == FrustumTest::Outside)
+            {
+                continue;
+            }
+            inside = result == FrustumTest::Inside;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(entry.nodeId))
+            {
+                return;
+            }
+        }
+        else
+        {
+            stack[stackSize++] = {node.child1, inside};
+            stack[stackSize++] = {node.child2, inside};
+        }
+    }
+}
+
+template <class Callback>
+void AABBTree::Raycast(const Ray& ray, float maxDistance, Callback&& callback) const
+{
+    const Vector3 invDirection = {1.0f / ray.direction.x,
+                                  1.0f / ray.direction.y,
+                                  1.0f / ray.direction.z};
+    int stack[StackSize];
+    int stackSize = 0;
+    stack[stackSize++] = mRoot;
+    while (stackSize > 0)
+    {
+        const int nodeId = stack[--stackSize];
+        if (nodeId == NullNode)
+        {
+            continue;
+        }
+
+        const Node& node = mNodes[nodeId];
+        if (Intersect(ray, invDirection, node.aabb, maxDistance) < 0.0f)
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            const float distance = callback(nodeId, maxDistance);
+            if (distance <= 0.0f)
+            {
+                return;
+            }
+            maxDistance = Min(maxDistance, distance);
+        }
+        else
+        {
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+    }
+}
+} // namespace Engine::Math
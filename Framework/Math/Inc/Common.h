@@ -3,5 +3,17 @@
 #include <Core/Inc/Core.h>
 
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <random>
+
+// SSE is baseline on every x86/x64 target we build for, other targets use the scalar paths
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MATH_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Wider paths are only taken when the compiler targets AVX (/arch:AVX or -mavx)
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
@@ -8,6 +8,11 @@
 #include "Vector4.h"
 #include "Quaternion.h"
 #include "Matrix4.h"
+#include "Plane.h"
+#include "Frustum.h"
+#include "AABB.h"
+#include "Ray.h"
+#include "MatrixBatch.h"
 
 namespace Engine::Math
 {
@@ -31,6 +36,16 @@ template <class T> constexpr T Lerp(T a, T b, float t)
     return a + ((b - a) * t);
 }
 
+// Uniform Catmull-Rom spline between p1 (t = 0) and p2 (t = 1), p0 and p3 shape the tangents
+template <class T> constexpr T CatmullRom(T p0, T p1, T p2, T p3, float t)
+{
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    return (p1 * 2.0f + (p2 - p0) * t + (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * t2 +
+            (p1 * 3.0f - p0 - p2 * 3.0f + p3) * t3) *
+           0.5f;
+}
+
 template <class T> constexpr T Abs(T value)
 {
     return value >= 0 ? value : -value;
@@ -150,6 +165,26 @@ inline Matrix4 Matrix4::RotationAxis(const Vector3& axis, float rad)
             1.0f};
 }
 
+inline Quaternion Quaternion::Multiply(const Quaternion& a, const Quaternion& b)
+{
+    return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+}
+
+inline Quaternion Quaternion::Nlerp(const Quaternion& q0, const Quaternion& q1, float t)
+{
+    const float sign = (q0.Dot(q1) < 0.0f) ? -1.0f : 1.0f;
+    const Quaternion q(q0.x + (q1.x * sign - q0.x) * t,
+                       q0.y + (q1.y * sign - q0.y) * t,
+                       q0.z + (q1.z * sign - q0.z) * t,
+                       q0.w + (q1.w * sign - q0.w) * t);
+    const float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    const float invLength = (length > 0.0f) ? 1.0f / length : 0.0f;
+    return q * invLength;
+}
+
 inline float Determinant(const Matrix4& m)
 {
     float det = 0.0f;
@@ -253,4 +288,195 @@ inline Vector3 GetScale(const Matrix4& m)
 {
     return {m._11, m._22, m._33};
 }
+
+inline float DistanceToPlane(const Plane& plane, const Vector3& point)
+{
+    return Dot(plane.normal, point) + plane.distance;
+}
+
+inline Plane Normalize(const Plane& plane)
+{
+    const float invMag = 1.0f / Magnitude(plane.normal);
+    return {plane.normal * invMag, plane.distance * invMag};
+}
+
+// Extracts the clip planes of a (world *) view * projection matrix. Plane normals point inwards and
+// are expressed in whatever space the matrix transforms from, so passing world * view * proj gives
+// a frustum in model space.
+inline Frustum ExtractFrustum(const Matrix4& m)
+{
+    Frustum frustum;
+    frustum.planes[Frustum::Left] =
+        Normalize(Plane(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41));
+    frustum.planes[Frustum::Right] =
+        Normalize(Plane(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41));
+    frustum.planes[Frustum::Bottom] =
+        Normalize(Plane(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42));
+    frustum.planes[Frustum::Top] =
+        Normalize(Plane(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42));
+    frustum.planes[Frustum::Near] = Normalize(Plane(m._13, m._23, m._33, m._43));
+    frustum.planes[Frustum::Far] =
+        Normalize(Plane(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43));
+    return frustum;
+}
+
+inline bool IsSphereInFrustum(const Frustum& frustum, const Vector3& center, float radius)
+{
+    for (const Plane& plane : frustum.planes)
+    {
+        if (DistanceToPlane(plane, center) < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline Vector3 Min(const Vector3& a, const Vector3& b)
+{
+    return {Min(a.x, b.x), Min(a.y, b.y), Min(a.z, b.z)};
+}
+
+inline Vector3 Max(const Vector3& a, const Vector3& b)
+{
+    return {Max(a.x, b.x), Max(a.y, b.y), Max(a.z, b.z)};
+}
+
+inline AABB Union(const AABB& a, const AABB& b)
+{
+    return {Min(a.min, b.min), Max(a.max, b.max)};
+}
+
+inline AABB Union(const AABB& box, const Vector3& point)
+{
+    return {Min(box.min, point), Max(box.max, point)};
+}
+
+inline Vector3 GetCenter(const AABB& box)
+{
+    return (box.min + box.max) * 0.5f;
+}
+
+inline Vector3 GetExtents(const AABB& box)
+{
+    return (box.max - box.min) * 0.5f;
+}
+
+inline float SurfaceArea(const AABB& box)
+{
+    const Vector3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+inline bool Contains(const AABB& outer, const AABB& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+           outer.min.z <= inner.min.z && outer.max.x >= inner.max.x &&
+           outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+inline bool Overlaps(const AABB& a, const AABB& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y &&
+           a.max.y >= b.min.y && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+enum class FrustumTest
+{
+    Outside,
+    Intersects,
+    Inside
+};
+
+// Tests the box corner furthest along and the corner furthest against each plane normal
+inline FrustumTest TestAABB(const Frustum& frustum, const AABB& box)
+{
+    FrustumTest result = FrustumTest::Inside;
+    for (const Plane& plane : frustum.planes)
+    {
+        const Vector3 positive = {plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                                  plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                                  plane.normal.z >= 0.0f ? box.max.z : box.min.z};
+        if (DistanceToPlane(plane, positive) < 0.0f)
+        {
+            return FrustumTest::Outside;
+        }
+
+        const Vector3 negative = {plane.normal.x >= 0.0f ? box.min.x : box.max.x,
+                                  plane.normal.y >= 0.0f ? box.min.y : box.max.y,
+                                  plane.normal.z >= 0.0f ? box.min.z : box.max.z};
+        if (DistanceToPlane(plane, negative) < 0.0f)
+        {
+            result = FrustumTest::Intersects;
+        }
+    }
+    return result;
+}
+
+inline Vector3 GetPoint(const Ray& ray, float distance)
+{
+    return ray.origin + ray.direction * distance;
+}
+
+// Slab test. invDirection is 1 / ray.direction, precomputed since it is shared by every box a ray
+// visits. Returns the entry distance, or a negative value on a miss.
+inline float Intersect(const Ray& ray,
+                       const Vector3& invDirection,
+                       const AABB& box,
+                       float maxDistance)
+{
+    const float tx0 = (box.min.x - ray.origin.x) * invDirection.x;
+    const float tx1 = (box.max.x - ray.origin.x) * invDirection.x;
+    const float ty0 = (box.min.y - ray.origin.y) * invDirection.y;
+    const float ty1 = (box.max.y - ray.origin.y) * invDirection.y;
+    const float tz0 = (box.min.z - ray.origin.z) * invDirection.z;
+    const float tz1 = (box.max.z - ray.origin.z) * invDirection.z;
+
+    const float tNear = Max(Max(Min(tx0, tx1), Min(ty0, ty1)), Max(Min(tz0, tz1), 0.0f));
+    const float tFar = Min(Min(Max(tx0, tx1), Max(ty0, ty1)), Min(Max(tz0, tz1), maxDistance));
+    return tNear <= tFar ? tNear : -1.0f;
+}
+
+// Moller-Trumbore, two sided. On a hit, distance is along the ray and u/v are the barycentric
+// weights of b and c.
+inline bool Intersect(const Ray& ray,
+                      const Vector3& a,
+                      const Vector3& b,
+                      const Vector3& c,
+                      float& distance,
+                      float& u,
+                      float& v)
+{
+    constexpr float epsilon = 1e-8f;
+
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 p = Cross(ray.direction, ac);
+    const float det = Dot(ab, p);
+    if (det > -epsilon && det < epsilon)
+    {
+        return false;
+    }
+
+    const float invDet = 1.0f / det;
+    const Vector3 s = ray.origin - a;
+    u = Dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+
+    const Vector3 q = Cross(s, ab);
+    v = Dot(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return false;
+    }
+
+    distance = Dot(ac, q) * invDet;
+    return distance >= 0.0f;
+}
 } // namespace Engine::Math
+
+// Spatial structures built on the helpers above
+#include "AABBTree.h"
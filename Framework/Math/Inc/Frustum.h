@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Engine::Math
+{
+struct Frustum
+{
+    enum Side
+    {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count
+    };
+
+    std::array<Plane, Side::Count> planes;
+};
+} // namespace Engine::Math
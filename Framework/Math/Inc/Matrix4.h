@@ -185,6 +185,34 @@ struct Matrix4
                        1.0f);
     }
 
+    // Same result as Scaling(scale) * MatrixRotationQuaternion(rotation) * Translation(position)
+    // without the two matrix multiplies
+    static Matrix4 Transformation(const Vector3& position,
+                                  const Math::Quaternion& rotation,
+                                  const Vector3& scale)
+    {
+        const Matrix4 r = MatrixRotationQuaternion(rotation);
+        return Matrix4(r._11 * scale.x,
+                       r._12 * scale.x,
+                       r._13 * scale.x,
+                       0.0f,
+
+                       r._21 * scale.y,
+                       r._22 * scale.y,
+                       r._23 * scale.y,
+                       0.0f,
+
+                       r._31 * scale.z,
+                       r._32 * scale.z,
+                       r._33 * scale.z,
+                       0.0f,
+
+                       position.x,
+                       position.y,
+                       position.z,
+                       1.0f);
+    }
+
     static Matrix4 Scaling(float s)
     {
         return Matrix4(
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace Engine::Math
+{
+// Structure of arrays view over a batch of position/rotation/scale transforms
+struct TransformStreams
+{
+    const float* positionX = nullptr;
+    const float* positionY = nullptr;
+    const float* positionZ = nullptr;
+    const float* rotationX = nullptr;
+    const float* rotationY = nullptr;
+    const float* rotationZ = nullptr;
+    const float* rotationW = nullptr;
+    const float* scaleX = nullptr;
+    const float* scaleY = nullptr;
+    const float* scaleZ = nullptr;
+};
+
+// Batched Matrix4::Transformation, four transforms per iteration with SSE
+void ComposeTransformations(const TransformStreams& transforms,
+                            uint32_t count,
+                            Matrix4* outMatrices);
+
+// Inverse transpose of the upper 3x3 of each matrix, for transforming normals. The translation of
+// the output is cleared.
+void ComputeNormalMatrices(const Matrix4* matrices, uint32_t count, Matrix4* outMatrices);
+
+Matrix4 ComputeNormalMatrix(const Matrix4& m);
+
+// Normalized lerp along the shortest arc for each pair, four pairs per iteration with SSE.
+// outRotations may alias either input.
+void NlerpQuaternions(const Quaternion* from,
+                      const Quaternion* to,
+                      float t,
+                      uint32_t count,
+                      Quaternion* outRotations);
+
+// out = a + (b - a) * t over plain float arrays, out may alias either input
+void LerpFloats(const float* a, const float* b, float t, uint32_t count, float* out);
+} // namespace Engine::Math
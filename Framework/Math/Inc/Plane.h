@@ -0,0 +1,22 @@
+#pragma once
+
+namespace Engine::Math
+{
+struct Plane
+{
+    Vector3 normal = {0.0f, 1.0f, 0.0f};
+    float distance = 0.0f;
+
+    constexpr Plane() noexcept = default;
+    constexpr Plane(const Vector3& n, float d) noexcept
+        : normal(n),
+          distance(d)
+    {
+    }
+    constexpr Plane(float a, float b, float c, float d) noexcept
+        : normal(a, b, c),
+          distance(d)
+    {
+    }
+};
+} // namespace Engine::Math
@@ -68,7 +68,12 @@ struct Quaternion
     static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll) noexcept;
     static Quaternion CreateFromRotationMatrix(const Matrix4& m) noexcept;
 
+    // Rotates by b, then by a
+    static Quaternion Multiply(const Quaternion& a, const Quaternion& b);
+
     static Quaternion Lerp(const Quaternion& q0, const Quaternion& q1, float t);
+    // Normalized lerp along the shorter arc, inline for the per bone blending loops
+    static Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
     static Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
 };
 } // namespace Engine::Math
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace Engine::Math
+{
+struct Ray
+{
+    Vector3 origin = {0.0f, 0.0f, 0.0f};
+    Vector3 direction = {0.0f, 0.0f, 1.0f};
+
+    constexpr Ray() noexcept = default;
+    constexpr Ray(const Vector3& origin, const Vector3& direction) noexcept
+        : origin(origin),
+          direction(direction)
+    {
+    }
+};
+} // namespace Engine::Math
@@ -0,0 +1,433 @@
+#include "Precompiled.h"
+#include "AABBTree.h"
+
+using namespace Engine;
+using namespace Engine::Math;
+
+namespace
+{
+AABB Fatten(const AABB& aabb, float margin)
+{
+    const Vector3 r(margin);
+    return {aabb.min - r, aabb.max + r};
+}
+} // namespace
+
+int AABBTree::CreateProxy(const AABB& aabb, void* userData)
+{
+    const int proxyId = AllocateNode();
+    Node& node = mNodes[proxyId];
+    node.aabb = Fatten(aabb, mMargin);
+    node.userData = userData;
+    node.height = 0;
+    node.moved = true;
+    InsertLeaf(proxyId);
+
+    mMoveBuffer.push_back(proxyId);
+    ++mProxyCount;
+    return proxyId;
+}
+
+void AABBTree::DestroyProxy(int proxyId)
+{
+    ASSERT(proxyId >= 0 && proxyId < static_cast<int>(mNodes.size()), "AABBTree: invalid proxy");
+    ASSERT(mNodes[proxyId].IsLeaf(), "AABBTree: proxy is not a leaf");
+
+    if (mNodes[proxyId].moved)
+    {
+        std::replace(mMoveBuffer.begin(), mMoveBuffer.end(), proxyId, NullNode);
+    }
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --mProxyCount;
+}
+
+bool AABBTree::MoveProxy(int proxyId, const AABB& aabb, const Vector3& displacement)
+{
+    ASSERT(proxyId >= 0 && proxyId < static_cast<int>(mNodes.size()), "AABBTree: invalid proxy");
+    ASSERT(mNodes[proxyId].IsLeaf(), "AABBTree: proxy is not a leaf");
+
+    // Extend the fat AABB in the direction of travel so the next few moves stay inside it
+    AABB fatAABB = Fatten(aabb, mMargin);
+    const Vector3 d = displacement * mDisplacementMultiplier;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (d.v[axis] < 0.0f)
+        {
+            fatAABB.min.v[axis] += d.v[axis];
+        }
+        else
+        {
+            fatAABB.max.v[axis] += d.v[axis];
+        }
+    }
+
+    // Also reinsert when the old fat AABB is far larger than needed, e.g. after a fast mover stops
+    const AABB& treeAABB = mNodes[proxyId].aabb;
+    if (Contains(treeAABB, aabb))
+    {
+        const AABB hugeAABB = Fatten(fatAABB, 4.0f * mMargin);
+        if (Contains(hugeAABB, treeAABB))
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxyId);
+    mNodes[proxyId].aabb = fatAABB;
+    InsertLeaf(proxyId);
+
+    if (!mNodes[proxyId].moved)
+    {
+        mNodes[proxyId].moved = true;
+        mMoveBuffer.push_back(proxyId);
+    }
+    return true;
+}
+
+void* AABBTree::GetUserData(int proxyId) const
+{
+    return mNodes[proxyId].userData;
+}
+
+const AABB& AABBTree::GetFatAABB(int proxyId) const
+{
+    return mNodes[proxyId].aabb;
+}
+
+bool AABBTree::WasMoved(int proxyId) const
+{
+    return mNodes[proxyId].moved;
+}
+
+void AABBTree::UpdatePairs(std::vector<std::pair<int, int>>& pairs)
+{
+    for (const int queryProxyId : mMoveBuffer)
+    {
+        if (queryProxyId == NullNode)
+        {
+            continue;
+        }
+
+        Query(mNodes[queryProxyId].aabb,
+              [&](int proxyId)
+              {
+                  // When both proxies moved, only the query of the higher id reports the pair
+                  if (proxyId == queryProxyId ||
+                      (mNodes[proxyId].moved && proxyId > queryProxyId))
+                  {
+                      return true;
+                  }
+                  pairs.push_back({Min(proxyId, queryProxyId), Max(proxyId, queryProxyId)});
+                  return true;
+              });
+    }
+
+    for (const int proxyId : mMoveBuffer)
+    {
+        if (proxyId != NullNode)
+        {
+            mNodes[proxyId].moved = false;
+        }
+    }
+    mMoveBuffer.clear();
+}
+
+void AABBTree::SetMargin(float margin)
+{
+    mMargin = margin;
+}
+
+void AABBTree::SetDisplacementMultiplier(float multiplier)
+{
+    mDisplacementMultiplier = multiplier;
+}
+
+int AABBTree::GetProxyCount() const
+{
+    return mProxyCount;
+}
+
+int AABBTree::GetHeight() const
+{
+    return (mRoot == NullNode) ? 0 : mNodes[mRoot].height;
+}
+
+float AABBTree::GetAreaRatio() const
+{
+    if (mRoot == NullNode)
+    {
+        return 0.0f;
+    }
+
+    float totalArea = 0.0f;
+    for (const Node& node : mNodes)
+    {
+        if (node.height >= 0)
+        {
+            totalArea += SurfaceArea(node.aabb);
+        }
+    }
+    return totalArea / SurfaceArea(mNodes[mRoot].aabb);
+}
+
+int AABBTree::AllocateNode()
+{
+    if (mFreeList == NullNode)
+    {
+        mNodes.emplace_back();
+        return static_cast<int>(mNodes.size()) - 1;
+    }
+
+    const int nodeId = mFreeList;
+    mFreeList = mNodes[nodeId].parent;
+    mNodes[nodeId] = Node();
+    return nodeId;
+}
+
+void AABBTree::FreeNode(int nodeId)
+{
+    mNodes[nodeId].parent = mFreeList;
+    mNodes[nodeId].height = -1;
+    mFreeList = nodeId;
+}
+
+void AABBTree::InsertLeaf(int leaf)
+{
+    if (mRoot == NullNode)
+    {
+        mRoot = leaf;
+        mNodes[leaf].parent = NullNode;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest surface area cost
+    const AABB leafAABB = mNodes[leaf].aabb;
+    int index = mRoot;
+    while (!mNodes[index].IsLeaf())
+    {
+        const Node& node = mNodes[index];
+        const float area = SurfaceArea(node.aabb);
+        const float combinedArea = SurfaceArea(Union(node.aabb, leafAABB));
+
+        // Cost of making a new parent for this node and the leaf
+        const float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int childId)
+        {
+            const Node& child = mNodes[childId];
+            const float childArea = SurfaceArea(Union(leafAABB, child.aabb));
+            return child.IsLeaf() ? childArea + inheritanceCost
+                                  : childArea - SurfaceArea(child.aabb) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+
+    const int sibling = index;
+    const int oldParent = mNodes[sibling].parent;
+    const int newParent = AllocateNode();
+    mNodes[newParent].parent = oldParent;
+    mNodes[newParent].aabb = Union(leafAABB, mNodes[sibling].aabb);
+    mNodes[newParent].height = mNodes[sibling].height + 1;
+    mNodes[newParent].child1 = sibling;
+    mNodes[newParent].child2 = leaf;
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode)
+    {
+        if (mNodes[oldParent].child1 == sibling)
+        {
+            mNodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            mNodes[oldParent].child2 = newParent;
+        }
+    }
+    else
+    {
+        mRoot = newParent;
+    }
+
+    // Refit and rebalance the ancestors
+    index = mNodes[leaf].parent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        Node& node = mNodes[index];
+        const Node& child1 = mNodes[node.child1];
+        const Node& child2 = mNodes[node.child2];
+        node.height = 1 + Max(child1.height, child2.height);
+        node.aabb = Union(child1.aabb, child2.aabb);
+
+        index = node.parent;
+    }
+}
+
+void AABBTree::RemoveLeaf(int leaf)
+{
+    if (leaf == mRoot)
+    {
+        mRoot = NullNode;
+        return;
+    }
+
+    const int parent = mNodes[leaf].parent;
+    const int grandParent = mNodes[parent].parent;
+    const int sibling =
+        (mNodes[parent].child1 == leaf) ? mNodes[parent].child2 : mNodes[parent].child1;
+
+    if (grandParent == NullNode)
+    {
+        mRoot = sibling;
+        mNodes[sibling].parent = NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // Replace the parent with the sibling
+    if (mNodes[grandParent].child1 == parent)
+    {
+        mNodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        mNodes[grandParent].child2 = sibling;
+    }
+    mNodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        Node& node = mNodes[index];
+        const Node& child1 = mNodes[node.child1];
+        const Node& child2 = mNodes[node.child2];
+        node.aabb = Union(child1.aabb, child2.aabb);
+        node.height = 1 + Max(child1.height, child2.height);
+
+        index = node.parent;
+    }
+}
+
+// Rotates the taller grandchild subtree up when the children of iA differ in height by more than
+// one. Returns the node now at iA's position.
+int AABBTree::Balance(int iA)
+{
+    Node& A = mNodes[iA];
+    if (A.IsLeaf() || A.height < 2)
+    {
+        return iA;
+    }
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    Node& B = mNodes[iB];
+    Node& C = mNodes[iC];
+    const int balance = C.height - B.height;
+
+    auto replaceInParent = [&](int oldChild, int newChild, int parent)
+    {
+        if (parent == NullNode)
+        {
+            mRoot = newChild;
+        }
+        else if (mNodes[parent].child1 == oldChild)
+        {
+            mNodes[parent].child1 = newChild;
+        }
+        else
+        {
+            mNodes[parent].child2 = newChild;
+        }
+    };
+
+    // Rotate C up
+    if (balance > 1)
+    {
+        const int iF = C.child1;
+        const int iG = C.child2;
+        Node& F = mNodes[iF];
+        Node& G = mNodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        replaceInParent(iA, iC, C.parent);
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = Union(B.aabb, G.aabb);
+            C.aabb = Union(A.aabb, F.aabb);
+            A.height = 1 + Max(B.height, G.height);
+            C.height = 1 + Max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = Union(B.aabb, F.aabb);
+            C.aabb = Union(A.aabb, G.aabb);
+            A.height = 1 + Max(B.height, F.height);
+            C.height = 1 + Max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1)
+    {
+        const int iD = B.child1;
+        const int iE = B.child2;
+        Node& D = mNodes[iD];
+        Node& E = mNodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        replaceInParent(iA, iB, B.parent);
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = Union(C.aabb, E.aabb);
+            B.aabb = Union(A.aabb, D.aabb);
+            A.height = 1 + Max(C.height, E.height);
+            B.height = 1 + Max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = Union(C.aabb, D.aabb);
+            B.aabb = Union(A.aabb, E.aabb);
+            A.height = 1 + Max(C.height, D.height);
+            B.height = 1 + Max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
@@ -0,0 +1,324 @@
+#include "Precompiled.h"
+#include "DWMath.h"
+
+using namespace Engine;
+using namespace Engine::Math;
+
+namespace
+{
+Matrix4 ComposeTransformation(const TransformStreams& t, uint32_t i)
+{
+    return Matrix4::Transformation(
+        {t.positionX[i], t.positionY[i], t.positionZ[i]},
+        {t.rotationX[i], t.rotationY[i], t.rotationZ[i], t.rotationW[i]},
+        {t.scaleX[i], t.scaleY[i], t.scaleZ[i]});
+}
+} // namespace
+
+Matrix4 Math::ComputeNormalMatrix(const Matrix4& m)
+{
+    // With rows a, b, c the inverse transpose has rows b x c, c x a, a x b over the determinant
+    const Vector3 a(m._11, m._12, m._13);
+    const Vector3 b(m._21, m._22, m._23);
+    const Vector3 c(m._31, m._32, m._33);
+    const Vector3 bc = Cross(b, c);
+    const Vector3 ca = Cross(c, a);
+    const Vector3 ab = Cross(a, b);
+    const float det = Dot(a, bc);
+    const float invDet = (det != 0.0f) ? 1.0f / det : 0.0f;
+    return Matrix4(bc.x * invDet,
+                   bc.y * invDet,
+                   bc.z * invDet,
+                   0.0f,
+                   ca.x * invDet,
+                   ca.y * invDet,
+                   ca.z * invDet,
+                   0.0f,
+                   ab.x * invDet,
+                   ab.y * invDet,
+                   ab.z * invDet,
+                   0.0f,
+                   0.0f,
+                   0.0f,
+                   0.0f,
+                   1.0f);
+}
+
+#ifdef MATH_USE_SSE
+
+void Math::ComposeTransformations(const TransformStreams& t, uint32_t count, Matrix4* outMatrices)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 qx = _mm_loadu_ps(t.rotationX + i);
+        const __m128 qy = _mm_loadu_ps(t.rotationY + i);
+        const __m128 qz = _mm_loadu_ps(t.rotationZ + i);
+        const __m128 qw = _mm_loadu_ps(t.rotationW + i);
+        const __m128 sx = _mm_loadu_ps(t.scaleX + i);
+        const __m128 sy = _mm_loadu_ps(t.scaleY + i);
+        const __m128 sz = _mm_loadu_ps(t.scaleZ + i);
+
+        const __m128 x2 = _mm_mul_ps(qx, two);
+        const __m128 y2 = _mm_mul_ps(qy, two);
+        const __m128 z2 = _mm_mul_ps(qz, two);
+        const __m128 xx = _mm_mul_ps(qx, x2);
+        const __m128 yy = _mm_mul_ps(qy, y2);
+        const __m128 zz = _mm_mul_ps(qz, z2);
+        const __m128 xy = _mm_mul_ps(qx, y2);
+        const __m128 xz = _mm_mul_ps(qx, z2);
+        const __m128 yz = _mm_mul_ps(qy, z2);
+        const __m128 wx = _mm_mul_ps(qw, x2);
+        const __m128 wy = _mm_mul_ps(qw, y2);
+        const __m128 wz = _mm_mul_ps(qw, z2);
+
+        // Rotation rows scaled by their axis scale, one lane per transform
+        __m128 r0x = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+        __m128 r0y = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+        __m128 r0z = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+        __m128 r0w = zero;
+        __m128 r1x = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+        __m128 r1y = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+        __m128 r1z = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+        __m128 r1w = zero;
+        __m128 r2x = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+        __m128 r2y = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+        __m128 r2z = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+        __m128 r2w = zero;
+        __m128 r3x = _mm_loadu_ps(t.positionX + i);
+        __m128 r3y = _mm_loadu_ps(t.positionY + i);
+        __m128 r3z = _mm_loadu_ps(t.positionZ + i);
+        __m128 r3w = one;
+
+        // Back to one matrix per register group
+        _MM_TRANSPOSE4_PS(r0x, r0y, r0z, r0w);
+        _MM_TRANSPOSE4_PS(r1x, r1y, r1z, r1w);
+        _MM_TRANSPOSE4_PS(r2x, r2y, r2z, r2w);
+        _MM_TRANSPOSE4_PS(r3x, r3y, r3z, r3w);
+
+        float* out = &outMatrices[i]._11;
+        _mm_storeu_ps(out + 0, r0x);
+        _mm_storeu_ps(out + 4, r1x);
+        _mm_storeu_ps(out + 8, r2x);
+        _mm_storeu_ps(out + 12, r3x);
+        _mm_storeu_ps(out + 16, r0y);
+        _mm_storeu_ps(out + 20, r1y);
+        _mm_storeu_ps(out + 24, r2y);
+        _mm_storeu_ps(out + 28, r3y);
+        _mm_storeu_ps(out + 32, r0z);
+        _mm_storeu_ps(out + 36, r1z);
+        _mm_storeu_ps(out + 40, r2z);
+        _mm_storeu_ps(out + 44, r3z);
+        _mm_storeu_ps(out + 48, r0w);
+        _mm_storeu_ps(out + 52, r1w);
+        _mm_storeu_ps(out + 56, r2w);
+        _mm_storeu_ps(out + 60, r3w);
+    }
+
+    for (; i < count; ++i)
+    {
+        outMatrices[i] = ComposeTransformation(t, i);
+    }
+}
+
+void Math::ComputeNormalMatrices(const Matrix4* matrices, uint32_t count, Matrix4* outMatrices)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 identityRow3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Load row r of four matrices and transpose, giving one component of that row per lane
+        const float* in = &matrices[i]._11;
+        __m128 ax = _mm_loadu_ps(in + 0);
+        __m128 ay = _mm_loadu_ps(in + 16);
+        __m128 az = _mm_loadu_ps(in + 32);
+        __m128 aw = _mm_loadu_ps(in + 48);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        __m128 bx = _mm_loadu_ps(in + 4);
+        __m128 by = _mm_loadu_ps(in + 20);
+        __m128 bz = _mm_loadu_ps(in + 36);
+        __m128 bw = _mm_loadu_ps(in + 52);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+        __m128 cx = _mm_loadu_ps(in + 8);
+        __m128 cy = _mm_loadu_ps(in + 24);
+        __m128 cz = _mm_loadu_ps(in + 40);
+        __m128 cw = _mm_loadu_ps(in + 56);
+        _MM_TRANSPOSE4_PS(cx, cy, cz, cw);
+
+        auto cross = [](__m128 ux, __m128 uy, __m128 uz, __m128 vx, __m128 vy, __m128 vz,
+                        __m128& rx, __m128& ry, __m128& rz)
+        {
+            rx = _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy));
+            ry = _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz));
+            rz = _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx));
+        };
+
+        __m128 n0x, n0y, n0z, n1x, n1y, n1z, n2x, n2y, n2z;
+        cross(bx, by, bz, cx, cy, cz, n0x, n0y, n0z);
+        cross(cx, cy, cz, ax, ay, az, n1x, n1y, n1z);
+        cross(ax, ay, az, bx, by, bz, n2x, n2y, n2z);
+
+        // Singular matrices get a zero normal matrix, same as the scalar path
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, n0x), _mm_mul_ps(ay, n0y)),
+                                      _mm_mul_ps(az, n0z));
+        const __m128 nonZero = _mm_cmpneq_ps(det, zero);
+        const __m128 invDet = _mm_and_ps(_mm_div_ps(one, det), nonZero);
+
+        n0x = _mm_mul_ps(n0x, invDet);
+        n0y = _mm_mul_ps(n0y, invDet);
+        n0z = _mm_mul_ps(n0z, invDet);
+        __m128 n0w = zero;
+        n1x = _mm_mul_ps(n1x, invDet);
+        n1y = _mm_mul_ps(n1y, invDet);
+        n1z = _mm_mul_ps(n1z, invDet);
+        __m128 n1w = zero;
+        n2x = _mm_mul_ps(n2x, invDet);
+        n2y = _mm_mul_ps(n2y, invDet);
+        n2z = _mm_mul_ps(n2z, invDet);
+        __m128 n2w = zero;
+        _MM_TRANSPOSE4_PS(n0x, n0y, n0z, n0w);
+        _MM_TRANSPOSE4_PS(n1x, n1y, n1z, n1w);
+        _MM_TRANSPOSE4_PS(n2x, n2y, n2z, n2w);
+
+        float* out = &outMatrices[i]._11;
+        const __m128 rows[4][3] = {
+            {n0x, n1x, n2x}, {n0y, n1y, n2y}, {n0z, n1z, n2z}, {n0w, n1w, n2w}};
+        for (uint32_t m = 0; m < 4; ++m)
+        {
+            _mm_storeu_ps(out + m * 16 + 0, rows[m][0]);
+            _mm_storeu_ps(out + m * 16 + 4, rows[m][1]);
+            _mm_storeu_ps(out + m * 16 + 8, rows[m][2]);
+            _mm_storeu_ps(out + m * 16 + 12, identityRow3);
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        outMatrices[i] = ComputeNormalMatrix(matrices[i]);
+    }
+}
+
+void Math::NlerpQuaternions(const Quaternion* from,
+                            const Quaternion* to,
+                            float t,
+                            uint32_t count,
+                            Quaternion* outRotations)
+{
+    const __m128 vt = _mm_set1_ps(t);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Transpose so each register holds one component of four quaternions
+        __m128 ax = _mm_loadu_ps(&from[i + 0].x);
+        __m128 ay = _mm_loadu_ps(&from[i + 1].x);
+        __m128 az = _mm_loadu_ps(&from[i + 2].x);
+        __m128 aw = _mm_loadu_ps(&from[i + 3].x);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        __m128 bx = _mm_loadu_ps(&to[i + 0].x);
+        __m128 by = _mm_loadu_ps(&to[i + 1].x);
+        __m128 bz = _mm_loadu_ps(&to[i + 2].x);
+        __m128 bw = _mm_loadu_ps(&to[i + 3].x);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        // Flip the target into the same hemisphere to take the shortest arc
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                      _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+        bx = _mm_xor_ps(bx, flip);
+        by = _mm_xor_ps(by, flip);
+        bz = _mm_xor_ps(bz, flip);
+        bw = _mm_xor_ps(bw, flip);
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), vt));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), vt));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), vt));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), vt));
+
+        const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                           _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+        rx = _mm_mul_ps(rx, invLength);
+        ry = _mm_mul_ps(ry, invLength);
+        rz = _mm_mul_ps(rz, invLength);
+        rw = _mm_mul_ps(rw, invLength);
+
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        _mm_storeu_ps(&outRotations[i + 0].x, rx);
+        _mm_storeu_ps(&outRotations[i + 1].x, ry);
+        _mm_storeu_ps(&outRotations[i + 2].x, rz);
+        _mm_storeu_ps(&outRotations[i + 3].x, rw);
+    }
+
+    for (; i < count; ++i)
+    {
+        outRotations[i] = Quaternion::Nlerp(from[i], to[i], t);
+    }
+}
+
+void Math::LerpFloats(const float* a, const float* b, float t, uint32_t count, float* out)
+{
+    const __m128 vt = _mm_set1_ps(t);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 vb = _mm_loadu_ps(b + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt)));
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+#else
+
+void Math::ComposeTransformations(const TransformStreams& t, uint32_t count, Matrix4* outMatrices)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        outMatrices[i] = ComposeTransformation(t, i);
+    }
+}
+
+void Math::ComputeNormalMatrices(const Matrix4* matrices, uint32_t count, Matrix4* outMatrices)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        outMatrices[i] = ComputeNormalMatrix(matrices[i]);
+    }
+}
+
+void Math::NlerpQuaternions(const Quaternion* from,
+                            const Quaternion* to,
+                            float t,
+                            uint32_t count,
+                            Quaternion* outRotations)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        outRotations[i] = Quaternion::Nlerp(from[i], to[i], t);
+    }
+}
+
+void Math::LerpFloats(const float* a, const float* b, float t, uint32_t count, float* out)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr float WorldSize = 500.0f;
+
+struct Body
+{
+    AABB aabb;
+    Vector3 velocity;
+    int proxyId = AABBTree::NullNode;
+};
+
+std::vector<Body> CreateBodies(uint32_t count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-WorldSize, WorldSize);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+    std::uniform_real_distribution<float> speed(-1.0f, 1.0f);
+
+    std::vector<Body> bodies(count);
+    for (Body& body : bodies)
+    {
+        const Vector3 center(position(rng), position(rng), position(rng));
+        const Vector3 extents(size(rng), size(rng), size(rng));
+        body.aabb = {center - extents, center + extents};
+        body.velocity = {speed(rng), speed(rng), speed(rng)};
+    }
+    return bodies;
+}
+
+void RunTreeBenchmark(uint32_t bodyCount)
+{
+    printf(" %u bodies\n", bodyCount);
+
+    std::mt19937 rng(bodyCount);
+    std::vector<Body> bodies = CreateBodies(bodyCount, rng);
+    AABBTree tree;
+    {
+        Benchmark::Timer timer;
+        for (Body& body : bodies)
+        {
+            body.proxyId = tree.CreateProxy(body.aabb, &body);
+        }
+        Benchmark::Report("Insert", bodyCount, timer.GetSeconds());
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    tree.UpdatePairs(pairs);
+
+    // 60 frames of everything moving, most moves stay inside the fat AABB
+    constexpr uint32_t frameCount = 60;
+    constexpr float deltaTime = 1.0f / 60.0f;
+    uint32_t reinserted = 0;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (Body& body : bodies)
+            {
+                const Vector3 displacement = body.velocity * deltaTime;
+                body.aabb = {body.aabb.min + displacement, body.aabb.max + displacement};
+                reinserted += tree.MoveProxy(body.proxyId, body.aabb, displacement) ? 1 : 0;
+            }
+        }
+        Benchmark::Report("Move", bodyCount * frameCount, timer.GetSeconds());
+    }
+    printf("  %-40s %10u\n", "Reinserted", reinserted);
+    printf("  %-40s %10d\n", "Height", tree.GetHeight());
+    printf("  %-40s %10.2f\n", "Area ratio", tree.GetAreaRatio());
+
+    {
+        pairs.clear();
+        Benchmark::Timer timer;
+        tree.UpdatePairs(pairs);
+        Benchmark::Report("Update pairs", bodyCount, timer.GetSeconds());
+        printf("  %-40s %10zu\n", "Pairs", pairs.size());
+    }
+
+    constexpr uint32_t queryCount = 10000;
+    std::uniform_real_distribution<float> position(-WorldSize, WorldSize);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+    uint64_t results = 0;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < queryCount; ++i)
+        {
+            const Vector3 center(position(rng), position(rng), position(rng));
+            const AABB region(center - Vector3(20.0f), center + Vector3(20.0f));
+            tree.Query(region,
+                       [&](int)
+                       {
+                           ++results;
+                           return true;
+                       });
+        }
+        Benchmark::Report("Region query", queryCount, timer.GetSeconds());
+    }
+
+    // Same queries by brute force for reference
+    {
+        std::mt19937 bruteRng(bodyCount);
+        uint64_t bruteResults = 0;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < queryCount / 10; ++i)
+        {
+            const Vector3 center(position(bruteRng), position(bruteRng), position(bruteRng));
+            const AABB region(center - Vector3(20.0f), center + Vector3(20.0f));
+            for (const Body& body : bodies)
+            {
+                bruteResults += Overlaps(body.aabb, region) ? 1 : 0;
+            }
+        }
+        Benchmark::Report("Region query (brute force)", queryCount / 10, timer.GetSeconds());
+        Benchmark::DoNotOptimize(bruteResults);
+    }
+
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < queryCount; ++i)
+        {
+            const Vector3 origin(position(rng), position(rng), position(rng));
+            const Vector3 dir = Normalize(Vector3(direction(rng), direction(rng), direction(rng)));
+            const Vector3 invDirection(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+            tree.Raycast(Ray(origin, dir),
+                         1000.0f,
+                         [&](int proxyId, float maxDistance)
+                         {
+                             const Body* body = static_cast<Body*>(tree.GetUserData(proxyId));
+                             const float distance =
+                                 Intersect(Ray(origin, dir), invDirection, body->aabb, maxDistance);
+                             if (distance >= 0.0f)
+                             {
+                                 ++results;
+                                 return distance;
+                             }
+                             return maxDistance;
+                         });
+        }
+        Benchmark::Report("Ray cast (closest)", queryCount, timer.GetSeconds());
+    }
+
+    {
+        // 60 degree perspective looking down +z
+        const float d = 1.0f / tanf(30.0f * Constants::DegToRad);
+        const float zn = 0.1f;
+        const float zf = 200.0f;
+        const float q = zf / (zf - zn);
+        const Matrix4 proj(d, 0.0f, 0.0f, 0.0f,
+                           0.0f, d, 0.0f, 0.0f,
+                           0.0f, 0.0f, q, 1.0f,
+                           0.0f, 0.0f, -zn * q, 0.0f);
+
+        constexpr uint32_t frustumCount = 1000;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < frustumCount; ++i)
+        {
+            const Vector3 eye(position(rng), position(rng), position(rng));
+            const Matrix4 view = Matrix4::Translation(-eye);
+            tree.Query(ExtractFrustum(view * proj),
+                       [&](int)
+                       {
+                           ++results;
+                           return true;
+                       });
+        }
+        Benchmark::Report("Frustum query", frustumCount, timer.GetSeconds());
+    }
+    Benchmark::DoNotOptimize(results);
+
+    {
+        Benchmark::Timer timer;
+        for (const Body& body : bodies)
+        {
+            tree.DestroyProxy(body.proxyId);
+        }
+        Benchmark::Report("Remove", bodyCount, timer.GetSeconds());
+    }
+}
+} // namespace
+
+void RunAABBTreeBenchmark()
+{
+    for (uint32_t bodyCount : {1000u, 10000u, 50000u})
+    {
+        RunTreeBenchmark(bodyCount);
+    }
+}
@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t FrameCount = 1000;
+constexpr uint32_t ListsPerFrame = 64;
+constexpr uint32_t ItemsPerList = 32;
+constexpr uint32_t ObjectCount = 100000;
+
+struct Particle
+{
+    float position[3];
+    float velocity[3];
+    float age;
+    uint32_t flags;
+};
+
+// Temporary lists built and thrown away every frame, the way gather and sort passes use them
+template <class MakeList> uint64_t BuildLists(MakeList makeList)
+{
+    uint64_t sum = 0;
+    for (uint32_t l = 0; l < ListsPerFrame; ++l)
+    {
+        auto list = makeList();
+        for (uint32_t i = 0; i < ItemsPerList; ++i)
+        {
+            list.push_back(l * ItemsPerList + i);
+        }
+        sum += list.back();
+    }
+    return sum;
+}
+} // namespace
+
+void RunAllocatorBenchmark()
+{
+    const uint64_t listOps = static_cast<uint64_t>(FrameCount) * ListsPerFrame;
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            sum += BuildLists([]() { return std::vector<uint32_t>(); });
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("std::vector, growing (per list)", listOps, timer.GetSeconds());
+    }
+
+    LinearAllocator frameArena;
+    frameArena.Initialize(1024 * 1024);
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            frameArena.Reset();
+            sum += BuildLists(
+                [&]()
+                {
+                    ArenaVector<uint32_t> list{ArenaStlAllocator<uint32_t>(frameArena)};
+                    list.reserve(ItemsPerList);
+                    return list;
+                });
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("Frame arena, reserved (per list)", listOps, timer.GetSeconds());
+    }
+    printf("  %-40s %10zu bytes\n", "Frame arena peak", frameArena.GetPeakUsed());
+
+    // Alignments above the buffer's own, after an odd sized block and once the arena overflows
+    bool isAligned = true;
+    frameArena.Reset();
+    for (size_t alignment : {64, 128, 4096, 64, 64 * 1024})
+    {
+        frameArena.Allocate(1, 1);
+        const void* memory = frameArena.Allocate(alignment, alignment);
+        isAligned &= (reinterpret_cast<uintptr_t>(memory) % alignment == 0);
+    }
+    frameArena.Allocate(frameArena.GetCapacity(), 1);
+    isAligned &= (reinterpret_cast<uintptr_t>(frameArena.Allocate(256, 256)) % 256 == 0);
+    frameArena.Terminate();
+    if (!isAligned)
+    {
+        printf("  %-40s MISMATCH\n", "Frame arena alignment");
+    }
+
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            ScratchScope scratch;
+            sum += BuildLists(
+                [&]()
+                {
+                    ArenaVector<uint32_t> list{ArenaStlAllocator<uint32_t>(scratch.GetAllocator())};
+                    list.reserve(ItemsPerList);
+                    return list;
+                });
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("Scratch scope, reserved (per list)", listOps, timer.GetSeconds());
+    }
+
+    // Objects created in one order and destroyed in another, like entities and particles
+    std::vector<Particle*> objects(ObjectCount);
+    const uint64_t objectOps = static_cast<uint64_t>(ObjectCount) * 20;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t round = 0; round < 20; ++round)
+        {
+            for (uint32_t i = 0; i < ObjectCount; ++i)
+            {
+                objects[i] = new Particle();
+            }
+            for (uint32_t i = 0; i < ObjectCount; ++i)
+            {
+                delete objects[(i * 7919) % ObjectCount];
+            }
+        }
+        Benchmark::Report("new/delete (per object)", objectOps, timer.GetSeconds());
+    }
+
+    PoolAllocator pool;
+    pool.Initialize(sizeof(Particle), ObjectCount, alignof(Particle));
+    {
+        Benchmark::Timer timer;
+        for (uint32_t round = 0; round < 20; ++round)
+        {
+            for (uint32_t i = 0; i < ObjectCount; ++i)
+            {
+                objects[i] = pool.New<Particle>();
+            }
+            for (uint32_t i = 0; i < ObjectCount; ++i)
+            {
+                pool.Delete(objects[(i * 7919) % ObjectCount]);
+            }
+        }
+        Benchmark::Report("Pool New/Delete (per object)", objectOps, timer.GetSeconds());
+    }
+    pool.Terminate();
+
+    PoolAllocator nodePool;
+    nodePool.Initialize(64, ObjectCount);
+    {
+        Benchmark::Timer timer;
+        std::list<uint32_t, PoolStlAllocator<uint32_t>> list{PoolStlAllocator<uint32_t>(nodePool)};
+        for (uint32_t i = 0; i < ObjectCount; ++i)
+        {
+            list.push_back(i);
+        }
+        list.clear();
+        Benchmark::Report("std::list on a pool (per node)", ObjectCount, timer.GetSeconds());
+    }
+    nodePool.Terminate();
+}
@@ -0,0 +1,229 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t CharacterCount = 1000;
+constexpr uint32_t BoneCount = 64;
+constexpr uint32_t UpperBodyFirstBone = 32;
+constexpr uint32_t FrameCount = 60;
+constexpr float DeltaTime = 1.0f / 60.0f;
+
+// Five limbs hanging off a root, like a simple character rig
+Skeleton CreateSkeleton()
+{
+    Skeleton skeleton;
+    skeleton.bones.resize(BoneCount);
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        Bone& bone = skeleton.bones[b];
+        bone.name = "Bone" + std::to_string(b);
+        bone.parentIndex = (b == 0) ? -1 : ((b - 1) % 5 == 0 ? 0 : static_cast<int>(b) - 1);
+        bone.restTransform.position = {0.0f, (b == 0) ? 1.0f : 0.2f, 0.0f};
+    }
+    skeleton.BuildRestPose();
+    return skeleton;
+}
+
+// Every bone swings around its own axis, the seed changes axes and phases between clips
+AnimationClip CreateClip(const Skeleton& skeleton, float duration, float amplitude, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    RawAnimationClip raw;
+    raw.name = "Clip" + std::to_string(seed);
+    raw.duration = duration;
+    raw.tracks.resize(BoneCount);
+    const uint32_t keyCount = static_cast<uint32_t>(duration * 30.0f) + 1;
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        const Vector3 axis = Normalize(Vector3(unit(rng), unit(rng), unit(rng)));
+        const float phase = unit(rng) * Constants::Pi;
+        for (uint32_t k = 0; k < keyCount; ++k)
+        {
+            const float time = duration * k / (keyCount - 1);
+            const float angle = amplitude * sinf(time / duration * Constants::TwoPi + phase);
+            raw.tracks[b].rotationKeys.push_back(
+                {Quaternion::CreateFromAxisAngle(axis, angle), time});
+        }
+    }
+    return AnimationClip::Compress(raw, skeleton);
+}
+
+struct Parameters
+{
+    uint32_t speed;
+    uint32_t direction;
+    uint32_t aim;
+    uint32_t wave;
+};
+
+// Idle and a 2D locomotion space in a state machine, an additive aim on top and a waving layer
+// over the upper body
+AnimationGraphDesc CreateGraph(Parameters& parameters)
+{
+    AnimationGraphDesc desc;
+    parameters.speed = desc.AddParameter("Speed");
+    parameters.direction = desc.AddParameter("Direction");
+    parameters.aim = desc.AddParameter("Aim");
+    parameters.wave = desc.AddParameter("Wave");
+
+    const uint32_t idle = desc.AddClip(0);
+    const uint32_t locomotion = desc.AddBlendSpace2D(parameters.direction,
+                                                     parameters.speed,
+                                                     {{0, {0.0f, 0.0f}},
+                                                      {1, {0.0f, 1.0f}},
+                                                      {2, {0.0f, 3.0f}},
+                                                      {3, {-1.0f, 1.0f}},
+                                                      {4, {1.0f, 1.0f}}});
+    const uint32_t movement = desc.AddStateMachine({idle, locomotion});
+    desc.AddTransition(movement, {0, 1, parameters.speed, AnimationGraphDesc::Comparison::Greater,
+                                  0.1f, 0.25f});
+    desc.AddTransition(movement, {1, 0, parameters.speed, AnimationGraphDesc::Comparison::Less,
+                                  0.05f, 0.25f});
+
+    const uint32_t aimed = desc.AddAdditive(movement, desc.AddClip(5), parameters.aim);
+
+    std::vector<float> upperBody(BoneCount, 0.0f);
+    std::fill(upperBody.begin() + UpperBodyFirstBone, upperBody.end(), 1.0f);
+    desc.root = desc.AddLayered(aimed, desc.AddClip(6), upperBody, parameters.wave);
+    return desc;
+}
+
+void SetParameters(AnimationGraphInstance& instance,
+                   const Parameters& parameters,
+                   uint32_t character,
+                   float time)
+{
+    const float phase = character * 0.37f;
+    instance.SetParameter(parameters.speed, Max(0.0f, 1.5f + 1.6f * sinf(time * 0.7f + phase)));
+    instance.SetParameter(parameters.direction, sinf(time * 0.3f + phase));
+    instance.SetParameter(parameters.aim, 0.5f + 0.5f * sinf(time + phase));
+    instance.SetParameter(parameters.wave, (character % 3 == 0) ? 1.0f : 0.0f);
+}
+
+void ReportFrame(const char* name, double seconds)
+{
+    printf("  %-40s %10.3f ms\n", name, seconds * 1000.0 / FrameCount);
+}
+} // namespace
+
+void RunAnimGraphBenchmark()
+{
+    const Skeleton skeleton = CreateSkeleton();
+    std::vector<AnimationClip> clips;
+    clips.push_back(CreateClip(skeleton, 3.0f, 0.05f, 1)); // Idle
+    clips.push_back(CreateClip(skeleton, 1.1f, 0.4f, 2));  // Walk
+    clips.push_back(CreateClip(skeleton, 0.7f, 0.6f, 3));  // Run
+    clips.push_back(CreateClip(skeleton, 1.2f, 0.4f, 4));  // Strafe left
+    clips.push_back(CreateClip(skeleton, 1.2f, 0.4f, 5));  // Strafe right
+    clips.push_back(CreateClip(skeleton, 2.0f, 0.2f, 6));  // Aim offsets
+    clips.push_back(CreateClip(skeleton, 1.5f, 0.8f, 7));  // Wave
+
+    Parameters parameters;
+    const AnimationGraphDesc desc = CreateGraph(parameters);
+    AnimationGraph graph;
+    if (!graph.Compile(desc, skeleton, clips))
+    {
+        printf("  Graph failed to compile\n");
+        return;
+    }
+    printf("  %u characters, %u bones, %zu nodes, %u instructions, %u pose registers\n",
+           CharacterCount,
+           BoneCount,
+           desc.nodes.size(),
+           graph.GetInstructionCount(),
+           graph.GetRegisterCount());
+
+    std::vector<AnimationGraphInstance> instances(CharacterCount);
+    std::vector<AnimationGraphInstance*> pointers(CharacterCount);
+    for (uint32_t c = 0; c < CharacterCount; ++c)
+    {
+        instances[c].Initialize(graph);
+        pointers[c] = &instances[c];
+    }
+
+    const auto runFrames = [&](bool parallel, const AnimationLodSettings& lodSettings)
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            for (uint32_t c = 0; c < CharacterCount; ++c)
+            {
+                SetParameters(instances[c], parameters, c, f * DeltaTime);
+            }
+            if (parallel)
+            {
+                AnimationGraphInstance::Update(
+                    pointers.data(), CharacterCount, DeltaTime, lodSettings);
+            }
+            else
+            {
+                for (AnimationGraphInstance& instance : instances)
+                {
+                    instance.Update(DeltaTime, lodSettings);
+                }
+            }
+        }
+        return timer.GetSeconds();
+    };
+
+    const uint64_t characterUpdates = static_cast<uint64_t>(FrameCount) * CharacterCount;
+    {
+        const double seconds = runFrames(false, {});
+        Benchmark::Report("Serial (per character)", characterUpdates, seconds);
+        ReportFrame("Serial, crowd frame", seconds);
+    }
+    {
+        const double seconds = runFrames(true, {});
+        Benchmark::Report("Parallel (per character)", characterUpdates, seconds);
+        ReportFrame("Parallel, crowd frame", seconds);
+    }
+
+    // Characters spread out to 100 units, most of them past the reduced rate distance
+    uint32_t evaluations = 0;
+    for (uint32_t c = 0; c < CharacterCount; ++c)
+    {
+        instances[c].SetLodDistance(100.0f * c / CharacterCount);
+        evaluations -= instances[c].GetEvaluationCount();
+    }
+    {
+        const double seconds = runFrames(true, {});
+        Benchmark::Report("Parallel + LOD (per character)", characterUpdates, seconds);
+        ReportFrame("Parallel + LOD, crowd frame", seconds);
+    }
+    for (const AnimationGraphInstance& instance : instances)
+    {
+        evaluations += instance.GetEvaluationCount();
+    }
+    printf("  %-40s %10.1f %%\n",
+           "Evaluations with LOD",
+           100.0 * evaluations / static_cast<double>(characterUpdates));
+
+    // Same character at full and lowest rate, the interpolated one trails by up to one interval
+    AnimationGraphInstance nearInstance;
+    AnimationGraphInstance farInstance;
+    nearInstance.Initialize(graph);
+    farInstance.Initialize(graph);
+    farInstance.SetLodDistance(100.0f);
+    const AnimationLodSettings lodSettings;
+    float maxError = 0.0f;
+    for (uint32_t f = 0; f < FrameCount * 4; ++f)
+    {
+        SetParameters(nearInstance, parameters, 1, f * DeltaTime);
+        SetParameters(farInstance, parameters, 1, f * DeltaTime);
+        nearInstance.Update(DeltaTime, lodSettings);
+        farInstance.Update(DeltaTime, lodSettings);
+        for (uint32_t b = 0; b < BoneCount; ++b)
+        {
+            const float error = Distance(GetTranslation(nearInstance.GetModelMatrices()[b]),
+                                         GetTranslation(farInstance.GetModelMatrices()[b]));
+            maxError = Max(maxError, error);
+        }
+    }
+    printf("  %-40s %10.4f\n", "Max bone offset, lowest rate vs full", maxError);
+}
@@ -0,0 +1,199 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t BoneCount = 64;
+constexpr float ClipDuration = 10.0f;
+constexpr float KeyRate = 30.0f;
+
+// Five limbs hanging off a root, like a simple character rig
+Skeleton CreateSkeleton()
+{
+    Skeleton skeleton;
+    skeleton.bones.resize(BoneCount);
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        Bone& bone = skeleton.bones[b];
+        bone.name = "Bone" + std::to_string(b);
+        bone.parentIndex = (b == 0) ? -1 : ((b - 1) % 5 == 0 ? 0 : static_cast<int>(b) - 1);
+        bone.restTransform.position = {0.0f, (b == 0) ? 1.0f : 0.2f, 0.0f};
+    }
+    skeleton.BuildRestPose();
+    return skeleton;
+}
+
+// Most bones rotate, every eighth stays at rest and every eighth holds a constant offset
+RawAnimationClip CreateClip(float frequencyScale)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    RawAnimationClip clip;
+    clip.name = "Synthetic";
+    clip.duration = ClipDuration;
+    clip.tracks.resize(BoneCount);
+
+    const uint32_t keyCount = static_cast<uint32_t>(ClipDuration * KeyRate) + 1;
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        RawAnimationClip::Track& track = clip.tracks[b];
+        const Vector3 axis = Normalize(Vector3(unit(rng), unit(rng), unit(rng)));
+        const float frequency = (0.5f + 0.5f * unit(rng)) * frequencyScale + 0.2f;
+        const float amplitude = 0.6f + 0.4f * unit(rng);
+        for (uint32_t k = 0; k < keyCount; ++k)
+        {
+            const float time = k / KeyRate;
+            float angle = amplitude * sinf(time * frequency * Constants::TwoPi + b);
+            if (b % 8 == 3)
+            {
+                angle = 0.0f;
+            }
+            else if (b % 8 == 5)
+            {
+                angle = amplitude;
+            }
+            track.rotationKeys.push_back({Quaternion::CreateFromAxisAngle(axis, angle), time});
+        }
+    }
+
+    for (uint32_t k = 0; k < keyCount; ++k)
+    {
+        const float time = k / KeyRate;
+        const Vector3 position(sinf(time), 1.0f + 0.1f * sinf(time * 4.0f), time * 0.5f);
+        clip.tracks[0].positionKeys.push_back({position, time});
+    }
+    return clip;
+}
+
+template <class T, class LerpFn>
+T SampleKeys(const std::vector<RawAnimationClip::Key<T>>& keys, float time, LerpFn lerp)
+{
+    const float position = Clamp(time * KeyRate, 0.0f, static_cast<float>(keys.size() - 1));
+    const size_t k0 = Min(static_cast<size_t>(position), keys.size() - 1);
+    const size_t k1 = Min(k0 + 1, keys.size() - 1);
+    return lerp(keys[k0].value, keys[k1].value, position - k0);
+}
+
+void SampleRaw(const RawAnimationClip& clip, const Skeleton& skeleton, float time, Pose& pose)
+{
+    pose = skeleton.restPose;
+    auto lerpVector = [](const Vector3& a, const Vector3& b, float t) { return a + (b - a) * t; };
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        const RawAnimationClip::Track& track = clip.tracks[b];
+        if (!track.rotationKeys.empty())
+        {
+            pose.rotations[b] = SampleKeys(track.rotationKeys, time, Quaternion::Slerp);
+        }
+        if (!track.positionKeys.empty())
+        {
+            pose.positions[b] = SampleKeys(track.positionKeys, time, lerpVector);
+        }
+    }
+}
+} // namespace
+
+void RunAnimationBenchmark()
+{
+    const Skeleton skeleton = CreateSkeleton();
+    const RawAnimationClip raw = CreateClip(1.0f);
+    const RawAnimationClip rawFast = CreateClip(3.0f);
+
+    AnimationClip clip;
+    {
+        Benchmark::Timer timer;
+        clip = AnimationClip::Compress(raw, skeleton);
+        Benchmark::Report("Compress", 1, timer.GetSeconds());
+    }
+    const AnimationClip fastClip = AnimationClip::Compress(rawFast, skeleton);
+
+    const AnimationClip::Stats stats = clip.GetStats();
+    printf("  %u bones, %.1f s, %u frames\n", BoneCount, ClipDuration, clip.GetFrameCount());
+    printf("  %u animated rotations, %u animated positions, %u constant, %u rest channels\n",
+           stats.animatedRotations,
+           stats.animatedPositions,
+           stats.constantChannels,
+           stats.restChannels);
+    printf("  %-40s %10zu bytes\n", "Raw clip", raw.GetMemorySize());
+    printf("  %-40s %10zu bytes\n", "Compressed clip", clip.GetMemorySize());
+    printf("  %-40s %10.1f x\n",
+           "Compression ratio",
+           static_cast<double>(raw.GetMemorySize()) / clip.GetMemorySize());
+
+    // Error against the raw keys, in local rotation angle and in model space bone position
+    Pose rawPose;
+    Pose pose;
+    std::vector<Matrix4> rawModel(BoneCount);
+    std::vector<Matrix4> model(BoneCount);
+    float maxAngleError = 0.0f;
+    float maxPositionError = 0.0f;
+    for (float time = 0.0f; time <= ClipDuration; time += 0.0137f)
+    {
+        SampleRaw(raw, skeleton, time, rawPose);
+        clip.Sample(skeleton, time, false, pose);
+        for (uint32_t b = 0; b < BoneCount; ++b)
+        {
+            const Quaternion& q0 = rawPose.rotations[b];
+            const Quaternion& q1 = pose.rotations[b];
+            const float dot = Abs(q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w);
+            maxAngleError = Max(maxAngleError, 2.0f * acosf(Min(dot, 1.0f)));
+        }
+
+        ComputeModelMatrices(skeleton, rawPose, rawModel.data());
+        ComputeModelMatrices(skeleton, pose, model.data());
+        for (uint32_t b = 0; b < BoneCount; ++b)
+        {
+            const float error = Distance(GetTranslation(rawModel[b]), GetTranslation(model[b]));
+            maxPositionError = Max(maxPositionError, error);
+        }
+    }
+    printf("  %-40s %10.6f rad\n", "Max rotation error", maxAngleError);
+    printf("  %-40s %10.6f\n", "Max model space position error", maxPositionError);
+
+    constexpr uint32_t sampleCount = 200'000;
+    const uint64_t boneOps = static_cast<uint64_t>(sampleCount) * BoneCount;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            SampleRaw(raw, skeleton, i * 0.0173f, rawPose);
+            Benchmark::DoNotOptimize(rawPose);
+        }
+        Benchmark::Report("Raw keys sample (per bone)", boneOps, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            clip.Sample(skeleton, i * 0.0173f, true, pose);
+            Benchmark::DoNotOptimize(pose);
+        }
+        Benchmark::Report("Compressed sample (per bone)", boneOps, timer.GetSeconds());
+    }
+
+    Pose other;
+    fastClip.Sample(skeleton, 1.0f, true, other);
+    Pose blended;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            BlendPoses(pose, other, (i & 255) / 255.0f, blended);
+            Benchmark::DoNotOptimize(blended);
+        }
+        Benchmark::Report("BlendPoses (per bone)", boneOps, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            ComputeModelMatrices(skeleton, blended, model.data());
+            Benchmark::DoNotOptimize(model);
+        }
+        Benchmark::Report("ComputeModelMatrices (per bone)", boneOps, timer.GetSeconds());
+    }
+}
@@ -0,0 +1,277 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint64_t MessageCount = 1000000;
+constexpr size_t QueueCapacity = 1024;
+constexpr uint32_t ProducerCount = 2;
+constexpr uint32_t ConsumerCount = 2;
+constexpr uint64_t LockCount = 1000000;
+constexpr uint32_t LockThreadCount = 4;
+constexpr uint64_t PingPongCount = 20000;
+
+// Baseline bounded queue: a deque behind a mutex
+template <class T> class MutexQueue
+{
+  public:
+    explicit MutexQueue(size_t capacity)
+        : mCapacity(capacity)
+    {
+    }
+
+    bool TryPush(T value)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mItems.size() >= mCapacity)
+        {
+            return false;
+        }
+        mItems.push_back(value);
+        return true;
+    }
+
+    bool TryPop(T& value)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mItems.empty())
+        {
+            return false;
+        }
+        value = mItems.front();
+        mItems.pop_front();
+        return true;
+    }
+
+  private:
+    std::mutex mMutex;
+    std::deque<T> mItems;
+    size_t mCapacity;
+};
+
+void ReportCheck(const char* name, uint64_t value, uint64_t expected)
+{
+    if (value != expected)
+    {
+        printf("  %-40s MISMATCH %llu != %llu\n",
+               name,
+               static_cast<unsigned long long>(value),
+               static_cast<unsigned long long>(expected));
+    }
+}
+
+// Producers push 1..N split between them, consumers pop until all N arrived. Returns the sum of
+// everything popped so lost or duplicated messages show up.
+template <class Queue>
+uint64_t RunQueue(Queue& queue, uint32_t producerCount, uint32_t consumerCount)
+{
+    std::atomic<uint64_t> popped{0};
+    std::atomic<uint64_t> sum{0};
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producerCount; ++p)
+    {
+        threads.emplace_back(
+            [&queue, p, producerCount]()
+            {
+                Backoff backoff;
+                for (uint64_t value = p + 1; value <= MessageCount; value += producerCount)
+                {
+                    while (!queue.TryPush(value))
+                    {
+                        backoff.Pause();
+                    }
+                    backoff.Reset();
+                }
+            });
+    }
+    for (uint32_t c = 0; c < consumerCount; ++c)
+    {
+        threads.emplace_back(
+            [&queue, &popped, &sum]()
+            {
+                Backoff backoff;
+                uint64_t localSum = 0;
+                uint64_t value = 0;
+                while (popped.load(std::memory_order_relaxed) < MessageCount)
+                {
+                    if (queue.TryPop(value))
+                    {
+                        localSum += value;
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                        backoff.Reset();
+                    }
+                    else
+                    {
+                        backoff.Pause();
+                    }
+                }
+                sum.fetch_add(localSum);
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return sum.load();
+}
+
+template <class Queue>
+void BenchQueue(const char* name, uint32_t producerCount, uint32_t consumerCount)
+{
+    Queue queue(QueueCapacity);
+    Benchmark::Timer timer;
+    const uint64_t sum = RunQueue(queue, producerCount, consumerCount);
+    Benchmark::Report(name, MessageCount, timer.GetSeconds());
+    ReportCheck(name, sum, MessageCount * (MessageCount + 1) / 2);
+}
+
+template <class Lock> void BenchLock(const char* name)
+{
+    Lock lock;
+    uint64_t counter = 0;
+    std::vector<std::thread> threads;
+    Benchmark::Timer timer;
+    for (uint32_t t = 0; t < LockThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&lock, &counter]()
+            {
+                for (uint64_t i = 0; i < LockCount / LockThreadCount; ++i)
+                {
+                    std::lock_guard<Lock> guard(lock);
+                    ++counter;
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    Benchmark::Report(name, LockCount, timer.GetSeconds());
+    ReportCheck(name, counter, LockCount);
+}
+
+struct CameraState
+{
+    float position[3];
+    float target[3];
+    float fov;
+    uint32_t frame;
+};
+
+void BenchSeqLock()
+{
+    SeqLock<CameraState> state;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    Benchmark::Timer timer;
+    for (uint32_t r = 0; r < 2; ++r)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                uint64_t localReads = 0;
+                uint64_t localTorn = 0;
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    // Every field of a store holds the same frame number
+                    const CameraState value = state.Load();
+                    const float frame = static_cast<float>(value.frame);
+                    localTorn += (value.position[0] != frame || value.fov != frame) ? 1 : 0;
+                    ++localReads;
+                }
+                reads.fetch_add(localReads);
+                torn.fetch_add(localTorn);
+            });
+    }
+    for (uint32_t frame = 0; frame < MessageCount; ++frame)
+    {
+        const float f = static_cast<float>(frame);
+        state.Store({{f, f, f}, {f, f, f}, f, frame});
+    }
+    done.store(true);
+    for (std::thread& thread : readers)
+    {
+        thread.join();
+    }
+    Benchmark::Report("SeqLock, 1 writer (per store)", MessageCount, timer.GetSeconds());
+    printf("  %-40s %10llu reads\n",
+           "SeqLock, 2 readers",
+           static_cast<unsigned long long>(reads.load()));
+    ReportCheck("SeqLock torn reads", torn.load(), 0);
+}
+
+void BenchEventPingPong()
+{
+    Event ping;
+    Event pong;
+    Benchmark::Timer timer;
+    std::thread partner(
+        [&]()
+        {
+            for (uint64_t i = 0; i < PingPongCount; ++i)
+            {
+                ping.Wait();
+                pong.Signal();
+            }
+        });
+    for (uint64_t i = 0; i < PingPongCount; ++i)
+    {
+        ping.Signal();
+        pong.Wait();
+    }
+    partner.join();
+    Benchmark::Report("Event ping-pong (per round trip)", PingPongCount, timer.GetSeconds());
+}
+
+void BenchConditionPingPong()
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool pingSignaled = false;
+    bool pongSignaled = false;
+    Benchmark::Timer timer;
+    std::thread partner(
+        [&]()
+        {
+            for (uint64_t i = 0; i < PingPongCount; ++i)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&]() { return pingSignaled; });
+                pingSignaled = false;
+                pongSignaled = true;
+                condition.notify_all();
+            }
+        });
+    for (uint64_t i = 0; i < PingPongCount; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        pingSignaled = true;
+        condition.notify_all();
+        condition.wait(lock, [&]() { return pongSignaled; });
+        pongSignaled = false;
+    }
+    partner.join();
+    Benchmark::Report("condition_variable ping-pong", PingPongCount, timer.GetSeconds());
+}
+} // namespace
+
+void RunConcurrencyBenchmark()
+{
+    BenchQueue<MutexQueue<uint64_t>>("mutex + deque, 1P/1C", 1, 1);
+    BenchQueue<SpscQueue<uint64_t>>("SpscQueue, 1P/1C", 1, 1);
+    BenchQueue<MutexQueue<uint64_t>>("mutex + deque, 2P/2C", ProducerCount, ConsumerCount);
+    BenchQueue<MpmcQueue<uint64_t>>("MpmcQueue, 2P/2C", ProducerCount, ConsumerCount);
+
+    BenchLock<std::mutex>("std::mutex counter, 4 threads");
+    BenchLock<SpinLock>("SpinLock counter, 4 threads");
+
+    BenchSeqLock();
+
+    BenchConditionPingPong();
+    BenchEventPingPong();
+}
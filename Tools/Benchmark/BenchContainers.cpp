@@ -0,0 +1,192 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t KeyCount = 4096; // Resource registry sized
+constexpr uint32_t LookupCount = 10000000;
+constexpr uint32_t ChurnCount = 1000000;
+constexpr uint32_t ListCount = 1000000;
+
+struct Resource
+{
+    void* view = nullptr;
+    uint32_t refCount = 0;
+};
+
+// Path hashes are already well spread, like Core::HashPath
+std::vector<size_t> MakeKeys(uint32_t count)
+{
+    std::vector<size_t> keys(count);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (size_t& key : keys)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<size_t>(state);
+    }
+    return keys;
+}
+
+// Draw order visits resources in a scattered but repeatable pattern
+std::vector<uint32_t> MakeOrder(uint32_t count, uint32_t range)
+{
+    std::vector<uint32_t> order(count);
+    uint32_t state = 12345;
+    for (uint32_t& index : order)
+    {
+        state = state * 1664525u + 1013904223u;
+        index = (state >> 8) % range;
+    }
+    return order;
+}
+
+// Random inserts and erases against std::unordered_map, reports the first disagreement
+bool ValidateFlatHashMap()
+{
+    FlatHashMap<uint32_t, uint32_t> map;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    uint32_t state = 777;
+    for (uint32_t i = 0; i < ChurnCount; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t key = (state >> 8) % 2048; // Small key range forces long probe runs
+        if ((state & 3) == 0)
+        {
+            if (map.Erase(key) != (reference.erase(key) > 0))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            map[key] = i;
+            reference[key] = i;
+        }
+    }
+
+    if (map.GetSize() != reference.size())
+    {
+        return false;
+    }
+    for (const auto& [key, value] : reference)
+    {
+        const uint32_t* found = map.Find(key);
+        if (found == nullptr || *found != value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+void RunContainersBenchmark()
+{
+    const std::vector<size_t> keys = MakeKeys(KeyCount);
+    const std::vector<uint32_t> order = MakeOrder(LookupCount, KeyCount);
+
+    std::unordered_map<size_t, Resource> nodeMap;
+    FlatHashMap<size_t, Resource> flatMap;
+    HandlePool<Resource> pool;
+    std::vector<Handle> handles;
+    for (size_t key : keys)
+    {
+        nodeMap[key] = {&nodeMap, 1};
+        flatMap[key] = {&nodeMap, 1};
+        handles.push_back(pool.Add(Resource{&nodeMap, 1}));
+    }
+
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t index : order)
+        {
+            sum += nodeMap.find(keys[index])->second.refCount;
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("unordered_map lookup (4096 keys)", LookupCount, timer.GetSeconds());
+    }
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t index : order)
+        {
+            sum += flatMap.Find(keys[index])->refCount;
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("FlatHashMap lookup (4096 keys)", LookupCount, timer.GetSeconds());
+    }
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t index : order)
+        {
+            sum += pool.Get(handles[index])->refCount;
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("HandlePool lookup (4096 handles)", LookupCount, timer.GetSeconds());
+    }
+
+    {
+        std::unordered_map<uint32_t, uint32_t> map;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < ChurnCount; ++i)
+        {
+            map[i & 4095] = i;
+            map.erase((i * 7) & 4095);
+        }
+        Benchmark::DoNotOptimize(map.size());
+        Benchmark::Report("unordered_map insert + erase", ChurnCount, timer.GetSeconds());
+    }
+    {
+        FlatHashMap<uint32_t, uint32_t> map;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < ChurnCount; ++i)
+        {
+            map[i & 4095] = i;
+            map.Erase((i * 7) & 4095);
+        }
+        Benchmark::DoNotOptimize(map.GetSize());
+        Benchmark::Report("FlatHashMap insert + erase", ChurnCount, timer.GetSeconds());
+    }
+
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < ListCount; ++i)
+        {
+            std::vector<uint32_t> list;
+            for (uint32_t j = 0; j < (i & 15); ++j)
+            {
+                list.push_back(j);
+            }
+            sum += list.size();
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("std::vector, 0-15 items", ListCount, timer.GetSeconds());
+    }
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < ListCount; ++i)
+        {
+            SmallVector<uint32_t, 16> list;
+            for (uint32_t j = 0; j < (i & 15); ++j)
+            {
+                list.push_back(j);
+            }
+            sum += list.size();
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("SmallVector<16>, 0-15 items", ListCount, timer.GetSeconds());
+    }
+
+    if (!ValidateFlatHashMap())
+    {
+        printf("  %-40s MISMATCH\n", "FlatHashMap vs unordered_map");
+    }
+}
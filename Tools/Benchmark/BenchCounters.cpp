@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t ThreadCount = 4;
+constexpr uint32_t AddsPerThread = 2000000;
+constexpr uint32_t FrameCount = 600;
+constexpr uint32_t DrawsPerFrame = 2000;
+
+const PerfCounter sBenchAdds("Bench.Adds");
+const PerfCounter sBenchDraws("Bench.Draws");
+const PerfCounter sBenchGauge("Bench.Gauge", PerfCounterType::Gauge);
+
+template <class Fn> double RunThreads(Fn fn)
+{
+    std::vector<std::thread> threads;
+    Benchmark::Timer timer;
+    for (uint32_t t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&fn]()
+            {
+                for (uint32_t i = 0; i < AddsPerThread; ++i)
+                {
+                    fn();
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return timer.GetSeconds();
+}
+
+size_t CountLines(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    return std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+}
+} // namespace
+
+void RunCountersBenchmark()
+{
+    const uint64_t addCount = static_cast<uint64_t>(ThreadCount) * AddsPerThread;
+    {
+        // What a counter table usually starts as: a map by name behind a lock
+        std::mutex mutex;
+        std::unordered_map<std::string, int64_t> counters;
+        const double seconds = RunThreads(
+            [&]()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++counters["Bench.Adds"];
+            });
+        Benchmark::DoNotOptimize(counters);
+        Benchmark::Report("Locked map by name, 4 threads", addCount, seconds);
+    }
+    {
+        const double seconds = RunThreads([]() { sBenchAdds.Add(); });
+        Benchmark::Report("PerfCounter::Add, 4 threads", addCount, seconds);
+    }
+    PerfCounters::EndFrame();
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path jsonPath = directory / "bench_counters.json";
+    const std::filesystem::path csvPath = directory / "bench_counters.csv";
+    bool isValid = (PerfCounters::GetLastFrameValue(sBenchAdds.GetId()) == int64_t(addCount));
+    for (const std::filesystem::path& path : {jsonPath, csvPath})
+    {
+        PerfCounters::StaticInitialize(path, 1000.0f);
+        PerfCounters::EndFrame(); // Starts the frame timing
+
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < FrameCount; ++frame)
+        {
+            for (uint32_t i = 0; i < DrawsPerFrame; ++i)
+            {
+                sBenchDraws.Add();
+            }
+            sBenchGauge.Set(frame);
+            PerfCounters::EndFrame();
+        }
+        const double seconds = timer.GetSeconds();
+        isValid &= (PerfCounters::GetLastFrameValue(sBenchDraws.GetId()) == DrawsPerFrame);
+        isValid &= (PerfCounters::GetLastFrameValue(sBenchGauge.GetId()) == FrameCount - 1);
+
+        Benchmark::Timer exportTimer;
+        PerfCounters::Export();
+        const double exportSeconds = exportTimer.GetSeconds();
+        PerfCounters::StaticTerminate();
+
+        if (path == jsonPath)
+        {
+            Benchmark::Report("Frames of 2000 adds + EndFrame", FrameCount, seconds);
+            Benchmark::Report("Export, JSON", 1, exportSeconds);
+            isValid &= (CountLines(path) == 1);
+        }
+        else
+        {
+            Benchmark::Report("Export, CSV", 1, exportSeconds);
+            isValid &= (CountLines(path) > 1);
+        }
+        std::filesystem::remove(path);
+    }
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Counter values");
+    }
+}
@@ -0,0 +1,156 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+struct Velocity
+{
+    Vector3 value;
+};
+
+Transform RandomTransform(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(0.0f, Constants::TwoPi);
+    Transform transform;
+    transform.position = {position(rng), position(rng), position(rng)};
+    transform.rotation = Quaternion::CreateFromAxisAngle(Vector3::YAxis, angle(rng));
+    return transform;
+}
+} // namespace
+
+void RunECSBenchmark()
+{
+    constexpr uint32_t entityCount = 100'000;
+    constexpr uint32_t frameCount = 20;
+
+    std::mt19937 rng(5);
+    World world;
+    std::vector<Entity> entities;
+    entities.reserve(entityCount);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < entityCount; ++i)
+        {
+            // Half the scene casts shadows, so the entities are spread over two archetypes
+            if (i % 2 == 0)
+            {
+                entities.push_back(world.Create(
+                    RandomTransform(rng), WorldMatrix(), MeshRenderer(), ShadowCaster()));
+            }
+            else
+            {
+                entities.push_back(
+                    world.Create(RandomTransform(rng), WorldMatrix(), MeshRenderer()));
+            }
+        }
+        Benchmark::Report("Create", entityCount, timer.GetSeconds());
+    }
+    printf("  %u entities, %u archetypes\n", world.GetEntityCount(), world.GetArchetypeCount());
+
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            world.ForEachChunk<const Transform, WorldMatrix>(
+                [](uint32_t count, const Entity*, const Transform* transforms, WorldMatrix* out)
+                { ComputeMatrices(transforms, count, &out->value); });
+        }
+        Benchmark::Report(
+            "World matrices, one thread", entityCount * frameCount, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            UpdateWorldMatrices(world);
+        }
+        Benchmark::Report(
+            "World matrices, UpdateWorldMatrices", entityCount * frameCount, timer.GetSeconds());
+    }
+
+    // Reference: the old layout, one RenderObject per scene object with its draw data inline
+    {
+        std::vector<RenderObject> renderObjects(entityCount);
+        for (RenderObject& renderObject : renderObjects)
+        {
+            renderObject.transform = RandomTransform(rng);
+        }
+        std::vector<Matrix4> worlds(entityCount);
+
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (uint32_t i = 0; i < entityCount; ++i)
+            {
+                worlds[i] = renderObjects[i].GetWorldMatrix();
+            }
+            Benchmark::DoNotOptimize(worlds);
+        }
+        Benchmark::Report(
+            "World matrices, RenderObject array", entityCount * frameCount, timer.GetSeconds());
+    }
+
+    // The shadow pass query only visits the shadow caster archetype
+    {
+        uint32_t visited = 0;
+        float sum = 0.0f;
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            world.ForEach<const ShadowCaster, const WorldMatrix>(
+                [&](Entity, const ShadowCaster&, const WorldMatrix& matWorld)
+                {
+                    sum += matWorld.value._41;
+                    ++visited;
+                });
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("ForEach shadow casters", visited, timer.GetSeconds());
+    }
+
+    // Structural changes move entities between archetypes
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < entityCount; i += 10)
+        {
+            world.AddComponent<Velocity>(entities[i], Vector3::XAxis);
+        }
+        for (uint32_t i = 0; i < entityCount; i += 10)
+        {
+            world.RemoveComponent<Velocity>(entities[i]);
+        }
+        Benchmark::Report("Add + remove component", entityCount / 5, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < entityCount; i += 2)
+        {
+            world.Destroy(entities[i]);
+        }
+        Benchmark::Report("Destroy", entityCount / 2, timer.GetSeconds());
+    }
+
+    // Sanity check: the surviving entities still hold their own transforms
+    uint32_t mismatches = 0;
+    UpdateWorldMatrices(world);
+    for (uint32_t i = 1; i < entityCount; i += 2)
+    {
+        const Transform* transform = world.GetComponent<Transform>(entities[i]);
+        const WorldMatrix* matWorld = world.GetComponent<WorldMatrix>(entities[i]);
+        if (transform == nullptr || matWorld == nullptr ||
+            Abs(transform->position.x - matWorld->value._41) > 1e-4f)
+        {
+            ++mismatches;
+        }
+        if (world.IsAlive(entities[i - 1]))
+        {
+            ++mismatches;
+        }
+    }
+    printf("  %-40s %10u\n", "Mismatches", mismatches);
+}
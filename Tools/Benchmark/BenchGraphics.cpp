@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t GridSize = 32;
+constexpr uint32_t ObjectCount = GridSize * GridSize;
+constexpr uint32_t FrameCount = 200;
+} // namespace
+
+// Submission cost of the standard effect with the GPU taken out: the null device records every
+// call and draws nothing, so the time is what the engine spends on the CPU per object
+void RunGraphicsBenchmark()
+{
+    GraphicsSystem::StaticInitialize(1280, 720);
+    TextureManager::StaticInitialize("");
+    GraphicsSystem* gs = GraphicsSystem::Get();
+    const uint32_t baseObjectCount = NullDevice::GetLiveObjectCount();
+
+    StandardEffect effect;
+    effect.Initialize("Standard.fx"); // Not read, the null device compiles no shaders
+
+    std::vector<RenderObject> renderObjects(ObjectCount);
+    const Mesh sphere = MeshBuilder::CreateSphere(16, 16, 0.4f);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < ObjectCount; ++i)
+        {
+            RenderObject& renderObject = renderObjects[i];
+            renderObject.transform.position = {
+                static_cast<float>(i % GridSize), 0.0f, static_cast<float>(i / GridSize)};
+            renderObject.meshBuffer.Initialize(sphere);
+        }
+        Benchmark::Report("MeshBuffer::Initialize, sphere", ObjectCount, timer.GetSeconds());
+    }
+
+    Camera camera;
+    camera.SetPosition({GridSize * 0.5f, 10.0f, -10.0f});
+    camera.SetLookAt({GridSize * 0.5f, 0.0f, GridSize * 0.5f});
+    DirectionalLight directionalLight;
+    effect.SetCamera(camera);
+    effect.SetDirectionalLight(directionalLight);
+
+    gs->EndRender(); // Starts counting the first frame
+    Benchmark::Timer timer;
+    for (uint32_t frame = 0; frame < FrameCount; ++frame)
+    {
+        gs->BeginRender();
+        effect.Begin();
+        for (const RenderObject& renderObject : renderObjects)
+        {
+            effect.Render(renderObject);
+        }
+        effect.End();
+        gs->EndRender();
+    }
+    const double seconds = timer.GetSeconds();
+    Benchmark::Report("StandardEffect::Render", uint64_t(ObjectCount) * FrameCount, seconds);
+
+    printf("  %-40s %10llu\n",
+           "API calls per frame",
+           static_cast<unsigned long long>(NullDevice::GetFrameCallCount()));
+    for (uint32_t i = 0; i < static_cast<uint32_t>(GraphicsApiCall::Count); ++i)
+    {
+        const GraphicsApiCall call = static_cast<GraphicsApiCall>(i);
+        if (NullDevice::GetFrameCallCount(call) > 0)
+        {
+            printf("    %-38s %10llu\n",
+                   NullDevice::GetCallName(call),
+                   static_cast<unsigned long long>(NullDevice::GetFrameCallCount(call)));
+        }
+    }
+    printf("  %-40s %10.2f MB\n",
+           "Uploaded per frame",
+           NullDevice::GetFrameUploadedBytes() / (1024.0 * 1024.0));
+    printf("  %-40s %10.2f MB\n",
+           "Live buffers",
+           NullDevice::GetLiveBufferBytes() / (1024.0 * 1024.0));
+
+    const size_t vertexBytes = sphere.vertices.size() * sizeof(Vertex);
+    const size_t indexBytes = sphere.indices.size() * sizeof(uint32_t);
+    bool isValid = (NullDevice::GetFrameCallCount(GraphicsApiCall::Draw) == ObjectCount);
+    isValid &= (NullDevice::GetFrameCallCount(GraphicsApiCall::Present) == 1);
+    isValid &= (NullDevice::GetLiveBufferBytes() >= (vertexBytes + indexBytes) * ObjectCount);
+
+    for (RenderObject& renderObject : renderObjects)
+    {
+        renderObject.Terminate();
+    }
+    effect.Terminate();
+    isValid &= (NullDevice::GetLiveObjectCount() == baseObjectCount);
+
+    TextureManager::StaticTerminate();
+    GraphicsSystem::StaticTerminate();
+    isValid &= (NullDevice::GetLiveObjectCount() == 0);
+    isValid &= (NullDevice::GetLiveBufferBytes() == 0 && NullDevice::GetLiveTextureBytes() == 0);
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Null device counts");
+    }
+}
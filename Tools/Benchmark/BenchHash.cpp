@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr size_t BufferSize = 1024 * 1024;
+constexpr uint32_t BufferRepeatCount = 256;
+constexpr uint32_t PathCount = 1000000;
+
+struct ReferenceHash
+{
+    std::string text;
+    uint64_t seed;
+    uint64_t hash;
+};
+
+// Published XXH64 outputs, a mismatch means the hash changed and persisted ids would break
+bool CheckReferenceHashes()
+{
+    std::string bytes;
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+        bytes.push_back(static_cast<char>(i & 255));
+    }
+
+    const ReferenceHash references[] = {
+        {"", 0, 0xef46db3751d8e999ull},
+        {"a", 0, 0xd24ec4f1a98c6e5bull},
+        {"abc", 0, 0x44bc2cf5ad770999ull},
+        {"abc", 1, 0xbea9ca8199328908ull},
+        {"Nobody inspects the spammish repetition", 0, 0xfbcea83c8a378bf1ull},
+        {bytes, 0, 0x6f3914f18fe4df57ull},
+        {bytes, 1, 0x3bd9fd41c5ec08c9ull},
+    };
+    for (const ReferenceHash& reference : references)
+    {
+        if (Hash64(reference.text, reference.seed) != reference.hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::filesystem::path> MakePaths(uint32_t count)
+{
+    const char* folders[] = {"Characters", "Environment", "Props", "Terrain", "Effects"};
+    std::vector<std::filesystem::path> paths;
+    paths.reserve(count);
+    char buffer[128];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        snprintf(buffer,
+                 sizeof(buffer),
+                 "../../Assets/%s/Set%u/asset_%u_diffuse.png",
+                 folders[i % 5],
+                 i / 1000,
+                 i);
+        paths.emplace_back(buffer);
+    }
+    return paths;
+}
+} // namespace
+
+void RunHashBenchmark()
+{
+    std::vector<char> buffer(BufferSize);
+    for (size_t i = 0; i < BufferSize; ++i)
+    {
+        buffer[i] = static_cast<char>(i * 31 + (i >> 8));
+    }
+    const std::string_view bufferView(buffer.data(), buffer.size());
+    const uint64_t byteCount = static_cast<uint64_t>(BufferSize) * BufferRepeatCount;
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < BufferRepeatCount; ++i)
+        {
+            sum += std::hash<std::string_view>()(bufferView);
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("std::hash, 1 MB buffer (per byte)", byteCount, timer.GetSeconds());
+    }
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < BufferRepeatCount; ++i)
+        {
+            sum += Hash64(bufferView);
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("Hash64, 1 MB buffer (per byte)", byteCount, timer.GetSeconds());
+    }
+
+    const std::vector<std::filesystem::path> paths = MakePaths(PathCount);
+    {
+        uint64_t sum = 0;
+        Benchmark::Timer timer;
+        for (const std::filesystem::path& path : paths)
+        {
+            sum += std::filesystem::hash_value(path);
+        }
+        Benchmark::DoNotOptimize(sum);
+        Benchmark::Report("filesystem::hash_value, paths", PathCount, timer.GetSeconds());
+    }
+    std::vector<uint64_t> pathHashes;
+    pathHashes.reserve(PathCount);
+    {
+        Benchmark::Timer timer;
+        for (const std::filesystem::path& path : paths)
+        {
+            pathHashes.push_back(HashPath(path));
+        }
+        Benchmark::Report("HashPath, normalized paths", PathCount, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < PathCount; i += 10)
+        {
+            Benchmark::DoNotOptimize(StringTable::InternPath(paths[i]));
+        }
+        Benchmark::Report("StringTable::InternPath, new", PathCount / 10, timer.GetSeconds());
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < PathCount; i += 10)
+        {
+            Benchmark::DoNotOptimize(StringTable::InternPath(paths[i]));
+        }
+        Benchmark::Report("StringTable::InternPath, existing", PathCount / 10, timer.GetSeconds());
+    }
+
+    std::sort(pathHashes.begin(), pathHashes.end());
+    const size_t uniqueCount =
+        std::unique(pathHashes.begin(), pathHashes.end()) - pathHashes.begin();
+    printf("  %-40s %10zu\n", "Collisions in 1M paths", PathCount - uniqueCount);
+
+    const bool sameId =
+        HashPath("Models\\..\\Textures/./Rock.PNG") == HashPath("textures/rock.png");
+    if (!CheckReferenceHashes() || !sameId)
+    {
+        printf("  %-40s MISMATCH\n", "Hash64 reference values");
+    }
+}
@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t ThreadCount = 4;
+constexpr uint32_t MessagesPerThread = 50000;
+constexpr uint64_t MessageCount = static_cast<uint64_t>(ThreadCount) * MessagesPerThread;
+constexpr uint32_t BurstSize = 256; // Fits a thread's ring, so the caller never waits
+constexpr uint32_t BurstCount = 200;
+
+#define BENCH_MESSAGE "Worker %u finished job %u, cost %f in %s"
+constexpr const char* JobName = "Skinning";
+
+// What LOG used to do: format on the calling thread and write under the stream's lock
+void WriteSynchronous(FILE* file, std::mutex& mutex, uint32_t thread, uint32_t i, float value)
+{
+    char buffer[256];
+    snprintf(buffer,
+             std::size(buffer),
+             "{%.3f}: " BENCH_MESSAGE "\n",
+             TimeUtil::GetTime(),
+             thread,
+             i,
+             value,
+             JobName);
+    std::lock_guard<std::mutex> lock(mutex);
+    fputs(buffer, file);
+}
+
+template <class Fn> double RunThreads(Fn fn)
+{
+    std::vector<std::thread> threads;
+    Benchmark::Timer timer;
+    for (uint32_t t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&fn, t]()
+            {
+                for (uint32_t i = 0; i < MessagesPerThread; ++i)
+                {
+                    fn(t, i);
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return timer.GetSeconds();
+}
+
+size_t CountLines(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    return std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+}
+} // namespace
+
+void RunLoggingBenchmark()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path syncPath = directory / "bench_log_sync.txt";
+    const std::filesystem::path asyncPath = directory / "bench_log_async.txt";
+
+    {
+        FILE* file = fopen(syncPath.u8string().c_str(), "w");
+        std::mutex mutex;
+        const double seconds = RunThreads([&](uint32_t t, uint32_t i)
+                                          { WriteSynchronous(file, mutex, t, i, i * 0.5f); });
+        fclose(file);
+        Benchmark::Report("snprintf + locked write, 4 threads", MessageCount, seconds);
+    }
+
+    Logger::StaticInitialize(asyncPath);
+    Logger::SetConsoleEnabled(false);
+    {
+        Benchmark::Timer timer;
+        RunThreads([](uint32_t t, uint32_t i)
+                   { LOG_WARNING(Engine, BENCH_MESSAGE, t, i, i * 0.5f, JobName); });
+        Logger::Flush();
+        Benchmark::Report("Logger, sustained, 4 threads", MessageCount, timer.GetSeconds());
+    }
+    {
+        double seconds = 0.0;
+        for (uint32_t burst = 0; burst < BurstCount; ++burst)
+        {
+            Benchmark::Timer timer;
+            for (uint32_t i = 0; i < BurstSize; ++i)
+            {
+                LOG_WARNING(Engine, BENCH_MESSAGE, burst, i, i * 0.5f, JobName);
+            }
+            seconds += timer.GetSeconds();
+            Logger::Flush();
+        }
+        Benchmark::Report("Logger, caller cost in bursts", BurstSize * BurstCount, seconds);
+    }
+    {
+        Logger::SetCategoryEnabled(LogCategory::Engine, false);
+        const double seconds =
+            RunThreads([](uint32_t t, uint32_t i)
+                       { LOG_WARNING(Engine, BENCH_MESSAGE, t, i, i * 0.5f, JobName); });
+        Logger::SetCategoryEnabled(LogCategory::Engine, true);
+        Benchmark::Report("Logger, category filtered out", MessageCount, seconds);
+    }
+
+    // One message too large for a record takes the preformatted path
+    const std::string longText(1000, 'x');
+    LOG_ERROR(Engine, "%s", longText.c_str());
+    Logger::StaticTerminate();
+    Logger::SetConsoleEnabled(true);
+
+    const size_t lineCount = CountLines(asyncPath);
+    if (lineCount != MessageCount + BurstSize * BurstCount + 1 ||
+        CountLines(syncPath) != MessageCount)
+    {
+        printf("  %-40s MISMATCH %zu lines\n", "Logger output", lineCount);
+    }
+    std::filesystem::remove(syncPath);
+    std::filesystem::remove(asyncPath);
+}
@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+float MaxDifference(const std::vector<Matrix4>& a, const std::vector<Matrix4>& b)
+{
+    float maxError = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        const float* x = &a[i]._11;
+        const float* y = &b[i]._11;
+        for (int j = 0; j < 16; ++j)
+        {
+            maxError = Max(maxError, Abs(x[j] - y[j]));
+        }
+    }
+    return maxError;
+}
+
+void RunBatch(uint32_t count)
+{
+    const uint32_t repeatCount = 10'000'000 / count;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(0.0f, Constants::TwoPi);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    std::vector<Transform> transforms(count);
+    for (Transform& t : transforms)
+    {
+        const Vector3 axis = Normalize(Vector3(position(rng), position(rng), position(rng)));
+        t.position = {position(rng), position(rng), position(rng)};
+        t.rotation = Quaternion::CreateFromAxisAngle(axis, angle(rng));
+        t.scale = {scale(rng), scale(rng), scale(rng)};
+    }
+
+    std::vector<float> streams[10];
+    for (std::vector<float>& stream : streams)
+    {
+        stream.resize(count);
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const Transform& t = transforms[i];
+        const float values[10] = {t.position.x, t.position.y, t.position.z, t.rotation.x,
+                                  t.rotation.y, t.rotation.z, t.rotation.w, t.scale.x,
+                                  t.scale.y,    t.scale.z};
+        for (int s = 0; s < 10; ++s)
+        {
+            streams[s][i] = values[s];
+        }
+    }
+    TransformStreams view;
+    view.positionX = streams[0].data();
+    view.positionY = streams[1].data();
+    view.positionZ = streams[2].data();
+    view.rotationX = streams[3].data();
+    view.rotationY = streams[4].data();
+    view.rotationZ = streams[5].data();
+    view.rotationW = streams[6].data();
+    view.scaleX = streams[7].data();
+    view.scaleY = streams[8].data();
+    view.scaleZ = streams[9].data();
+
+    printf("  %u transforms\n", count);
+    const uint64_t opCount = static_cast<uint64_t>(count) * repeatCount;
+
+    std::vector<Matrix4> reference(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const Transform& t = transforms[i];
+                reference[i] = Matrix4::Scaling(t.scale) *
+                               Matrix4::MatrixRotationQuaternion(t.rotation) *
+                               Matrix4::Translation(t.position);
+            }
+            Benchmark::DoNotOptimize(reference);
+        }
+        Benchmark::Report("S * R * T", opCount, timer.GetSeconds());
+    }
+
+    std::vector<Matrix4> closedForm(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                closedForm[i] = transforms[i].GetMatrix4();
+            }
+            Benchmark::DoNotOptimize(closedForm);
+        }
+        Benchmark::Report("Matrix4::Transformation", opCount, timer.GetSeconds());
+    }
+
+    std::vector<Matrix4> aos(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            ComputeMatrices(transforms.data(), count, aos.data());
+            Benchmark::DoNotOptimize(aos);
+        }
+        Benchmark::Report("ComputeMatrices (AoS gather)", opCount, timer.GetSeconds());
+    }
+
+    std::vector<Matrix4> soa(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            ComposeTransformations(view, count, soa.data());
+            Benchmark::DoNotOptimize(soa);
+        }
+        Benchmark::Report("ComposeTransformations (SoA)", opCount, timer.GetSeconds());
+    }
+
+    std::vector<Matrix4> normalReference(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                Matrix4 m = reference[i];
+                m._41 = m._42 = m._43 = 0.0f;
+                normalReference[i] = Transpose(Inverse(m));
+            }
+            Benchmark::DoNotOptimize(normalReference);
+        }
+        Benchmark::Report("Transpose(Inverse(m))", opCount, timer.GetSeconds());
+    }
+
+    std::vector<Matrix4> normals(count);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t r = 0; r < repeatCount; ++r)
+        {
+            ComputeNormalMatrices(soa.data(), count, normals.data());
+            Benchmark::DoNotOptimize(normals);
+        }
+        Benchmark::Report("ComputeNormalMatrices", opCount, timer.GetSeconds());
+    }
+
+    printf("  %-40s %10.6f\n", "Max error, Transformation", MaxDifference(reference, closedForm));
+    printf("  %-40s %10.6f\n", "Max error, AoS batch", MaxDifference(reference, aos));
+    printf("  %-40s %10.6f\n", "Max error, SoA batch", MaxDifference(reference, soa));
+    printf("  %-40s %10.6f\n",
+           "Max error, normal matrices",
+           MaxDifference(normalReference, normals));
+}
+} // namespace
+
+void RunMatrixBenchmark()
+{
+    RunBatch(10'000);
+    RunBatch(100'000);
+}
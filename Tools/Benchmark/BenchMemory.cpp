@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t ThreadCount = 4;
+constexpr uint32_t UpdatesPerThread = 1000000;
+constexpr uint32_t TrackCount = 100000;
+constexpr uint32_t LeakCount = 3;
+
+template <class Fn> double RunThreads(Fn fn)
+{
+    std::vector<std::thread> threads;
+    Benchmark::Timer timer;
+    for (uint32_t t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&fn]()
+            {
+                for (uint32_t i = 0; i < UpdatesPerThread; ++i)
+                {
+                    fn(i);
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return timer.GetSeconds();
+}
+} // namespace
+
+void RunMemoryBenchmark()
+{
+    const size_t cpuBytes = MemoryTracker::GetCpuBytes();
+    const size_t gpuBytes = MemoryTracker::GetGpuBytes();
+    {
+        // Like ECS chunks: unnamed, every grow is matched by a shrink
+        const double seconds = RunThreads(
+            [](uint32_t i)
+            { MemoryTracker::AddBytes(MemoryTag::Ecs, (i % 2 == 0) ? 16384 : -16384); });
+        Benchmark::Report("AddBytes, 4 threads", uint64_t(ThreadCount) * UpdatesPerThread, seconds);
+    }
+
+    std::vector<MemoryAllocationId> ids(TrackCount);
+    {
+        Benchmark::Timer timer;
+        for (uint32_t i = 0; i < TrackCount; ++i)
+        {
+            ids[i] = MemoryTracker::Track(MemoryTag::Textures, 4096 + i, "Bench texture");
+        }
+        Benchmark::Report("Track, named", TrackCount, timer.GetSeconds());
+    }
+    const size_t trackedGpuBytes = MemoryTracker::GetGpuBytes();
+    {
+        Benchmark::Timer timer;
+        for (MemoryAllocationId id : ids)
+        {
+            MemoryTracker::Untrack(id);
+        }
+        Benchmark::Report("Untrack, named", TrackCount, timer.GetSeconds());
+    }
+
+    const size_t expectedBytes =
+        size_t(TrackCount) * 4096 + size_t(TrackCount) * (TrackCount - 1) / 2;
+    bool isValid = (trackedGpuBytes - gpuBytes == expectedBytes);
+    isValid &= (MemoryTracker::GetCpuBytes() == cpuBytes);
+    isValid &= (MemoryTracker::GetGpuBytes() == gpuBytes);
+    isValid &= (MemoryTracker::GetPeakBytes(MemoryTag::Textures) >= expectedBytes);
+
+    // Everything still tracked at the end of a run shows up in the leak report
+    MemoryAllocationId leaks[LeakCount];
+    for (uint32_t i = 0; i < LeakCount; ++i)
+    {
+        leaks[i] = MemoryTracker::Track(MemoryTag::Buffers, 256, "Bench buffer");
+    }
+    Logger::SetConsoleEnabled(false);
+    isValid &= (MemoryTracker::ReportLeaks() == LeakCount);
+    Logger::SetConsoleEnabled(true);
+    for (MemoryAllocationId id : leaks)
+    {
+        MemoryTracker::Untrack(id);
+    }
+    isValid &= (MemoryTracker::ReportLeaks() == 0);
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Memory totals");
+    }
+}
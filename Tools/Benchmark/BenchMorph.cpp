@@ -0,0 +1,165 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t GridWidth = 200;
+constexpr uint32_t GridHeight = 100;
+constexpr uint32_t TargetCount = 48;
+constexpr uint32_t ActiveTargetCount = 6;
+constexpr float RegionRadius = 0.03f;
+constexpr uint32_t FrameCount = 200;
+
+// A face sized sheet of vertices, rows of GridWidth
+Mesh CreateSheet()
+{
+    Mesh mesh;
+    for (uint32_t y = 0; y < GridHeight; ++y)
+    {
+        for (uint32_t x = 0; x < GridWidth; ++x)
+        {
+            Vertex& vertex = mesh.vertices.emplace_back();
+            vertex.position = {x * 0.002f, y * 0.002f, 0.0f};
+            vertex.normal = {0.0f, 0.0f, -1.0f};
+            vertex.tangent = {1.0f, 0.0f, 0.0f};
+            vertex.uvCoord = {static_cast<float>(x) / GridWidth,
+                              static_cast<float>(y) / GridHeight};
+        }
+    }
+    return mesh;
+}
+
+// Each shape bulges a small disc of the sheet, like a facial expression moving one feature
+void CreateShape(const Mesh& mesh,
+                 uint32_t index,
+                 std::vector<Vector3>& positions,
+                 std::vector<Vector3>& normals)
+{
+    const Vector3 center(0.4f * ((index * 37) % 101) / 100.0f,
+                         0.2f * ((index * 53) % 97) / 96.0f,
+                         0.0f);
+    for (size_t v = 0; v < mesh.vertices.size(); ++v)
+    {
+        const Vertex& vertex = mesh.vertices[v];
+        const float distance = Distance(vertex.position, center);
+        const float falloff = Max(0.0f, 1.0f - distance / RegionRadius);
+        positions[v] = vertex.position + Vector3(0.0f, 0.0f, -0.01f * falloff * falloff);
+        normals[v] = Normalize(vertex.normal + (vertex.position - center) * falloff);
+    }
+}
+
+// Float offsets for every vertex of every target, every target applied every frame
+void ApplyDense(const Mesh& mesh,
+                const std::vector<std::vector<Vector3>>& positionOffsets,
+                const std::vector<std::vector<Vector3>>& normalOffsets,
+                const float* weights,
+                Vertex* output)
+{
+    for (size_t v = 0; v < mesh.vertices.size(); ++v)
+    {
+        Vector3 position = mesh.vertices[v].position;
+        Vector3 normal = mesh.vertices[v].normal;
+        for (uint32_t t = 0; t < TargetCount; ++t)
+        {
+            position += positionOffsets[t][v] * weights[t];
+            normal += normalOffsets[t][v] * weights[t];
+        }
+        output[v].position = position;
+        output[v].normal = Normalize(normal);
+    }
+}
+} // namespace
+
+void RunMorphBenchmark()
+{
+    const Mesh mesh = CreateSheet();
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+
+    std::vector<MorphTarget> targets;
+    std::vector<std::vector<Vector3>> positionOffsets(TargetCount);
+    std::vector<std::vector<Vector3>> normalOffsets(TargetCount);
+    std::vector<Vector3> positions(vertexCount);
+    std::vector<Vector3> normals(vertexCount);
+    size_t sparseBytes = 0;
+    uint32_t storedVertices = 0;
+    for (uint32_t t = 0; t < TargetCount; ++t)
+    {
+        CreateShape(mesh, t, positions, normals);
+        const std::string name = "Shape" + std::to_string(t);
+        const MorphTarget& target = targets.emplace_back(
+            MorphTarget::Build(name, mesh, positions.data(), normals.data()));
+        sparseBytes += target.GetMemorySize();
+        storedVertices += target.GetVertexCount();
+
+        positionOffsets[t].resize(vertexCount);
+        normalOffsets[t].resize(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            positionOffsets[t][v] = positions[v] - mesh.vertices[v].position;
+            normalOffsets[t][v] = normals[v] - mesh.vertices[v].normal;
+        }
+    }
+
+    printf("  %u vertices, %u targets, %u active, %.1f%% of vertices per target\n",
+           vertexCount,
+           TargetCount,
+           ActiveTargetCount,
+           100.0f * storedVertices / (TargetCount * vertexCount));
+    printf("  %-40s %10zu KB\n",
+           "Dense float offsets",
+           TargetCount * vertexCount * sizeof(Vector3) * 2 / 1024);
+    printf("  %-40s %10zu KB\n", "Sparse quantized deltas", sparseBytes / 1024);
+
+    // A few expressions fade in and out at once, the rest stay at zero
+    std::vector<std::vector<float>> weights(FrameCount, std::vector<float>(TargetCount, 0.0f));
+    for (uint32_t f = 0; f < FrameCount; ++f)
+    {
+        for (uint32_t a = 0; a < ActiveTargetCount; ++a)
+        {
+            const uint32_t t = (f / 20 + a * 7) % TargetCount;
+            weights[f][t] = 0.5f + 0.5f * sinf(f * 0.1f + a);
+        }
+    }
+
+    std::vector<Vertex> dense = mesh.vertices;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            ApplyDense(mesh, positionOffsets, normalOffsets, weights[f].data(), dense.data());
+            Benchmark::DoNotOptimize(dense);
+        }
+        Benchmark::Report("Dense, every target (per frame)", FrameCount, timer.GetSeconds());
+    }
+
+    Morpher morpher;
+    morpher.Initialize(mesh, targets);
+    std::vector<Vertex> sparse = mesh.vertices;
+    uint64_t writtenVertices = 0;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            morpher.Apply(weights[f].data(), sparse.data());
+            for (const VertexRange& range : morpher.GetChangedRanges())
+            {
+                writtenVertices += range.end - range.begin;
+            }
+            Benchmark::DoNotOptimize(sparse);
+        }
+        Benchmark::Report("Sparse, active targets (per frame)", FrameCount, timer.GetSeconds());
+    }
+
+    float maxError = 0.0f;
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        maxError = Max(maxError, Distance(dense[v].position, sparse[v].position));
+    }
+    printf("  %-40s %9.1f%%\n",
+           "Vertices written per frame",
+           100.0 * writtenVertices / (static_cast<uint64_t>(FrameCount) * vertexCount));
+    printf("  %-40s %10.7f\n", "Max error, sparse vs dense", maxError);
+}
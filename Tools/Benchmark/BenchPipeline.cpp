@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::ECS;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t GridSize = 32;
+constexpr uint32_t EntityCount = GridSize * GridSize;
+constexpr uint32_t FrameCount = 200;
+
+// A grid of bobbing spheres: the simulation moves every transform, the submission draws them
+class GridState final : public AppState
+{
+  public:
+    GridState(World& world, StandardEffect& effect)
+        : mWorld(world)
+        , mEffect(effect)
+    {
+    }
+
+    void Simulate(float deltaTime, RenderSnapshot& snapshot) override
+    {
+        mTime += deltaTime;
+        const float time = mTime;
+        mWorld.ForEach<Transform>(
+            [time](Entity, Transform& transform)
+            { transform.position.y = sinf(time + transform.position.x * 0.3f); });
+        UpdateWorldMatrices(mWorld);
+        BuildRenderSnapshot(mWorld, snapshot);
+        snapshot.camera = mCamera;
+        snapshot.directionalLight = mDirectionalLight;
+    }
+
+    void Submit(const RenderSnapshot& snapshot) override
+    {
+        mEffect.SetCamera(snapshot.camera);
+        mEffect.SetDirectionalLight(snapshot.directionalLight);
+        mEffect.Begin();
+        RenderScene(snapshot, mEffect);
+        mEffect.End();
+        mDrawCount += static_cast<uint32_t>(snapshot.meshes.size());
+    }
+
+    Camera mCamera;
+    DirectionalLight mDirectionalLight;
+    uint32_t mDrawCount = 0;
+
+  private:
+    World& mWorld;
+    StandardEffect& mEffect;
+    float mTime = 0.0f;
+};
+} // namespace
+
+// Sequential frames against pipelined ones on the null device. The pipelined loop only wins when
+// a worker is free to simulate while the main thread submits; on a single core both do the same
+// work and the difference is the cost of handing the snapshot over.
+void RunPipelineBenchmark()
+{
+    GraphicsSystem::StaticInitialize(1280, 720);
+    TextureManager::StaticInitialize("");
+    GraphicsSystem* gs = GraphicsSystem::Get();
+
+    StandardEffect effect;
+    effect.Initialize("Standard.fx"); // Not read, the null device compiles no shaders
+
+    RenderObject sphere;
+    sphere.meshBuffer.Initialize(MeshBuilder::CreateSphere(16, 16, 0.4f));
+
+    World world;
+    for (uint32_t i = 0; i < EntityCount; ++i)
+    {
+        Transform transform;
+        transform.position = {
+            static_cast<float>(i % GridSize), 0.0f, static_cast<float>(i / GridSize)};
+        world.Create(transform, WorldMatrix(), MeshRenderer{&sphere});
+    }
+
+    GridState state(world, effect);
+    state.mCamera.SetPosition({GridSize * 0.5f, 10.0f, -10.0f});
+    state.mCamera.SetLookAt({GridSize * 0.5f, 0.0f, GridSize * 0.5f});
+    const float deltaTime = 1.0f / 60.0f;
+
+    RenderSnapshot snapshot;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < FrameCount; ++frame)
+        {
+            snapshot.meshes.clear();
+            state.Simulate(deltaTime, snapshot);
+            gs->BeginRender();
+            state.Submit(snapshot);
+            gs->EndRender();
+        }
+        Benchmark::Report("Sequential frame", FrameCount, timer.GetSeconds());
+    }
+    const uint32_t sequentialDrawCount = state.mDrawCount;
+    const uint64_t sequentialCallCount = NullDevice::GetFrameCallCount();
+
+    // One extra kick, the first one has nothing to submit yet
+    state.mDrawCount = 0;
+    FramePipeline pipeline;
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame <= FrameCount; ++frame)
+        {
+            const RenderSnapshot* submitSnapshot = pipeline.Kick(state, deltaTime);
+            gs->BeginRender();
+            if (submitSnapshot != nullptr)
+            {
+                state.Submit(*submitSnapshot);
+            }
+            gs->EndRender();
+        }
+        pipeline.Wait();
+        Benchmark::Report("Pipelined frame", FrameCount, timer.GetSeconds());
+    }
+    printf("  %-40s %10u\n", "Workers", Core::JobSystem::Get()->GetWorkerCount());
+
+    bool isValid = (sequentialDrawCount == EntityCount * FrameCount);
+    isValid &= (state.mDrawCount == EntityCount * FrameCount);
+    isValid &= (NullDevice::GetFrameCallCount() == sequentialCallCount);
+    isValid &= (NullDevice::GetFrameCallCount(GraphicsApiCall::Draw) == EntityCount);
+
+    pipeline.Reset();
+    sphere.Terminate();
+    effect.Terminate();
+    TextureManager::StaticTerminate();
+    GraphicsSystem::StaticTerminate();
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Pipelined draws");
+    }
+}
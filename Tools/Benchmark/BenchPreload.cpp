@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+namespace
+{
+const char* const ModelFiles[] = {
+    "Character_01/Character_01.model", "parasite/parasite.model", "zombie/zombie.model"};
+const char* const TextureFiles[] = {"earth.jpg", "earth_normal.jpg", "earth_spec.jpg", "paper.jpg"};
+const char* const SharedTextureFile = "earth.jpg"; // Used by the old state too
+
+void StartManagers()
+{
+    TextureManager::StaticInitialize(L"Assets/Textures");
+    ModelManager::StaticInitialize(L"Assets/Models");
+}
+
+void StopManagers()
+{
+    ModelManager::StaticTerminate();
+    TextureManager::StaticTerminate();
+}
+
+// What the next state's Initialize does with the assets
+void LoadAll(std::vector<TextureId>& textureIds)
+{
+    for (const char* modelFile : ModelFiles)
+    {
+        ModelManager::Get()->LoadModel(modelFile);
+    }
+    for (const char* textureFile : TextureFiles)
+    {
+        textureIds.push_back(TextureManager::Get()->LoadTexture(textureFile));
+    }
+}
+
+void ReleaseAll(std::vector<TextureId>& textureIds)
+{
+    for (TextureId textureId : textureIds)
+    {
+        TextureManager::Get()->ReleaseTexture(textureId);
+    }
+    textureIds.clear();
+}
+} // namespace
+
+// A state switch with and without preloading, from the main thread's point of view: the longest
+// stall is what shows up as a hitch. Reads the assets, so it runs from the repository root.
+void RunPreloadBenchmark()
+{
+    if (!std::filesystem::exists("Assets/Models"))
+    {
+        printf("  Skipped, run from the repository root\n");
+        return;
+    }
+
+    GraphicsSystem::StaticInitialize(1280, 720);
+    std::vector<TextureId> textureIds;
+    bool isValid = true;
+
+    StartManagers();
+    {
+        Benchmark::Timer timer;
+        LoadAll(textureIds);
+        const double seconds = timer.GetSeconds();
+        printf("  %-40s %10.3f ms\n", "Switch stall, loading in Initialize", seconds * 1e3);
+    }
+    ReleaseAll(textureIds);
+    StopManagers();
+
+    StartManagers();
+    const TextureId sharedId = TextureManager::Get()->LoadTexture(SharedTextureFile);
+    AssetManifest manifest;
+    manifest.models.assign(std::begin(ModelFiles), std::end(ModelFiles));
+    manifest.textures.assign(std::begin(TextureFiles), std::end(TextureFiles));
+
+    // The old state keeps its frames going, each one hands finished assets over
+    AssetPreloader preloader;
+    double longestUpdate = 0.0;
+    uint32_t frameCount = 0;
+    Benchmark::Timer preloadTimer;
+    preloader.Begin(manifest);
+    for (bool isDone = false; !isDone; ++frameCount)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Benchmark::Timer timer;
+        isDone = preloader.Update();
+        longestUpdate = std::max(longestUpdate, timer.GetSeconds());
+    }
+    const double preloadSeconds = preloadTimer.GetSeconds();
+
+    // The switch: the old state lets go of the shared texture, the new one finds everything
+    TextureManager::Get()->ReleaseTexture(sharedId);
+    isValid &= (TextureManager::Get()->FindTexture(SharedTextureFile) != Core::InvalidHandle);
+    const uint32_t preloadedObjectCount = NullDevice::GetLiveObjectCount();
+    Benchmark::Timer switchTimer;
+    LoadAll(textureIds);
+    const double switchSeconds = switchTimer.GetSeconds();
+    isValid &= (NullDevice::GetLiveObjectCount() == preloadedObjectCount);
+
+    // The materials' textures were preloaded too, for the render groups
+    TextureManager* tm = TextureManager::Get();
+    for (const char* modelFile : ModelFiles)
+    {
+        const ModelId modelId = ModelManager::Get()->GetModelId(modelFile);
+        const Model* model = ModelManager::Get()->GetModel(modelId);
+        isValid &= (model != nullptr);
+        if (model == nullptr)
+        {
+            continue;
+        }
+        for (const Model::MaterialData& materialData : model->materialData)
+        {
+            const std::string& name = materialData.diffuseMapName;
+            isValid &= name.empty() || tm->FindTexture(name) != Core::InvalidHandle;
+        }
+    }
+    preloader.Release();
+
+    printf("  %-40s %10.3f ms\n", "Switch stall, preloaded", switchSeconds * 1e3);
+    printf("  %-40s %10.3f ms\n", "Longest Update while preloading", longestUpdate * 1e3);
+    printf("  %-40s %10.3f ms, %u frames\n", "Preload", preloadSeconds * 1e3, frameCount);
+
+    // Once the new state lets go, nothing is left behind by the preloader
+    ReleaseAll(textureIds);
+    for (const char* textureFile : TextureFiles)
+    {
+        isValid &= (TextureManager::Get()->FindTexture(textureFile) == Core::InvalidHandle);
+    }
+
+    StopManagers();
+    GraphicsSystem::StaticTerminate();
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Preloaded assets");
+    }
+}
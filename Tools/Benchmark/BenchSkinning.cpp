@@ -0,0 +1,263 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+constexpr uint32_t CharacterCount = 200;
+constexpr uint32_t BoneCount = 32;
+constexpr uint32_t RingCount = 100;
+constexpr uint32_t RingVertexCount = 60;
+constexpr float Height = 2.0f;
+constexpr float BoneLength = Height / BoneCount;
+constexpr uint32_t FrameCount = 20;
+
+void ReportFrame(const char* name, double seconds)
+{
+    printf("  %-40s %10.3f ms\n", name, seconds * 1000.0 / FrameCount);
+}
+
+// A chain of bones up the y axis
+Skeleton CreateSkeleton()
+{
+    Skeleton skeleton;
+    skeleton.bones.resize(BoneCount);
+    for (uint32_t b = 0; b < BoneCount; ++b)
+    {
+        Bone& bone = skeleton.bones[b];
+        bone.name = "Bone" + std::to_string(b);
+        bone.parentIndex = static_cast<int>(b) - 1;
+        bone.restTransform.position = {0.0f, (b == 0) ? 0.0f : BoneLength, 0.0f};
+        bone.offsetTransform = Matrix4::Translation({0.0f, -BoneLength * b, 0.0f});
+    }
+    skeleton.BuildRestPose();
+    return skeleton;
+}
+
+// A tube around the chain, each vertex weighted to the four nearest bones. Rigid meshes use the
+// nearest bone only.
+void CreateTube(Mesh& mesh, std::vector<BoneWeights>& boneWeights, bool rigid)
+{
+    for (uint32_t r = 0; r < RingCount; ++r)
+    {
+        const float y = Height * r / (RingCount - 1);
+        for (uint32_t i = 0; i < RingVertexCount; ++i)
+        {
+            const float angle = Constants::TwoPi * i / RingVertexCount;
+            Vertex& vertex = mesh.vertices.emplace_back();
+            vertex.normal = {cosf(angle), 0.0f, sinf(angle)};
+            vertex.position = vertex.normal * 0.2f + Vector3(0.0f, y, 0.0f);
+            vertex.tangent = {-sinf(angle), 0.0f, cosf(angle)};
+            vertex.uvCoord = {static_cast<float>(i) / RingVertexCount, y / Height};
+
+            BoneWeights& weights = boneWeights.emplace_back();
+            const float bonePosition = Min(y / BoneLength, BoneCount - 1.0f);
+            const int nearest = static_cast<int>(bonePosition + 0.5f);
+            if (rigid)
+            {
+                weights.boneIndices[0] = static_cast<uint16_t>(Min(nearest, int(BoneCount) - 1));
+                weights.weights[0] = 1.0f;
+                continue;
+            }
+
+            float total = 0.0f;
+            for (int k = 0; k < 4; ++k)
+            {
+                const int bone = Clamp(nearest - 2 + k, 0, int(BoneCount) - 1);
+                const float weight = Max(0.0f, 2.0f - Abs(bonePosition - bone));
+                weights.boneIndices[k] = static_cast<uint16_t>(bone);
+                weights.weights[k] = weight;
+                total += weight;
+            }
+            for (float& weight : weights.weights)
+            {
+                weight /= total;
+            }
+        }
+    }
+
+    for (uint32_t r = 0; r + 1 < RingCount; ++r)
+    {
+        for (uint32_t i = 0; i < RingVertexCount; ++i)
+        {
+            const uint32_t a = r * RingVertexCount + i;
+            const uint32_t b = r * RingVertexCount + (i + 1) % RingVertexCount;
+            mesh.indices.insert(mesh.indices.end(), {a, a + RingVertexCount, b});
+            mesh.indices.insert(mesh.indices.end(), {b, a + RingVertexCount, b + RingVertexCount});
+        }
+    }
+}
+
+AnimationClip CreateClip(const Skeleton& skeleton)
+{
+    RawAnimationClip raw;
+    raw.name = "Bend";
+    raw.duration = 2.0f;
+    raw.tracks.resize(BoneCount);
+    for (uint32_t b = 1; b < BoneCount; ++b)
+    {
+        for (uint32_t k = 0; k <= 60; ++k)
+        {
+            const float time = raw.duration * k / 60.0f;
+            const float angle = 0.08f * sinf(time * Constants::Pi + b * 0.2f);
+            const Quaternion rotation = Quaternion::CreateFromAxisAngle(
+                Normalize(Vector3(1.0f, 0.0f, (b & 1) ? 0.5f : -0.5f)), angle);
+            raw.tracks[b].rotationKeys.push_back({rotation, time});
+        }
+    }
+    return AnimationClip::Compress(raw, skeleton);
+}
+
+// What skinning looks like without the SoA kernels, one vertex at a time
+void SkinReference(const Mesh& mesh,
+                   const std::vector<BoneWeights>& boneWeights,
+                   const Matrix4* skinningMatrices,
+                   Vertex* output)
+{
+    for (size_t v = 0; v < mesh.vertices.size(); ++v)
+    {
+        Matrix4 blended(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        for (uint32_t k = 0; k < BoneWeights::MaxInfluences; ++k)
+        {
+            blended = blended +
+                      skinningMatrices[boneWeights[v].boneIndices[k]] * boneWeights[v].weights[k];
+        }
+
+        const Vertex& vertex = mesh.vertices[v];
+        output[v].position = TransformCoord(vertex.position, blended);
+        output[v].normal = Normalize(TransformNormal(vertex.normal, blended));
+        output[v].tangent = Normalize(TransformNormal(vertex.tangent, blended));
+        output[v].uvCoord = vertex.uvCoord;
+    }
+}
+
+float MaxPositionError(const std::vector<Vertex>& a, const std::vector<Vertex>& b)
+{
+    float maxError = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        maxError = Max(maxError, Distance(a[i].position, b[i].position));
+    }
+    return maxError;
+}
+} // namespace
+
+void RunSkinningBenchmark()
+{
+    const Skeleton skeleton = CreateSkeleton();
+    const AnimationClip clip = CreateClip(skeleton);
+
+    Mesh mesh;
+    std::vector<BoneWeights> boneWeights;
+    CreateTube(mesh, boneWeights, false);
+    SkinnedMesh skinnedMesh;
+    skinnedMesh.Initialize(mesh, boneWeights);
+
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    printf("  %u characters, %u bones, %u vertices each, %u worker threads\n",
+           CharacterCount,
+           BoneCount,
+           vertexCount,
+           Core::JobSystem::Get()->GetWorkerCount());
+
+    // Every character plays the clip at its own time
+    std::vector<std::vector<Matrix4>> skinningMatrices(CharacterCount);
+    std::vector<std::vector<DualQuaternion>> dualQuaternions(CharacterCount);
+    std::vector<std::vector<Vertex>> outputs(CharacterCount);
+    std::vector<Matrix4> modelMatrices(BoneCount);
+    Pose pose;
+    for (uint32_t c = 0; c < CharacterCount; ++c)
+    {
+        clip.Sample(skeleton, c * 0.037f, true, pose);
+        ComputeModelMatrices(skeleton, pose, modelMatrices.data());
+        skinningMatrices[c].resize(BoneCount);
+        ComputeSkinningMatrices(skeleton, modelMatrices.data(), skinningMatrices[c].data());
+        dualQuaternions[c].resize(BoneCount);
+        outputs[c].resize(vertexCount);
+    }
+
+    const uint64_t vertexOps = static_cast<uint64_t>(FrameCount) * CharacterCount * vertexCount;
+
+    std::vector<std::vector<Vertex>> reference(CharacterCount);
+    for (std::vector<Vertex>& vertices : reference)
+    {
+        vertices.resize(vertexCount);
+    }
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            for (uint32_t c = 0; c < CharacterCount; ++c)
+            {
+                SkinReference(mesh, boneWeights, skinningMatrices[c].data(), reference[c].data());
+            }
+            Benchmark::DoNotOptimize(reference);
+        }
+        const double seconds = timer.GetSeconds();
+        Benchmark::Report("Scalar per vertex (per vertex)", vertexOps, seconds);
+        ReportFrame("Scalar per vertex, crowd frame", seconds);
+    }
+
+    std::vector<SkinningJob> jobs(CharacterCount);
+    for (uint32_t c = 0; c < CharacterCount; ++c)
+    {
+        jobs[c].mesh = &skinnedMesh;
+        jobs[c].skinningMatrices = skinningMatrices[c].data();
+        jobs[c].dualQuaternions = dualQuaternions[c].data();
+        jobs[c].output = outputs[c].data();
+    }
+
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            SkinMeshes(jobs.data(), CharacterCount, SkinningMethod::Linear);
+            Benchmark::DoNotOptimize(outputs);
+        }
+        const double seconds = timer.GetSeconds();
+        Benchmark::Report("SoA linear blend (per vertex)", vertexOps, seconds);
+        ReportFrame("SoA linear blend, crowd frame", seconds);
+    }
+
+    float linearError = 0.0f;
+    for (uint32_t c = 0; c < CharacterCount; ++c)
+    {
+        linearError = Max(linearError, MaxPositionError(reference[c], outputs[c]));
+    }
+
+    {
+        Benchmark::Timer timer;
+        for (uint32_t f = 0; f < FrameCount; ++f)
+        {
+            for (uint32_t c = 0; c < CharacterCount; ++c)
+            {
+                ComputeDualQuaternions(
+                    skinningMatrices[c].data(), BoneCount, dualQuaternions[c].data());
+            }
+            SkinMeshes(jobs.data(), CharacterCount, SkinningMethod::DualQuaternion);
+            Benchmark::DoNotOptimize(outputs);
+        }
+        const double seconds = timer.GetSeconds();
+        Benchmark::Report("SoA dual quaternion (per vertex)", vertexOps, seconds);
+        ReportFrame("SoA dual quaternion, crowd frame", seconds);
+    }
+
+    // With one influence per vertex both methods are the same rigid transform
+    Mesh rigidMesh;
+    std::vector<BoneWeights> rigidWeights;
+    CreateTube(rigidMesh, rigidWeights, true);
+    SkinnedMesh rigidSkinnedMesh;
+    rigidSkinnedMesh.Initialize(rigidMesh, rigidWeights);
+    std::vector<Vertex> linear(vertexCount);
+    std::vector<Vertex> dual(vertexCount);
+    rigidSkinnedMesh.SkinLinear(skinningMatrices[7].data(), 0, vertexCount, linear.data());
+    rigidSkinnedMesh.SkinDualQuaternion(dualQuaternions[7].data(), 0, vertexCount, dual.data());
+
+    printf("  %-40s %10.6f\n", "Max error, linear vs scalar", linearError);
+    printf("  %-40s %10.6f\n",
+           "Max error, rigid dual quat vs linear",
+           MaxPositionError(linear, dual));
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Core;
+
+namespace
+{
+constexpr uint32_t TaskCount = 10000;
+constexpr uint32_t LoadCount = 6;
+constexpr auto DeviceTime = std::chrono::milliseconds(20);
+constexpr auto LoadTime = std::chrono::milliseconds(30);
+
+// Every task checks that its dependencies finished first
+struct OrderCheck
+{
+    std::vector<std::atomic<bool>> isDone;
+    std::atomic<bool> isValid{true};
+
+    explicit OrderCheck(uint32_t count)
+        : isDone(count)
+    {
+    }
+
+    void Finish(TaskId id, std::initializer_list<TaskId> dependencies)
+    {
+        for (TaskId dependency : dependencies)
+        {
+            if (!isDone[dependency].load())
+            {
+                isValid = false;
+            }
+        }
+        isDone[id] = true;
+    }
+};
+} // namespace
+
+void RunTaskGraphBenchmark()
+{
+    bool isValid = true;
+
+    // Scheduling cost: one root releasing every other task, then a chain where each task waits
+    // for the one before
+    {
+        OrderCheck check(TaskCount);
+        TaskGraph graph;
+        const TaskId root = graph.Add("Root", [&check]() { check.Finish(0, {}); });
+        for (TaskId i = 1; i < TaskCount; ++i)
+        {
+            graph.Add("Fan out", [&check, i]() { check.Finish(i, {0}); }, {root});
+        }
+        Benchmark::Timer timer;
+        graph.Run();
+        Benchmark::Report("Fan out, per task", TaskCount, timer.GetSeconds());
+        isValid &= check.isValid;
+    }
+    {
+        OrderCheck check(TaskCount);
+        TaskGraph graph;
+        graph.Add("Chain", [&check]() { check.Finish(0, {}); });
+        for (TaskId i = 1; i < TaskCount; ++i)
+        {
+            const TaskThread thread = (i % 2 == 0) ? TaskThread::Main : TaskThread::Any;
+            graph.Add("Chain", [&check, i]() { check.Finish(i, {i - 1}); }, {i - 1}, thread);
+        }
+        Benchmark::Timer timer;
+        graph.Run();
+        Benchmark::Report("Chain, alternating threads, per task", TaskCount, timer.GetSeconds());
+        isValid &= check.isValid;
+    }
+
+    // Startup shaped graph: a main thread chain standing in for window and device creation, and
+    // loads sleeping like file reads. Half the loads need the device.
+    auto sleepFor = [](auto duration)
+    { return [duration]() { std::this_thread::sleep_for(duration); }; };
+    TaskGraph startup;
+    const TaskId window = startup.Add("Window", sleepFor(DeviceTime), {}, TaskThread::Main);
+    const TaskId device = startup.Add("Device", sleepFor(DeviceTime), {window}, TaskThread::Main);
+    startup.Add("DebugUI", sleepFor(DeviceTime), {device}, TaskThread::Main);
+    for (uint32_t i = 0; i < LoadCount; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            startup.Add("Parse", sleepFor(LoadTime));
+        }
+        else
+        {
+            startup.Add("Upload", sleepFor(LoadTime), {device});
+        }
+    }
+    startup.Run();
+
+    const double sequentialMs =
+        std::chrono::duration<double, std::milli>(DeviceTime * 3 + LoadTime * LoadCount).count();
+    printf("  %-40s %10.1f ms\n", "Startup, sequential", sequentialMs);
+    printf("  %-40s %10.1f ms\n", "Startup, task graph", startup.GetTotalMs());
+    printf("  %-40s %10u\n", "Workers", JobSystem::Get()->GetWorkerCount());
+    isValid &= (startup.GetTotalMs() < sequentialMs);
+    for (const TaskGraph::TaskTiming& timing : startup.GetTimings())
+    {
+        isValid &= (timing.endMs >= timing.startMs && timing.endMs <= startup.GetTotalMs());
+    }
+
+    if (!isValid)
+    {
+        printf("  %-40s MISMATCH\n", "Task order");
+    }
+}
@@ -0,0 +1,120 @@
+#include "Benchmark.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+using namespace Engine::Math;
+
+namespace
+{
+// Wide and shallow, like a scene of characters: roots with children with grandchildren
+void BuildHierarchy(TransformHierarchy& hierarchy,
+                    std::vector<TransformNodeId>& nodes,
+                    uint32_t rootCount,
+                    uint32_t fanOut,
+                    uint32_t depth)
+{
+    std::vector<TransformNodeId> level;
+    for (uint32_t i = 0; i < rootCount; ++i)
+    {
+        level.push_back(hierarchy.Create());
+    }
+    nodes.insert(nodes.end(), level.begin(), level.end());
+
+    for (uint32_t d = 1; d < depth; ++d)
+    {
+        std::vector<TransformNodeId> next;
+        for (TransformNodeId parent : level)
+        {
+            for (uint32_t c = 0; c < fanOut; ++c)
+            {
+                const TransformNodeId node = hierarchy.Create(parent);
+                hierarchy.SetPosition(node, {1.0f, 0.0f, 0.0f});
+                next.push_back(node);
+            }
+        }
+        nodes.insert(nodes.end(), next.begin(), next.end());
+        level = std::move(next);
+    }
+}
+
+Matrix4 ComputeWorld(const TransformHierarchy& hierarchy, TransformNodeId node)
+{
+    const Matrix4 local = hierarchy.GetLocal(node).GetMatrix4();
+    const TransformNodeId parent = hierarchy.GetParent(node);
+    return (parent == InvalidTransformNode) ? local : local * ComputeWorld(hierarchy, parent);
+}
+} // namespace
+
+void RunTransformBenchmark()
+{
+    constexpr uint32_t frameCount = 100;
+
+    TransformHierarchy hierarchy;
+    std::vector<TransformNodeId> nodes;
+    BuildHierarchy(hierarchy, nodes, 1000, 4, 4);
+    const uint32_t nodeCount = hierarchy.GetNodeCount();
+    {
+        Benchmark::Timer timer;
+        hierarchy.Update();
+        Benchmark::Report("First update (rebuild order)", nodeCount, timer.GetSeconds());
+    }
+    printf("  %u nodes, %u levels\n", nodeCount, hierarchy.GetLevelCount());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> angle(0.0f, Constants::TwoPi);
+
+    // Every root moves, every node's world matrix changes
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                hierarchy.SetRotation(nodes[i],
+                                      Quaternion::CreateFromAxisAngle(Vector3::YAxis, angle(rng)));
+            }
+            hierarchy.Update();
+        }
+        Benchmark::Report("Update, all roots moved", nodeCount * frameCount, timer.GetSeconds());
+    }
+
+    // A few leaves move, most of the tree is skipped by the dirty flags
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (uint32_t i = 0; i < 100; ++i)
+            {
+                const TransformNodeId node = nodes[nodes.size() - 1 - i * 97];
+                hierarchy.SetRotation(node,
+                                      Quaternion::CreateFromAxisAngle(Vector3::YAxis, angle(rng)));
+            }
+            hierarchy.Update();
+        }
+        Benchmark::Report("Update, 100 leaves moved", nodeCount * frameCount, timer.GetSeconds());
+    }
+
+    // Reference: recomputing every world matrix from its chain of parents
+    {
+        Benchmark::Timer timer;
+        for (uint32_t frame = 0; frame < 10; ++frame)
+        {
+            for (TransformNodeId node : nodes)
+            {
+                const Matrix4 world = ComputeWorld(hierarchy, node);
+                Benchmark::DoNotOptimize(world);
+            }
+        }
+        Benchmark::Report("Recompute from scratch", nodeCount * 10, timer.GetSeconds());
+    }
+
+    // Cached results should match the reference
+    float maxError = 0.0f;
+    for (TransformNodeId node : nodes)
+    {
+        const Matrix4 expected = ComputeWorld(hierarchy, node);
+        const Matrix4& cached = hierarchy.GetWorldMatrix(node);
+        maxError = Max(maxError, Abs(expected._41 - cached._41) + Abs(expected._43 - cached._43));
+    }
+    printf("  %-40s %10.6f\n", "Max translation error", maxError);
+}
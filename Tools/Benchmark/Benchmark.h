@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Engine/Inc/Engine.h>
+
+namespace Benchmark
+{
+class Timer
+{
+  public:
+    Timer()
+        : mStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    double GetSeconds() const
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - mStart;
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point mStart;
+};
+
+// Prints one result row: total time, time per operation and operations per second
+inline void Report(const char* name, uint64_t operationCount, double seconds)
+{
+    const double nsPerOp = (operationCount > 0) ? seconds * 1e9 / operationCount : 0.0;
+    const double opsPerSecond = (seconds > 0.0) ? operationCount / seconds : 0.0;
+    printf("  %-40s %10.3f ms %12.1f ns/op %14.0f op/s\n",
+           name,
+           seconds * 1000.0,
+           nsPerOp,
+           opsPerSecond);
+}
+
+// Keeps the optimizer from discarding a result
+template <class T> void DoNotOptimize(const T& value)
+{
+    static const T* volatile sink = nullptr;
+    sink = &value;
+}
+} // namespace Benchmark
+
+void RunAABBTreeBenchmark();
+void RunAllocatorBenchmark();
+void RunAnimationBenchmark();
+void RunAnimGraphBenchmark();
+void RunConcurrencyBenchmark();
+void RunContainersBenchmark();
+void RunCountersBenchmark();
+void RunECSBenchmark();
+void RunGraphicsBenchmark();
+void RunHashBenchmark();
+void RunLoggingBenchmark();
+void RunMatrixBenchmark();
+void RunMemoryBenchmark();
+void RunMorphBenchmark();
+void RunPipelineBenchmark();
+void RunPreloadBenchmark();
+void RunSkinningBenchmark();
+void RunTaskGraphBenchmark();
+void RunTransformBenchmark();
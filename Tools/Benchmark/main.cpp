@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+struct Suite
+{
+    const char* name;
+    void (*run)();
+};
+
+const Suite gSuites[] = {
+    {"aabbtree", RunAABBTreeBenchmark},
+    {"allocator", RunAllocatorBenchmark},
+    {"animation", RunAnimationBenchmark},
+    {"animgraph", RunAnimGraphBenchmark},
+    {"concurrency", RunConcurrencyBenchmark},
+    {"containers", RunContainersBenchmark},
+    {"counters", RunCountersBenchmark},
+    {"ecs", RunECSBenchmark},
+    {"graphics", RunGraphicsBenchmark},
+    {"hash", RunHashBenchmark},
+    {"logging", RunLoggingBenchmark},
+    {"matrix", RunMatrixBenchmark},
+    {"memory", RunMemoryBenchmark},
+    {"morph", RunMorphBenchmark},
+    {"pipeline", RunPipelineBenchmark},
+    {"preload", RunPreloadBenchmark},
+    {"skinning", RunSkinningBenchmark},
+    {"taskgraph", RunTaskGraphBenchmark},
+    {"transform", RunTransformBenchmark},
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "-list") == 0)
+    {
+        for (const Suite& suite : gSuites)
+        {
+            printf("%s\n", suite.name);
+        }
+        return 0;
+    }
+
+    Engine::Core::JobSystem::StaticInitialize();
+
+    // No arguments runs every suite, otherwise only the named ones
+    int suitesRun = 0;
+    for (const Suite& suite : gSuites)
+    {
+        bool selected = (argc == 1);
+        for (int i = 1; i < argc && !selected; ++i)
+        {
+            selected = strcmp(argv[i], suite.name) == 0;
+        }
+
+        if (selected)
+        {
+            printf("[%s]\n", suite.name);
+            suite.run();
+            printf("\n");
+            ++suitesRun;
+        }
+    }
+
+    Engine::Core::JobSystem::StaticTerminate();
+
+    if (suitesRun == 0)
+    {
+        printf("Usage: Benchmark [-list] [suite ...]\n");
+        return -1;
+    }
+    return 0;
+}
@@ -15,13 +15,14 @@ struct Arguments
     std::filesystem::path inputFileName;
     std::filesystem::path outputFileName;
     float scale = 1.0f;                  // 1 Unit = 1 Millimeter
+    bool buildBVH = false;               // Save ray cast acceleration data with the model
 };
 
 std::optional<Arguments> ParseArgs(int argc, char* argv[])
 {
     if (argc < 3)
     {
-        printf("Usage: ModelImporter <input file> <output file> [scale]\n");
+        printf("Usage: ModelImporter [-scale <scale>] [-bvh] <input file> <output file>\n");
         return std::nullopt;
     }
 
@@ -36,6 +37,10 @@ std::optional<Arguments> ParseArgs(int argc, char* argv[])
             args.scale = atof(argv[i + 1]);
             ++i;
         }
+        else if (strcmp(argv[i], "-bvh") == 0)
+        {
+            args.buildBVH = true;
+        }
     }
     return args;
 }
@@ -59,6 +64,190 @@ Vector2 ToTexCoord(const aiVector3D& v)
     };
 }
 
+Quaternion ToQuaternion(const aiQuaternion& q)
+{
+    return
+    {
+        static_cast<float>(q.x),
+        static_cast<float>(q.y),
+        static_cast<float>(q.z),
+        static_cast<float>(q.w)
+    };
+}
+
+// Assimp matrices transform column vectors, ours transform row vectors
+Matrix4 ToMatrix4(const aiMatrix4x4& m)
+{
+    return
+    {
+        m.a1, m.b1, m.c1, m.d1,
+        m.a2, m.b2, m.c2, m.d2,
+        m.a3, m.b3, m.c3, m.d3,
+        m.a4, m.b4, m.c4, m.d4
+    };
+}
+
+// Every node becomes a bone, parents first, so clips can animate nodes that have no skin
+void BuildSkeleton(const aiNode* node, int parentIndex, float scale, Skeleton& skeleton)
+{
+    const int boneIndex = static_cast<int>(skeleton.bones.size());
+    Bone& bone = skeleton.bones.emplace_back();
+    bone.name = node->mName.C_Str();
+    bone.parentIndex = parentIndex;
+
+    aiVector3D scaling, position;
+    aiQuaternion rotation;
+    node->mTransformation.Decompose(scaling, rotation, position);
+    bone.restTransform.position = ToVector3(position) * scale;
+    bone.restTransform.rotation = ToQuaternion(rotation);
+    bone.restTransform.scale = ToVector3(scaling);
+
+    for (uint32_t i = 0; i < node->mNumChildren; ++i)
+    {
+        BuildSkeleton(node->mChildren[i], boneIndex, scale, skeleton);
+    }
+}
+
+bool HasBones(const aiScene* scene)
+{
+    for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex)
+    {
+        if (scene->mMeshes[meshIndex]->HasBones())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReadBoneWeights(const aiMesh* aiMesh, float scale, Skeleton& skeleton, std::vector<BoneWeights>& boneWeights)
+{
+    boneWeights.resize(aiMesh->mNumVertices);
+    for (uint32_t b = 0; b < aiMesh->mNumBones; ++b)
+    {
+        const aiBone* aiBone = aiMesh->mBones[b];
+        const int boneIndex = skeleton.FindBone(aiBone->mName.C_Str());
+        if (boneIndex < 0)
+        {
+            printf("Skipping unknown bone: %s\n", aiBone->mName.C_Str());
+            continue;
+        }
+
+        Matrix4 offset = ToMatrix4(aiBone->mOffsetMatrix);
+        offset._41 *= scale;
+        offset._42 *= scale;
+        offset._43 *= scale;
+        skeleton.bones[boneIndex].offsetTransform = offset;
+
+        // Keep the strongest influences, replacing the weakest one when a vertex is full
+        for (uint32_t w = 0; w < aiBone->mNumWeights; ++w)
+        {
+            const aiVertexWeight& weight = aiBone->mWeights[w];
+            BoneWeights& vertexWeights = boneWeights[weight.mVertexId];
+            uint32_t weakest = 0;
+            for (uint32_t i = 1; i < BoneWeights::MaxInfluences; ++i)
+            {
+                if (vertexWeights.weights[i] < vertexWeights.weights[weakest])
+                {
+                    weakest = i;
+                }
+            }
+            if (weight.mWeight > vertexWeights.weights[weakest])
+            {
+                vertexWeights.boneIndices[weakest] = static_cast<uint16_t>(boneIndex);
+                vertexWeights.weights[weakest] = weight.mWeight;
+            }
+        }
+    }
+
+    for (BoneWeights& vertexWeights : boneWeights)
+    {
+        float total = 0.0f;
+        for (float weight : vertexWeights.weights)
+        {
+            total += weight;
+        }
+        if (total > 0.0f)
+        {
+            for (float& weight : vertexWeights.weights)
+            {
+                weight /= total;
+            }
+        }
+    }
+}
+
+// Assimp stores each blend shape as the whole mesh fully morphed, only what moves is kept
+void ReadMorphTargets(const aiMesh* aiMesh, float scale, Model::MeshData& meshData)
+{
+    const Mesh& mesh = meshData.mesh;
+    std::vector<Vector3> positions(mesh.vertices.size());
+    std::vector<Vector3> normals(mesh.vertices.size());
+    for (uint32_t a = 0; a < aiMesh->mNumAnimMeshes; ++a)
+    {
+        const aiAnimMesh* aiAnimMesh = aiMesh->mAnimMeshes[a];
+        std::string name = aiAnimMesh->mName.C_Str();
+        if (name.empty())
+        {
+            name = "Target" + std::to_string(a);
+        }
+        if (!aiAnimMesh->HasPositions() || aiAnimMesh->mNumVertices != mesh.vertices.size())
+        {
+            printf("Skipping morph target without matching vertices: %s\n", name.c_str());
+            continue;
+        }
+
+        for (uint32_t v = 0; v < aiAnimMesh->mNumVertices; ++v)
+        {
+            positions[v] = ToVector3(aiAnimMesh->mVertices[v]) * scale;
+            normals[v] = (aiAnimMesh->HasNormals()) ? ToVector3(aiAnimMesh->mNormals[v]) : mesh.vertices[v].normal;
+        }
+
+        const MorphTarget& target = meshData.morphTargets.emplace_back(MorphTarget::Build(name, mesh, positions.data(), normals.data()));
+        printf("Morph target %s: %u of %zu vertices moved, %zu bytes\n",
+            target.name.c_str(), target.GetVertexCount(), mesh.vertices.size(), target.GetMemorySize());
+    }
+}
+
+RawAnimationClip ReadAnimation(const aiAnimation* aiAnimation, float scale, const Skeleton& skeleton)
+{
+    const double ticksPerSecond = (aiAnimation->mTicksPerSecond > 0.0) ? aiAnimation->mTicksPerSecond : 25.0;
+    auto toSeconds = [ticksPerSecond](double ticks) { return static_cast<float>(ticks / ticksPerSecond); };
+
+    RawAnimationClip clip;
+    clip.name = aiAnimation->mName.C_Str();
+    clip.duration = toSeconds(aiAnimation->mDuration);
+    clip.tracks.resize(skeleton.bones.size());
+    for (uint32_t c = 0; c < aiAnimation->mNumChannels; ++c)
+    {
+        const aiNodeAnim* channel = aiAnimation->mChannels[c];
+        const int boneIndex = skeleton.FindBone(channel->mNodeName.C_Str());
+        if (boneIndex < 0)
+        {
+            printf("Skipping channel for unknown node: %s\n", channel->mNodeName.C_Str());
+            continue;
+        }
+
+        RawAnimationClip::Track& track = clip.tracks[boneIndex];
+        for (uint32_t k = 0; k < channel->mNumPositionKeys; ++k)
+        {
+            const aiVectorKey& key = channel->mPositionKeys[k];
+            track.positionKeys.push_back({ ToVector3(key.mValue) * scale, toSeconds(key.mTime) });
+        }
+        for (uint32_t k = 0; k < channel->mNumRotationKeys; ++k)
+        {
+            const aiQuatKey& key = channel->mRotationKeys[k];
+            track.rotationKeys.push_back({ ToQuaternion(key.mValue), toSeconds(key.mTime) });
+        }
+        for (uint32_t k = 0; k < channel->mNumScalingKeys; ++k)
+        {
+            const aiVectorKey& key = channel->mScalingKeys[k];
+            track.scaleKeys.push_back({ ToVector3(key.mValue), toSeconds(key.mTime) });
+        }
+    }
+    return clip;
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -89,6 +278,13 @@ int main(int argc, char* argv[])
 
 
     Model model;
+    if (HasBones(scene) || scene->HasAnimations())
+    {
+        printf("Reading Skeleton...\n");
+        BuildSkeleton(scene->mRootNode, -1, args.scale, model.skeleton);
+        model.skeleton.BuildRestPose();
+    }
+
     if (scene->HasMeshes())
     {
         printf("Reading Mesh Data...\n");
@@ -140,12 +336,78 @@ int main(int argc, char* argv[])
                     mesh.indices.push_back(aiFace.mIndices[i]);
                 }
             }
+
+            if (aiMesh->HasBones())
+            {
+                printf("Reading Bone Weights for Mesh...\n");
+                ReadBoneWeights(aiMesh, args.scale, model.skeleton, meshData.boneWeights);
+            }
+
+            if (aiMesh->mNumAnimMeshes > 0)
+            {
+                printf("Reading Morph Targets for Mesh...\n");
+                ReadMorphTargets(aiMesh, args.scale, meshData);
+            }
+        }
+    }
+
+    if (scene->HasAnimations())
+    {
+        printf("Reading Animations...\n");
+        for (uint32_t animIndex = 0; animIndex < scene->mNumAnimations; ++animIndex)
+        {
+            const RawAnimationClip rawClip = ReadAnimation(scene->mAnimations[animIndex], args.scale, model.skeleton);
+            const AnimationClip& clip = model.animationClips.emplace_back(AnimationClip::Compress(rawClip, model.skeleton));
+            const AnimationClip::Stats stats = clip.GetStats();
+            printf("Clip %s: %.2fs, %zu bytes raw, %zu bytes compressed, %u/%u/%u animated rotation/position/scale tracks\n",
+                rawClip.name.c_str(), rawClip.duration, rawClip.GetMemorySize(), clip.GetMemorySize(),
+                stats.animatedRotations, stats.animatedPositions, stats.animatedScales);
         }
     }
 
     printf("Saving Model...\n");
     ModelIO::SaveModel(args.outputFileName, model);
 
+    if (!model.skeleton.IsEmpty())
+    {
+        printf("Saving Skeleton...\n");
+        ModelIO::SaveSkeleton(args.outputFileName, model);
+    }
+
+    if (!model.animationClips.empty())
+    {
+        printf("Saving Animations...\n");
+        ModelIO::SaveAnimations(args.outputFileName, model);
+    }
+
+    const auto hasMorphTargets = [](const Model::MeshData& meshData) { return !meshData.morphTargets.empty(); };
+    if (std::any_of(model.meshData.begin(), model.meshData.end(), hasMorphTargets))
+    {
+        printf("Saving Morph Targets...\n");
+        ModelIO::SaveMorphTargets(args.outputFileName, model);
+    }
+
+    printf("Building Meshlets...\n");
+    for (Model::MeshData& meshData : model.meshData)
+    {
+        meshData.meshlets = MeshletBuilder::Build(meshData.mesh);
+    }
+
+    printf("Saving Meshlets...\n");
+    ModelIO::SaveMeshlets(args.outputFileName, model);
+
+    if (args.buildBVH)
+    {
+        printf("Building BVH...\n");
+        for (Model::MeshData& meshData : model.meshData)
+        {
+            meshData.bvh.Build(meshData.mesh);
+        }
+
+        printf("Saving BVH...\n");
+        ModelIO::SaveBVH(args.outputFileName, model);
+    }
+
     printf("Import Complete!\n");
 
     return 0;
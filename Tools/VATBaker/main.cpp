@@ -0,0 +1,90 @@
+#include <Engine/Inc/Engine.h>
+
+#include <cstdio>
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+struct Arguments
+{
+    std::filesystem::path modelFileName;
+    float frameRate = 30.0f; // Baked frames per second of each clip
+};
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: VATBaker [-rate <frames per second>] <model file>\n");
+        return std::nullopt;
+    }
+
+    // .. -rate 15 <modelFileName>
+    Arguments args;
+    args.modelFileName = argv[argc - 1];
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], "-rate") == 0 && i + 2 < argc)
+        {
+            args.frameRate = static_cast<float>(atof(argv[i + 1]));
+            ++i;
+        }
+    }
+    return args;
+}
+
+// Bakes the clips of an imported model into the .vat file next to it, ModelManager picks it up
+// when the model is loaded
+int main(int argc, char* argv[])
+{
+    const auto argOpt = ParseArgs(argc, argv);
+    if (!argOpt.has_value())
+    {
+        return -1;
+    }
+    const Arguments& args = argOpt.value();
+
+    Model model;
+    ModelIO::LoadModel(args.modelFileName, model);
+    ModelIO::LoadSkeleton(args.modelFileName, model);
+    ModelIO::LoadAnimations(args.modelFileName, model);
+    if (model.meshData.empty())
+    {
+        printf("Failed to load model file: %s\n", args.modelFileName.u8string().c_str());
+        return -1;
+    }
+    if (model.skeleton.IsEmpty() || model.animationClips.empty())
+    {
+        printf("Model has no skeleton or animations to bake\n");
+        return -1;
+    }
+
+    printf("Baking %zu clips at %.1f frames per second...\n",
+           model.animationClips.size(),
+           args.frameRate);
+    model.vertexAnimation = VertexAnimationData::Bake(model, args.frameRate);
+    const VertexAnimationData& data = model.vertexAnimation;
+    if (data.IsEmpty())
+    {
+        printf("Bake failed, the frames do not fit in a %ux%u texture\n",
+               VertexAnimationData::MaxTextureWidth,
+               VertexAnimationData::MaxTextureHeight);
+        return -1;
+    }
+
+    for (const VertexAnimationClip& clip : data.clips)
+    {
+        printf("  %-32s %5u frames %8.2f s\n", clip.name.c_str(), clip.frameCount, clip.duration);
+    }
+    printf("Vertices: %u, Textures: %ux%u, Size: %zu bytes\n",
+           data.vertexCount,
+           data.textureWidth,
+           data.GetTextureHeight(),
+           data.GetMemorySize());
+
+    printf("Saving Vertex Animation...\n");
+    ModelIO::SaveVertexAnimation(args.modelFileName, model);
+
+    printf("All done!\n");
+    return 0;
+}